@@ -0,0 +1,139 @@
+/**
+ * 智能桌面伴侣 - 指针表盘
+ *
+ * 指针端点由60个位置的 Q14 定点正弦表计算，正弦表在编译期（constexpr，泰勒级数）生成，
+ * 运行时没有浮点 sin()/cos()。余弦与正弦相差15个位置，共用同一张表。
+ * 刻度光栅化一次后作为缓存层；指针按 Bresenham 直接画到页格式帧缓冲，
+ * 同时记下经过的tile，每秒只需比较和发送指针经过的区域。
+ */
+
+#ifndef ANALOG_DIAL_H
+#define ANALOG_DIAL_H
+
+#include <stdint.h>
+#include "FrameBuffer.h"
+#include "PageSprite.h"
+
+namespace AnalogDial {
+    const uint8_t POSITIONS = 60;           // 表盘位置数（每秒/每分钟一格）
+    const uint8_t QUARTER = POSITIONS / 4;  // 余弦 = 正弦后移四分之一圈
+    const int16_t Q14_ONE = 1 << 14;        // Q14 中的1.0
+
+    // 60个位置的 Q14 正弦值
+    struct TrigTable {
+        int16_t values[POSITIONS];
+    };
+
+    namespace detail {
+        constexpr double PI = 3.14159265358979323846;
+
+        // 泰勒级数 x - x^3/3! + x^5/5! ...，|x| <= π 时13项的误差远小于 Q14 的分辨率
+        constexpr double sinSeries(double x2, double term, int k) {
+            return k > 25 ? 0.0 : term + sinSeries(x2, -term * x2 / ((k + 1) * (k + 2)), k + 2);
+        }
+
+        // 第 i 个位置的角度（弧度，折算到 [-π, π]）
+        constexpr double positionAngle(unsigned i) {
+            return (i <= POSITIONS / 2 ? (double)i : (double)i - POSITIONS) * 2.0 * PI / POSITIONS;
+        }
+
+        constexpr int16_t toQ14(double v) {
+            // 转换为整数时向零截断，先按符号加减0.5实现四舍五入
+            return (int16_t)(v >= 0 ? v * Q14_ONE + 0.5 : v * Q14_ONE - 0.5);
+        }
+
+        constexpr int16_t sinQ14(unsigned i) {
+            return toQ14(sinSeries(positionAngle(i) * positionAngle(i), positionAngle(i), 1));
+        }
+
+        // 编译期整数序列见 PageSprite.h
+        template <unsigned... I>
+        constexpr TrigTable makeTable(PageSpriteDetail::IndexList<I...>) {
+            return TrigTable{{ sinQ14(I)... }};
+        }
+    }
+
+    // 编译期生成的正弦表（位于flash）
+    constexpr TrigTable SIN_TABLE = detail::makeTable(PageSpriteDetail::MakeIndexList<POSITIONS>::type());
+
+    inline int16_t sinQ14(uint8_t pos) {
+        return SIN_TABLE.values[pos % POSITIONS];
+    }
+
+    inline int16_t cosQ14(uint8_t pos) {
+        return SIN_TABLE.values[(pos + QUARTER) % POSITIONS];
+    }
+
+    /**
+     * 指针端点：位置0指向12点，顺时针增加（屏幕Y轴向下）
+     * @param pos 位置 (0-59)
+     * @param length 指针长度（像素）
+     * @param cx 表盘中心X
+     * @param cy 表盘中心Y
+     */
+    inline void handEnd(uint8_t pos, uint8_t length, int16_t cx, int16_t cy, int16_t& x, int16_t& y) {
+        // Q14 乘积四舍五入（算术右移）
+        x = (int16_t)(cx + (((int32_t)sinQ14(pos) * length + (Q14_ONE >> 1)) >> 14));
+        y = (int16_t)(cy - (((int32_t)cosQ14(pos) * length + (Q14_ONE >> 1)) >> 14));
+    }
+
+    /**
+     * 在页格式帧缓冲中画线（按位或，超出屏幕的像素忽略），并标记经过的tile
+     * @param frame 页格式帧缓冲
+     * @param tiles 输出：经过的tile加入标记（可为nullptr）
+     */
+    inline void drawLine(uint8_t* frame, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                         FrameBuffer::DirtyMask tiles) {
+        int16_t dx = x1 > x0 ? x1 - x0 : x0 - x1;
+        int16_t dy = y1 > y0 ? y0 - y1 : y1 - y0;
+        int16_t sx = x0 < x1 ? 1 : -1;
+        int16_t sy = y0 < y1 ? 1 : -1;
+        int16_t err = dx + dy;
+        for (;;) {
+            if ((uint16_t)x0 < FrameBuffer::ROW_BYTES && (uint16_t)y0 < FrameBuffer::TILE_ROWS * 8) {
+                frame[(y0 >> 3) * FrameBuffer::ROW_BYTES + x0] |= (uint8_t)(1 << (y0 & 7));
+                if (tiles != nullptr) {
+                    tiles[y0 >> 3] |= (uint16_t)(1u << (x0 >> 3));
+                }
+            }
+            if (x0 == x1 && y0 == y1) {
+                break;
+            }
+            int16_t e2 = (int16_t)(2 * err);
+            if (e2 >= dy) {
+                err += dy;
+                x0 += sx;
+            }
+            if (e2 <= dx) {
+                err += dx;
+                y0 += sy;
+            }
+        }
+    }
+
+    /**
+     * 画一根指针（从中心到端点）
+     */
+    inline void drawHand(uint8_t* frame, uint8_t pos, uint8_t length, int16_t cx, int16_t cy,
+                         FrameBuffer::DirtyMask tiles) {
+        int16_t x, y;
+        handEnd(pos, length, cx, cy, x, y);
+        drawLine(frame, cx, cy, x, y, tiles);
+    }
+
+    /**
+     * 画表盘刻度：整点为长刻度，其余为点
+     * @param radius 表盘半径（刻度外端）
+     * @param tickLength 整点刻度长度
+     */
+    inline void drawTicks(uint8_t* frame, int16_t cx, int16_t cy, uint8_t radius, uint8_t tickLength) {
+        for (uint8_t pos = 0; pos < POSITIONS; pos++) {
+            int16_t x0, y0, x1, y1;
+            handEnd(pos, radius, cx, cy, x1, y1);
+            handEnd(pos, pos % 5 == 0 ? (uint8_t)(radius - tickLength) : radius, cx, cy, x0, y0);
+            drawLine(frame, x0, y0, x1, y1, nullptr);
+        }
+    }
+}
+
+#endif // ANALOG_DIAL_H
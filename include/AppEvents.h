@@ -0,0 +1,102 @@
+/**
+ * 智能桌面伴侣 - 应用事件
+ *
+ * 事件总线上的事件类型、生产者和订阅者定义。
+ * 触摸、WiFi、时间同步等模块只投递事件，由界面、音频、网络在各自的任务中处理
+ */
+
+#ifndef APP_EVENTS_H
+#define APP_EVENTS_H
+
+#include <stdint.h>
+#include "EventBus.h"
+
+#define EVENT_BUS_DEPTH     8       // 每个（生产者，订阅者）缓冲的事件数
+
+/**
+ * 事件类型
+ */
+enum AppEventType : uint8_t {
+    EVENT_TOUCH = 0,        // 触摸事件（value: TouchEvent）
+    EVENT_WIFI,             // WiFi状态变化（value: WiFiConnectionState）
+    EVENT_TIME_SYNC,        // 时间同步状态变化（value: TimeSyncState）
+    EVENT_CLOCK,            // 当前时间（秒变化时）
+    EVENT_STATUS,           // 系统状态汇总（内存、运行时间、信号强度）
+    EVENT_DORMANT,          // 睡眠模式关屏/唤醒（value: 1 = 关屏，可以关闭WiFi进入light sleep；0 = 唤醒）
+    EVENT_SPEAK,            // 整点问候（音频播放合成的问候语，表情模式下嘴巴按音量包络开合）
+    EVENT_TOUCH_EDGE        // 触摸引脚上升沿（触摸中断投递，touch.edgeMicros 为边沿时刻，防抖前）
+};
+
+/**
+ * 生产者（每个生产者同一时刻只在一个任务或中断中投递）
+ */
+enum EventProducer : uint8_t {
+    PRODUCER_INPUT = 0,     // 触摸管理器（输入任务）
+    PRODUCER_NETWORK,       // WiFi管理器、时间管理器、整点问候（网络任务）
+    PRODUCER_HOUSEKEEPING,  // 系统状态汇总（后台任务）
+    PRODUCER_UI,            // 关屏/唤醒（界面任务）
+    PRODUCER_TOUCH_ISR,     // 触摸边沿中断（只由 TouchManager 的边沿中断写入）
+    PRODUCER_COUNT
+};
+
+/**
+ * 订阅者（各自在自己的任务中取出事件）
+ */
+enum EventSubscriber : uint8_t {
+    SUBSCRIBER_UI = 0,      // 界面：模式逻辑、通知、渲染数据
+    SUBSCRIBER_AUDIO,       // 音频：按键音、提示音、问候语
+    SUBSCRIBER_NETWORK,     // 网络：连接后同步时间
+    SUBSCRIBER_INPUT,       // 输入：边沿唤醒后轮询防抖
+    SUBSCRIBER_COUNT
+};
+
+/**
+ * 事件（按值复制进缓冲，16字节）
+ */
+struct AppEvent {
+    uint32_t timestamp;     // 投递时刻（微秒）
+    uint8_t type;           // AppEventType
+    uint8_t value;          // TouchEvent / WiFiConnectionState / TimeSyncState
+    union {
+        struct {
+            int64_t edgeMicros;     // 按下边沿时刻（esp_timer微秒）
+        } touch;
+        struct {
+            uint16_t year;
+            uint8_t month;
+            uint8_t day;
+            uint8_t hour;
+            uint8_t minute;
+            uint8_t second;
+            bool synced;
+        } clock;
+        struct {
+            uint32_t freeHeap;
+            uint32_t uptime;
+            int8_t rssi;
+            bool wifiConnected;
+        } status;
+    };
+};
+
+typedef EventBus<AppEvent, PRODUCER_COUNT, SUBSCRIBER_COUNT, EVENT_BUS_DEPTH> AppEventBus;
+
+/**
+ * 事件类型对应的订阅掩码位
+ */
+inline uint32_t eventBit(AppEventType type) {
+    return 1UL << type;
+}
+
+/**
+ * 构造一个只有类型和值的事件
+ */
+inline AppEvent makeEvent(AppEventType type, uint8_t value, uint32_t timestamp) {
+    AppEvent event = {};
+    event.timestamp = timestamp;
+    event.type = type;
+    event.value = value;
+    return event;
+}
+
+#endif // APP_EVENTS_H
@@ -11,6 +11,7 @@
 #include <Arduino.h>
 #include "driver/i2s.h"
 #include "config.h"
+#include "LipSync.h"
 
 // 音效类型枚举
 enum SoundEffect {
@@ -20,7 +21,8 @@ enum SoundEffect {
     SOUND_ERROR,        // 错误音效
     SOUND_NOTIFY,       // 通知音效
     SOUND_SLEEP,        // 睡眠音效
-    SOUND_WAKEUP        // 唤醒音效
+    SOUND_WAKEUP,       // 唤醒音效
+    SOUND_GREETING      // 问候语（合成的几个音节，经 playPcm 播放）
 };
 
 class AudioManager {
@@ -54,6 +56,19 @@ public:
      */
     void playMelody(const uint16_t* notes, const uint16_t* durations, uint8_t count);
     
+    /**
+     * 播放单声道16位PCM（如语音合成结果），采样率为 I2S_SAMPLE_RATE
+     * 播放时发布音量包络，供表情口型同步使用
+     * @param samples PCM样本
+     * @param count 样本数
+     */
+    void playPcm(const int16_t* samples, size_t count);
+    
+    /**
+     * 获取音量包络通道（每写入一块I2S数据更新一次，发布的是此时开始播放的那一块）
+     */
+    const LipSync::Channel& getEnvelope() const { return envelope; }
+    
     /**
      * 设置音量
      * @param vol 音量 (0-100)
@@ -86,6 +101,19 @@ private:
     bool muted;             // 是否静音
     bool playing;           // 是否正在播放
     bool initialized;       // 是否已初始化
+    LipSync::Channel envelope;  // 正在播放的那一块样本的包络
+    LipSync::Envelope queuedEnvelope;   // 最近写入、还在DMA缓冲中排队的一块样本的包络
+    size_t queuedSamples;               // 排队的那一块的样本数（0表示没有）
+    
+    /**
+     * 播放结束：发布最后一块的包络，等它播完后清除包络
+     */
+    void finishEnvelope();
+    
+    /**
+     * 逐个音节合成问候语的PCM并播放（元音式的波形，各音节音调不同）
+     */
+    void playGreeting();
     
     /**
      * 生成正弦波样本
@@ -93,7 +121,7 @@ private:
     void generateSineWave(int16_t* buffer, size_t samples, uint16_t frequency);
     
     /**
-     * 写入 I2S 数据
+     * 写入 I2S 数据（立体声交错），计算这一块的包络，并发布此时开始播放的上一块的包络
      */
     void writeI2S(int16_t* buffer, size_t samples);
 };
@@ -2,6 +2,7 @@
  * 智能桌面伴侣 - 时钟显示渲染器
  * 
  * 负责渲染时钟界面，显示时间和日期
+ * 支持数字表盘和指针表盘：两者都只重绘变化的部分（字符或指针），并报告涉及的tile
  */
 
 #ifndef CLOCK_RENDERER_H
@@ -10,6 +11,33 @@
 #include <Arduino.h>
 #include <U8g2lib.h>
 #include "config.h"
+#include "FrameBuffer.h"
+#include "AnalogDial.h"
+
+// 时间字形缓存配置
+#define CLOCK_TIME_CHARS        8       // "HH:MM:SS"
+#define CLOCK_TIME_BASELINE     38      // 时间基线Y坐标
+#define CLOCK_GLYPH_COUNT       11      // 数字0-9和冒号
+#define CLOCK_GLYPH_MAX_WIDTH   20      // 单个字形最大宽度（像素）
+#define CLOCK_GLYPH_MAX_PAGES   4       // 字形最多跨越的页数
+
+// 指针表盘布局（表盘在左半屏，日期和迷你表情在右半屏）
+#define CLOCK_DIAL_X            32      // 表盘中心X
+#define CLOCK_DIAL_Y            32      // 表盘中心Y
+#define CLOCK_DIAL_RADIUS       31      // 刻度外端半径
+#define CLOCK_DIAL_TICK         4       // 整点刻度长度
+#define CLOCK_HOUR_HAND         15      // 时针长度
+#define CLOCK_MINUTE_HAND       23      // 分针长度
+#define CLOCK_SECOND_HAND       27      // 秒针长度
+
+/**
+ * 表盘样式
+ */
+enum ClockFace {
+    CLOCK_FACE_DIGITAL = 0, // 数字表盘
+    CLOCK_FACE_ANALOG,      // 指针表盘
+    CLOCK_FACE_COUNT
+};
 
 class ClockRenderer {
 public:
@@ -21,11 +49,25 @@ public:
     void init();
     
     /**
-     * 渲染时钟界面到显示器
+     * 渲染时钟界面的动态内容（时间）
+     * 首次调用时把时钟字体的数字预光栅化为页格式字形条并计算布局，
+     * 之后只把与上次不同的字符从字形条复制到时间行缓存，再将时间行合成到帧缓冲
      * @param display U8g2显示对象指针
      */
     void render(U8G2* display);
     
+    /**
+     * 渲染静态背景层（迷你表情、日期、离线指示器）
+     * 结果由DisplayManager缓存，只在getStaticVersion()变化时重新调用
+     * @param display U8g2显示对象指针
+     */
+    void renderStatic(U8G2* display);
+    
+    /**
+     * 获取静态背景层的版本号（日期或离线状态变化时递增）
+     */
+    uint16_t getStaticVersion() const;
+    
     /**
      * 设置当前时间
      * @param hour 小时 (0-23)
@@ -48,6 +90,62 @@ public:
      */
     void setOffline(bool offline);
     
+    /**
+     * 设置表盘样式
+     */
+    void setFace(ClockFace face);
+    
+    /**
+     * 获取表盘样式
+     */
+    ClockFace getFace() const;
+    
+    /**
+     * 在数字表盘和指针表盘之间切换，并输出两种表盘的每秒渲染耗时和存储占用
+     */
+    void toggleFace();
+    
+    /**
+     * 检查画面是否需要重绘（时间/日期变化后置位，render后清除）
+     */
+    bool isDirty() const;
+    
+    /**
+     * 标记画面需要重绘
+     */
+    void markDirty();
+    
+    /**
+     * 获取距离下一次秒数跳变的时间
+     * @param now 当前时间（millis）
+     * @return 剩余毫秒数，0表示已到期
+     */
+    unsigned long getNextDeadline(unsigned long now) const;
+    
+    /**
+     * 获取上一次render中重绘的字符数
+     */
+    uint8_t getLastRedrawnChars() const;
+    
+    /**
+     * 获取上一次render中变化的内容（数字表盘的字符 / 指针表盘的新旧指针）覆盖的tile
+     * @param tiles 输出tile标记
+     */
+    void getChangedTiles(FrameBuffer::DirtyMask tiles) const;
+    
+    /**
+     * 获取某种表盘上一次render的耗时（微秒，每秒一次）
+     */
+    uint32_t getRenderMicros(ClockFace which) const;
+    
+    /**
+     * 获取某种表盘的存储占用
+     * @param which 表盘样式
+     * @param ramBytes 输出：缓存占用的RAM字节数（字形条 / 指针tile记录，不含共用的背景层）
+     * @return 占用的flash字节数（数字表盘为时钟字体，指针表盘为正弦表）
+     */
+    static uint32_t getFlashBytes(ClockFace which, uint32_t& ramBytes);
+    
     /**
      * 格式化时间为字符串
      * @param hour 小时
@@ -82,6 +180,63 @@ private:
     // 是否离线
     bool isOffline;
     
+    // 画面是否需要重绘
+    bool dirty;
+    
+    // 上次秒数跳变的时间（millis）
+    unsigned long lastSecondTick;
+    
+    // 静态背景层版本号
+    uint16_t staticVersion;
+    
+    // 表盘样式
+    ClockFace face;
+    
+    // 上一次render变化的tile，指针表盘上一帧各指针经过的tile
+    FrameBuffer::DirtyMask changedTiles;
+    FrameBuffer::DirtyMask handTiles;
+    bool handsDrawn;
+    
+    // 各表盘上一次render的耗时（微秒）
+    uint32_t renderMicros[CLOCK_FACE_COUNT];
+    
+    // 页格式字形条：数字0-9和冒号，每个字形按页存放、与时间行页对齐
+    uint8_t glyphStrip[CLOCK_GLYPH_COUNT][CLOCK_GLYPH_MAX_PAGES][CLOCK_GLYPH_MAX_WIDTH];
+    uint8_t glyphWidth[CLOCK_GLYPH_COUNT];
+    bool glyphsReady;
+    
+    // 时间行布局（只计算一次）
+    uint8_t timePage;                       // 时间行起始页
+    uint8_t timePages;                      // 时间行占用页数
+    uint8_t charX[CLOCK_TIME_CHARS];        // 每个字符的X坐标
+    uint8_t timeX0;                         // 时间行左边界
+    uint8_t timeX1;                         // 时间行右边界（不含）
+    
+    // 时间行缓存：已绘制的字符及其页格式像素
+    uint8_t timeLine[CLOCK_GLYPH_MAX_PAGES][FrameBuffer::ROW_BYTES];
+    char lastChars[CLOCK_TIME_CHARS];
+    uint8_t lastRedrawnChars;
+    
+    /**
+     * 渲染数字表盘的时间行
+     */
+    void renderDigital(uint8_t* frame, U8G2* display);
+    
+    /**
+     * 渲染指针表盘的三根指针
+     */
+    void renderAnalog(uint8_t* frame);
+    
+    /**
+     * 预光栅化时钟字体的字形条并计算时间行布局
+     */
+    bool buildGlyphStrip(U8G2* display);
+    
+    /**
+     * 字符对应的字形条索引
+     */
+    static uint8_t glyphIndex(char c);
+    
     /**
      * 绘制迷你表情图标
      */
@@ -60,6 +60,13 @@ public:
      */
     bool isDirty() const;
     
+    /**
+     * 获取下一次自动保存的时间
+     * @param now 当前时间（毫秒）
+     * @return 剩余毫秒数，0表示下一次update会保存，DEADLINE_NONE表示没有未保存的更改
+     */
+    unsigned long getNextDeadline(unsigned long now) const;
+    
     // ========================================================================
     // 配置项访问器
     // ========================================================================
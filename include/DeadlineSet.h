@@ -0,0 +1,99 @@
+/**
+ * 智能桌面伴侣 - 截止时间汇总
+ *
+ * 空闲前向各个模块询问下一次需要醒来的时间（剩余毫秒数，DEADLINE_NONE表示没有），
+ * 取最早的一个作为本次等待的时长，并记住它来自哪个模块，便于统计是谁在频繁唤醒设备。
+ */
+
+#ifndef DEADLINE_SET_H
+#define DEADLINE_SET_H
+
+#include <stdint.h>
+
+/**
+ * 截止时间的来源
+ */
+enum DeadlineSource : uint8_t {
+    DEADLINE_TOUCH = 0,         // 触摸：按下或防抖期间的轮询
+    DEADLINE_DISPLAY,           // 显示：下一帧（眨眼、动画、秒表、通知）
+    DEADLINE_SCREEN_SAVER,      // 屏幕保护：调暗/睡眠超时、工厂重置提示
+    DEADLINE_CONFIG,            // 配置：自动保存
+    DEADLINE_TIME,              // 时间：下一秒、定期同步
+    DEADLINE_WIFI,              // WiFi：连接检查、断线重连、配网超时
+    DEADLINE_MONITOR,           // 系统监控：检查间隔
+    DEADLINE_SOURCE_COUNT
+};
+
+class DeadlineSet {
+public:
+    // 没有截止时间（与 DEADLINE_NONE 相同）
+    static const uint32_t NONE = 0xFFFFFFFFUL;
+
+    DeadlineSet() {
+        clear();
+    }
+
+    /**
+     * 开始新一轮汇总
+     */
+    void clear() {
+        earliest = NONE;
+        source = DEADLINE_SOURCE_COUNT;
+    }
+
+    /**
+     * 提交一个模块的截止时间
+     * @param from 来源（DeadlineSource）
+     * @param remainingMs 剩余毫秒数，NONE表示该模块没有截止时间
+     */
+    void offer(uint8_t from, uint32_t remainingMs) {
+        if (remainingMs < earliest) {
+            earliest = remainingMs;
+            source = from;
+        }
+    }
+
+    /**
+     * 最早的截止时间
+     * @return 剩余毫秒数，NONE表示所有模块都没有截止时间
+     */
+    uint32_t getEarliest() const { return earliest; }
+
+    /**
+     * 最早的截止时间的来源
+     * @return DeadlineSource，没有截止时间时为 DEADLINE_SOURCE_COUNT
+     */
+    uint8_t getSource() const { return source; }
+
+    /**
+     * 本次等待的时长：最早的截止时间，不超过 maxMs（没有截止时间时也按 maxMs 醒来）
+     */
+    uint32_t getWait(uint32_t maxMs) const {
+        return earliest < maxMs ? earliest : maxMs;
+    }
+
+    /**
+     * 从 since 起经过 interval 的截止时间还剩多少（按无符号差值计算，允许millis()回绕）
+     * @return 剩余毫秒数，已过期时为0
+     */
+    static uint32_t remaining(uint32_t now, uint32_t since, uint32_t interval) {
+        uint32_t elapsed = now - since;
+        return elapsed >= interval ? 0 : interval - elapsed;
+    }
+
+    /**
+     * 来源名称（用于日志）
+     */
+    static const char* sourceName(uint8_t from) {
+        static const char* const names[DEADLINE_SOURCE_COUNT] = {
+            "touch", "display", "screensaver", "config", "time", "wifi", "monitor"
+        };
+        return from < DEADLINE_SOURCE_COUNT ? names[from] : "none";
+    }
+
+private:
+    uint32_t earliest;
+    uint8_t source;
+};
+
+#endif // DEADLINE_SET_H
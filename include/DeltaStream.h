@@ -0,0 +1,186 @@
+/**
+ * 智能桌面伴侣 - 预计算的tile增量流
+ *
+ * 空闲表情的几段固定动画（眨眼、看左右、触摸反应）都是在同一张基础表情上变化，
+ * 开机时把每段动画按动画帧率逐帧渲染一次，与基础表情逐tile比较，
+ * 只保存变化的tile（tile序号 + 8字节内容）。
+ *
+ * 播放时把基础表情整帧复制到帧缓冲，再写入当前帧的增量tile，
+ * 同时得到这一帧相对基础表情变化的tile集合，直接交给刷新，不需要重新绘制。
+ * 内容相同的相邻帧只保存一次。
+ */
+
+#ifndef DELTA_STREAM_H
+#define DELTA_STREAM_H
+
+#include <stdint.h>
+#include <string.h>
+#include "FrameBuffer.h"
+
+#define DELTA_STREAM_MAX_FRAMES     24      // 每段增量流最多的帧数（去重后）
+#define DELTA_STREAM_TILE_BYTES     (1 + FrameBuffer::TILE_BYTES)   // tile序号 + tile内容
+
+class DeltaStream {
+public:
+    /**
+     * 一帧的增量：从 time 开始显示，直到下一帧
+     */
+    struct Frame {
+        uint16_t time;          // 相对动画开始的时间（毫秒）
+        uint16_t offset;        // 增量数据在存储区中的偏移
+        uint8_t tiles;          // 与基础表情不同的tile数
+    };
+
+    DeltaStream() : data(nullptr), capacity(0), used(0), frameCount(0), duration(0), ready(false), overflow(false) {}
+
+    /**
+     * 开始生成增量流
+     * @param storage 增量数据存储区（由调用者分配，多段增量流可依次共用一块内存）
+     * @param size 存储区字节数
+     */
+    void begin(uint8_t* storage, uint16_t size) {
+        data = storage;
+        capacity = size;
+        used = 0;
+        frameCount = 0;
+        duration = 0;
+        ready = false;
+        overflow = false;
+    }
+
+    /**
+     * 添加一帧：与基础表情逐tile比较，只保存变化的tile
+     * 时间必须递增；与上一帧内容相同时只延长上一帧
+     * @param time 相对动画开始的时间（毫秒）
+     * @param frame 动画在该时刻的完整画面
+     * @param base 基础表情画面
+     * @return false 存储区或帧表已满（该增量流不可用）
+     */
+    bool addFrame(uint16_t time, const uint8_t* frame, const uint8_t* base) {
+        if (overflow || data == nullptr) {
+            return false;
+        }
+
+        FrameBuffer::DirtyMask dirty;
+        uint8_t tiles = FrameBuffer::diffTiles(frame, base, dirty);
+        uint16_t bytes = (uint16_t)(tiles * DELTA_STREAM_TILE_BYTES);
+        if (frameCount >= DELTA_STREAM_MAX_FRAMES || used + bytes > capacity) {
+            overflow = true;
+            return false;
+        }
+
+        // 先写到存储区末尾，与上一帧相同则不占用
+        uint8_t* out = data + used;
+        for (uint8_t ty = 0; ty < FrameBuffer::TILE_ROWS; ty++) {
+            for (uint8_t tx = 0; tx < FrameBuffer::TILE_COLS; tx++) {
+                if (dirty[ty] & (1u << tx)) {
+                    *out++ = (uint8_t)(ty * FrameBuffer::TILE_COLS + tx);
+                    memcpy(out, frame + ty * FrameBuffer::ROW_BYTES + tx * FrameBuffer::TILE_BYTES,
+                           FrameBuffer::TILE_BYTES);
+                    out += FrameBuffer::TILE_BYTES;
+                }
+            }
+        }
+        if (frameCount > 0) {
+            const Frame& last = frames[frameCount - 1];
+            if (last.tiles == tiles && memcmp(data + last.offset, data + used, bytes) == 0) {
+                return true;
+            }
+        }
+
+        Frame& entry = frames[frameCount++];
+        entry.time = time;
+        entry.offset = used;
+        entry.tiles = tiles;
+        used += bytes;
+        return true;
+    }
+
+    /**
+     * 结束生成
+     * @param length 动画总时长（毫秒）
+     * @return 增量流是否可用
+     */
+    bool finish(uint16_t length) {
+        duration = length;
+        ready = !overflow && frameCount > 0 && frames[0].time == 0;
+        return ready;
+    }
+
+    bool isReady() const {
+        return ready;
+    }
+
+    /**
+     * 获取动画在指定时刻显示的帧
+     */
+    uint8_t frameAt(uint32_t elapsed) const {
+        // 二分查找最后一个 time <= elapsed 的帧
+        uint8_t low = 0;
+        uint8_t high = frameCount;
+        while (high - low > 1) {
+            uint8_t mid = (uint8_t)((low + high) / 2);
+            if (frames[mid].time <= elapsed) {
+                low = mid;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    /**
+     * 把一帧的增量tile写入帧缓冲（帧缓冲中应已是基础表情）
+     * @param index 帧序号（frameAt的结果）
+     * @param frame 帧缓冲
+     * @param dirty 输出该帧相对基础表情变化的tile
+     */
+    void apply(uint8_t index, uint8_t* frame, FrameBuffer::DirtyMask dirty) const {
+        memset(dirty, 0, sizeof(FrameBuffer::DirtyMask));
+        if (index >= frameCount) {
+            return;
+        }
+        const uint8_t* in = data + frames[index].offset;
+        for (uint8_t i = 0; i < frames[index].tiles; i++) {
+            uint8_t ty = in[0] / FrameBuffer::TILE_COLS;
+            uint8_t tx = in[0] % FrameBuffer::TILE_COLS;
+            memcpy(frame + ty * FrameBuffer::ROW_BYTES + tx * FrameBuffer::TILE_BYTES, in + 1, FrameBuffer::TILE_BYTES);
+            dirty[ty] |= (uint16_t)(1u << tx);
+            in += DELTA_STREAM_TILE_BYTES;
+        }
+    }
+
+    uint8_t getFrameCount() const {
+        return frameCount;
+    }
+
+    uint16_t getDuration() const {
+        return duration;
+    }
+
+    /**
+     * 增量数据占用的存储区字节数
+     */
+    uint16_t getDataBytes() const {
+        return used;
+    }
+
+    /**
+     * 增量流占用的总内存（帧表 + 增量数据）
+     */
+    uint16_t getBytes() const {
+        return (uint16_t)(sizeof(frames) + used);
+    }
+
+private:
+    Frame frames[DELTA_STREAM_MAX_FRAMES];
+    uint8_t* data;
+    uint16_t capacity;
+    uint16_t used;
+    uint8_t frameCount;
+    uint16_t duration;
+    bool ready;
+    bool overflow;
+};
+
+#endif // DELTA_STREAM_H
@@ -9,10 +9,60 @@
 
 #include <Arduino.h>
 #include <U8g2lib.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_timer.h>
 #include "config.h"
+#include "FrameBuffer.h"
+#include "DeltaStream.h"
+#include "PanelEffects.h"
+#include "GrayPlanes.h"
+#include "ToastQueue.h"
 #include "FaceRenderer.h"
 #include "ClockRenderer.h"
 #include "SysInfoRenderer.h"
+#include "TextRenderer.h"
+#include "StopwatchRenderer.h"
+
+/**
+ * 显示层
+ * 每帧按 背景层 -> 内容层 -> 覆盖层 的顺序合成：
+ * - 背景层：渲染器的静态部分，光栅化一次后缓存，按32位字复制到帧缓冲
+ * - 内容层：渲染器的动态部分，每帧直接绘制
+ * - 覆盖层：跨模式的叠加内容，缓存后按32位字或合成；通知栏缓存后整页复制到屏幕底部
+ */
+enum DisplayLayer {
+    LAYER_BACKGROUND = 0,   // 静态背景层
+    LAYER_CONTENT,          // 动态内容层
+    LAYER_OVERLAY           // 覆盖层
+};
+
+/**
+ * 模式切换过渡效果
+ * 旧画面与新画面分别位于两个离屏缓冲，按定点进度逐帧合成
+ */
+enum TransitionType {
+    TRANSITION_SLIDE = 0,   // 水平滑动（新画面从右侧推入）
+    TRANSITION_WIPE,        // 垂直擦除（新画面从顶部向下覆盖）
+    TRANSITION_DISSOLVE     // 有序抖动交叉淡入淡出
+};
+
+/**
+ * 睡眠阶段
+ * 进入睡眠后只发送一帧静态画面，之后由屏幕硬件（或逐步发送对比度命令）做呼吸效果；
+ * 更长时间无操作后渐暗并关闭屏幕和电荷泵
+ */
+enum SleepStage {
+    SLEEP_STAGE_NONE = 0,       // 未睡眠
+    SLEEP_STAGE_ENTERING,       // 等待过渡动画和静态画面发送完成
+    SLEEP_STAGE_BREATHING,      // 静态画面 + 对比度呼吸
+    SLEEP_STAGE_FADING_OUT,     // 屏幕自行渐暗（硬件效果），完成后关闭屏幕
+    SLEEP_STAGE_PANEL_OFF       // 屏幕关闭（显存内容保留）
+};
+
+// 覆盖层绘制函数类型
+typedef void (*OverlayDrawFunc)(U8G2* display, void* context);
 
 class DisplayManager {
 public:
@@ -26,9 +76,16 @@ public:
     
     /**
      * 更新显示内容（在主循环中调用）
+     * 只有渲染器标记为脏或动画到期时才会生成新帧
      */
     void update();
     
+    /**
+     * 获取距离下一帧的时间
+     * @return 剩余毫秒数，0表示下一次update会出帧，DEADLINE_NONE表示没有待处理的帧
+     */
+    unsigned long getNextDeadline() const;
+    
     /**
      * 设置显示模式
      * @param mode 目标显示模式
@@ -58,6 +115,47 @@ public:
      */
     uint8_t getBrightness() const;
     
+    /**
+     * 屏幕是否处于开启状态（深度睡眠时关闭）
+     */
+    bool isPanelOn() const;
+    
+    /**
+     * 刷新任务是否空闲（没有正在发送或等待发送的帧，I2C总线未被占用），进入light sleep前检查
+     */
+    bool isFlushIdle() const;
+    
+    /**
+     * 获取当前睡眠阶段
+     */
+    SleepStage getSleepStage() const;
+    
+    /**
+     * 以4级灰度显示一个灰度精灵（屏幕其余部分清空）
+     * 定时器按 GRAY_PLANE_HZ 唤醒刷新任务轮流发送位平面，期间主循环不出帧；
+     * 切换模式或显示其他画面时自动退出
+     * @param sprite 灰度精灵（数据须在灰度模式期间保持有效）
+     * @param x 左上角X坐标
+     * @param page 左上角所在页 (0-7)
+     * @return false 未启用异步刷新或定时器创建失败
+     */
+    bool showGrayscale(const GraySprite& sprite, int16_t x, uint8_t page);
+    
+    /**
+     * 退出灰度模式，恢复总线时钟和屏幕扫描率，下一次update重绘当前模式
+     */
+    void stopGrayscale();
+    
+    /**
+     * 是否处于灰度模式
+     */
+    bool isGrayscale() const;
+    
+    /**
+     * 获取灰度模式的平面节拍统计（实际平面速率、抖动、丢失的平面数）
+     */
+    const GrayPlanes::PlaneTiming& getGrayTiming() const;
+    
     /**
      * 获取U8g2显示对象指针（供渲染器使用）
      * @return U8g2对象指针
@@ -70,17 +168,43 @@ public:
     void showBootScreen();
     
     /**
-     * 显示连接状态
+     * 以通知形式显示连接状态（带WiFi图标，可在任意任务中调用）
      * @param message 状态消息
      */
     void showConnectionStatus(const char* message);
     
     /**
-     * 显示通用消息
-     * @param message 要显示的消息
+     * 显示通用消息：一行能显示完的西文消息以通知显示（可在任意任务中调用），
+     * 更长或含中文的消息切换到文本模式（showText，只能在界面任务中调用）
+     * @param message 要显示的消息（UTF-8）
      */
     void showMessage(const char* message);
     
+    /**
+     * 投递一条通知，由正常出帧流程合成到当前模式之上，到期后自动移除
+     * 可在任意任务中调用（无锁），不会阻塞调用者
+     * @param text 文本（最多 TOAST_TEXT_BYTES - 1 字节）
+     * @param priority 优先级，高优先级的通知先显示
+     * @param durationMs 显示时长
+     * @param icon 图标字形（open_iconic_www_1x），0表示没有图标
+     * @return false 通知队列已满
+     */
+    bool postToast(const char* text, ToastPriority priority = TOAST_INFO,
+                   uint32_t durationMs = TOAST_DEFAULT_MS, uint16_t icon = 0);
+    
+    /**
+     * 当前是否正在显示通知
+     */
+    bool isToastShowing() const;
+    
+    /**
+     * 切换到文本模式显示一条消息（如AI回复）
+     * 长文本自动换行并纵向滚动，或以单行跑马灯方式滚动
+     * @param text UTF-8文本
+     * @param mode 滚动方式
+     */
+    void showText(const char* text, TextScrollMode mode = TEXT_SCROLL_VERTICAL);
+    
     /**
      * 清空显示
      */
@@ -100,6 +224,95 @@ public:
      * 获取系统信息渲染器引用
      */
     SysInfoRenderer& getSysInfoRenderer();
+    
+    /**
+     * 获取文本渲染器引用
+     */
+    TextRenderer& getTextRenderer();
+    
+    /**
+     * 获取秒表渲染器引用
+     */
+    StopwatchRenderer& getStopwatchRenderer();
+    
+    /**
+     * 获取上一帧通过I2C发送的字节数
+     */
+    uint16_t getLastFlushBytes() const;
+    
+    /**
+     * 获取累计通过I2C发送的字节数
+     */
+    uint32_t getTotalFlushBytes() const;
+    
+    /**
+     * 获取累计刷新的帧数
+     */
+    uint32_t getFlushedFrameCount() const;
+    
+    /**
+     * 获取累计渲染的帧数
+     */
+    uint32_t getRenderedFrameCount() const;
+    
+    /**
+     * 获取交给刷新任务的帧数
+     */
+    uint32_t getQueuedFrameCount() const;
+    
+    /**
+     * 获取因刷新任务忙而丢弃的帧数
+     */
+    uint32_t getDroppedFrameCount() const;
+    
+    /**
+     * 获取由预计算增量流合成（没有重新绘制表情）的帧数
+     */
+    uint32_t getStreamedFrameCount() const;
+    
+    /**
+     * 获取空闲动画的预计算增量流（帧数、内存占用）
+     * @param index 空闲动画序号（见 FaceRenderer::getIdleAnimation）
+     */
+    const DeltaStream& getFaceStream(uint8_t index) const;
+    
+    /**
+     * 获取上一帧的光栅化耗时（微秒，包含各层合成）
+     */
+    uint32_t getLastRenderMicros() const;
+    
+    /**
+     * 获取上一次静态背景层光栅化的耗时（微秒）
+     */
+    uint32_t getLastStaticRenderMicros() const;
+    
+    /**
+     * 获取上一次过渡动画的总CPU耗时（微秒，包含新画面渲染与合成）
+     */
+    uint32_t getLastTransitionMicros() const;
+    
+    /**
+     * 获取上一次过渡动画的帧数
+     */
+    uint16_t getLastTransitionFrames() const;
+    
+    /**
+     * 获取上一次过渡动画中超出每帧CPU预算的帧数
+     */
+    uint16_t getLastTransitionOverBudget() const;
+    
+    /**
+     * 设置覆盖层内容
+     * @param draw 绘制函数（nullptr表示移除覆盖层）
+     * @param context 传给绘制函数的参数
+     */
+    void setOverlay(OverlayDrawFunc draw, void* context);
+    
+    /**
+     * 使缓存的图层失效（下一帧重新光栅化）
+     * @param layer 背景层或覆盖层
+     */
+    void invalidateLayer(DisplayLayer layer);
 
 private:
     // U8g2显示对象 - SSD1306 128x64 I2C模式
@@ -123,10 +336,130 @@ private:
     // 过渡动画持续时间（毫秒）
     static const unsigned long TRANSITION_DURATION_MS = 200;
     
+    // 当前过渡效果
+    TransitionType transitionType;
+    
+    // 过渡动画的旧画面快照与新画面离屏缓冲
+    uint8_t transitionFrom[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    uint8_t transitionTo[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    
+    // 过渡动画CPU耗时统计（当前过渡累计 / 上一次过渡结果）
+    uint32_t transitionMicros;
+    uint16_t transitionFrames;
+    uint16_t transitionOverBudget;
+    uint32_t lastTransitionMicros;
+    uint16_t lastTransitionFrames;
+    uint16_t lastTransitionOverBudget;
+    
+    // 上一帧的渲染时间
+    unsigned long lastFrameTime;
+    
+    // 是否需要重绘当前模式（模式切换或画面被临时消息覆盖后）
+    bool forceRedraw;
+    
+    // 累计渲染的帧数
+    uint32_t renderedFrames;
+    
+    // 屏幕上已显示内容的副本（用于逐tile比较）
+    uint8_t shadowBuffer[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    
+    // 两个帧缓冲，交替作为U8g2的渲染缓冲（后缓冲）和待发送的前缓冲
+    // 使用自有的4字节对齐缓冲替代U8g2内部缓冲，以便按32位字合成
+    uint8_t frameBuffers[2][FrameBuffer::SIZE] __attribute__((aligned(4)));
+    
+    // 前缓冲：已完成渲染、等待或正在发送到屏幕的帧
+    uint8_t* frontBuffer;
+    
+    // 下一帧是否强制全屏刷新（影子缓冲与屏幕内容不一致时）
+    volatile bool forceFullFlush;
+    
+    // I2C刷新统计
+    volatile uint16_t lastFlushBytes;
+    volatile uint32_t totalFlushBytes;
+    volatile uint32_t flushedFrames;
+    
+    // 帧提交统计
+    uint32_t queuedFrames;
+    uint32_t droppedFrames;
+    
+    // 显示刷新任务
+    TaskHandle_t flushTask;
+    
+    // 前缓冲空闲信号（刷新任务发送完成后释放）
+    SemaphoreHandle_t frontFree;
+    
+    // I2C总线互斥锁（刷新任务与主循环中的对比度命令共用总线）
+    SemaphoreHandle_t busMutex;
+    
+    // 静态背景层缓存（只在内容变化时重新光栅化）
+    uint8_t staticLayer[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    bool staticLayerValid;
+    DisplayMode staticLayerMode;
+    uint16_t staticLayerVersion;
+    
+    // 覆盖层缓存（叠加在所有模式之上）
+    uint8_t overlayLayer[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    OverlayDrawFunc overlayDraw;
+    void* overlayContext;
+    bool overlayValid;
+    
+    // 通知队列和当前通知的缓存（只使用通知栏所在的页）
+    ToastQueue toasts;
+    uint8_t toastLayer[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    bool toastValid;
+    
+    // 空闲表情动画：基础表情画面和各段动画的预计算增量流（开机时生成，共用一块存储区）
+    uint8_t faceBaseFrame[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    DeltaStream faceStreams[FACE_IDLE_ANIMATIONS];
+    uint8_t faceStreamPool[FACE_STREAM_POOL_BYTES];
+    bool faceStreamsReady;
+    uint32_t streamedFrames;
+    
+    // 刚合成的帧是否来自增量流，及其相对基础表情变化的tile
+    bool streamComposed;
+    FrameBuffer::DirtyMask streamDirty;
+    
+    // 最近一次提交的帧是否来自增量流（且没有覆盖层），及其相对基础表情变化的tile
+    bool presentedStream;
+    FrameBuffer::DirtyMask presentedStreamDirty;
+    
+    // 最近一次提交的帧是否为可报告变化tile的画面（时钟、秒表，且没有覆盖层），及其模式和背景层版本
+    bool presentedTiled;
+    DisplayMode presentedTiledMode;
+    uint16_t presentedTiledVersion;
+    
+    // 随帧交给刷新任务的候选tile（有效时刷新只比较这些tile）
+    FrameBuffer::DirtyMask flushHint;
+    volatile bool flushHintValid;
+    
+    // 灰度模式：精灵位置、下一个平面序号、平面帧缓冲（只由刷新任务写入）和平面之间变化的tile
+    volatile bool grayActive;
+    GraySprite graySprite;
+    int16_t grayX;
+    uint8_t grayPage;
+    uint8_t grayPlaneIndex;
+    uint8_t grayFrame[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    FrameBuffer::DirtyMask grayTiles;
+    GrayPlanes::PlaneTiming grayTiming;
+    esp_timer_handle_t grayTimer;
+    
+    // 睡眠状态
+    SleepStage sleepStage;
+    unsigned long sleepStartTime;
+    unsigned long lastBreathTime;
+    uint8_t breathStep;
+    bool panelOn;
+    
+    // 光栅化耗时统计（微秒）
+    uint32_t lastRenderMicros;
+    uint32_t lastStaticRenderMicros;
+    
     // 渲染器实例
     FaceRenderer faceRenderer;
     ClockRenderer clockRenderer;
     SysInfoRenderer sysInfoRenderer;
+    TextRenderer textRenderer;
+    StopwatchRenderer stopwatchRenderer;
     
     /**
      * 渲染过渡动画
@@ -134,9 +467,140 @@ private:
     void renderTransition();
     
     /**
-     * 根据当前模式渲染内容
+     * 根据当前模式渲染内容并提交
      */
     void renderCurrentMode();
+    
+    /**
+     * 按 背景层 -> 内容层 -> 覆盖层 合成当前模式到U8g2的渲染缓冲（不提交）
+     */
+    void composeCurrentMode();
+    
+    /**
+     * 开机时生成空闲表情动画的增量流：用单独的表情渲染器实例逐帧绘制，与基础表情比较
+     */
+    void bakeFaceStreams();
+    
+    /**
+     * 由基础表情和增量流合成表情画面（不重新绘制）
+     * @param frame 帧缓冲
+     * @return false 当前画面没有预计算，需要完整绘制
+     */
+    bool composeFaceStream(uint8_t* frame);
+    
+    /**
+     * 根据切换前后的模式选择过渡效果
+     */
+    TransitionType selectTransition(DisplayMode from, DisplayMode to) const;
+    
+    /**
+     * 获取最近一次提交的帧（过渡动画的旧画面来源）
+     */
+    const uint8_t* getPresentedFrame();
+    
+    /**
+     * 获取当前模式的最小帧间隔（毫秒）
+     */
+    unsigned long getFrameInterval() const;
+    
+    /**
+     * 检查当前模式是否有静态背景层
+     */
+    bool hasStaticLayer() const;
+    
+    /**
+     * 获取当前模式静态背景层的版本号
+     */
+    uint16_t getStaticLayerVersion() const;
+    
+    /**
+     * 将当前模式的静态背景层光栅化到缓存
+     */
+    void rasterizeStaticLayer();
+    
+    /**
+     * 当前帧是否有覆盖层或通知（有时不使用渲染器报告的变化tile）
+     */
+    bool hasOverlay() const;
+    
+    /**
+     * 将当前通知光栅化到通知栏缓存
+     */
+    void rasterizeToast(const ToastQueue::Toast& toast);
+    
+    /**
+     * 获取当前模式的渲染器在上一次render中变化的内容覆盖的tile
+     * @return false 当前模式不报告变化的tile
+     */
+    bool getChangedContentTiles(FrameBuffer::DirtyMask tiles) const;
+    
+    /**
+     * 检查当前模式的渲染器是否需要重绘
+     */
+    bool isCurrentModeDirty() const;
+    
+    /**
+     * 提交已渲染完成的帧（替代sendBuffer）
+     * 异步模式下交换前后缓冲并通知刷新任务，刷新任务忙时丢弃该帧
+     * @param waitForFlush true 等待上一帧发送完成（用于必须显示的一次性画面）
+     * @param hint 与上一次提交的帧相比可能变化的tile（DirtyMask），nullptr 表示逐tile比较整帧
+     * @return false 刷新任务忙，本帧被丢弃
+     */
+    bool presentFrame(bool waitForFlush = false, const uint16_t* hint = nullptr);
+    
+    /**
+     * 将帧中变化的tile发送到屏幕
+     * @param frame 要发送的帧缓冲
+     */
+    void flushFrame(uint8_t* frame);
+    
+    /**
+     * 设置屏幕对比度（与刷新任务互斥访问I2C总线）
+     */
+    void setContrastLocked(uint8_t level);
+    
+    /**
+     * 发送一组SSD1306命令（与刷新任务互斥访问I2C总线）
+     * @param commands 命令及参数字节
+     * @param length 字节数
+     */
+    void sendCommands(const uint8_t* commands, uint8_t length);
+    
+    /**
+     * 设置屏幕硬件渐暗/闪烁模式
+     * @param mode PanelEffects::FADE_OFF / FADE_OUT / FADE_BLINK
+     */
+    void setPanelFade(uint8_t mode);
+    
+    /**
+     * 生成并发送下一个灰度平面（在刷新任务中调用，调用者持有总线锁）
+     */
+    void flushGrayPlane();
+    
+    /**
+     * 打开或关闭屏幕（显示开关 + 电荷泵），显存内容保持不变
+     */
+    void setPanelPower(bool on);
+    
+    /**
+     * 处理睡眠阶段：呼吸对比度步进、超时后关闭屏幕
+     */
+    void updateSleep(unsigned long now);
+    
+    /**
+     * 获取睡眠阶段的下一个截止时间
+     */
+    unsigned long getSleepDeadline(unsigned long now) const;
+    
+    /**
+     * 显示刷新任务入口
+     */
+    static void flushTaskEntry(void* arg);
+    
+    /**
+     * 灰度平面定时器回调（通知刷新任务发送下一个平面）
+     */
+    static void grayTimerEntry(void* arg);
 };
 
 #endif // DISPLAY_MANAGER_H
@@ -0,0 +1,298 @@
+/**
+ * 智能桌面伴侣 - 事件总线
+ *
+ * 生产者（触摸、WiFi、时间同步等）投递带时间戳的事件，订阅者在自己的任务或循环节拍中取出处理，
+ * 生产者的调用只是把事件复制进环形缓冲，不会执行订阅者的代码，也不会被慢的订阅者阻塞。
+ *
+ * 每个（生产者，订阅者）组合有一个有界的单生产者/单消费者环形缓冲：
+ *   生产者只写 head，订阅者只写 tail，两边都只有一次32位原子读写（没有CAS和锁），
+ *   所以投递是无等待的；缓冲满时丢弃新事件并计数。
+ *   每个生产者同一时刻只能在一个上下文中投递（丢弃数和峰值深度由生产者读-改-写，不能交错）。
+ * 中断使用专门的生产者编号，只由这一个中断写入（publishFromISR），任务不使用这个编号，
+ *   所以中断打断任务中的投递也不会写同一个缓冲。
+ * 订阅者按事件类型掩码订阅；取出时在各生产者的缓冲之间按时间戳合并，同一生产者的事件保持投递顺序。
+ * 订阅者可以注册唤醒函数（如任务通知），投递在事件入队后调用它；中断中的投递调用单独的中断唤醒函数。
+ *
+ * 统计：每个缓冲的当前深度、峰值深度和丢弃数（生产者写、任意任务读），
+ * 每个订阅者的分发次数和投递到处理的延迟（只由该订阅者记录和读取）。
+ *
+ * 事件类型 Payload 需要有 uint8_t type（小于32）和 uint32_t timestamp（微秒）两个成员。
+ */
+
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <stdint.h>
+#include <atomic>
+#include "LatencyStats.h"
+
+/**
+ * 单生产者/单消费者环形缓冲
+ * @tparam Depth 容量（2的幂）
+ */
+template <typename Item, uint8_t Depth>
+class SpscRing {
+    static_assert(Depth >= 2 && (Depth & (Depth - 1)) == 0, "SpscRing depth must be a power of two");
+
+public:
+    SpscRing() : head(0), tail(0), dropped(0), highWater(0) {}
+
+    /**
+     * 放入一项（生产者，无等待）
+     * @return false 缓冲已满，丢弃
+     */
+    bool push(const Item& item) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        uint32_t t = tail.load(std::memory_order_acquire);
+        if (h - t >= Depth) {
+            dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        slots[h & (Depth - 1)] = item;
+        head.store(h + 1, std::memory_order_release);
+
+        uint32_t depth = h + 1 - t;
+        if (depth > highWater.load(std::memory_order_relaxed)) {
+            highWater.store(depth, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /**
+     * 查看最早的一项（消费者）
+     * @return nullptr 缓冲为空
+     */
+    const Item* peek() const {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (head.load(std::memory_order_acquire) == t) {
+            return nullptr;
+        }
+        return &slots[t & (Depth - 1)];
+    }
+
+    /**
+     * 移除 peek 返回的那一项（消费者）
+     */
+    void pop() {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    uint32_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+    uint32_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+    uint32_t getHighWater() const { return highWater.load(std::memory_order_relaxed); }
+
+private:
+    Item slots[Depth];
+    std::atomic<uint32_t> head;         // 下一个写入位置（只由生产者修改）
+    std::atomic<uint32_t> tail;         // 下一个读取位置（只由消费者修改）
+    std::atomic<uint32_t> dropped;      // 缓冲满时丢弃的数量（只由生产者修改，非原子的读-改-写）
+    std::atomic<uint32_t> highWater;    // 峰值深度（只由生产者修改，非原子的读-改-写）
+};
+
+/**
+ * 事件总线
+ * @tparam Producers 生产者数量（每个生产者同一时刻只能在一个任务或中断中投递）
+ * @tparam Subscribers 订阅者数量（不超过8）
+ * @tparam Depth 每个缓冲的容量（2的幂）
+ */
+template <typename Payload, uint8_t Producers, uint8_t Subscribers, uint8_t Depth>
+class EventBus {
+    static_assert(Subscribers <= 8, "EventBus supports at most 8 subscribers");
+
+public:
+    /**
+     * 唤醒函数：subscribers 为收到事件的订阅者位掩码
+     */
+    typedef void (*WakeFunc)(uint8_t subscribers, void* context);
+
+    /**
+     * 中断中的唤醒函数（如 vTaskNotifyGiveFromISR）
+     * @return true 唤醒了比被中断的任务优先级更高的任务，中断退出时需要切换
+     */
+    typedef bool (*WakeFromISRFunc)(uint8_t subscribers, void* context);
+
+    EventBus() : wake(nullptr), wakeContext(nullptr), wakeFromISR(nullptr), wakeFromISRContext(nullptr) {
+        for (uint8_t s = 0; s < Subscribers; s++) {
+            masks[s] = 0;
+            dispatched[s] = 0;
+        }
+    }
+
+    /**
+     * 订阅事件类型（在开始投递之前调用）
+     * @param typeMask 事件类型位掩码（1 << type）
+     */
+    void subscribe(uint8_t subscriber, uint32_t typeMask) {
+        masks[subscriber] |= typeMask;
+    }
+
+    /**
+     * 设置唤醒函数（在开始投递之前调用）
+     */
+    void setWake(WakeFunc func, void* context) {
+        wake = func;
+        wakeContext = context;
+    }
+
+    /**
+     * 设置中断中的唤醒函数（在开始投递之前调用）
+     */
+    void setWakeFromISR(WakeFromISRFunc func, void* context) {
+        wakeFromISR = func;
+        wakeFromISRContext = context;
+    }
+
+    /**
+     * 投递事件（生产者所在的任务），入队后唤醒收到事件的订阅者
+     * @return 收到事件的订阅者位掩码（缓冲已满的订阅者不计入）
+     */
+    uint8_t publish(uint8_t producer, const Payload& event) {
+        uint8_t delivered = enqueue(producer, event);
+        if (delivered != 0 && wake != nullptr) {
+            wake(delivered, wakeContext);
+        }
+        return delivered;
+    }
+
+    /**
+     * 投递事件（中断，producer 只能由这一个中断使用），入队后调用中断中的唤醒函数
+     * @param higherPriorityWoken 唤醒了更高优先级的任务时置为 true（调用者在中断退出前切换任务）
+     * @return 收到事件的订阅者位掩码
+     */
+    uint8_t publishFromISR(uint8_t producer, const Payload& event, bool* higherPriorityWoken) {
+        uint8_t delivered = enqueue(producer, event);
+        if (delivered != 0 && wakeFromISR != nullptr && wakeFromISR(delivered, wakeFromISRContext)) {
+            *higherPriorityWoken = true;
+        }
+        return delivered;
+    }
+
+    /**
+     * 取出并处理订阅者的全部待处理事件（订阅者自己的任务），按时间戳从早到晚
+     * 最多处理调用时已在队列中的事件数量，处理期间新到的事件留给下一次
+     * @param now 当前时间（微秒），用于统计分发延迟
+     * @param handler 对每个事件调用 handler(const Payload&)
+     * @return 处理的事件数
+     */
+    template <typename Handler>
+    uint16_t drain(uint8_t subscriber, uint32_t now, Handler handler) {
+        uint16_t budget = (uint16_t)getDepth(subscriber);
+        uint16_t handled = 0;
+        while (handled < budget) {
+            // 各生产者缓冲的队首中时间戳最早的一个（按与now的有符号差值比较，允许计时器回绕；
+            // 取得now之后才投递的事件差值为负）
+            int8_t oldest = -1;
+            int32_t oldestAge = 0;
+            for (uint8_t p = 0; p < Producers; p++) {
+                const Payload* head = rings[p][subscriber].peek();
+                if (head == nullptr) {
+                    continue;
+                }
+                int32_t age = (int32_t)(now - head->timestamp);
+                if (oldest < 0 || age > oldestAge) {
+                    oldest = (int8_t)p;
+                    oldestAge = age;
+                }
+            }
+            if (oldest < 0) {
+                break;
+            }
+
+            SpscRing<Payload, Depth>& ring = rings[oldest][subscriber];
+            Payload event = *ring.peek();
+            ring.pop();
+            latency[subscriber].record(oldestAge > 0 ? (uint32_t)oldestAge : 0);
+            dispatched[subscriber]++;
+            handled++;
+            handler(event);
+        }
+        return handled;
+    }
+
+    /**
+     * 订阅者是否有待处理事件
+     */
+    bool hasPending(uint8_t subscriber) const {
+        for (uint8_t p = 0; p < Producers; p++) {
+            if (rings[p][subscriber].peek() != nullptr) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * 订阅者当前排队的事件数（各生产者缓冲之和）
+     */
+    uint32_t getDepth(uint8_t subscriber) const {
+        uint32_t depth = 0;
+        for (uint8_t p = 0; p < Producers; p++) {
+            depth += rings[p][subscriber].size();
+        }
+        return depth;
+    }
+
+    /**
+     * 订阅者各缓冲中最大的峰值深度
+     */
+    uint32_t getHighWater(uint8_t subscriber) const {
+        uint32_t highWater = 0;
+        for (uint8_t p = 0; p < Producers; p++) {
+            uint32_t h = rings[p][subscriber].getHighWater();
+            if (h > highWater) {
+                highWater = h;
+            }
+        }
+        return highWater;
+    }
+
+    /**
+     * 因订阅者的缓冲已满而丢弃的事件数
+     */
+    uint32_t getDropped(uint8_t subscriber) const {
+        uint32_t total = 0;
+        for (uint8_t p = 0; p < Producers; p++) {
+            total += rings[p][subscriber].getDropped();
+        }
+        return total;
+    }
+
+    /**
+     * 订阅者已处理的事件总数（订阅者自己的任务）
+     */
+    uint32_t getDispatched(uint8_t subscriber) const { return dispatched[subscriber]; }
+
+    /**
+     * 订阅者的分发延迟统计（订阅者自己的任务，可以调用 reset 开始新的统计周期）
+     */
+    LatencyStats& getLatency(uint8_t subscriber) { return latency[subscriber]; }
+
+private:
+    SpscRing<Payload, Depth> rings[Producers][Subscribers];
+    uint32_t masks[Subscribers];
+    uint32_t dispatched[Subscribers];
+    LatencyStats latency[Subscribers];
+    WakeFunc wake;
+    void* wakeContext;
+    WakeFromISRFunc wakeFromISR;
+    void* wakeFromISRContext;
+
+    /**
+     * 复制进订阅了该类型的订阅者的缓冲
+     * @return 收到事件的订阅者位掩码
+     */
+    uint8_t enqueue(uint8_t producer, const Payload& event) {
+        uint32_t bit = 1UL << event.type;
+        uint8_t delivered = 0;
+        for (uint8_t s = 0; s < Subscribers; s++) {
+            if ((masks[s] & bit) != 0 && rings[producer][s].push(event)) {
+                delivered |= (uint8_t)(1 << s);
+            }
+        }
+        return delivered;
+    }
+};
+
+#endif // EVENT_BUS_H
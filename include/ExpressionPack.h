@@ -0,0 +1,485 @@
+/**
+ * 智能桌面伴侣 - 表情包
+ *
+ * 表情包是存放在独立flash分区中的二进制文件，新增表情无需重新编译固件：
+ * - 分区内容由 tools/make_expression_pack.py 生成
+ * - 通过内存映射直接访问，索引表不复制到RAM
+ * - 精灵（页格式）和动画轨道（关键帧）都经过RLE压缩
+ * - 只有当前表情被解压到固定大小的RAM缓存，表情数量增加不占用更多RAM
+ *
+ * 表情包格式（小端）：
+ *   [0]   Header（12字节）
+ *   [12]  expressionCount 个 ExpressionEntry（24字节）
+ *   [..]  spriteCount 个 SpriteEntry（12字节）
+ *   [..]  trackCount 个 TrackEntry（12字节）
+ *   [..]  压缩数据，由各表项的 offset 指向（相对表情包开头）
+ *
+ * RLE编码（PackBits）：控制字节 n < 128 时后跟 n+1 个原样字节；
+ * n >= 128 时后跟1个字节，重复 n-125 次（3-130次）
+ *
+ * 关键帧序列化为14字节：time、openness、pupilX、pupilY、squint、size（各2字节）、mouth、easing
+ */
+
+#ifndef EXPRESSION_PACK_H
+#define EXPRESSION_PACK_H
+
+#include <stdint.h>
+#include <string.h>
+#include "PageSprite.h"
+#include "Timeline.h"
+
+#define EXPRESSION_PACK_MAGIC       0x4B505845UL    // "EXPK"
+#define EXPRESSION_PACK_VERSION     1
+#define EXPRESSION_NAME_LENGTH      8               // 表情名最大长度（不含结尾0）
+#define EXPRESSION_MAX_SPRITES      4               // 单个表情最多精灵帧数
+#define EXPRESSION_MAX_KEYFRAMES    16              // 单个表情动画最多关键帧数
+#define EXPRESSION_CACHE_BYTES      512             // 当前表情精灵的解压缓存
+#define EXPRESSION_KEYFRAME_BYTES   14              // 序列化后的关键帧大小
+#define EXPRESSION_NO_TRACK         0xFF            // 表情没有动画轨道
+
+class ExpressionPack {
+public:
+    // 微秒时钟（用于统计加载耗时）
+    typedef uint32_t (*ClockFunc)();
+
+    /**
+     * 表情包文件头
+     */
+    struct Header {
+        uint32_t magic;             // EXPRESSION_PACK_MAGIC
+        uint16_t version;           // EXPRESSION_PACK_VERSION
+        uint16_t expressionCount;   // 表情数量
+        uint16_t spriteCount;       // 精灵数量
+        uint16_t trackCount;        // 动画轨道数量
+    };
+
+    /**
+     * 表情：眼睛参数 + 嘴巴精灵帧 + 可选的动画轨道
+     */
+    struct ExpressionEntry {
+        char name[EXPRESSION_NAME_LENGTH];  // 表情名（不足时补0）
+        int16_t eye[5];                     // 眼睛基础参数（EyeModel::Params 各字段）
+        uint8_t firstSprite;                // 第一帧在精灵表中的序号
+        uint8_t spriteCount;                // 帧数（0表示使用内置嘴巴）
+        uint16_t frameMs;                   // 帧间隔（毫秒）
+        uint8_t track;                      // 动画轨道序号，EXPRESSION_NO_TRACK 表示没有
+        uint8_t reserved;
+    };
+
+    /**
+     * 精灵：RLE压缩的页格式数据
+     */
+    struct SpriteEntry {
+        uint32_t offset;            // 压缩数据偏移
+        uint16_t packedSize;        // 压缩后字节数
+        uint8_t width;              // 宽度（列数）
+        uint8_t height;             // 高度（像素行数）
+        uint8_t shift;              // 预置的纵向偏移（0-7）
+        uint8_t pages;              // 页数
+        uint16_t reserved;
+    };
+
+    /**
+     * 动画轨道：RLE压缩的关键帧序列
+     */
+    struct TrackEntry {
+        uint32_t offset;            // 压缩数据偏移
+        uint16_t packedSize;        // 压缩后字节数
+        uint8_t keyframeCount;      // 关键帧数量
+        uint8_t channels;           // Timeline::Channel 组合
+        uint8_t blend;              // Timeline::Blend
+        uint8_t reserved[3];
+    };
+
+    /**
+     * RLE解码
+     * @return 解码的字节数，数据损坏或超出 dstLength 时返回0
+     */
+    static uint32_t rleDecode(const uint8_t* src, uint32_t srcLength, uint8_t* dst, uint32_t dstLength) {
+        uint32_t in = 0;
+        uint32_t out = 0;
+        while (in < srcLength) {
+            uint8_t control = src[in++];
+            if (control < 128) {
+                uint32_t count = control + 1u;
+                if (in + count > srcLength || out + count > dstLength) return 0;
+                memcpy(dst + out, src + in, count);
+                in += count;
+                out += count;
+            } else {
+                uint32_t count = control - 125u;
+                if (in >= srcLength || out + count > dstLength) return 0;
+                memset(dst + out, src[in++], count);
+                out += count;
+            }
+        }
+        return out;
+    }
+
+    /**
+     * RLE编码（与 tools/make_expression_pack.py 相同）
+     * @return 编码后的字节数，超出 dstLength 时返回0
+     */
+    static uint32_t rleEncode(const uint8_t* src, uint32_t length, uint8_t* dst, uint32_t dstLength) {
+        uint32_t in = 0;
+        uint32_t out = 0;
+        while (in < length) {
+            // 连续3个以上相同字节编码为重复
+            uint32_t run = 1;
+            while (in + run < length && run < 130 && src[in + run] == src[in]) {
+                run++;
+            }
+            if (run >= 3) {
+                if (out + 2 > dstLength) return 0;
+                dst[out++] = (uint8_t)(run + 125);
+                dst[out++] = src[in];
+                in += run;
+                continue;
+            }
+
+            // 原样字节直到下一段重复
+            uint32_t literal = 0;
+            while (in + literal < length && literal < 128) {
+                uint32_t next = in + literal;
+                if (next + 2 < length && src[next] == src[next + 1] && src[next] == src[next + 2]) {
+                    break;
+                }
+                literal++;
+            }
+            if (out + 1 + literal > dstLength) return 0;
+            dst[out++] = (uint8_t)(literal - 1);
+            memcpy(dst + out, src + in, literal);
+            in += literal;
+            out += literal;
+        }
+        return out;
+    }
+
+    ExpressionPack()
+        : base(nullptr)
+        , size(0)
+        , clock(nullptr)
+        , ready(false)
+        , active(-1)
+        , spriteCount(0)
+        , frameMs(0) {
+        memset(&header, 0, sizeof(header));
+        memset(&eyeParams, 0, sizeof(eyeParams));
+        memset(&animation, 0, sizeof(animation));
+        resetStats();
+    }
+
+    /**
+     * 打开表情包
+     * @param data 表情包数据（内存映射的flash分区）
+     * @param length 数据长度
+     * @param clockFunc 微秒时钟，nullptr表示不统计耗时
+     * @return true 表情包有效
+     */
+    bool begin(const uint8_t* data, uint32_t length, ClockFunc clockFunc = nullptr) {
+        base = data;
+        size = length;
+        clock = clockFunc;
+        ready = false;
+        active = -1;
+        spriteCount = 0;
+
+        if (base == nullptr || size < sizeof(Header)) {
+            return false;
+        }
+        memcpy(&header, base, sizeof(header));
+        if (header.magic != EXPRESSION_PACK_MAGIC || header.version != EXPRESSION_PACK_VERSION ||
+            header.expressionCount == 0 || tracksOffset() + header.trackCount * sizeof(TrackEntry) > size) {
+            return false;
+        }
+
+        ready = true;
+        return true;
+    }
+
+    /**
+     * 表情包是否可用
+     */
+    bool isReady() const {
+        return ready;
+    }
+
+    /**
+     * 获取表情数量
+     */
+    uint16_t getExpressionCount() const {
+        return ready ? header.expressionCount : 0;
+    }
+
+    /**
+     * 按名称查找表情
+     * @return 表情序号，没有时返回-1
+     */
+    int32_t find(const char* name) const {
+        for (uint16_t i = 0; i < getExpressionCount(); i++) {
+            ExpressionEntry entry = expressionAt(i);
+            if (strncmp(entry.name, name, EXPRESSION_NAME_LENGTH) == 0) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * 获取表情名
+     * @param dst 至少 EXPRESSION_NAME_LENGTH + 1 字节
+     */
+    void getName(uint16_t index, char* dst) const {
+        dst[0] = '\0';
+        if (index >= getExpressionCount()) return;
+        ExpressionEntry entry = expressionAt(index);
+        memcpy(dst, entry.name, EXPRESSION_NAME_LENGTH);
+        dst[EXPRESSION_NAME_LENGTH] = '\0';
+    }
+
+    /**
+     * 把表情解压到RAM缓存（替换之前的表情）
+     * @return true 加载成功，失败时没有当前表情
+     */
+    bool load(uint16_t index) {
+        if (!ready || index >= header.expressionCount) {
+            return false;
+        }
+        loads++;
+        if (active == (int32_t)index) {
+            hits++;
+            return true;
+        }
+
+        uint32_t start = clock != nullptr ? clock() : 0;
+        active = -1;
+        spriteCount = 0;
+        animation.count = 0;
+        ExpressionEntry entry = expressionAt(index);
+        if (!loadSprites(entry) || !loadTrack(entry)) {
+            spriteCount = 0;
+            animation.count = 0;
+            return false;
+        }
+        eyeParams.openness = entry.eye[0];
+        eyeParams.pupilX = entry.eye[1];
+        eyeParams.pupilY = entry.eye[2];
+        eyeParams.squint = entry.eye[3];
+        eyeParams.size = entry.eye[4];
+        frameMs = entry.frameMs;
+        active = index;
+
+        if (clock != nullptr) {
+            lastLoadMicros = clock() - start;
+            totalLoadMicros += lastLoadMicros;
+            if (lastLoadMicros > maxLoadMicros) {
+                maxLoadMicros = lastLoadMicros;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * 卸载当前表情
+     */
+    void unload() {
+        active = -1;
+        spriteCount = 0;
+        animation.count = 0;
+    }
+
+    /**
+     * 当前表情序号，-1表示没有
+     */
+    int32_t getActive() const {
+        return active;
+    }
+
+    /**
+     * 当前表情的眼睛基础参数
+     */
+    const EyeModel::Params& getEyeParams() const {
+        return eyeParams;
+    }
+
+    /**
+     * 当前表情的嘴巴帧数（0表示使用内置嘴巴）
+     */
+    uint8_t getSpriteCount() const {
+        return spriteCount;
+    }
+
+    /**
+     * 当前表情的帧间隔（毫秒）
+     */
+    uint16_t getFrameMs() const {
+        return frameMs;
+    }
+
+    /**
+     * 获取当前表情已解压的精灵帧
+     */
+    const PageSprite* getSprite(uint8_t frame) const {
+        return frame < spriteCount ? &sprites[frame] : nullptr;
+    }
+
+    /**
+     * 获取当前表情的动画（已解压到RAM），没有时返回nullptr
+     */
+    const Timeline::Animation* getAnimation() const {
+        return animation.count > 0 ? &animation : nullptr;
+    }
+
+    /**
+     * 清零统计
+     */
+    void resetStats() {
+        loads = 0;
+        hits = 0;
+        lastLoadMicros = 0;
+        maxLoadMicros = 0;
+        totalLoadMicros = 0;
+    }
+
+    uint32_t getLoadCount() const { return loads; }
+    uint32_t getHitCount() const { return hits; }
+    uint32_t getLastLoadMicros() const { return lastLoadMicros; }
+    uint32_t getMaxLoadMicros() const { return maxLoadMicros; }
+
+    /**
+     * 获取平均解压耗时（微秒，不含已缓存的加载）
+     */
+    uint32_t getAverageLoadMicros() const {
+        return loads == hits ? 0 : totalLoadMicros / (loads - hits);
+    }
+
+private:
+    // 数据访问
+    const uint8_t* base;
+    uint32_t size;
+    ClockFunc clock;
+    Header header;
+    bool ready;
+
+    // 当前表情的RAM缓存
+    int32_t active;
+    EyeModel::Params eyeParams;
+    uint8_t spriteCount;
+    uint16_t frameMs;
+    PageSprite sprites[EXPRESSION_MAX_SPRITES];
+    uint8_t spriteCache[EXPRESSION_CACHE_BYTES];
+    Timeline::Keyframe keyframes[EXPRESSION_MAX_KEYFRAMES];
+    Timeline::Animation animation;
+
+    // 统计
+    uint32_t loads;
+    uint32_t hits;
+    uint32_t lastLoadMicros;
+    uint32_t maxLoadMicros;
+    uint32_t totalLoadMicros;
+
+    uint32_t spritesOffset() const {
+        return sizeof(Header) + header.expressionCount * (uint32_t)sizeof(ExpressionEntry);
+    }
+
+    uint32_t tracksOffset() const {
+        return spritesOffset() + header.spriteCount * (uint32_t)sizeof(SpriteEntry);
+    }
+
+    // 表项可能不对齐，逐个复制出来读取
+    ExpressionEntry expressionAt(uint16_t index) const {
+        ExpressionEntry entry;
+        memcpy(&entry, base + sizeof(Header) + index * sizeof(ExpressionEntry), sizeof(entry));
+        return entry;
+    }
+
+    SpriteEntry spriteAt(uint16_t index) const {
+        SpriteEntry entry;
+        memcpy(&entry, base + spritesOffset() + index * sizeof(SpriteEntry), sizeof(entry));
+        return entry;
+    }
+
+    TrackEntry trackAt(uint16_t index) const {
+        TrackEntry entry;
+        memcpy(&entry, base + tracksOffset() + index * sizeof(TrackEntry), sizeof(entry));
+        return entry;
+    }
+
+    static int16_t readInt16(const uint8_t* p) {
+        return (int16_t)(p[0] | (p[1] << 8));
+    }
+
+    /**
+     * 解压表情的所有精灵帧到缓存
+     */
+    bool loadSprites(const ExpressionEntry& entry) {
+        if (entry.spriteCount > EXPRESSION_MAX_SPRITES ||
+            entry.firstSprite + entry.spriteCount > header.spriteCount ||
+            (entry.spriteCount > 1 && entry.frameMs == 0)) {
+            return false;
+        }
+        uint32_t used = 0;
+        for (uint8_t i = 0; i < entry.spriteCount; i++) {
+            SpriteEntry sprite = spriteAt((uint16_t)(entry.firstSprite + i));
+            uint32_t bytes = (uint32_t)sprite.width * sprite.pages;
+            if (sprite.offset + sprite.packedSize > size || bytes == 0 ||
+                rleDecode(base + sprite.offset, sprite.packedSize,
+                          spriteCache + used, EXPRESSION_CACHE_BYTES - used) != bytes) {
+                return false;
+            }
+            sprites[i].width = sprite.width;
+            sprites[i].height = sprite.height;
+            sprites[i].pages = sprite.pages;
+            sprites[i].shift = sprite.shift;
+            sprites[i].data = spriteCache + used;
+            used += bytes;
+        }
+        spriteCount = entry.spriteCount;
+        return true;
+    }
+
+    /**
+     * 解压表情的动画轨道并反序列化为关键帧
+     */
+    bool loadTrack(const ExpressionEntry& entry) {
+        if (entry.track == EXPRESSION_NO_TRACK) {
+            return true;
+        }
+        if (entry.track >= header.trackCount) {
+            return false;
+        }
+        TrackEntry track = trackAt(entry.track);
+        uint32_t bytes = (uint32_t)track.keyframeCount * EXPRESSION_KEYFRAME_BYTES;
+        if (track.keyframeCount < 2 || track.keyframeCount > EXPRESSION_MAX_KEYFRAMES ||
+            track.offset + track.packedSize > size) {
+            return false;
+        }
+
+        uint8_t raw[EXPRESSION_MAX_KEYFRAMES * EXPRESSION_KEYFRAME_BYTES];
+        if (rleDecode(base + track.offset, track.packedSize, raw, sizeof(raw)) != bytes) {
+            return false;
+        }
+        for (uint8_t i = 0; i < track.keyframeCount; i++) {
+            const uint8_t* p = raw + i * EXPRESSION_KEYFRAME_BYTES;
+            keyframes[i].time = (uint16_t)readInt16(p);
+            keyframes[i].eye.openness = readInt16(p + 2);
+            keyframes[i].eye.pupilX = readInt16(p + 4);
+            keyframes[i].eye.pupilY = readInt16(p + 6);
+            keyframes[i].eye.squint = readInt16(p + 8);
+            keyframes[i].eye.size = readInt16(p + 10);
+            keyframes[i].mouth = p[12];
+            keyframes[i].easing = p[13];
+            // 第一个关键帧必须从0开始，时间不能倒退
+            if (i == 0 ? keyframes[i].time != 0 : keyframes[i].time < keyframes[i - 1].time) {
+                return false;
+            }
+        }
+        animation.frames = keyframes;
+        animation.count = track.keyframeCount;
+        animation.channels = track.channels;
+        animation.blend = track.blend;
+        return true;
+    }
+};
+
+#endif // EXPRESSION_PACK_H
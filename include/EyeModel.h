@@ -0,0 +1,251 @@
+/**
+ * 智能桌面伴侣 - 参数化眼睛模型
+ *
+ * 眼睛由一组定点参数描述（睁开程度、瞳孔位置、眯眼程度、大小），
+ * 按列扫描直接填充到页格式帧缓冲：每列只计算眼眶和瞳孔的上下边界，
+ * 拼成一个32位列掩码后写入相邻的4页，不需要位图数据。
+ * 参数在帧间按时间平滑插值，眨眼、看左右都是连续变化。
+ *
+ * 坐标和半径使用Q4（1/16像素），参数使用Q8（256 = 1.0）
+ */
+
+#ifndef EYE_MODEL_H
+#define EYE_MODEL_H
+
+#include <stdint.h>
+#include "FrameBuffer.h"
+
+#define EYE_Q8_ONE              256     // Q8 定点数的 1.0
+#define EYE_RADIUS              8       // 眼眶基准半径（像素）
+#define EYE_PUPIL_RADIUS        4       // 瞳孔基准半径（像素）
+#define EYE_MAX_RADIUS          12      // 最大半径（列掩码为32位，需 2 x 12 + 7 < 32）
+#define EYE_CLOSED_OPENNESS     24      // 低于此睁开程度时绘制闭眼弧线
+#define EYE_EASE_MS             60      // 参数插值的时间常数（毫秒）
+
+namespace EyeModel {
+    /**
+     * 眼睛参数
+     */
+    struct Params {
+        int16_t openness;   // 睁开程度 Q8（0 闭眼，256 全睁）
+        int16_t pupilX;     // 瞳孔相对眼睛中心的水平偏移 Q8（像素）
+        int16_t pupilY;     // 瞳孔相对眼睛中心的垂直偏移 Q8（像素）
+        int16_t squint;     // 眯眼程度 Q8（下眼睑抬起的比例）
+        int16_t size;       // 大小 Q8（256 为基准半径）
+    };
+
+    // 单位圆 sqrt(1 - t^2) 的Q8查表，t = i / 32（上限255）
+    const uint8_t CIRCLE_Q8[33] = {
+        255, 255, 255, 255, 254, 253, 251, 250, 248, 246, 243, 240, 237, 234, 230, 226,
+        222, 217, 212, 206, 200, 193, 186, 178, 169, 160, 149, 137, 124, 108, 89, 63, 0
+    };
+
+    /**
+     * 两组参数是否相同
+     */
+    inline bool equals(const Params& a, const Params& b) {
+        return a.openness == b.openness && a.pupilX == b.pupilX && a.pupilY == b.pupilY &&
+               a.squint == b.squint && a.size == b.size;
+    }
+
+    /**
+     * 单个参数向目标靠近：按经过时间取比例，至少移动1个单位，保证有限步内到达
+     */
+    inline int16_t approachValue(int16_t current, int16_t target, uint32_t alpha) {
+        int32_t diff = (int32_t)target - current;
+        if (diff == 0) {
+            return current;
+        }
+        int32_t step = diff * (int32_t)alpha / EYE_Q8_ONE;
+        if (step == 0) {
+            step = diff > 0 ? 1 : -1;
+        }
+        return (int16_t)(current + step);
+    }
+
+    /**
+     * 参数向目标平滑插值（指数趋近）
+     * @param current 当前参数（原地更新）
+     * @param target 目标参数
+     * @param elapsedMs 距离上一次插值的时间
+     * @return true 参数有变化
+     */
+    inline bool approach(Params& current, const Params& target, uint32_t elapsedMs) {
+        if (equals(current, target)) {
+            return false;
+        }
+        uint32_t alpha = elapsedMs >= EYE_EASE_MS ? EYE_Q8_ONE : elapsedMs * EYE_Q8_ONE / EYE_EASE_MS;
+        current.openness = approachValue(current.openness, target.openness, alpha);
+        current.pupilX = approachValue(current.pupilX, target.pupilX, alpha);
+        current.pupilY = approachValue(current.pupilY, target.pupilY, alpha);
+        current.squint = approachValue(current.squint, target.squint, alpha);
+        current.size = approachValue(current.size, target.size, alpha);
+        return true;
+    }
+
+    /**
+     * 半径为 radius 的圆在水平距离 offset 处的半高（均为Q4）
+     * @param inverse (1 << 16) / radius，每只眼睛只算一次
+     */
+    inline int32_t circleHalfHeight(int32_t offset, int32_t radius, uint32_t inverse) {
+        uint32_t t = (uint32_t)(offset < 0 ? -offset : offset) * inverse >> 8;    // Q8
+        if (t >= EYE_Q8_ONE) {
+            return -1;
+        }
+        uint8_t i = (uint8_t)(t >> 3);
+        int32_t c = CIRCLE_Q8[i] + (((int32_t)CIRCLE_Q8[i + 1] - CIRCLE_Q8[i]) * (int32_t)(t & 7) >> 3);
+        return radius * c >> 8;
+    }
+
+    /**
+     * Q4 坐标向下/向上取整到像素（采样点在像素中心）
+     */
+    inline int16_t firstRow(int32_t q4) {
+        return (int16_t)(-((8 - q4) >> 4));
+    }
+
+    inline int16_t lastRow(int32_t q4) {
+        return (int16_t)((q4 - 8) >> 4);
+    }
+
+    /**
+     * 列掩码中 [from, to] 行的位（超出0-31的部分被截断）
+     */
+    inline uint32_t spanMask(int16_t from, int16_t to) {
+        if (from < 0) from = 0;
+        if (to > 31) to = 31;
+        if (from > to) return 0;
+        uint32_t high = to >= 31 ? 0xFFFFFFFFUL : ((2UL << to) - 1);
+        return high & ~((1UL << from) - 1);
+    }
+
+    /**
+     * 将眼睛绘制到帧缓冲（在眼睛所占的列内为不透明绘制）
+     * @param buf U8g2帧缓冲（128x64，页格式）
+     * @param cx 眼睛中心X（像素边界）
+     * @param cy 眼睛中心Y（像素边界）
+     * @param params 眼睛参数
+     * @return 写入帧缓冲的字节数
+     */
+    inline uint16_t render(uint8_t* buf, int16_t cx, int16_t cy, const Params& params) {
+        // 眼眶半径（Q4），限制在列掩码能容纳的范围内
+        int32_t radius = (int32_t)EYE_RADIUS * 16 * params.size / EYE_Q8_ONE;
+        if (radius > EYE_MAX_RADIUS * 16) radius = EYE_MAX_RADIUS * 16;
+        if (radius < 16) radius = 16;
+        int32_t openness = params.openness < 0 ? 0 : (params.openness > EYE_Q8_ONE ? EYE_Q8_ONE : params.openness);
+        int32_t squint = params.squint < 0 ? 0 : (params.squint > EYE_Q8_ONE ? EYE_Q8_ONE : params.squint);
+        int32_t halfHeight = radius * openness / EYE_Q8_ONE;
+        int32_t lowerLid = halfHeight - 2 * halfHeight * squint / EYE_Q8_ONE;
+        uint32_t inverse = (1UL << 16) / (uint32_t)radius;
+        bool closed = openness < EYE_CLOSED_OPENNESS;
+
+        // 瞳孔（Q4）
+        int32_t pupilRadius = (int32_t)EYE_PUPIL_RADIUS * 16 * params.size / EYE_Q8_ONE;
+        if (pupilRadius < 16) pupilRadius = 16;
+        uint32_t pupilInverse = (1UL << 16) / (uint32_t)pupilRadius;
+        int32_t pupilX = params.pupilX / 16;
+        int32_t pupilY = params.pupilY / 16;
+
+        // 列掩码的第0位对应的屏幕行（页对齐）
+        int16_t page0 = (int16_t)((cy - EYE_MAX_RADIUS) >> 3);
+        int16_t bit0 = (int16_t)(cy - page0 * 8);   // 眼睛中心行在列掩码中的位置
+        uint32_t box = spanMask(bit0 - EYE_MAX_RADIUS, bit0 + EYE_MAX_RADIUS - 1);
+        uint8_t firstPage = page0 < 0 ? (uint8_t)(-page0) : 0;
+        uint8_t lastPage = (uint8_t)((bit0 + EYE_MAX_RADIUS - 1) >> 3);
+        if (page0 + lastPage >= FrameBuffer::TILE_ROWS) {
+            lastPage = (uint8_t)(FrameBuffer::TILE_ROWS - 1 - page0);
+        }
+
+        // 第一遍：每列眼眶的上下边界（相对中心的行号），左右对称只算左半边
+        const uint8_t MAX_COLS = 2 * EYE_MAX_RADIUS;
+        int16_t tops[MAX_COLS];
+        int16_t bottoms[MAX_COLS];
+        bool inside[MAX_COLS];
+        int16_t half = (int16_t)((radius + 15) >> 4);
+        uint8_t cols = (uint8_t)(2 * half);
+        for (uint8_t i = 0; i < half; i++) {
+            int32_t offset = (int32_t)(i - half) * 16 + 8;
+            int32_t h = circleHalfHeight(offset, radius, inverse);
+            uint8_t mirror = (uint8_t)(cols - 1 - i);
+            inside[i] = h >= 0;
+            inside[mirror] = inside[i];
+            if (!inside[i]) {
+                tops[i] = tops[mirror] = 0;
+                bottoms[i] = bottoms[mirror] = 0;
+                continue;
+            }
+            if (closed) {
+                // 闭眼：中间低、两端翘起的抛物线弧（2像素粗）
+                int32_t t = (int32_t)((uint32_t)(offset < 0 ? -offset : offset) * inverse >> 8);
+                int32_t arc = 32 - (48 * t * t >> 16);
+                tops[i] = tops[mirror] = lastRow(arc + 8);
+                bottoms[i] = bottoms[mirror] = (int16_t)(tops[i] + 1);
+                continue;
+            }
+            int32_t v = h * openness / EYE_Q8_ONE;
+            int32_t bottom = v < lowerLid ? v : lowerLid;
+            tops[i] = firstRow(-v);
+            bottoms[i] = lastRow(bottom);
+            if (bottoms[i] < tops[i]) {
+                bottoms[i] = tops[i];
+            }
+            tops[mirror] = tops[i];
+            bottoms[mirror] = bottoms[i];
+        }
+
+        // 第二遍：拼出列掩码并写入帧缓冲
+        uint16_t written = 0;
+        for (uint8_t i = 0; i < cols; i++) {
+            int16_t x = (int16_t)(cx - half + i);
+            if (x < 0 || x >= (int16_t)FrameBuffer::ROW_BYTES) continue;
+
+            uint32_t column = 0;
+            if (inside[i]) {
+                int16_t top = tops[i];
+                int16_t bottom = bottoms[i];
+                bool hasLeft = i > 0 && inside[i - 1];
+                bool hasRight = i + 1 < cols && inside[i + 1];
+                if (closed) {
+                    // 弧线向上延伸到相邻列，保证线条连续
+                    int16_t neighbor = top;
+                    if (hasLeft && tops[i - 1] < neighbor) neighbor = tops[i - 1];
+                    if (hasRight && tops[i + 1] < neighbor) neighbor = tops[i + 1];
+                    if (neighbor + 1 < top) top = (int16_t)(neighbor + 1);
+                    column = spanMask(bit0 + top, bit0 + bottom);
+                } else {
+                    // 眼眶轮廓：上下描边延伸到相邻列的边界，保证边缘连续；最外侧的列连成竖线
+                    int16_t mid = (int16_t)((top + bottom) / 2);
+                    int16_t leftTop = hasLeft ? (int16_t)(tops[i - 1] - 1) : mid;
+                    int16_t rightTop = hasRight ? (int16_t)(tops[i + 1] - 1) : mid;
+                    int16_t leftBottom = hasLeft ? (int16_t)(bottoms[i - 1] + 1) : mid;
+                    int16_t rightBottom = hasRight ? (int16_t)(bottoms[i + 1] + 1) : mid;
+                    int16_t topEnd = leftTop > rightTop ? leftTop : rightTop;
+                    int16_t bottomStart = leftBottom < rightBottom ? leftBottom : rightBottom;
+                    if (topEnd < top) topEnd = top;
+                    if (topEnd > bottom) topEnd = bottom;
+                    if (bottomStart > bottom) bottomStart = bottom;
+                    if (bottomStart < top) bottomStart = top;
+                    column = spanMask(bit0 + top, bit0 + topEnd) | spanMask(bit0 + bottomStart, bit0 + bottom);
+
+                    // 瞳孔：被眼睑裁剪
+                    int32_t ph = circleHalfHeight((int32_t)(i - half) * 16 + 8 - pupilX, pupilRadius, pupilInverse);
+                    if (ph >= 0) {
+                        column |= spanMask(bit0 + firstRow(pupilY - ph), bit0 + lastRow(pupilY + ph))
+                                  & spanMask(bit0 + top, bit0 + bottom);
+                    }
+                }
+            }
+
+            // 写入4页（不透明：先清除眼睛范围内的旧像素）
+            uint8_t* dst = buf + (page0 + firstPage) * FrameBuffer::ROW_BYTES + x;
+            for (uint8_t p = firstPage; p <= lastPage; p++, dst += FrameBuffer::ROW_BYTES) {
+                uint8_t mask = (uint8_t)(box >> (p * 8));
+                *dst = (uint8_t)((*dst & ~mask) | ((column >> (p * 8)) & mask));
+                written++;
+            }
+        }
+        return written;
+    }
+}
+
+#endif // EYE_MODEL_H
@@ -0,0 +1,90 @@
+/**
+ * 智能桌面伴侣 - 表情动画数据
+ *
+ * 眨眼、触摸反应、说话、唤醒、看左右等动画的关键帧表（constexpr，存放在flash中）
+ * 新增表情动画只需在此定义关键帧表，再通过 FaceRenderer::playAnimation 播放
+ * 仅由 FaceRenderer.cpp 包含
+ */
+
+#ifndef FACE_ANIMATIONS_H
+#define FACE_ANIMATIONS_H
+
+#include "config.h"
+#include "Timeline.h"
+
+#define DEFINE_FACE_ANIMATION(name, frames, channels, blend) \
+    constexpr Timeline::Animation name = { frames, sizeof(frames) / sizeof(frames[0]), channels, blend }
+
+// 常用参数
+#define EYE_OPEN        EYE_Q8_ONE
+#define EYE_SHUT        0
+#define EYE_LOOK_OFFSET (3 * EYE_Q8_ONE)    // 看左右时瞳孔偏移（像素，Q8）
+
+// ============================================================================
+// 眨眼：睁开程度按比例缩放（可叠加在任何表情上）
+// ============================================================================
+constexpr Timeline::Keyframe BLINK_FRAMES[] = {
+    {0,                     {EYE_OPEN, 0, 0, 0, EYE_Q8_ONE}, Timeline::MOUTH_KEEP, Timeline::EASE_STEP},
+    {BLINK_DURATION_MS / 2, {EYE_SHUT, 0, 0, 0, EYE_Q8_ONE}, Timeline::MOUTH_KEEP, Timeline::EASE_IN_OUT},
+    {BLINK_DURATION_MS,     {EYE_OPEN, 0, 0, 0, EYE_Q8_ONE}, Timeline::MOUTH_KEEP, Timeline::EASE_IN_OUT}
+};
+DEFINE_FACE_ANIMATION(BLINK_ANIMATION, BLINK_FRAMES, Timeline::CHANNEL_OPENNESS, Timeline::BLEND_MULTIPLY);
+
+// ============================================================================
+// 触摸反应：眼睛睁大、惊讶的嘴巴，持续500ms
+// ============================================================================
+constexpr Timeline::Keyframe REACTION_FRAMES[] = {
+    {0,   {0, 0, 0, 0, EYE_Q8_ONE},          MOUTH_SURPRISED, Timeline::EASE_STEP},
+    {80,  {0, 0, 0, 0, EYE_Q8_ONE * 9 / 8},  MOUTH_SURPRISED, Timeline::EASE_IN_OUT},
+    {400, {0, 0, 0, 0, EYE_Q8_ONE * 9 / 8},  MOUTH_SURPRISED, Timeline::EASE_STEP},
+    {500, {0, 0, 0, 0, EYE_Q8_ONE},          MOUTH_SURPRISED, Timeline::EASE_LINEAR}
+};
+DEFINE_FACE_ANIMATION(REACTION_ANIMATION, REACTION_FRAMES,
+                      Timeline::CHANNEL_SIZE | Timeline::CHANNEL_MOUTH, Timeline::BLEND_OVERRIDE);
+
+// ============================================================================
+// 说话：问候语播放期间显示说话嘴型（张嘴程度由口型同步决定），长度与合成的音节相同
+// ============================================================================
+constexpr Timeline::Keyframe SPEAK_FRAMES[] = {
+    {0,                                     {0, 0, 0, 0, EYE_Q8_ONE}, MOUTH_TALKING, Timeline::EASE_STEP},
+    {SPEAK_SYLLABLES * SPEAK_SYLLABLE_MS,   {0, 0, 0, 0, EYE_Q8_ONE}, MOUTH_TALKING, Timeline::EASE_STEP}
+};
+DEFINE_FACE_ANIMATION(SPEAK_ANIMATION, SPEAK_FRAMES, Timeline::CHANNEL_MOUTH, Timeline::BLEND_OVERRIDE);
+
+// ============================================================================
+// 唤醒：半睁眼 -> 打哈欠 -> 伸懒腰（闭眼）-> 眯眼微笑，共1.5秒
+// ============================================================================
+constexpr Timeline::Keyframe WAKE_UP_FRAMES[] = {
+    {0,    {EYE_SHUT,           0, 0, 0,              EYE_Q8_ONE}, MOUTH_NEUTRAL,   Timeline::EASE_STEP},
+    {300,  {EYE_Q8_ONE * 3 / 8, 0, 0, 0,              EYE_Q8_ONE}, MOUTH_SURPRISED, Timeline::EASE_IN_OUT},
+    {400,  {EYE_OPEN,           0, 0, 0,              EYE_Q8_ONE}, MOUTH_SURPRISED, Timeline::EASE_IN_OUT},
+    {600,  {EYE_OPEN,           0, 0, 0,              EYE_Q8_ONE}, MOUTH_TALKING,   Timeline::EASE_STEP},
+    {700,  {EYE_SHUT,           0, 0, 0,              EYE_Q8_ONE}, MOUTH_TALKING,   Timeline::EASE_IN_OUT},
+    {1000, {EYE_SHUT,           0, 0, 0,              EYE_Q8_ONE}, MOUTH_SMILE,     Timeline::EASE_STEP},
+    {1150, {EYE_OPEN,           0, 0, EYE_Q8_ONE * 3 / 8, EYE_Q8_ONE}, MOUTH_SMILE, Timeline::EASE_IN_OUT},
+    {1500, {EYE_OPEN,           0, 0, 0,              EYE_Q8_ONE}, MOUTH_SMILE,     Timeline::EASE_IN_OUT}
+};
+DEFINE_FACE_ANIMATION(WAKE_UP_ANIMATION, WAKE_UP_FRAMES,
+                      Timeline::CHANNEL_OPENNESS | Timeline::CHANNEL_SQUINT | Timeline::CHANNEL_MOUTH,
+                      Timeline::BLEND_OVERRIDE);
+
+// ============================================================================
+// 看左 / 看右：瞳孔平滑移过去，停留1秒后回到中间
+// ============================================================================
+constexpr Timeline::Keyframe LOOK_LEFT_FRAMES[] = {
+    {0,    {0, 0,                0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_STEP},
+    {150,  {0, -EYE_LOOK_OFFSET, 0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_IN_OUT},
+    {1000, {0, -EYE_LOOK_OFFSET, 0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_STEP},
+    {1150, {0, 0,                0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_IN_OUT}
+};
+DEFINE_FACE_ANIMATION(LOOK_LEFT_ANIMATION, LOOK_LEFT_FRAMES, Timeline::CHANNEL_PUPIL, Timeline::BLEND_MULTIPLY);
+
+constexpr Timeline::Keyframe LOOK_RIGHT_FRAMES[] = {
+    {0,    {0, 0,               0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_STEP},
+    {150,  {0, EYE_LOOK_OFFSET, 0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_IN_OUT},
+    {1000, {0, EYE_LOOK_OFFSET, 0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_STEP},
+    {1150, {0, 0,               0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_IN_OUT}
+};
+DEFINE_FACE_ANIMATION(LOOK_RIGHT_ANIMATION, LOOK_RIGHT_FRAMES, Timeline::CHANNEL_PUPIL, Timeline::BLEND_MULTIPLY);
+
+#endif // FACE_ANIMATIONS_H
@@ -10,6 +10,11 @@
 #include <Arduino.h>
 #include <U8g2lib.h>
 #include "config.h"
+#include "EyeModel.h"
+#include "Timeline.h"
+#include "ExpressionPack.h"
+#include "LipSync.h"
+#include "Particles.h"
 
 // 表情结构体
 struct Expression {
@@ -17,6 +22,22 @@ struct Expression {
     MouthState mouth;
 };
 
+/**
+ * 表情动画层（按顺序叠加，后面的层覆盖前面的层）
+ */
+enum FaceAnimationLayer {
+    FACE_LAYER_ACTION = 0,      // 唤醒、看左右等动作
+    FACE_LAYER_REACTION,        // 触摸反应
+    FACE_LAYER_BLINK            // 眨眼
+};
+
+// 预计算为tile增量流的空闲动画数量（眨眼、看左、看右、触摸反应）
+#define FACE_IDLE_ANIMATIONS    4
+
+// FaceRenderer::getIdleFrame 的返回值（非负值为空闲动画序号）
+#define FACE_IDLE_BASE          -1      // 基础表情，没有动画
+#define FACE_IDLE_NONE          -2      // 不是基础表情上的单段空闲动画，需要完整绘制
+
 // 表情布局配置
 struct FaceLayout {
     int16_t leftEyeX, leftEyeY;    // 左眼位置
@@ -72,6 +93,44 @@ public:
      */
     MouthState getMouthState() const;
     
+    /**
+     * 播放关键帧动画（见 FaceAnimations.h）
+     * @param animation 动画
+     * @param layer 动画层（FaceAnimationLayer）
+     * @param queue true 排在该层当前动画之后播放，false 立即替换
+     * @return false 队列已满
+     */
+    bool playAnimation(const Timeline::Animation& animation, uint8_t layer, bool queue = false);
+    
+    /**
+     * 显示表情包中的表情（眼睛参数、嘴巴帧和动画），直到切换表情或进入睡眠
+     * @param index 表情序号
+     * @return false 没有表情包或表情数据无效
+     */
+    bool showPackExpression(uint16_t index);
+    
+    /**
+     * 切换到表情包中的下一个表情，最后一个之后回到内置表情
+     * @return true 正在显示表情包中的表情
+     */
+    bool nextPackExpression();
+    
+    /**
+     * 回到内置表情
+     */
+    void clearPackExpression();
+    
+    /**
+     * 获取表情包（用于查询表情列表和加载耗时）
+     */
+    const ExpressionPack& getExpressionPack() const;
+    
+    /**
+     * 设置口型同步的音量包络来源（如 AudioManager::getEnvelope()）
+     * 设置后说话嘴型在播放声音时按音量选择张嘴档位，没有声音时（如唤醒动画）和 nullptr 一样定时交替
+     */
+    void setLipSyncSource(const LipSync::Channel* channel);
+    
     /**
      * 触发眨眼动画
      */
@@ -82,6 +141,26 @@ public:
      */
     void triggerReaction();
     
+    /**
+     * 说话：问候语播放期间显示说话嘴型（声音由音频任务播放）
+     */
+    void speak();
+    
+    /**
+     * 播放庆祝效果（彩纸）
+     */
+    void celebrate();
+    
+    /**
+     * 是否有粒子效果在播放（播放期间按动画帧率出帧）
+     */
+    bool hasParticles() const;
+    
+    /**
+     * 获取粒子系统（粒子数、上限和每帧耗时）
+     */
+    const ParticleSystem& getParticles() const;
+    
     /**
      * 进入睡眠状态
      */
@@ -92,6 +171,50 @@ public:
      */
     void wakeUp();
     
+    /**
+     * 检查画面是否需要重绘（状态变化后置位，render后清除）
+     */
+    bool isDirty() const;
+    
+    /**
+     * 标记画面需要重绘
+     */
+    void markDirty();
+    
+    /**
+     * 增量流生成后的画面已由DisplayManager合成（清除重绘标记）
+     */
+    void markRendered();
+    
+    /**
+     * 当前画面能否直接由基础表情和预计算的增量流得到
+     * 条件：正常睁眼 + 微笑、没有表情包表情、眼睛参数已到位，且最多只有一段空闲动画在播放
+     * @param now 当前时间（millis）
+     * @param elapsed 输出空闲动画已播放的时间
+     * @return 空闲动画序号，FACE_IDLE_BASE 或 FACE_IDLE_NONE
+     */
+    int8_t getIdleFrame(unsigned long now, uint32_t& elapsed) const;
+    
+    /**
+     * 绘制空闲动画在指定时刻的画面（开机时生成增量流用）
+     * 会改变动画状态，只应在未初始化的单独实例上调用，此时基础表情为默认的正常睁眼 + 微笑
+     * @param index 空闲动画序号
+     * @param elapsed 动画时间（毫秒）
+     */
+    void renderIdleFrame(U8G2* display, uint8_t index, uint32_t elapsed);
+    
+    /**
+     * 获取空闲动画的关键帧表
+     */
+    static const Timeline::Animation& getIdleAnimation(uint8_t index);
+    
+    /**
+     * 获取距离下一个动画时刻的时间
+     * @param now 当前时间（millis）
+     * @return 剩余毫秒数，0表示已到期，DEADLINE_NONE表示没有待处理的动画
+     */
+    unsigned long getNextDeadline(unsigned long now) const;
+    
     /**
      * 生成随机眨眼间隔
      * @return 眨眼间隔（毫秒）
@@ -105,25 +228,43 @@ private:
     // 当前嘴巴状态
     MouthState mouthState;
     
-    // 眨眼动画相关
+    // 随机眨眼计时
     unsigned long lastBlinkTime;
     unsigned long nextBlinkInterval;
-    bool isBlinking;
-    uint8_t blinkFrame;
-    unsigned long blinkStartTime;
     
-    // 随机看左右相关
+    // 随机看左右计时
     unsigned long lastLookTime;
     unsigned long nextLookInterval;
     
-    // 触摸反应相关
-    bool isReacting;
-    unsigned long reactionStartTime;
+    // 眼睛基础参数：按帧向当前眼睛状态的目标插值
+    EyeModel::Params eyeParams;
+    unsigned long lastEyeUpdate;
+    
+    // 关键帧动画播放器（叠加在基础参数和嘴巴状态上）
+    Timeline::Player timeline;
+    
+    // 说话动画当前帧
+    uint8_t talkingFrame;
     
-    // 唤醒动画相关
-    bool isWakingUp;
-    unsigned long wakeUpStartTime;
-    uint8_t wakeUpFrame;
+    // 口型同步：包络来源、是否正在播放（有新包络）和当前张嘴档位
+    const LipSync::Channel* lipSync;
+    bool lipSyncLive;
+    LipSync::Follower lipSyncLevel;
+    
+    // 表情包（只有当前表情解压在RAM中）及其嘴巴动画当前帧
+    ExpressionPack expressionPack;
+    uint8_t packFrame;
+    
+    // 粒子效果（爱心、"z"、彩纸）及其上一次推进的时间
+    ParticleSystem particles;
+    unsigned long lastParticleUpdate;
+    
+    // 睡眠开始时间和上一次发射 "z" 的时间
+    unsigned long sleepStartTime;
+    unsigned long lastZTime;
+    
+    // 画面是否需要重绘
+    bool dirty;
     
     // 表情布局
     FaceLayout layout;
@@ -133,6 +274,27 @@ private:
      */
     void drawEyes(U8G2* display);
     
+    /**
+     * 读取最新的音频包络并更新张嘴档位
+     * @return true 档位或播放状态有变化
+     */
+    bool updateLipSync(unsigned long now);
+    
+    /**
+     * 获取眼睛基础参数的插值目标（表情包表情优先）
+     */
+    const EyeModel::Params& getEyeTarget() const;
+    
+    /**
+     * 是否使用表情包中的嘴巴帧（动画覆盖嘴巴时使用内置嘴巴）
+     */
+    bool usePackMouth() const;
+    
+    /**
+     * 获取叠加动画后实际显示的嘴巴状态
+     */
+    MouthState getDisplayedMouth() const;
+    
     /**
      * 绘制嘴巴
      */
@@ -144,24 +306,29 @@ private:
     void drawBlush(U8G2* display);
     
     /**
-     * 处理眨眼动画
+     * 绘制睡眠时的 "zZ" 标记
+     */
+    void drawSleepMark(U8G2* display);
+    
+    /**
+     * 按动画帧率推进粒子效果，睡眠开始后定时发射 "z"
      */
-    void handleBlinkAnimation();
+    void updateParticles(unsigned long now);
     
     /**
-     * 处理随机看左右
+     * 获取粒子效果的下一个时刻
      */
-    void handleRandomLook();
+    unsigned long getParticleDeadline(unsigned long now) const;
     
     /**
-     * 处理触摸反应动画
+     * 到达随机间隔时播放眨眼
      */
-    void handleReactionAnimation();
+    void scheduleBlink(unsigned long now);
     
     /**
-     * 处理唤醒动画
+     * 到达随机间隔时播放看左或看右
      */
-    void handleWakeUpAnimation();
+    void scheduleRandomLook(unsigned long now);
 };
 
 #endif // FACE_RENDERER_H
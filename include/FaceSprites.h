@@ -0,0 +1,211 @@
+/**
+ * 智能桌面伴侣 - 表情精灵数据
+ * 
+ * 眼睛和嘴巴的XBM原图，以及编译期转换出的页格式精灵
+ * 仅由 FaceRenderer.cpp（和native测试）包含
+ */
+
+#ifndef FACE_SPRITES_H
+#define FACE_SPRITES_H
+
+#include <stdint.h>
+#include "PageSprite.h"
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+
+// 眼睛和嘴巴在默认布局中的位置（精灵按Y坐标预先移位，绘制时页对齐）
+#define FACE_LEFT_EYE_X     20
+#define FACE_RIGHT_EYE_X    84
+#define FACE_EYE_Y          12
+#define FACE_MOUTH_X        44
+#define FACE_MOUTH_Y        42
+
+#define EYE_WIDTH           20
+#define EYE_HEIGHT          20
+#define MOUTH_WIDTH         40
+#define MOUTH_HEIGHT        16
+
+// ============================================================================
+// 眼睛位图数据 (20x20 像素，每只眼睛 - 更大更可爱)
+// 表情渲染已改用 EyeModel 参数化绘制，这些位图只作为native测试的对照基准
+// ============================================================================
+
+// 正常睁眼 - 大圆眼睛
+constexpr uint8_t EYE_NORMAL_BITMAP[] PROGMEM = {
+    0x00, 0x00, 0x00, 0xE0, 0x07, 0x00, 0x18, 0x18, 0x00, 0x04, 0x20, 0x00,
+    0x02, 0x40, 0x00, 0xE2, 0x47, 0x00, 0xF1, 0x8F, 0x00, 0xF1, 0x8F, 0x00,
+    0xF1, 0x8F, 0x00, 0xF1, 0x8F, 0x00, 0xF1, 0x8F, 0x00, 0xE2, 0x47, 0x00,
+    0x02, 0x40, 0x00, 0x04, 0x20, 0x00, 0x18, 0x18, 0x00, 0xE0, 0x07, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+// 眨眼帧1（半闭）
+constexpr uint8_t EYE_BLINK_1[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x07, 0x00,
+    0x18, 0x18, 0x00, 0x04, 0x20, 0x00, 0xE2, 0x47, 0x00, 0xF1, 0x8F, 0x00,
+    0xF1, 0x8F, 0x00, 0xF1, 0x8F, 0x00, 0xE2, 0x47, 0x00, 0x04, 0x20, 0x00,
+    0x18, 0x18, 0x00, 0xE0, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+// 眨眼帧2（更闭）
+constexpr uint8_t EYE_BLINK_2[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xE0, 0x07, 0x00, 0x18, 0x18, 0x00, 0xFC, 0x3F, 0x00,
+    0xFC, 0x3F, 0x00, 0xFC, 0x3F, 0x00, 0x18, 0x18, 0x00, 0xE0, 0x07, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+// 眨眼帧3（闭眼）/ 睡眠闭眼 - 弯弯的眼睛
+constexpr uint8_t EYE_CLOSED[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x06, 0x00, 0x00, 0x0E, 0x00, 0x00, 0xFC, 0x3F, 0x00, 0xF8, 0x1F, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+// 看左（瞳孔偏左）
+constexpr uint8_t EYE_LOOK_LEFT_BITMAP[] PROGMEM = {
+    0x00, 0x00, 0x00, 0xE0, 0x07, 0x00, 0x18, 0x18, 0x00, 0x04, 0x20, 0x00,
+    0x02, 0x40, 0x00, 0x72, 0x40, 0x00, 0x79, 0x80, 0x00, 0x79, 0x80, 0x00,
+    0x79, 0x80, 0x00, 0x79, 0x80, 0x00, 0x79, 0x80, 0x00, 0x72, 0x40, 0x00,
+    0x02, 0x40, 0x00, 0x04, 0x20, 0x00, 0x18, 0x18, 0x00, 0xE0, 0x07, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+// 看右（瞳孔偏右）
+constexpr uint8_t EYE_LOOK_RIGHT_BITMAP[] PROGMEM = {
+    0x00, 0x00, 0x00, 0xE0, 0x07, 0x00, 0x18, 0x18, 0x00, 0x04, 0x20, 0x00,
+    0x02, 0x40, 0x00, 0x02, 0x4E, 0x00, 0x01, 0x9E, 0x00, 0x01, 0x9E, 0x00,
+    0x01, 0x9E, 0x00, 0x01, 0x9E, 0x00, 0x01, 0x9E, 0x00, 0x02, 0x4E, 0x00,
+    0x02, 0x40, 0x00, 0x04, 0x20, 0x00, 0x18, 0x18, 0x00, 0xE0, 0x07, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+// 开心眼睛 - 弯弯的笑眼
+constexpr uint8_t EYE_HAPPY_BITMAP[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x06, 0x00, 0x00, 0x0E, 0x00, 0x00,
+    0x1C, 0x00, 0x00, 0xF8, 0x1F, 0x00, 0xF0, 0x0F, 0x00, 0xE0, 0x07, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+// ============================================================================
+// 嘴巴位图数据 (40x16 像素 - 更宽更可爱)
+// ============================================================================
+
+// 微笑 - 更圆润的弧线
+constexpr uint8_t MOUTH_SMILE_BITMAP[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0xC0, 0x00,
+    0x03, 0x00, 0x00, 0xC0, 0x00, 0x06, 0x00, 0x00, 0x60, 0x00,
+    0x0C, 0x00, 0x00, 0x30, 0x00, 0x18, 0x00, 0x00, 0x18, 0x00,
+    0x70, 0x00, 0x00, 0x0E, 0x00, 0xE0, 0x01, 0x80, 0x07, 0x00,
+    0x80, 0x0F, 0xF0, 0x01, 0x00, 0x00, 0xFE, 0x7F, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+// 大笑 - 张开的笑嘴
+constexpr uint8_t MOUTH_LAUGH_BITMAP[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0x3F, 0x00, 0x00,
+    0x00, 0x03, 0xC0, 0x00, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00,
+    0x40, 0x00, 0x00, 0x02, 0x00, 0x20, 0x00, 0x00, 0x04, 0x00,
+    0x10, 0x00, 0x00, 0x08, 0x00, 0x10, 0x00, 0x00, 0x08, 0x00,
+    0x10, 0x00, 0x00, 0x08, 0x00, 0x20, 0x00, 0x00, 0x04, 0x00,
+    0x40, 0x00, 0x00, 0x02, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00,
+    0x00, 0x03, 0xC0, 0x00, 0x00, 0x00, 0xFC, 0x3F, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+// 中性 - 小嘴
+constexpr uint8_t MOUTH_NEUTRAL_BITMAP[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x1F, 0x00, 0x00,
+    0x00, 0xF8, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+// 惊讶（O形嘴）
+constexpr uint8_t MOUTH_SURPRISED_BITMAP[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x0F, 0x00, 0x00,
+    0x00, 0x0C, 0x30, 0x00, 0x00, 0x00, 0x03, 0xC0, 0x00, 0x00,
+    0x80, 0x00, 0x00, 0x01, 0x00, 0x40, 0x00, 0x00, 0x02, 0x00,
+    0x40, 0x00, 0x00, 0x02, 0x00, 0x40, 0x00, 0x00, 0x02, 0x00,
+    0x40, 0x00, 0x00, 0x02, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00,
+    0x00, 0x03, 0xC0, 0x00, 0x00, 0x00, 0x0C, 0x30, 0x00, 0x00,
+    0x00, 0xF0, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+// 说话帧1
+constexpr uint8_t MOUTH_TALKING_1[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x07, 0x00, 0x00,
+    0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x06, 0x60, 0x00, 0x00,
+    0x00, 0x02, 0x40, 0x00, 0x00, 0x00, 0x02, 0x40, 0x00, 0x00,
+    0x00, 0x06, 0x60, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00,
+    0x00, 0xE0, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+// 说话帧2
+constexpr uint8_t MOUTH_TALKING_2[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xF8, 0x1F, 0x00, 0x00, 0x00, 0x06, 0x60, 0x00, 0x00,
+    0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00,
+    0x00, 0x06, 0x60, 0x00, 0x00, 0x00, 0xF8, 0x1F, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+// ============================================================================
+// 页格式精灵（编译期由上面的XBM转换）
+// ============================================================================
+
+#define EYE_SPRITE_SHIFT    (FACE_EYE_Y & 7)
+#define EYE_SPRITE_PAGES    ((EYE_HEIGHT + EYE_SPRITE_SHIFT + 7) / 8)
+#define EYE_SPRITE_BYTES    PAGE_SPRITE_BYTES(EYE_WIDTH, EYE_HEIGHT, EYE_SPRITE_SHIFT)
+
+#define MOUTH_SPRITE_SHIFT  (FACE_MOUTH_Y & 7)
+#define MOUTH_SPRITE_PAGES  ((MOUTH_HEIGHT + MOUTH_SPRITE_SHIFT + 7) / 8)
+#define MOUTH_SPRITE_BYTES  PAGE_SPRITE_BYTES(MOUTH_WIDTH, MOUTH_HEIGHT, MOUTH_SPRITE_SHIFT)
+
+#define DEFINE_EYE_SPRITE(name, xbm) \
+    constexpr PageSpriteBytes<EYE_SPRITE_BYTES> name##_PAGES PROGMEM = \
+        xbmToPageSprite<EYE_SPRITE_BYTES>(xbm, EYE_WIDTH, EYE_HEIGHT, EYE_SPRITE_SHIFT); \
+    constexpr PageSprite name = { EYE_WIDTH, EYE_HEIGHT, EYE_SPRITE_PAGES, EYE_SPRITE_SHIFT, name##_PAGES.bytes }
+
+#define DEFINE_MOUTH_SPRITE(name, xbm) \
+    constexpr PageSpriteBytes<MOUTH_SPRITE_BYTES> name##_PAGES PROGMEM = \
+        xbmToPageSprite<MOUTH_SPRITE_BYTES>(xbm, MOUTH_WIDTH, MOUTH_HEIGHT, MOUTH_SPRITE_SHIFT); \
+    constexpr PageSprite name = { MOUTH_WIDTH, MOUTH_HEIGHT, MOUTH_SPRITE_PAGES, MOUTH_SPRITE_SHIFT, name##_PAGES.bytes }
+
+DEFINE_EYE_SPRITE(EYE_NORMAL_SPRITE, EYE_NORMAL_BITMAP);
+DEFINE_EYE_SPRITE(EYE_BLINK_1_SPRITE, EYE_BLINK_1);
+DEFINE_EYE_SPRITE(EYE_BLINK_2_SPRITE, EYE_BLINK_2);
+DEFINE_EYE_SPRITE(EYE_CLOSED_SPRITE, EYE_CLOSED);
+DEFINE_EYE_SPRITE(EYE_LOOK_LEFT_SPRITE, EYE_LOOK_LEFT_BITMAP);
+DEFINE_EYE_SPRITE(EYE_LOOK_RIGHT_SPRITE, EYE_LOOK_RIGHT_BITMAP);
+DEFINE_EYE_SPRITE(EYE_HAPPY_SPRITE, EYE_HAPPY_BITMAP);
+
+DEFINE_MOUTH_SPRITE(MOUTH_SMILE_SPRITE, MOUTH_SMILE_BITMAP);
+DEFINE_MOUTH_SPRITE(MOUTH_LAUGH_SPRITE, MOUTH_LAUGH_BITMAP);
+DEFINE_MOUTH_SPRITE(MOUTH_NEUTRAL_SPRITE, MOUTH_NEUTRAL_BITMAP);
+DEFINE_MOUTH_SPRITE(MOUTH_SURPRISED_SPRITE, MOUTH_SURPRISED_BITMAP);
+DEFINE_MOUTH_SPRITE(MOUTH_TALKING_1_SPRITE, MOUTH_TALKING_1);
+DEFINE_MOUTH_SPRITE(MOUTH_TALKING_2_SPRITE, MOUTH_TALKING_2);
+
+#endif // FACE_SPRITES_H
@@ -0,0 +1,255 @@
+/**
+ * 智能桌面伴侣 - 帧缓冲工具
+ *
+ * SSD1306 帧缓冲（页模式）的比较与合成工具函数
+ * 缓冲区布局与U8g2全缓冲模式一致：8个页（tile行），每页128字节，
+ * 每字节表示一列中纵向的8个像素（bit0在最上方）
+ */
+
+#ifndef FRAME_BUFFER_H
+#define FRAME_BUFFER_H
+
+#include <stdint.h>
+#include <string.h>
+
+namespace FrameBuffer {
+    const uint8_t  TILE_COLS     = 16;      // 每行tile数 (128 / 8)
+    const uint8_t  TILE_ROWS     = 8;       // tile行数 (64 / 8)
+    const uint8_t  TILE_BYTES    = 8;       // 每个tile字节数
+    const uint16_t ROW_BYTES     = 128;     // 每页字节数
+    const uint16_t SIZE          = 1024;    // 整帧字节数
+
+    // 每个tile行的脏标记（bit n 表示第n列tile有变化）
+    typedef uint16_t DirtyMask[TILE_ROWS];
+
+    /**
+     * 比较两帧，逐tile生成脏标记
+     * @param current 当前帧
+     * @param previous 上一帧（屏幕上已显示的内容）
+     * @param dirty 输出脏标记
+     * @return 变化的tile数量
+     */
+    inline uint8_t diffTiles(const uint8_t* current, const uint8_t* previous, DirtyMask dirty) {
+        uint8_t count = 0;
+        for (uint8_t ty = 0; ty < TILE_ROWS; ty++) {
+            uint16_t mask = 0;
+            const uint8_t* cur = current + ty * ROW_BYTES;
+            const uint8_t* prev = previous + ty * ROW_BYTES;
+            for (uint8_t tx = 0; tx < TILE_COLS; tx++) {
+                // 每个tile 8字节，按两个32位字比较
+                uint32_t a[2], b[2];
+                memcpy(a, cur + tx * TILE_BYTES, TILE_BYTES);
+                memcpy(b, prev + tx * TILE_BYTES, TILE_BYTES);
+                if ((a[0] ^ b[0]) | (a[1] ^ b[1])) {
+                    mask |= (uint16_t)(1u << tx);
+                    count++;
+                }
+            }
+            dirty[ty] = mask;
+        }
+        return count;
+    }
+
+    /**
+     * 只比较已知可能变化的tile，去掉其中内容没有变化的（其余tile不比较）
+     * @param current 当前帧
+     * @param previous 上一帧（屏幕上已显示的内容）
+     * @param dirty 输入候选tile，输出实际变化的tile
+     * @return 变化的tile数量
+     */
+    inline uint8_t diffCandidateTiles(const uint8_t* current, const uint8_t* previous, DirtyMask dirty) {
+        uint8_t count = 0;
+        for (uint8_t ty = 0; ty < TILE_ROWS; ty++) {
+            uint16_t mask = dirty[ty];
+            for (uint8_t tx = 0; mask >> tx; tx++) {
+                if (!(mask & (1u << tx))) continue;
+                uint16_t offset = ty * ROW_BYTES + tx * TILE_BYTES;
+                if (memcmp(current + offset, previous + offset, TILE_BYTES) == 0) {
+                    mask &= (uint16_t)~(1u << tx);
+                } else {
+                    count++;
+                }
+            }
+            dirty[ty] = mask;
+        }
+        return count;
+    }
+
+    /**
+     * 整帧复制（按32位字），用于把缓存的背景层铺到帧缓冲
+     * 两个缓冲区都必须4字节对齐
+     */
+    inline void copyFrame(uint8_t* dst, const uint8_t* src) {
+        uint32_t* d = reinterpret_cast<uint32_t*>(dst);
+        const uint32_t* s = reinterpret_cast<const uint32_t*>(src);
+        for (uint16_t i = 0; i < SIZE / 4; i++) {
+            d[i] = s[i];
+        }
+    }
+
+    /**
+     * 整帧按位或合成（按32位字），用于叠加覆盖层
+     * 两个缓冲区都必须4字节对齐
+     */
+    inline void orFrame(uint8_t* dst, const uint8_t* src) {
+        uint32_t* d = reinterpret_cast<uint32_t*>(dst);
+        const uint32_t* s = reinterpret_cast<const uint32_t*>(src);
+        for (uint16_t i = 0; i < SIZE / 4; i++) {
+            d[i] |= s[i];
+        }
+    }
+
+    /**
+     * 水平滑动过渡：新画面从右侧推入，旧画面向左移出
+     * @param offset 已移动的列数 (0-128)
+     */
+    inline void slideHorizontal(uint8_t* dst, const uint8_t* from, const uint8_t* to, uint8_t offset) {
+        if (offset > ROW_BYTES) offset = ROW_BYTES;
+        for (uint8_t page = 0; page < TILE_ROWS; page++) {
+            uint16_t base = page * ROW_BYTES;
+            memcpy(dst + base, from + base + offset, ROW_BYTES - offset);
+            memcpy(dst + base + ROW_BYTES - offset, to + base, offset);
+        }
+    }
+
+    /**
+     * 垂直擦除过渡：新画面从顶部向下覆盖旧画面
+     * @param rows 已被新画面覆盖的行数 (0-64)
+     */
+    inline void wipeVertical(uint8_t* dst, const uint8_t* from, const uint8_t* to, uint8_t rows) {
+        uint32_t* d = reinterpret_cast<uint32_t*>(dst);
+        const uint32_t* f = reinterpret_cast<const uint32_t*>(from);
+        const uint32_t* t = reinterpret_cast<const uint32_t*>(to);
+        const uint16_t wordsPerPage = ROW_BYTES / 4;
+
+        for (uint8_t page = 0; page < TILE_ROWS; page++) {
+            // 本页中取新画面的行（bit0为页内最上一行）
+            int16_t covered = (int16_t)rows - page * 8;
+            uint8_t maskByte = covered <= 0 ? 0x00 : covered >= 8 ? 0xFF : (uint8_t)((1u << covered) - 1);
+            uint32_t mask = maskByte * 0x01010101u;
+            for (uint16_t i = page * wordsPerPage; i < (page + 1) * wordsPerPage; i++) {
+                d[i] = (t[i] & mask) | (f[i] & ~mask);
+            }
+        }
+    }
+
+    /**
+     * 有序抖动交叉淡入淡出：按4x4 Bayer矩阵逐步用新画面像素替换旧画面
+     * 页格式中每列的掩码只与 x%4 有关，4列合成一个32位字掩码
+     * @param level 抖动级别 (0-16)，0为全旧画面，16为全新画面
+     */
+    inline void ditherCrossfade(uint8_t* dst, const uint8_t* from, const uint8_t* to, uint8_t level) {
+        static const uint8_t BAYER[4][4] = {
+            { 0,  8,  2, 10},
+            {12,  4, 14,  6},
+            { 3, 11,  1,  9},
+            {15,  7, 13,  5}
+        };
+
+        // 计算 x%4 = 0..3 四列的页掩码，拼成32位字（小端：低字节为左列）
+        uint32_t mask = 0;
+        for (uint8_t col = 0; col < 4; col++) {
+            uint8_t maskByte = 0;
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                if (BAYER[bit & 3][col] < level) {
+                    maskByte |= (uint8_t)(1u << bit);
+                }
+            }
+            mask |= (uint32_t)maskByte << (col * 8);
+        }
+
+        uint32_t* d = reinterpret_cast<uint32_t*>(dst);
+        const uint32_t* f = reinterpret_cast<const uint32_t*>(from);
+        const uint32_t* t = reinterpret_cast<const uint32_t*>(to);
+        for (uint16_t i = 0; i < SIZE / 4; i++) {
+            d[i] = (t[i] & mask) | (f[i] & ~mask);
+        }
+    }
+
+    /**
+     * 从更高的页格式位图中取出一屏（用于像素级纵向滚动）
+     * 每个输出字节由源位图相邻两页的字节移位拼成，按32位字处理4列
+     * @param dst 输出帧（128x64）
+     * @param src 源位图（宽128，srcPages页），两个缓冲区都必须4字节对齐
+     * @param srcPages 源位图页数
+     * @param topRow 窗口顶端在源位图中的行号
+     */
+    inline void scrollWindow(uint8_t* dst, const uint8_t* src, uint8_t srcPages, uint16_t topRow) {
+        uint32_t* d = reinterpret_cast<uint32_t*>(dst);
+        const uint32_t* s = reinterpret_cast<const uint32_t*>(src);
+        const uint16_t wordsPerPage = ROW_BYTES / 4;
+        uint8_t firstPage = (uint8_t)(topRow >> 3);
+        uint8_t shift = topRow & 7;
+        // 每字节右移后保留的低位掩码
+        uint32_t lowMask = (uint32_t)(0xFF >> shift) * 0x01010101u;
+
+        for (uint8_t page = 0; page < TILE_ROWS; page++) {
+            uint8_t upper = firstPage + page;
+            uint8_t lower = upper + 1;
+            for (uint16_t i = 0; i < wordsPerPage; i++) {
+                uint32_t a = upper < srcPages ? s[upper * wordsPerPage + i] : 0;
+                uint32_t value = (a >> shift) & lowMask;
+                if (shift != 0 && lower < srcPages) {
+                    value |= (s[lower * wordsPerPage + i] << (8 - shift)) & ~lowMask;
+                }
+                d[page * wordsPerPage + i] = value;
+            }
+        }
+    }
+
+    /**
+     * 将所有tile标记为脏（用于强制全屏刷新）
+     */
+    inline void markAll(DirtyMask dirty) {
+        for (uint8_t ty = 0; ty < TILE_ROWS; ty++) {
+            dirty[ty] = 0xFFFF;
+        }
+    }
+
+    /**
+     * 把一个矩形区域覆盖的tile加入脏标记（超出屏幕的部分忽略）
+     * @param x 左边界（像素）
+     * @param width 宽度（像素）
+     * @param page 起始页
+     * @param pages 页数
+     */
+    inline void markColumns(DirtyMask dirty, uint8_t x, uint8_t width, uint8_t page, uint8_t pages) {
+        if (width == 0 || x >= ROW_BYTES) {
+            return;
+        }
+        uint16_t last = (uint16_t)(x + width - 1);
+        if (last >= ROW_BYTES) last = ROW_BYTES - 1;
+        uint8_t first = x >> 3;
+        uint8_t count = (uint8_t)((last >> 3) - first + 1);
+        uint16_t mask = (uint16_t)(((count >= TILE_COLS) ? 0xFFFFu : ((1u << count) - 1)) << first);
+        for (uint8_t ty = page; ty < TILE_ROWS && ty < page + pages; ty++) {
+            dirty[ty] |= mask;
+        }
+    }
+
+    /**
+     * 从tile行脏标记中取出下一段连续的脏tile
+     * @param mask 该行脏标记
+     * @param start 输入：开始搜索的列；输出：连续段起始列
+     * @param length 输出：连续段长度
+     * @return true 找到连续段，false 该行已无脏tile
+     */
+    inline bool nextRun(uint16_t mask, uint8_t& start, uint8_t& length) {
+        uint8_t tx = start;
+        while (tx < TILE_COLS && !(mask & (1u << tx))) {
+            tx++;
+        }
+        if (tx >= TILE_COLS) {
+            return false;
+        }
+        uint8_t end = tx;
+        while (end < TILE_COLS && (mask & (1u << end))) {
+            end++;
+        }
+        start = tx;
+        length = end - tx;
+        return true;
+    }
+}
+
+#endif // FRAME_BUFFER_H
@@ -0,0 +1,294 @@
+/**
+ * 智能桌面伴侣 - 中文字形库
+ *
+ * 中文点阵字库放在独立的flash分区中，按需读取到RAM中的LRU缓存：
+ * - 分区内容由 tools/make_glyph_font.py 从BDF字体生成
+ * - 码点索引按升序排列，查找时二分搜索，每次探测只读2字节
+ * - 字形为页格式（与U8g2帧缓冲一致），可直接用 blitPageSprite 绘制
+ *
+ * 字库文件格式（小端）：
+ *   [0]   Header（12字节）
+ *   [12]  glyphCount 个 uint16_t 码点（升序）
+ *   [..]  4字节对齐后，glyphCount 个字形，每个 bytesPerGlyph 字节
+ *
+ * 数据通过读取回调访问
+ */
+
+#ifndef GLYPH_STORE_H
+#define GLYPH_STORE_H
+
+#include <stdint.h>
+#include <string.h>
+#include "PageSprite.h"
+
+#define GLYPH_FONT_MAGIC    0x46594C47UL    // "GLYF"
+#define GLYPH_FONT_VERSION  1
+#define GLYPH_MAX_BYTES     32              // 单个字形最大字节数（16x16）
+#define GLYPH_CACHE_SIZE    48              // RAM中缓存的字形数
+
+class GlyphStore {
+public:
+    // 从字库分区读取数据的回调
+    typedef bool (*ReadFunc)(uint32_t offset, void* dst, uint32_t length, void* context);
+
+    // 微秒时钟（用于统计查找耗时）
+    typedef uint32_t (*ClockFunc)();
+
+    /**
+     * 字库文件头
+     */
+    struct Header {
+        uint32_t magic;             // GLYPH_FONT_MAGIC
+        uint16_t version;           // GLYPH_FONT_VERSION
+        uint16_t glyphCount;        // 字形数量
+        uint8_t width;              // 字形宽度（像素）
+        uint8_t height;             // 字形高度（像素）
+        uint8_t advance;            // 前进宽度（像素）
+        uint8_t bytesPerGlyph;      // 每个字形字节数 = width * 页数
+    };
+
+    /**
+     * 码点索引在字库中的偏移
+     */
+    static uint32_t indexOffset() {
+        return sizeof(Header);
+    }
+
+    /**
+     * 字形数据在字库中的偏移
+     */
+    static uint32_t bitmapOffset(uint16_t glyphCount) {
+        return (sizeof(Header) + glyphCount * 2u + 3u) & ~3u;
+    }
+
+    GlyphStore()
+        : read(nullptr)
+        , readContext(nullptr)
+        , clock(nullptr)
+        , ready(false)
+        , useTick(0) {
+        memset(&header, 0, sizeof(header));
+        memset(cacheCode, 0, sizeof(cacheCode));
+        memset(cacheTick, 0, sizeof(cacheTick));
+        resetStats();
+    }
+
+    /**
+     * 打开字库
+     * @param readFunc 读取回调
+     * @param context 传给读取回调的参数（如分区句柄）
+     * @param clockFunc 微秒时钟，nullptr表示不统计耗时
+     * @return true 字库有效
+     */
+    bool begin(ReadFunc readFunc, void* context, ClockFunc clockFunc = nullptr) {
+        read = readFunc;
+        readContext = context;
+        clock = clockFunc;
+        ready = false;
+
+        if (read == nullptr || !read(0, &header, sizeof(header), readContext)) {
+            return false;
+        }
+        if (header.magic != GLYPH_FONT_MAGIC || header.version != GLYPH_FONT_VERSION ||
+            header.glyphCount == 0 || header.bytesPerGlyph == 0 ||
+            header.bytesPerGlyph > GLYPH_MAX_BYTES ||
+            header.bytesPerGlyph != header.width * ((header.height + 7) / 8)) {
+            return false;
+        }
+
+        // 清空缓存
+        memset(cacheTick, 0, sizeof(cacheTick));
+        useTick = 0;
+        ready = true;
+        return true;
+    }
+
+    /**
+     * 字库是否可用
+     */
+    bool isReady() const {
+        return ready;
+    }
+
+    /**
+     * 查找字形
+     * @param codepoint Unicode码点
+     * @return 页格式字形数据（在下一次缓存未命中前有效），字库中没有时返回nullptr
+     */
+    const uint8_t* find(uint32_t codepoint) {
+        if (!ready || codepoint > 0xFFFF) {
+            return nullptr;
+        }
+
+        uint32_t start = clock != nullptr ? clock() : 0;
+        const uint8_t* result = nullptr;
+        lookups++;
+        useTick++;
+
+        // 先查RAM缓存
+        uint8_t slot = GLYPH_CACHE_SIZE;
+        for (uint8_t i = 0; i < GLYPH_CACHE_SIZE; i++) {
+            if (cacheTick[i] != 0 && cacheCode[i] == codepoint) {
+                slot = i;
+                break;
+            }
+        }
+
+        if (slot < GLYPH_CACHE_SIZE) {
+            hits++;
+            cacheTick[slot] = useTick;
+            result = cacheBitmap[slot];
+        } else {
+            int32_t index = search((uint16_t)codepoint);
+            if (index < 0) {
+                notFound++;
+            } else {
+                // 替换最久未使用的缓存项
+                slot = 0;
+                for (uint8_t i = 1; i < GLYPH_CACHE_SIZE; i++) {
+                    if (cacheTick[i] < cacheTick[slot]) {
+                        slot = i;
+                    }
+                }
+                uint32_t offset = bitmapOffset(header.glyphCount) + (uint32_t)index * header.bytesPerGlyph;
+                flashReads++;
+                if (read(offset, cacheBitmap[slot], header.bytesPerGlyph, readContext)) {
+                    misses++;
+                    cacheCode[slot] = (uint16_t)codepoint;
+                    cacheTick[slot] = useTick;
+                    result = cacheBitmap[slot];
+                } else {
+                    cacheTick[slot] = 0;
+                    notFound++;
+                }
+            }
+        }
+
+        if (clock != nullptr) {
+            lastLookupMicros = clock() - start;
+            totalLookupMicros += lastLookupMicros;
+            if (lastLookupMicros > maxLookupMicros) {
+                maxLookupMicros = lastLookupMicros;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * 查找字形并包装为页格式精灵
+     * @return true 找到字形
+     */
+    bool findSprite(uint32_t codepoint, PageSprite& sprite) {
+        const uint8_t* data = find(codepoint);
+        if (data == nullptr) {
+            return false;
+        }
+        sprite.width = header.width;
+        sprite.height = header.height;
+        sprite.pages = (uint8_t)((header.height + 7) / 8);
+        sprite.shift = 0;
+        sprite.data = data;
+        return true;
+    }
+
+    /**
+     * 获取字形前进宽度
+     */
+    uint8_t getAdvance() const {
+        return header.advance;
+    }
+
+    /**
+     * 获取字库中的字形数量
+     */
+    uint16_t getGlyphCount() const {
+        return header.glyphCount;
+    }
+
+    /**
+     * 清零统计
+     */
+    void resetStats() {
+        lookups = 0;
+        hits = 0;
+        misses = 0;
+        notFound = 0;
+        flashReads = 0;
+        lastLookupMicros = 0;
+        maxLookupMicros = 0;
+        totalLookupMicros = 0;
+    }
+
+    /**
+     * 获取缓存命中率（百分比）
+     */
+    uint8_t getHitRate() const {
+        return lookups == 0 ? 0 : (uint8_t)((uint64_t)hits * 100 / lookups);
+    }
+
+    uint32_t getLookupCount() const { return lookups; }
+    uint32_t getHitCount() const { return hits; }
+    uint32_t getMissCount() const { return misses; }
+    uint32_t getNotFoundCount() const { return notFound; }
+    uint32_t getFlashReadCount() const { return flashReads; }
+    uint32_t getLastLookupMicros() const { return lastLookupMicros; }
+    uint32_t getMaxLookupMicros() const { return maxLookupMicros; }
+
+    /**
+     * 获取平均查找耗时（微秒）
+     */
+    uint32_t getAverageLookupMicros() const {
+        return lookups == 0 ? 0 : totalLookupMicros / lookups;
+    }
+
+private:
+    // 数据访问
+    ReadFunc read;
+    void* readContext;
+    ClockFunc clock;
+    Header header;
+    bool ready;
+
+    // LRU缓存：码点、最近使用时刻（0表示空）、字形数据
+    uint32_t useTick;
+    uint16_t cacheCode[GLYPH_CACHE_SIZE];
+    uint32_t cacheTick[GLYPH_CACHE_SIZE];
+    uint8_t cacheBitmap[GLYPH_CACHE_SIZE][GLYPH_MAX_BYTES];
+
+    // 统计
+    uint32_t lookups;
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t notFound;
+    uint32_t flashReads;
+    uint32_t lastLookupMicros;
+    uint32_t maxLookupMicros;
+    uint32_t totalLookupMicros;
+
+    /**
+     * 在码点索引中二分查找
+     * @return 字形序号，没有时返回-1
+     */
+    int32_t search(uint16_t codepoint) {
+        int32_t lo = 0;
+        int32_t hi = (int32_t)header.glyphCount - 1;
+        while (lo <= hi) {
+            int32_t mid = (lo + hi) / 2;
+            uint16_t code = 0;
+            flashReads++;
+            if (!read(indexOffset() + (uint32_t)mid * 2, &code, sizeof(code), readContext)) {
+                return -1;
+            }
+            if (code == codepoint) {
+                return mid;
+            } else if (code < codepoint) {
+                lo = mid + 1;
+            } else {
+                hi = mid - 1;
+            }
+        }
+        return -1;
+    }
+};
+
+#endif // GLYPH_STORE_H
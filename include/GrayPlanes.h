@@ -0,0 +1,194 @@
+/**
+ * 智能桌面伴侣 - 时间抖动灰度
+ *
+ * SSD1306 每个像素只有亮/灭两种状态。灰度精灵每像素2位（4级灰度），
+ * 显示时拆成3个位平面按固定速率轮流发送：灰度为 L 的像素在每3个平面中点亮 L 个，
+ * 平面速率足够高时视觉暂留把它混合成灰色。
+ *
+ * 每个像素点亮的平面按 (x + y) % 3 错开，同一时刻每种灰度只有约1/3的像素变化，
+ * 避免整块区域同时闪烁；只有含中间灰度（1、2级）的tile在平面之间变化，
+ * 刷新时只需比较和发送这些tile。
+ */
+
+#ifndef GRAY_PLANES_H
+#define GRAY_PLANES_H
+
+#include <stdint.h>
+#include <string.h>
+#include "FrameBuffer.h"
+
+/**
+ * 灰度精灵（页格式，左上角与页对齐）
+ * 像素灰度 = hi位 x 2 + lo位，0为黑，3为全亮；hi、lo各 width x pages 字节，布局与 PageSprite 相同
+ */
+struct GraySprite {
+    uint8_t width;          // 宽度（列数）
+    uint8_t pages;          // 占用页数
+    const uint8_t* hi;      // 灰度高位平面
+    const uint8_t* lo;      // 灰度低位平面
+};
+
+namespace GrayPlanes {
+    const uint8_t LEVELS = 4;       // 灰度级数
+    const uint8_t PLANES = 3;       // 每个灰度周期的平面数
+
+    // 页字节中行号 % 3 == 0 / 1 / 2 的位
+    const uint8_t PHASE_BITS[3] = {0x49, 0x92, 0x24};
+
+    /**
+     * 计算一个页字节在指定平面中的点亮位
+     * @param hi 灰度高位平面字节
+     * @param lo 灰度低位平面字节
+     * @param x 屏幕列
+     * @param page 屏幕页
+     * @param plane 平面序号 (0-2)
+     */
+    inline uint8_t planeByte(uint8_t hi, uint8_t lo, uint8_t x, uint8_t page, uint8_t plane) {
+        // 像素在本平面的序号 t = (x + y + plane) % 3，灰度大于 t 时点亮
+        const uint8_t lit[3] = {(uint8_t)(hi | lo), hi, (uint8_t)(hi & lo)};
+        uint8_t base = (uint8_t)((x + page * 8) % 3);
+        uint8_t out = 0;
+        for (uint8_t k = 0; k < 3; k++) {
+            out |= (uint8_t)(PHASE_BITS[k] & lit[(base + k + plane) % 3]);
+        }
+        return out;
+    }
+
+    /**
+     * 把灰度精灵的一个平面写入帧缓冲（不透明，超出屏幕的部分裁剪）
+     * @param frame 页格式帧缓冲
+     * @param x 左上角X坐标
+     * @param page 左上角所在页
+     * @param plane 平面序号 (0-2)
+     */
+    inline void renderPlane(uint8_t* frame, const GraySprite& sprite, int16_t x, uint8_t page, uint8_t plane) {
+        for (uint8_t p = 0; p < sprite.pages && page + p < FrameBuffer::TILE_ROWS; p++) {
+            const uint8_t* hi = sprite.hi + p * sprite.width;
+            const uint8_t* lo = sprite.lo + p * sprite.width;
+            uint8_t* dst = frame + (page + p) * FrameBuffer::ROW_BYTES;
+            for (uint8_t c = 0; c < sprite.width; c++) {
+                int16_t sx = x + c;
+                if (sx < 0 || sx >= FrameBuffer::ROW_BYTES) continue;
+                dst[sx] = planeByte(hi[c], lo[c], (uint8_t)sx, (uint8_t)(page + p), plane);
+            }
+        }
+    }
+
+    /**
+     * 标记平面之间会变化的tile（含中间灰度像素的tile）
+     * @param dirty 输出tile集合
+     * @return tile数量
+     */
+    inline uint8_t changingTiles(const GraySprite& sprite, int16_t x, uint8_t page, FrameBuffer::DirtyMask dirty) {
+        memset(dirty, 0, sizeof(FrameBuffer::DirtyMask));
+        uint8_t count = 0;
+        for (uint8_t p = 0; p < sprite.pages && page + p < FrameBuffer::TILE_ROWS; p++) {
+            for (uint8_t c = 0; c < sprite.width; c++) {
+                int16_t sx = x + c;
+                if (sx < 0 || sx >= FrameBuffer::ROW_BYTES) continue;
+                if ((sprite.hi[p * sprite.width + c] ^ sprite.lo[p * sprite.width + c]) == 0) continue;
+                uint16_t bit = (uint16_t)(1u << (sx / FrameBuffer::TILE_BYTES));
+                if (!(dirty[page + p] & bit)) {
+                    dirty[page + p] |= bit;
+                    count++;
+                }
+            }
+        }
+        return count;
+    }
+
+    /**
+     * 平面节拍统计：每个平面开始发送时记录一次，
+     * 与定时器周期比较得到实际平面速率、抖动和丢失的平面数
+     */
+    class PlaneTiming {
+    public:
+        PlaneTiming() {
+            reset(0);
+        }
+
+        /**
+         * 清零统计
+         * @param period 定时器周期（微秒）
+         */
+        void reset(uint32_t period) {
+            periodMicros = period;
+            planes = 0;
+            missed = 0;
+            firstMicros = 0;
+            lastMicros = 0;
+            jitterSum = 0;
+            maxJitter = 0;
+        }
+
+        /**
+         * 记录一个平面的开始时刻
+         * @param now 当前时间（微秒）
+         */
+        void record(uint32_t now) {
+            if (planes == 0) {
+                firstMicros = now;
+            } else if (periodMicros > 0) {
+                // 间隔超过1.5个周期时，中间的定时器节拍被合并（平面丢失）
+                uint32_t interval = now - lastMicros;
+                uint32_t periods = (interval + periodMicros / 2) / periodMicros;
+                if (periods == 0) {
+                    periods = 1;
+                }
+                missed += periods - 1;
+                uint32_t target = periods * periodMicros;
+                uint32_t jitter = interval > target ? interval - target : target - interval;
+                jitterSum += jitter;
+                if (jitter > maxJitter) {
+                    maxJitter = jitter;
+                }
+            }
+            lastMicros = now;
+            planes++;
+        }
+
+        uint32_t getPlanes() const {
+            return planes;
+        }
+
+        uint32_t getMissed() const {
+            return missed;
+        }
+
+        /**
+         * 实际平面速率（毫赫兹）
+         */
+        uint32_t getRateMilliHz() const {
+            uint32_t span = lastMicros - firstMicros;
+            if (planes < 2 || span == 0) {
+                return 0;
+            }
+            return (uint32_t)((uint64_t)(planes - 1) * 1000000000ULL / span);
+        }
+
+        /**
+         * 平面间隔与定时器周期的平均偏差（微秒）
+         */
+        uint32_t getMeanJitterMicros() const {
+            return planes < 2 ? 0 : (uint32_t)(jitterSum / (planes - 1));
+        }
+
+        /**
+         * 平面间隔与定时器周期的最大偏差（微秒）
+         */
+        uint32_t getMaxJitterMicros() const {
+            return maxJitter;
+        }
+
+    private:
+        uint32_t periodMicros;
+        uint32_t planes;
+        uint32_t missed;
+        uint32_t firstMicros;
+        uint32_t lastMicros;
+        uint64_t jitterSum;
+        uint32_t maxJitter;
+    };
+}
+
+#endif // GRAY_PLANES_H
@@ -0,0 +1,121 @@
+/**
+ * 智能桌面伴侣 - 空闲管理器
+ *
+ * 主循环（或各任务）把各模块的截止时间汇总后，在这里睡到最早的一个：
+ * - 普通空闲：阻塞在任务通知上，触摸的边沿中断提前唤醒，CPU在空闲任务中等待中断
+ * - 睡眠模式关屏、WiFi关闭后：esp_light_sleep_start，由定时器或触摸引脚的高电平唤醒。
+ *   单循环在 idle() 中直接进入；多任务时各任务阻塞前登记醒来的时刻，
+ *   由最低优先级的睡眠任务在其他任务都阻塞时调用 sleepTasks() 睡到最早的一个
+ * - SDK开启了电源管理和tickless idle时：配置自动light sleep，所有任务都阻塞时由系统进入睡眠
+ *
+ * 同时统计空闲比例：系统节拍中断采样当前运行的是否是空闲任务，忙的节拍数与实际经过的时间相比
+ * （light sleep期间没有节拍，计为空闲）
+ */
+
+#ifndef IDLE_MANAGER_H
+#define IDLE_MANAGER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "DeadlineSet.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+/**
+ * 登记醒来时刻的任务（多任务）
+ */
+enum IdleTaskSlot : uint8_t {
+    IDLE_SLOT_INPUT = 0,
+    IDLE_SLOT_UI,
+    IDLE_SLOT_NETWORK,
+    IDLE_SLOT_HOUSEKEEPING,
+    IDLE_SLOT_COUNT
+};
+
+class IdleManager {
+public:
+    IdleManager();
+    
+    /**
+     * 初始化：开始空闲统计，SDK支持时配置自动light sleep
+     */
+    void init();
+    
+    /**
+     * 阻塞到最早的截止时间（不超过 IDLE_MAX_WAIT_MS），或被触摸的边沿中断提前唤醒
+     * 调用任务需要是事件总线中断唤醒函数的通知对象（单循环时为loop任务）
+     * @param deadlines 汇总好的截止时间
+     * @param allowLightSleep 可以进入light sleep（WiFi已关闭、没有灰度刷新等依赖时钟的外设在工作）
+     * @return true 从light sleep被触摸引脚唤醒（唤醒时刻见 getWakeMicros）
+     */
+    bool idle(const DeadlineSet& deadlines, bool allowLightSleep);
+    
+    /**
+     * 设置是否可以进入light sleep（WiFi关闭后为true，由持有WiFi管理器的任务设置）
+     */
+    void setLightSleepAllowed(bool allowed);
+    bool isLightSleepAllowed() const;
+    
+    /**
+     * 阻塞当前任务到 waitMs 后或被通知唤醒，阻塞前登记醒来的时刻（多任务）
+     * @param slot 任务的登记位置（IdleTaskSlot）
+     * @return ulTaskNotifyTake 的返回值
+     */
+    uint32_t waitTask(uint8_t slot, uint32_t waitMs);
+    
+    /**
+     * 多任务：在其他任务都阻塞时（最低优先级的任务中）调用，
+     * 各任务登记的醒来时刻都不早于 LIGHT_SLEEP_MIN_MS 时进入light sleep
+     * 醒来后需要调用 wakeTasks()：睡眠期间系统节拍停止，各任务按节拍计算的超时会推迟
+     * @return true 进入了light sleep（是否被触摸唤醒见 wasTouchWake）
+     */
+    bool sleepTasks();
+    
+    /**
+     * 通知登记过的任务重新计算截止时间（sleepTasks 醒来后调用）
+     */
+    void wakeTasks();
+    
+    /**
+     * 最近一次light sleep是否被触摸引脚唤醒
+     */
+    bool wasTouchWake() const;
+    
+    /**
+     * 最近一次被触摸引脚从light sleep唤醒的时刻（esp_timer微秒）
+     */
+    int64_t getWakeMicros() const;
+    
+    /**
+     * 是否使用系统的自动light sleep（电源管理 + tickless idle）
+     */
+    bool isAutoLightSleep() const;
+    
+    /**
+     * 输出本统计周期的空闲比例、light sleep次数和唤醒来源，然后开始新的周期
+     */
+    void report();
+    
+private:
+    bool _autoLightSleep;               // 是否已配置自动light sleep
+    volatile bool _lightSleepAllowed;   // 是否可以进入light sleep（WiFi已关闭）
+    int64_t _wakeMicros;                // 最近一次触摸唤醒的时刻
+    bool _touchWake;                    // 最近一次light sleep是否被触摸唤醒
+    
+    volatile unsigned long _taskWakeAt[IDLE_SLOT_COUNT];    // 各任务登记的醒来时刻（millis）
+    TaskHandle_t _tasks[IDLE_SLOT_COUNT];                   // 登记过的任务
+    
+    int64_t _periodStart;               // 统计周期开始时刻（esp_timer微秒）
+    uint32_t _periodBusyTicks;          // 统计周期开始时的忙节拍数
+    int64_t _lightSleepMicros;          // 本周期light sleep的总时长
+    uint32_t _lightSleeps;              // 本周期light sleep的次数
+    uint32_t _wakeups[DEADLINE_SOURCE_COUNT + 1];  // 本周期各来源结束空闲的次数（最后一项为没有截止时间）
+    
+    /**
+     * 进入light sleep，定时器或触摸引脚唤醒（调用前先发完串口缓冲）
+     * @return true 被触摸引脚唤醒
+     */
+    bool lightSleep(uint32_t waitMs);
+};
+
+#endif // IDLE_MANAGER_H
@@ -0,0 +1,97 @@
+/**
+ * 智能桌面伴侣 - 延迟统计
+ *
+ * 记录一组延迟样本（微秒）的次数、最小/平均/最大值，并按2的幂分桶估算百分位，
+ * 用于比较FreeRTOS多任务和单循环两种架构下的输入延迟、轮询间隔等。
+ * 记录只做几次整数运算，不分配内存；同一个统计只由一个任务记录和读取。
+ */
+
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+#include <stdint.h>
+
+#define LATENCY_BUCKETS     24      // 分桶数：第i桶为 [2^(i-1), 2^i) 微秒，最后一桶包含更大的值（约8.4秒以上）
+
+class LatencyStats {
+public:
+    LatencyStats() {
+        reset();
+    }
+
+    /**
+     * 清空统计（每个统计周期结束后调用）
+     */
+    void reset() {
+        count = 0;
+        total = 0;
+        minimum = 0xFFFFFFFFUL;
+        maximum = 0;
+        for (uint8_t i = 0; i < LATENCY_BUCKETS; i++) {
+            buckets[i] = 0;
+        }
+    }
+
+    /**
+     * 记录一个样本
+     * @param micros 延迟（微秒）
+     */
+    void record(uint32_t micros) {
+        count++;
+        total += micros;
+        if (micros < minimum) {
+            minimum = micros;
+        }
+        if (micros > maximum) {
+            maximum = micros;
+        }
+        buckets[bucketOf(micros)]++;
+    }
+
+    uint32_t getCount() const { return count; }
+    uint32_t getMin() const { return count == 0 ? 0 : minimum; }
+    uint32_t getMax() const { return maximum; }
+    uint32_t getMean() const { return count == 0 ? 0 : (uint32_t)(total / count); }
+
+    /**
+     * 估算百分位（返回所在分桶的上界，并且不超过实际最大值）
+     * @param percent 百分位（1-100）
+     */
+    uint32_t getPercentile(uint8_t percent) const {
+        if (count == 0) {
+            return 0;
+        }
+        // 第rank个样本（从1开始，向上取整）所在的分桶
+        uint32_t rank = (uint32_t)(((uint64_t)count * percent + 99) / 100);
+        uint32_t seen = 0;
+        for (uint8_t i = 0; i < LATENCY_BUCKETS; i++) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                uint32_t upper = (1UL << i) - 1;
+                return (i == LATENCY_BUCKETS - 1 || upper > maximum) ? maximum : upper;
+            }
+        }
+        return maximum;
+    }
+
+    /**
+     * 样本所在的分桶：0 -> 0，1 -> 1，2-3 -> 2，4-7 -> 3 ...
+     */
+    static uint8_t bucketOf(uint32_t micros) {
+        uint8_t bucket = 0;
+        while (micros != 0 && bucket < LATENCY_BUCKETS - 1) {
+            micros >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+private:
+    uint32_t count;
+    uint64_t total;
+    uint32_t minimum;
+    uint32_t maximum;
+    uint32_t buckets[LATENCY_BUCKETS];
+};
+
+#endif // LATENCY_STATS_H
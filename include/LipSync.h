@@ -0,0 +1,190 @@
+/**
+ * 智能桌面伴侣 - 口型同步
+ *
+ * 音频输出路径在每次写I2S时顺便计算这一块样本的RMS和峰值（全程定点），
+ * 打包成一个32位值写入无锁通道；表情渲染器按帧读取最新的包络，
+ * 映射为几档张嘴程度，说话时嘴巴跟随实际播放的声音开合。
+ *
+ * 通道只保存最新值（单写单读），写入和读取都是一次32位原子操作，
+ * 音频任务不会因显示而阻塞；包络带有时间戳，音频停止后自动失效。
+ */
+
+#ifndef LIP_SYNC_H
+#define LIP_SYNC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+#define LIPSYNC_LEVELS          4       // 张嘴档位数（0为闭嘴）
+#define LIPSYNC_HOLD_MS         100     // 超过此时间没有新包络视为音频已停止
+#define LIPSYNC_RELEASE_MS      60      // 声音变小时每档的保持时间（防止嘴巴抖动）
+
+namespace LipSync {
+    // 各档位的RMS下限（8位包络，RMS / 128），按档位升序
+    const uint8_t LEVEL_THRESHOLDS[LIPSYNC_LEVELS - 1] = {6, 20, 48};
+
+    /**
+     * 一块样本的包络
+     */
+    struct Envelope {
+        uint8_t rms;        // RMS / 128（0-255）
+        uint8_t peak;       // 峰值绝对值 / 128（0-255）
+        uint16_t time;      // 计算时刻（毫秒，低15位）
+    };
+
+    /**
+     * 32位整数平方根（逐位法，无除法）
+     */
+    inline uint16_t isqrt(uint32_t value) {
+        uint32_t result = 0;
+        uint32_t bit = 1UL << 30;
+        while (bit > value) {
+            bit >>= 2;
+        }
+        while (bit != 0) {
+            if (value >= result + bit) {
+                value -= result + bit;
+                result = (result >> 1) + bit;
+            } else {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+        return (uint16_t)result;
+    }
+
+    /**
+     * 计算一块PCM样本的包络
+     * @param samples 16位PCM
+     * @param count 参与计算的样本数
+     * @param stride 样本间隔（立体声交错数据传2，只取左声道）
+     */
+    inline Envelope measure(const int16_t* samples, size_t count, size_t stride, uint32_t now) {
+        Envelope envelope = {0, 0, (uint16_t)(now & 0x7FFF)};
+        if (count == 0) {
+            return envelope;
+        }
+        uint64_t sum = 0;
+        uint16_t peak = 0;
+        for (size_t i = 0; i < count; i++) {
+            int32_t s = samples[i * stride];
+            uint16_t magnitude = (uint16_t)(s < 0 ? -s : s);
+            if (magnitude > peak) {
+                peak = magnitude;
+            }
+            sum += (uint32_t)(s * s);
+        }
+        uint16_t rms = isqrt((uint32_t)(sum / count));
+        envelope.rms = (uint8_t)(rms >= 32768 ? 255 : rms >> 7);
+        envelope.peak = (uint8_t)(peak >= 32768 ? 255 : peak >> 7);
+        return envelope;
+    }
+
+    /**
+     * 包络对应的张嘴档位
+     */
+    inline uint8_t levelFor(const Envelope& envelope) {
+        uint8_t level = 0;
+        while (level < LIPSYNC_LEVELS - 1 && envelope.rms >= LEVEL_THRESHOLDS[level]) {
+            level++;
+        }
+        return level;
+    }
+
+    /**
+     * 单值无锁通道：音频任务写入最新包络，显示任务读取
+     */
+    class Channel {
+    public:
+        Channel() : word(0) {}
+
+        /**
+         * 发布包络（音频任务）
+         */
+        void publish(const Envelope& envelope) {
+            // 时间(15位) | 峰值(8位) | RMS(8位) | 1，最低位区分"从未写入"
+            uint32_t packed = ((uint32_t)(envelope.time & 0x7FFF) << 17) | ((uint32_t)envelope.peak << 9) |
+                              ((uint32_t)envelope.rms << 1) | 1u;
+            word.store(packed, std::memory_order_release);
+        }
+
+        /**
+         * 读取最新包络（显示任务）
+         * @return false 没有包络或已超过 LIPSYNC_HOLD_MS 没有更新
+         */
+        bool read(uint32_t now, Envelope& envelope) const {
+            uint32_t packed = word.load(std::memory_order_acquire);
+            if ((packed & 1u) == 0) {
+                return false;
+            }
+            envelope.rms = (uint8_t)(packed >> 1);
+            envelope.peak = (uint8_t)(packed >> 9);
+            envelope.time = (uint16_t)(packed >> 17);
+            // 时间只保留15位，按32秒回绕比较
+            return (uint16_t)((now - envelope.time) & 0x7FFF) < LIPSYNC_HOLD_MS;
+        }
+
+        /**
+         * 音频停止时清除，嘴巴立即闭合
+         */
+        void clear() {
+            word.store(0, std::memory_order_release);
+        }
+
+    private:
+        std::atomic<uint32_t> word;
+    };
+
+    /**
+     * 张嘴档位跟随：声音变大时立即张大，变小时每 LIPSYNC_RELEASE_MS 最多降一档
+     */
+    class Follower {
+    public:
+        Follower() : level(0), lastChange(0) {}
+
+        /**
+         * @return true 档位有变化
+         */
+        bool update(uint8_t target, uint32_t now) {
+            // 声音不小于当前档位时重新开始保持计时
+            if (target >= level) {
+                bool changed = target > level;
+                level = target;
+                lastChange = now;
+                return changed;
+            }
+            if (now - lastChange >= LIPSYNC_RELEASE_MS) {
+                level--;
+                lastChange = now;
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * 距离下一次可能降档的时间，0表示已到期，0xFFFFFFFF表示不会降档
+         */
+        uint32_t getNextDeadline(uint8_t target, uint32_t now) const {
+            if (target >= level) {
+                return 0xFFFFFFFFUL;
+            }
+            uint32_t elapsed = now - lastChange;
+            return elapsed >= LIPSYNC_RELEASE_MS ? 0 : LIPSYNC_RELEASE_MS - elapsed;
+        }
+
+        uint8_t getLevel() const {
+            return level;
+        }
+
+        void reset() {
+            level = 0;
+        }
+
+    private:
+        uint8_t level;
+        uint32_t lastChange;
+    };
+}
+
+#endif // LIP_SYNC_H
@@ -0,0 +1,156 @@
+/**
+ * 智能桌面伴侣 - 页格式精灵
+ *
+ * SSD1306 的显存按页组织（每字节为一列中纵向8个像素），
+ * 行优先的XBM位图每画一个像素都要换算一次地址。
+ * 页格式精灵在编译期（constexpr）由XBM转换而来，数据布局与U8g2帧缓冲一致，
+ * 绘制时按字节整块复制；Y坐标不对齐时退化为移位合并。
+ */
+
+#ifndef PAGE_SPRITE_H
+#define PAGE_SPRITE_H
+
+#include <stdint.h>
+#include <string.h>
+#include "FrameBuffer.h"
+
+// 页格式精灵占用的字节数（宽度 × 页数）
+#define PAGE_SPRITE_BYTES(w, h, shift)  ((w) * (((h) + (shift) + 7) / 8))
+
+/**
+ * 页格式精灵
+ * data 按页存放，每页 width 字节；精灵第0行位于第0页的第 shift 位
+ */
+struct PageSprite {
+    uint8_t width;          // 宽度（列数）
+    uint8_t height;         // 高度（像素行数）
+    uint8_t pages;          // 占用页数
+    uint8_t shift;          // 预置的纵向偏移（0-7）
+    const uint8_t* data;    // 页格式数据
+};
+
+// 编译期转换结果的存储类型
+template <unsigned N>
+struct PageSpriteBytes {
+    uint8_t bytes[N];
+};
+
+namespace PageSpriteDetail {
+    // 编译期整数序列（C++11 没有 std::index_sequence）
+    template <unsigned... I> struct IndexList {};
+    template <unsigned N, unsigned... I> struct MakeIndexList : MakeIndexList<N - 1, N - 1, I...> {};
+    template <unsigned... I> struct MakeIndexList<0, I...> { typedef IndexList<I...> type; };
+
+    // 读取XBM中的一个像素（越界返回0）
+    constexpr uint8_t xbmPixel(const uint8_t* xbm, unsigned w, unsigned h, int x, int y) {
+        return (y < 0 || y >= (int)h) ? 0
+             : (uint8_t)((xbm[y * ((w + 7) / 8) + x / 8] >> (x & 7)) & 1);
+    }
+
+    // 组合页字节中第 bit 位及之后的各位
+    constexpr uint8_t pageByte(const uint8_t* xbm, unsigned w, unsigned h, unsigned shift,
+                               int x, int page, int bit) {
+        return bit >= 8 ? 0
+             : (uint8_t)((xbmPixel(xbm, w, h, x, page * 8 + bit - (int)shift) << bit)
+                         | pageByte(xbm, w, h, shift, x, page, bit + 1));
+    }
+
+    template <unsigned N, unsigned... I>
+    constexpr PageSpriteBytes<N> convert(const uint8_t* xbm, unsigned w, unsigned h, unsigned shift,
+                                         IndexList<I...>) {
+        return PageSpriteBytes<N>{{ pageByte(xbm, w, h, shift, (int)(I % w), (int)(I / w), 0)... }};
+    }
+
+    // 页字节中 [lo, hi) 行对应的位掩码
+    inline uint8_t rowMask(int lo, int hi) {
+        if (lo < 0) lo = 0;
+        if (hi > 8) hi = 8;
+        if (lo >= hi) return 0;
+        return (uint8_t)((0xFF << lo) & (0xFF >> (8 - hi)));
+    }
+}
+
+/**
+ * 编译期将XBM位图转换为页格式
+ * @tparam N 输出字节数，使用 PAGE_SPRITE_BYTES(w, h, shift)
+ * @param xbm XBM位图（必须是constexpr数组）
+ * @param shift 纵向预置偏移，取绘制位置 y 的低3位可使绘制时页对齐
+ */
+template <unsigned N>
+constexpr PageSpriteBytes<N> xbmToPageSprite(const uint8_t* xbm, unsigned w, unsigned h, unsigned shift) {
+    return PageSpriteDetail::convert<N>(xbm, w, h, shift,
+                                        typename PageSpriteDetail::MakeIndexList<N>::type());
+}
+
+/**
+ * 将页格式精灵绘制到帧缓冲（不透明模式，与drawXBMP默认行为一致）
+ *
+ * (y - shift) 为8的倍数时，整页直接复制，首尾不完整的页按掩码合并；
+ * 否则每个字节移位后拆分到相邻两页合并
+ *
+ * @param buf U8g2帧缓冲（128x64，页格式）
+ * @param x 左上角X坐标
+ * @param y 左上角Y坐标
+ * @param sprite 精灵
+ * @return 写入帧缓冲的字节数
+ */
+inline uint16_t blitPageSprite(uint8_t* buf, int16_t x, int16_t y, const PageSprite& sprite) {
+    // 水平裁剪
+    int16_t x0 = x < 0 ? 0 : x;
+    int16_t x1 = x + sprite.width;
+    if (x1 > FrameBuffer::ROW_BYTES) x1 = FrameBuffer::ROW_BYTES;
+    if (x0 >= x1) return 0;
+    uint8_t col0 = (uint8_t)(x0 - x);
+    uint8_t cols = (uint8_t)(x1 - x0);
+
+    // 精灵数据第0页顶端对应的屏幕行
+    int16_t top = y - sprite.shift;
+    int16_t page0 = top >> 3;
+    uint8_t delta = top & 7;
+    uint16_t written = 0;
+
+    for (uint8_t p = 0; p < sprite.pages; p++) {
+        // 本页中属于精灵的行
+        uint8_t mask = PageSpriteDetail::rowMask(sprite.shift - p * 8,
+                                                 sprite.shift + sprite.height - p * 8);
+        const uint8_t* src = sprite.data + p * sprite.width + col0;
+        int16_t page = page0 + p;
+
+        if (delta == 0) {
+            // 页对齐：整页复制或按掩码合并
+            if (page < 0 || page >= FrameBuffer::TILE_ROWS) continue;
+            uint8_t* dst = buf + page * FrameBuffer::ROW_BYTES + x0;
+            if (mask == 0xFF) {
+                memcpy(dst, src, cols);
+            } else {
+                for (uint8_t i = 0; i < cols; i++) {
+                    dst[i] = (uint8_t)((dst[i] & ~mask) | (src[i] & mask));
+                }
+            }
+            written += cols;
+            continue;
+        }
+
+        // 不对齐：移位后拆分到上下两页
+        uint8_t maskLo = (uint8_t)(mask << delta);
+        uint8_t maskHi = (uint8_t)(mask >> (8 - delta));
+        if (page >= 0 && page < FrameBuffer::TILE_ROWS && maskLo) {
+            uint8_t* dst = buf + page * FrameBuffer::ROW_BYTES + x0;
+            for (uint8_t i = 0; i < cols; i++) {
+                dst[i] = (uint8_t)((dst[i] & ~maskLo) | ((src[i] << delta) & maskLo));
+            }
+            written += cols;
+        }
+        if (page + 1 >= 0 && page + 1 < FrameBuffer::TILE_ROWS && maskHi) {
+            uint8_t* dst = buf + (page + 1) * FrameBuffer::ROW_BYTES + x0;
+            for (uint8_t i = 0; i < cols; i++) {
+                dst[i] = (uint8_t)((dst[i] & ~maskHi) | ((src[i] >> (8 - delta)) & maskHi));
+            }
+            written += cols;
+        }
+    }
+
+    return written;
+}
+
+#endif // PAGE_SPRITE_H
@@ -0,0 +1,163 @@
+/**
+ * 智能桌面伴侣 - SSD1306硬件效果命令
+ *
+ * SSD1306 自带渐暗/闪烁（0x23）和连续水平/斜向滚动（0x26/0x27/0x29/0x2A）功能，
+ * 启动后由屏幕按自身刷新率完成动画，期间不需要CPU和I2C参与。
+ * 这里只负责按数据手册生成命令序列，由 DisplayManager 通过总线互斥发送。
+ * DisplayManager 目前只使用渐暗/闪烁（睡眠呼吸和关屏渐暗）；滚动只能循环移动显存中的128列，
+ * 超过屏幕宽度的跑马灯仍由软件逐帧移位，滚动命令保留备用。
+ *
+ * 注意：
+ * - 修改滚动参数前必须先停止滚动（0x2E），生成的启动序列已包含
+ * - 滚动期间不能写显存；停止滚动后显存内容需要整屏重写
+ */
+
+#ifndef PANEL_EFFECTS_H
+#define PANEL_EFFECTS_H
+
+#include <stdint.h>
+
+namespace PanelEffects {
+    // 命令
+    const uint8_t CMD_FADE              = 0x23;     // 渐暗/闪烁，参数：模式 | 间隔
+    const uint8_t CMD_SCROLL_RIGHT      = 0x26;     // 水平向右滚动
+    const uint8_t CMD_SCROLL_LEFT       = 0x27;     // 水平向左滚动
+    const uint8_t CMD_SCROLL_DIAG_RIGHT = 0x29;     // 垂直 + 水平向右滚动
+    const uint8_t CMD_SCROLL_DIAG_LEFT  = 0x2A;     // 垂直 + 水平向左滚动
+    const uint8_t CMD_SCROLL_STOP       = 0x2E;     // 停止滚动
+    const uint8_t CMD_SCROLL_START      = 0x2F;     // 开始滚动
+    const uint8_t CMD_SCROLL_AREA       = 0xA3;     // 垂直滚动区域
+
+    // 渐暗模式（0x23 参数的 A[5:4]）
+    const uint8_t FADE_OFF              = 0x00;     // 关闭
+    const uint8_t FADE_OUT              = 0x20;     // 渐暗到熄灭后保持
+    const uint8_t FADE_BLINK            = 0x30;     // 渐暗、渐亮循环（呼吸）
+
+    // 单个命令序列的最大字节数
+    const uint8_t MAX_SEQUENCE_BYTES    = 12;
+
+    // 滚动步进间隔编码（0x26等命令的间隔参数）对应的帧数，按编码顺序
+    const uint16_t SCROLL_INTERVAL_FRAMES[8] = {5, 64, 128, 256, 3, 4, 25, 2};
+
+    /**
+     * 选择最接近指定帧数的滚动间隔编码
+     * @param frames 每滚动一列的帧数
+     */
+    inline uint8_t scrollIntervalCode(uint16_t frames) {
+        uint8_t best = 0;
+        uint16_t bestError = 0xFFFF;
+        for (uint8_t code = 0; code < 8; code++) {
+            uint16_t interval = SCROLL_INTERVAL_FRAMES[code];
+            uint16_t error = interval > frames ? interval - frames : frames - interval;
+            if (error < bestError) {
+                best = code;
+                bestError = error;
+            }
+        }
+        return best;
+    }
+
+    /**
+     * 毫秒换算为屏幕帧数（至少1帧）
+     * @param frameHz 屏幕刷新率
+     */
+    inline uint16_t msToFrames(uint32_t ms, uint16_t frameHz) {
+        uint32_t frames = (ms * frameHz + 500) / 1000;
+        return (uint16_t)(frames == 0 ? 1 : frames > 0xFFFF ? 0xFFFF : frames);
+    }
+
+    /**
+     * 渐暗/闪烁命令
+     * @param out 输出缓冲（至少 MAX_SEQUENCE_BYTES 字节）
+     * @param mode FADE_OFF / FADE_OUT / FADE_BLINK
+     * @param frames 每级亮度的帧数（按8帧取整，8-128）
+     * @return 命令字节数
+     */
+    inline uint8_t fade(uint8_t* out, uint8_t mode, uint16_t frames) {
+        uint16_t steps = (uint16_t)((frames + 4) / 8);
+        uint8_t interval = (uint8_t)(steps == 0 ? 0 : steps > 16 ? 15 : steps - 1);
+        out[0] = CMD_FADE;
+        out[1] = mode == FADE_OFF ? FADE_OFF : (uint8_t)(mode | interval);
+        return 2;
+    }
+
+    /**
+     * 停止滚动命令（之后需要整屏重写显存）
+     */
+    inline uint8_t stopScroll(uint8_t* out) {
+        out[0] = CMD_SCROLL_STOP;
+        return 1;
+    }
+
+    /**
+     * 水平循环滚动指定页范围（移出的列从另一侧移入）
+     * @param left true 向左，false 向右
+     * @param startPage 起始页 (0-7)
+     * @param endPage 结束页 (startPage-7)
+     * @param frames 每滚动一列的帧数（取最接近的可用间隔）
+     * @return 命令字节数
+     */
+    inline uint8_t horizontalScroll(uint8_t* out, bool left, uint8_t startPage, uint8_t endPage, uint16_t frames) {
+        uint8_t n = 0;
+        out[n++] = CMD_SCROLL_STOP;
+        out[n++] = left ? CMD_SCROLL_LEFT : CMD_SCROLL_RIGHT;
+        out[n++] = 0x00;
+        out[n++] = (uint8_t)(startPage & 0x07);
+        out[n++] = scrollIntervalCode(frames);
+        out[n++] = (uint8_t)(endPage & 0x07);
+        out[n++] = 0x00;
+        out[n++] = 0xFF;
+        out[n++] = CMD_SCROLL_START;
+        return n;
+    }
+
+    /**
+     * 斜向滚动：每步水平移动一列，同时在垂直滚动区域内上移 verticalOffset 行
+     * @param fixedRows 顶部不滚动的行数
+     * @param scrollRows 垂直滚动区域的行数
+     * @return 命令字节数
+     */
+    inline uint8_t diagonalScroll(uint8_t* out, bool left, uint8_t startPage, uint8_t endPage, uint16_t frames,
+                                  uint8_t verticalOffset, uint8_t fixedRows, uint8_t scrollRows) {
+        uint8_t n = 0;
+        out[n++] = CMD_SCROLL_STOP;
+        out[n++] = CMD_SCROLL_AREA;
+        out[n++] = (uint8_t)(fixedRows & 0x3F);
+        out[n++] = (uint8_t)(scrollRows & 0x7F);
+        out[n++] = left ? CMD_SCROLL_DIAG_LEFT : CMD_SCROLL_DIAG_RIGHT;
+        out[n++] = 0x00;
+        out[n++] = (uint8_t)(startPage & 0x07);
+        out[n++] = scrollIntervalCode(frames);
+        out[n++] = (uint8_t)(endPage & 0x07);
+        out[n++] = (uint8_t)(verticalOffset & 0x3F);
+        out[n++] = CMD_SCROLL_START;
+        return n;
+    }
+
+    /**
+     * 软件模拟水平滚动后的显存内容（页格式帧，用于验证与调试）
+     * @param frame 页格式帧（128列）
+     * @param columns 已滚动的列数
+     */
+    inline void simulateHorizontalScroll(uint8_t* frame, bool left, uint8_t startPage, uint8_t endPage,
+                                         uint16_t columns) {
+        const uint8_t width = 128;
+        uint8_t shift = (uint8_t)(columns % width);
+        if (shift == 0) {
+            return;
+        }
+        uint8_t row[width];
+        for (uint8_t page = startPage; page <= endPage && page < 8; page++) {
+            uint8_t* line = frame + page * width;
+            for (uint8_t x = 0; x < width; x++) {
+                uint8_t src = left ? (uint8_t)((x + shift) % width) : (uint8_t)((x + width - shift) % width);
+                row[x] = line[src];
+            }
+            for (uint8_t x = 0; x < width; x++) {
+                line[x] = row[x];
+            }
+        }
+    }
+}
+
+#endif // PANEL_EFFECTS_H
@@ -0,0 +1,299 @@
+/**
+ * 智能桌面伴侣 - 定点粒子系统
+ *
+ * 表情和睡眠画面上的氛围效果（触摸时飘起的爱心、睡眠时落下的 "z"、成功时的彩纸）。
+ * 粒子按结构数组（SoA）存放：位置和速度为4个独立的 int16 Q8.8 数组，
+ * 每帧的积分、出界/寿命判断和删除合并在一个没有分支的循环中完成
+ * （存活的粒子原地前移，不需要空闲链表）。
+ *
+ * 同时存在的粒子数不是固定常数：每帧测量更新 + 绘制的耗时，
+ * 按每帧的微秒预算换算出上限，超出预算时先丢弃最早的粒子。
+ * 数组容量 PARTICLE_CAPACITY 只是存储上限。
+ */
+
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <stdint.h>
+#include <string.h>
+#include "FrameBuffer.h"
+
+#define PARTICLE_CAPACITY       96      // 粒子存储容量（实际上限由每帧预算决定）
+#define PARTICLE_Q8_ONE         256     // Q8.8 中的1像素
+
+/**
+ * 粒子种类
+ */
+enum ParticleKind {
+    PARTICLE_HEART = 0,     // 爱心：向上飘并逐渐加速
+    PARTICLE_Z,             // "z"：缓慢下落
+    PARTICLE_CONFETTI,      // 彩纸：向上炸开后受重力下落
+    PARTICLE_KIND_COUNT
+};
+
+// 计时函数（微秒），用于测量每帧耗时
+typedef uint32_t (*ParticleClock)();
+
+namespace ParticleDetail {
+    /**
+     * 种类参数（速度和加速度为 Q8.8 像素/帧）
+     */
+    struct KindInfo {
+        const uint8_t* shape;   // 形状，每列一个字节（bit0在最上方）
+        uint8_t width;          // 列数
+        int16_t gravity;        // 每帧的纵向加速度
+        int16_t vxMin, vxMax;   // 横向初速度范围
+        int16_t vyMin, vyMax;   // 纵向初速度范围
+        int16_t spread;         // 发射位置的横向随机范围
+        uint8_t life;           // 寿命（帧）
+    };
+
+    // 爱心 5x5
+    //  .X.X.
+    //  XXXXX
+    //  XXXXX
+    //  .XXX.
+    //  ..X..
+    const uint8_t HEART_SHAPE[5] = {0x06, 0x0F, 0x1E, 0x0F, 0x06};
+
+    // "z" 4x4
+    const uint8_t Z_SHAPE[4] = {0x09, 0x0D, 0x0B, 0x09};
+
+    // 彩纸 2x2
+    const uint8_t CONFETTI_SHAPE[2] = {0x03, 0x03};
+
+    const KindInfo KINDS[PARTICLE_KIND_COUNT] = {
+        // 形状            宽  加速度  vx范围       vy范围        横向范围  寿命
+        {HEART_SHAPE,     5,  -2,    -40,  40,   -160, -96,   1024,     60},    // PARTICLE_HEART
+        {Z_SHAPE,         4,   1,    -24,  8,     48,   96,   1536,     90},    // PARTICLE_Z
+        {CONFETTI_SHAPE,  2,  28,    -512, 512,  -768, -256,  512,      50}     // PARTICLE_CONFETTI
+    };
+}
+
+class ParticleSystem {
+public:
+    ParticleSystem()
+        : count(0), limit(PARTICLE_CAPACITY), budgetMicros(0), clock(nullptr),
+          updateMicros(0), lastMicros(0), costNs(0), dropped(0), seed(0x2545F491u) {}
+
+    /**
+     * 设置计时函数和每帧预算
+     * @param clockFunc 计时函数（nullptr 表示不测量，上限为存储容量）
+     * @param budget 每帧更新 + 绘制的预算（微秒）
+     */
+    void begin(ParticleClock clockFunc, uint16_t budget) {
+        clock = clockFunc;
+        budgetMicros = budget;
+        limit = PARTICLE_CAPACITY;
+        costNs = 0;
+    }
+
+    /**
+     * 在指定位置发射粒子，初速度和寿命按种类随机
+     * @param kind 粒子种类
+     * @param px 发射位置X（像素）
+     * @param py 发射位置Y（像素）
+     * @param n 请求的粒子数
+     * @return 实际发射的粒子数（受当前上限限制）
+     */
+    uint8_t emit(uint8_t kind, int16_t px, int16_t py, uint8_t n) {
+        const ParticleDetail::KindInfo& info = ParticleDetail::KINDS[kind];
+        uint8_t spawned = 0;
+        while (spawned < n && count < limit) {
+            int32_t fx = (int32_t)px * PARTICLE_Q8_ONE + random(-info.spread, info.spread);
+            x[count] = (int16_t)(fx < -MARGIN ? -MARGIN : fx >= X_LIMIT ? X_LIMIT - 1 : fx);
+            y[count] = (int16_t)((int32_t)py * PARTICLE_Q8_ONE);
+            vx[count] = (int16_t)random(info.vxMin, info.vxMax);
+            vy[count] = (int16_t)random(info.vyMin, info.vyMax);
+            life[count] = (uint8_t)(info.life - random(0, info.life / 4));
+            kinds[count] = kind;
+            count++;
+            spawned++;
+        }
+        return spawned;
+    }
+
+    /**
+     * 推进一帧：积分位置和速度，删除寿命结束或移出屏幕的粒子
+     */
+    void update() {
+        uint32_t start = clock != nullptr ? clock() : 0;
+
+        uint8_t alive = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            int32_t nx = x[i] + vx[i];
+            int32_t ny = y[i] + vy[i];
+            // 左右各留出一个粒子宽度，完全离开屏幕后删除（也保证位置不超出 int16）
+            uint8_t keep = (uint8_t)((life[i] > 1)
+                                     & ((uint32_t)(nx + MARGIN) < (uint32_t)(X_LIMIT + MARGIN))
+                                     & ((uint32_t)(ny + MARGIN) < (uint32_t)(Y_LIMIT + MARGIN)));
+            // 无条件写入当前末尾，只有存活时末尾才前进
+            x[alive] = (int16_t)nx;
+            y[alive] = (int16_t)ny;
+            vx[alive] = vx[i];
+            vy[alive] = (int16_t)(vy[i] + ParticleDetail::KINDS[kinds[i]].gravity);
+            life[alive] = (uint8_t)(life[i] - 1);
+            kinds[alive] = kinds[i];
+            alive += keep;
+        }
+        count = alive;
+
+        updateMicros = clock != nullptr ? clock() - start : 0;
+    }
+
+    /**
+     * 把所有粒子按位或绘制到页格式帧缓冲，并按本帧耗时调整粒子上限
+     * @param frame 页格式帧缓冲
+     */
+    void render(uint8_t* frame) {
+        uint32_t start = clock != nullptr ? clock() : 0;
+
+        for (uint8_t i = 0; i < count; i++) {
+            const ParticleDetail::KindInfo& info = ParticleDetail::KINDS[kinds[i]];
+            int16_t px = (int16_t)(x[i] >> 8);
+            int16_t py = (int16_t)(y[i] >> 8);
+            int16_t page = (int16_t)(py >> 3);      // 负坐标算术右移后为 -1
+            uint8_t shift = (uint8_t)(py & 7);
+            bool topVisible = page >= 0 && page < FrameBuffer::TILE_ROWS;
+            bool bottomVisible = page + 1 >= 0 && page + 1 < FrameBuffer::TILE_ROWS && shift != 0;
+            int16_t topOffset = (int16_t)(page * FrameBuffer::ROW_BYTES);
+            for (uint8_t c = 0; c < info.width; c++) {
+                int16_t col = (int16_t)(px + c);
+                if ((uint16_t)col >= FrameBuffer::ROW_BYTES) continue;
+                // 每列不超过8个像素，跨页时拆到相邻两页
+                uint16_t bits = (uint16_t)(info.shape[c] << shift);
+                if (topVisible) frame[topOffset + col] |= (uint8_t)bits;
+                if (bottomVisible) frame[topOffset + FrameBuffer::ROW_BYTES + col] |= (uint8_t)(bits >> 8);
+            }
+        }
+
+        if (clock != nullptr) {
+            lastMicros = updateMicros + (clock() - start);
+            adapt();
+        }
+    }
+
+    /**
+     * 删除所有粒子
+     */
+    void clear() {
+        count = 0;
+    }
+
+    bool isActive() const {
+        return count > 0;
+    }
+
+    uint8_t getCount() const {
+        return count;
+    }
+
+    /**
+     * 第 i 个粒子的位置和速度（Q8.8，按发射顺序，最早的在前）
+     */
+    int16_t getX(uint8_t i) const {
+        return x[i];
+    }
+
+    int16_t getY(uint8_t i) const {
+        return y[i];
+    }
+
+    int16_t getVX(uint8_t i) const {
+        return vx[i];
+    }
+
+    int16_t getVY(uint8_t i) const {
+        return vy[i];
+    }
+
+    /**
+     * 当前的粒子上限（由每帧预算和测得的单个粒子耗时换算）
+     */
+    uint8_t getLimit() const {
+        return limit;
+    }
+
+    /**
+     * 上一帧更新 + 绘制的耗时（微秒）
+     */
+    uint32_t getLastMicros() const {
+        return lastMicros;
+    }
+
+    /**
+     * 测得的单个粒子每帧耗时（纳秒，滑动平均）
+     */
+    uint32_t getCostNs() const {
+        return costNs;
+    }
+
+    /**
+     * 因超出预算而提前删除的粒子数
+     */
+    uint32_t getDroppedCount() const {
+        return dropped;
+    }
+
+private:
+    static const int32_t MARGIN = 8 * PARTICLE_Q8_ONE;
+    static const int32_t X_LIMIT = FrameBuffer::ROW_BYTES * PARTICLE_Q8_ONE;
+    static const int32_t Y_LIMIT = FrameBuffer::TILE_ROWS * 8 * PARTICLE_Q8_ONE;
+
+    int16_t x[PARTICLE_CAPACITY];
+    int16_t y[PARTICLE_CAPACITY];
+    int16_t vx[PARTICLE_CAPACITY];
+    int16_t vy[PARTICLE_CAPACITY];
+    uint8_t life[PARTICLE_CAPACITY];
+    uint8_t kinds[PARTICLE_CAPACITY];
+    uint8_t count;
+    uint8_t limit;
+
+    uint16_t budgetMicros;
+    ParticleClock clock;
+    uint32_t updateMicros;
+    uint32_t lastMicros;
+    uint32_t costNs;
+    uint32_t dropped;
+    uint32_t seed;
+
+    /**
+     * 按本帧耗时更新单个粒子的耗时估计和粒子上限；超出上限时丢弃最早的粒子
+     */
+    void adapt() {
+        if (count == 0) {
+            return;
+        }
+        // 计时分辨率为1微秒，耗时为0时按1微秒估计（偏保守）
+        uint32_t sample = (lastMicros == 0 ? 1 : lastMicros) * 1000 / count;
+        costNs = costNs == 0 ? sample : (costNs * 3 + sample) / 4;
+        uint32_t allowed = (uint32_t)budgetMicros * 1000 / (costNs == 0 ? 1 : costNs);
+        limit = (uint8_t)(allowed > PARTICLE_CAPACITY ? PARTICLE_CAPACITY : allowed == 0 ? 1 : allowed);
+
+        if (count > limit) {
+            // 粒子按发射顺序存放，最早的在前面
+            uint8_t excess = (uint8_t)(count - limit);
+            uint8_t remain = limit;
+            memmove(x, x + excess, remain * sizeof(x[0]));
+            memmove(y, y + excess, remain * sizeof(y[0]));
+            memmove(vx, vx + excess, remain * sizeof(vx[0]));
+            memmove(vy, vy + excess, remain * sizeof(vy[0]));
+            memmove(life, life + excess, remain);
+            memmove(kinds, kinds + excess, remain);
+            count = limit;
+            dropped += excess;
+        }
+    }
+
+    /**
+     * [lo, hi] 范围内的伪随机数（xorshift32）
+     */
+    int32_t random(int32_t lo, int32_t hi) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return lo + (int32_t)(seed % (uint32_t)(hi - lo + 1));
+    }
+};
+
+#endif // PARTICLES_H
@@ -0,0 +1,217 @@
+/**
+ * 智能桌面伴侣 - 秒表/倒计时
+ *
+ * 计时只保存开始时刻和已累计的时长（esp_timer 微秒），显示值在需要时由当前时刻算出，
+ * 主循环卡顿只会推迟画面，不会影响计时精度。
+ * 开始/暂停使用触摸的GPIO边沿时刻，而不是主循环处理到触摸事件的时刻。
+ */
+
+#ifndef STOPWATCH_H
+#define STOPWATCH_H
+
+#include <stdint.h>
+
+#define STOPWATCH_MAX_CENTIS    599999UL    // 显示上限 99:59.99
+
+/**
+ * 计时方式
+ */
+enum StopwatchKind {
+    STOPWATCH_UP = 0,       // 正计时
+    STOPWATCH_COUNTDOWN     // 倒计时
+};
+
+class Stopwatch {
+public:
+    Stopwatch()
+        : kind(STOPWATCH_UP), running(false), startMicros(0), accumulated(0), duration(0) {}
+
+    /**
+     * 切换为正计时并清零
+     */
+    void setStopwatch() {
+        kind = STOPWATCH_UP;
+        duration = 0;
+        reset();
+    }
+
+    /**
+     * 切换为倒计时并清零
+     * @param durationMicros 倒计时时长（微秒）
+     */
+    void setCountdown(int64_t durationMicros) {
+        kind = STOPWATCH_COUNTDOWN;
+        duration = durationMicros;
+        reset();
+    }
+
+    /**
+     * 停止并清零（保留计时方式）
+     */
+    void reset() {
+        running = false;
+        accumulated = 0;
+        startMicros = 0;
+    }
+
+    /**
+     * 开始计时（已在计时或倒计时已结束时无效）
+     * @param now 开始时刻（微秒）
+     */
+    void start(int64_t now) {
+        if (running || isExpired(now)) {
+            return;
+        }
+        startMicros = now;
+        running = true;
+    }
+
+    /**
+     * 暂停计时
+     * @param now 暂停时刻（微秒）
+     */
+    void stop(int64_t now) {
+        if (!running) {
+            return;
+        }
+        accumulated = getElapsed(now);
+        running = false;
+    }
+
+    /**
+     * 开始/暂停；倒计时结束后改为清零
+     * @param now 触摸时刻（微秒）
+     * @return 操作后是否在计时
+     */
+    bool toggle(int64_t now) {
+        if (running) {
+            stop(now);
+        } else if (isExpired(now)) {
+            reset();
+        } else {
+            start(now);
+        }
+        return running;
+    }
+
+    /**
+     * 倒计时到期时自动停止（停在时长处）
+     * @param now 当前时刻（微秒）
+     * @return true 本次调用时刚好到期
+     */
+    bool update(int64_t now) {
+        if (!running || kind != STOPWATCH_COUNTDOWN || getElapsed(now) < duration) {
+            return false;
+        }
+        accumulated = duration;
+        running = false;
+        return true;
+    }
+
+    /**
+     * 已计时长（微秒，倒计时不超过时长）
+     * @param now 当前时刻（微秒）
+     */
+    int64_t getElapsed(int64_t now) const {
+        int64_t elapsed = accumulated;
+        if (running && now > startMicros) {
+            elapsed += now - startMicros;
+        }
+        if (kind == STOPWATCH_COUNTDOWN && elapsed > duration) {
+            elapsed = duration;
+        }
+        return elapsed;
+    }
+
+    /**
+     * 显示值（百分之一秒）：正计时向下取整，倒计时剩余时间向上取整（到期时正好显示0）
+     * @param now 当前时刻（微秒）
+     */
+    uint32_t getCentis(int64_t now) const {
+        int64_t centis;
+        if (kind == STOPWATCH_COUNTDOWN) {
+            centis = (duration - getElapsed(now) + 9999) / 10000;
+        } else {
+            centis = getElapsed(now) / 10000;
+        }
+        return centis > (int64_t)STOPWATCH_MAX_CENTIS ? STOPWATCH_MAX_CENTIS : (uint32_t)centis;
+    }
+
+    /**
+     * 距离显示值下一次变化的时间（微秒），不在计时时返回 -1
+     * @param now 当前时刻（微秒）
+     */
+    int64_t getNextChange(int64_t now) const {
+        if (!running) {
+            return -1;
+        }
+        int64_t elapsed = getElapsed(now);
+        if (kind == STOPWATCH_COUNTDOWN) {
+            // 剩余时间向上取整：剩余时间降到下一个10ms整数倍时变化
+            int64_t phase = (duration - elapsed) % 10000;
+            return phase == 0 ? 10000 : phase;
+        }
+        return 10000 - elapsed % 10000;
+    }
+
+    /**
+     * 倒计时是否已结束
+     */
+    bool isExpired(int64_t now) const {
+        return kind == STOPWATCH_COUNTDOWN && getElapsed(now) >= duration;
+    }
+
+    bool isRunning() const {
+        return running;
+    }
+
+    /**
+     * 是否处于清零状态（未开始）
+     */
+    bool isReset() const {
+        return !running && accumulated == 0;
+    }
+
+    StopwatchKind getKind() const {
+        return kind;
+    }
+
+    int64_t getDuration() const {
+        return duration;
+    }
+
+    /**
+     * 格式化显示值为 MM:SS.cc
+     * @param centis 百分之一秒
+     * @param buffer 输出缓冲区（至少9字节）
+     * @return 格式化后的字符串指针
+     */
+    static char* format(uint32_t centis, char* buffer) {
+        if (centis > STOPWATCH_MAX_CENTIS) {
+            centis = STOPWATCH_MAX_CENTIS;
+        }
+        uint32_t seconds = centis / 100;
+        uint8_t minute = (uint8_t)(seconds / 60);
+        uint8_t second = (uint8_t)(seconds % 60);
+        uint8_t cs = (uint8_t)(centis % 100);
+        buffer[0] = '0' + (minute / 10);
+        buffer[1] = '0' + (minute % 10);
+        buffer[2] = ':';
+        buffer[3] = '0' + (second / 10);
+        buffer[4] = '0' + (second % 10);
+        buffer[5] = '.';
+        buffer[6] = '0' + (cs / 10);
+        buffer[7] = '0' + (cs % 10);
+        buffer[8] = '\0';
+        return buffer;
+    }
+
+private:
+    StopwatchKind kind;
+    bool running;
+    int64_t startMicros;    // 本段计时的开始时刻
+    int64_t accumulated;    // 之前各段累计的时长
+    int64_t duration;       // 倒计时时长
+};
+
+#endif // STOPWATCH_H
@@ -0,0 +1,177 @@
+/**
+ * 智能桌面伴侣 - 秒表/倒计时渲染器
+ *
+ * 负责渲染秒表界面，以 MM:SS.cc 显示到百分之一秒
+ * 计时基于 esp_timer，显示值在出帧时由当前时刻算出；
+ * 每帧只更新变化的字符，并报告这些字符覆盖的tile供刷新时只比较这些tile
+ */
+
+#ifndef STOPWATCH_RENDERER_H
+#define STOPWATCH_RENDERER_H
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "config.h"
+#include "FrameBuffer.h"
+#include "Stopwatch.h"
+
+// 时间字形缓存配置
+#define STOPWATCH_CHARS             8       // "MM:SS.cc"
+#define STOPWATCH_BASELINE          40      // 时间基线Y坐标
+#define STOPWATCH_GLYPH_COUNT       12      // 数字0-9、冒号和小数点
+#define STOPWATCH_GLYPH_MAX_WIDTH   20      // 单个字形最大宽度（像素）
+#define STOPWATCH_GLYPH_MAX_PAGES   4       // 字形最多跨越的页数
+
+class StopwatchRenderer {
+public:
+    StopwatchRenderer();
+
+    /**
+     * 初始化秒表渲染器
+     */
+    void init();
+
+    /**
+     * 推进计时状态：倒计时到期时停止并开始闪烁（在主循环中调用）
+     */
+    void update();
+
+    /**
+     * 渲染时间行（动态内容）
+     * 首次调用时预光栅化数字字形条，之后只把变化的字符复制到时间行缓存
+     * @param display U8g2显示对象指针
+     */
+    void render(U8G2* display);
+
+    /**
+     * 渲染静态背景层（标题和操作提示）
+     * 结果由DisplayManager缓存，只在getStaticVersion()变化时重新调用
+     * @param display U8g2显示对象指针
+     */
+    void renderStatic(U8G2* display);
+
+    /**
+     * 获取静态背景层的版本号（计时状态变化时递增）
+     */
+    uint16_t getStaticVersion() const;
+
+    /**
+     * 开始/暂停（倒计时结束后为清零）
+     * @param edgeMicros 触摸的GPIO边沿时刻（esp_timer微秒），0表示以当前时刻为准
+     */
+    void toggle(int64_t edgeMicros);
+
+    /**
+     * 长按：撤销本次按下时的开始/暂停，然后
+     * 有计时时清零；已清零的正计时切换为倒计时；已清零的倒计时切回正计时并请求退出
+     * @return false 请求退出秒表模式
+     */
+    bool longPress();
+
+    /**
+     * 切换为倒计时并清零
+     * @param seconds 倒计时时长（秒）
+     */
+    void setCountdown(uint32_t seconds);
+
+    /**
+     * 获取计时状态
+     */
+    const Stopwatch& getStopwatch() const;
+
+    /**
+     * 是否正在计时
+     */
+    bool isRunning() const;
+
+    /**
+     * 检查画面是否需要重绘（显示值或闪烁状态变化时）
+     */
+    bool isDirty() const;
+
+    /**
+     * 标记画面需要重绘
+     */
+    void markDirty();
+
+    /**
+     * 获取距离显示值下一次变化的时间
+     * @param now 当前时间（millis，显示值本身由esp_timer计算）
+     * @return 剩余毫秒数，0表示已到期，DEADLINE_NONE表示不在计时
+     */
+    unsigned long getNextDeadline(unsigned long now) const;
+
+    /**
+     * 获取上一次render中变化的字符覆盖的tile
+     * @param tiles 输出tile标记
+     */
+    void getChangedTiles(FrameBuffer::DirtyMask tiles) const;
+
+    /**
+     * 获取上一次开始/暂停从触摸GPIO边沿到处理完成的延迟（微秒）
+     */
+    uint32_t getLastLatencyMicros() const;
+
+private:
+    // 计时状态，以及本次按下前的状态（长按时撤销按下时的开始/暂停）
+    Stopwatch stopwatch;
+    Stopwatch beforeToggle;
+    bool toggledByPress;
+
+    // 倒计时到期时刻（用于闪烁）
+    int64_t expiredAt;
+
+    // 画面是否需要重绘
+    bool dirty;
+
+    // 上一次render显示的值和时间行是否可见
+    uint32_t renderedCentis;
+    bool lineVisible;
+
+    // 静态背景层版本号
+    uint16_t staticVersion;
+
+    // 上一次开始/暂停的触摸延迟
+    uint32_t lastLatencyMicros;
+
+    // 页格式字形条：数字0-9、冒号和小数点，按页存放、与时间行页对齐
+    uint8_t glyphStrip[STOPWATCH_GLYPH_COUNT][STOPWATCH_GLYPH_MAX_PAGES][STOPWATCH_GLYPH_MAX_WIDTH];
+    uint8_t glyphWidth[STOPWATCH_GLYPH_COUNT];
+    bool glyphsReady;
+
+    // 时间行布局（只计算一次）
+    uint8_t timePage;                       // 时间行起始页
+    uint8_t timePages;                      // 时间行占用页数
+    uint8_t charX[STOPWATCH_CHARS];         // 每个字符的X坐标
+    uint8_t timeX0;                         // 时间行左边界
+    uint8_t timeX1;                         // 时间行右边界（不含）
+
+    // 时间行缓存：已绘制的字符及其页格式像素
+    uint8_t timeLine[STOPWATCH_GLYPH_MAX_PAGES][FrameBuffer::ROW_BYTES];
+    char lastChars[STOPWATCH_CHARS];
+
+    // 上一次render中变化的tile
+    FrameBuffer::DirtyMask changedTiles;
+
+    /**
+     * 预光栅化数字字形条并计算时间行布局
+     */
+    bool buildGlyphStrip(U8G2* display);
+
+    /**
+     * 字符对应的字形条索引
+     */
+    static uint8_t glyphIndex(char c);
+
+    /**
+     * 时间行当前是否可见（倒计时结束后闪烁）
+     */
+    bool isLineVisible(int64_t now) const;
+
+    /**
+     * 计时状态变化：重绘背景层和时间行
+     */
+    void stateChanged();
+};
+
+#endif // STOPWATCH_RENDERER_H
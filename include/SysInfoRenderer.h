@@ -21,11 +21,23 @@ public:
     void init();
     
     /**
-     * 渲染系统信息界面到显示器
+     * 渲染系统信息界面的动态内容（数值、内存条、信号图标）
      * @param display U8g2显示对象指针
      */
     void render(U8G2* display);
     
+    /**
+     * 渲染静态背景层（标题、分隔线、标签、内存条外框）
+     * 结果由DisplayManager缓存，只在getStaticVersion()变化时重新调用
+     * @param display U8g2显示对象指针
+     */
+    void renderStatic(U8G2* display);
+    
+    /**
+     * 获取静态背景层的版本号（标签不会变化，始终为0）
+     */
+    uint16_t getStaticVersion() const;
+    
     /**
      * 设置空闲堆内存
      * @param bytes 空闲内存字节数
@@ -50,6 +62,23 @@ public:
      */
     void setWiFiConnected(bool connected);
     
+    /**
+     * 检查画面是否需要重绘（数据变化后置位，render后清除）
+     */
+    bool isDirty() const;
+    
+    /**
+     * 标记画面需要重绘
+     */
+    void markDirty();
+    
+    /**
+     * 获取距离下一次刷新的时间（1Hz）
+     * @param now 当前时间（millis）
+     * @return 剩余毫秒数，0表示已到期，DEADLINE_NONE表示数据没有变化
+     */
+    unsigned long getNextDeadline(unsigned long now) const;
+    
     /**
      * 格式化运行时间为可读字符串
      * @param seconds 运行时间（秒）
@@ -71,6 +100,12 @@ private:
     // WiFi是否已连接
     bool wifiConnected;
     
+    // 画面是否需要重绘
+    bool dirty;
+    
+    // 上次渲染时间（millis）
+    unsigned long lastRenderTime;
+    
     /**
      * 绘制信号强度图标
      */
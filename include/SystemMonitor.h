@@ -23,6 +23,13 @@ public:
      */
     void update();
     
+    /**
+     * 获取下一次检查的时间
+     * @param now 当前时间（毫秒）
+     * @return 剩余毫秒数，0表示下一次update会检查
+     */
+    unsigned long getNextDeadline(unsigned long now) const;
+    
     /**
      * 获取空闲堆内存（字节）
      * @return 空闲堆内存大小
@@ -0,0 +1,207 @@
+/**
+ * 智能桌面伴侣 - 文本排版
+ *
+ * UTF-8 解码与自动换行：
+ * - 英文等按空格断词，单词超过行宽时强制断开
+ * - 中日韩文字之间可任意断行
+ * - 逗号、句号等标点不出现在行首（避头尾）
+ * - '\n' 强制换行
+ *
+ * 字形宽度通过回调获取
+ */
+
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include <stdint.h>
+
+namespace TextLayout {
+    // 解码失败时使用的替换字符
+    const uint32_t REPLACEMENT_CHAR = 0xFFFD;
+
+    /**
+     * 一行排版结果（字节偏移，不包含行尾的空格和换行符）
+     */
+    struct Line {
+        uint16_t start;     // 行首在文本中的字节偏移
+        uint16_t length;    // 字节长度
+        uint16_t width;     // 像素宽度
+    };
+
+    // 获取字形前进宽度的回调
+    typedef uint8_t (*AdvanceFunc)(uint32_t codepoint, void* context);
+
+    /**
+     * 解码一个UTF-8字符
+     * @param text 文本
+     * @param pos 输入：当前字节偏移；输出：下一个字符的偏移
+     * @param length 文本字节长度
+     * @return Unicode码点，非法序列返回REPLACEMENT_CHAR并前进1字节
+     */
+    inline uint32_t decodeUtf8(const char* text, uint16_t& pos, uint16_t length) {
+        const uint8_t* s = reinterpret_cast<const uint8_t*>(text);
+        uint8_t lead = s[pos];
+        uint8_t extra;
+        uint32_t cp;
+
+        if (lead < 0x80) {
+            pos++;
+            return lead;
+        } else if ((lead & 0xE0) == 0xC0) {
+            extra = 1;
+            cp = lead & 0x1F;
+        } else if ((lead & 0xF0) == 0xE0) {
+            extra = 2;
+            cp = lead & 0x0F;
+        } else if ((lead & 0xF8) == 0xF0) {
+            extra = 3;
+            cp = lead & 0x07;
+        } else {
+            pos++;
+            return REPLACEMENT_CHAR;
+        }
+
+        // 文本在多字节序列中间结束
+        if (pos + extra >= length) {
+            pos++;
+            return REPLACEMENT_CHAR;
+        }
+        for (uint8_t i = 1; i <= extra; i++) {
+            uint8_t c = s[pos + i];
+            if ((c & 0xC0) != 0x80) {
+                pos++;
+                return REPLACEMENT_CHAR;
+            }
+            cp = (cp << 6) | (c & 0x3F);
+        }
+        pos += extra + 1;
+        return cp;
+    }
+
+    /**
+     * 是否为中日韩文字或全角符号（两侧均可断行）
+     */
+    inline bool isCjk(uint32_t cp) {
+        return (cp >= 0x2E80 && cp <= 0x9FFF)       // 部首、标点、假名、统一汉字
+            || (cp >= 0xAC00 && cp <= 0xD7AF)       // 韩文音节
+            || (cp >= 0xF900 && cp <= 0xFAFF)       // 兼容汉字
+            || (cp >= 0xFF00 && cp <= 0xFFEF);      // 全角字符
+    }
+
+    /**
+     * 是否为不能出现在行首的标点
+     */
+    inline bool isNoLineStart(uint32_t cp) {
+        switch (cp) {
+            case ',': case '.': case ';': case ':': case '!': case '?':
+            case ')': case ']': case '}':
+            case 0x3001: case 0x3002:                   // 、。
+            case 0xFF0C: case 0xFF0E: case 0xFF1A:      // ，．：
+            case 0xFF1B: case 0xFF01: case 0xFF1F:      // ；！？
+            case 0xFF09: case 0x3009: case 0x300B:      // ）〉》
+            case 0x300D: case 0x300F: case 0x3011:      // 」』】
+            case 0x201D: case 0x2019: case 0x2026:      // ” ’ …
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * 自动换行
+     * @param text UTF-8文本
+     * @param length 文本字节长度
+     * @param maxWidth 最大行宽（像素）
+     * @param advance 字形宽度回调
+     * @param context 传给回调的参数
+     * @param lines 输出行数组
+     * @param maxLines 最多输出的行数（超出部分被截断）
+     * @return 输出的行数
+     */
+    inline uint8_t breakLines(const char* text, uint16_t length, uint16_t maxWidth,
+                              AdvanceFunc advance, void* context,
+                              Line* lines, uint8_t maxLines) {
+        uint8_t count = 0;
+        uint16_t pos = 0;
+
+        while (pos < length && count < maxLines) {
+            uint16_t lineStart = pos;
+            uint16_t width = 0;
+            uint32_t prev = 0;
+
+            // 最近的断行点：行在 breakEnd 处结束，下一行从 breakResume 开始
+            bool hasBreak = false;
+            uint16_t breakEnd = 0;
+            uint16_t breakResume = 0;
+            uint16_t breakWidth = 0;
+
+            uint16_t lineEnd = length;
+            uint16_t resume = length;
+            uint16_t lineWidth = 0;
+            bool softWrap = false;
+
+            while (pos < length) {
+                uint16_t cpStart = pos;
+                uint32_t cp = decodeUtf8(text, pos, length);
+
+                if (cp == '\n') {
+                    lineEnd = cpStart;
+                    resume = pos;
+                    lineWidth = width;
+                    break;
+                }
+
+                // 记录当前字符之前的断行点
+                if (cp == ' ') {
+                    hasBreak = true;
+                    breakEnd = cpStart;
+                    breakResume = pos;
+                    breakWidth = width;
+                } else if (prev != 0 && prev != ' ' && !isNoLineStart(cp) &&
+                           (isCjk(cp) || isCjk(prev) || isNoLineStart(prev))) {
+                    hasBreak = true;
+                    breakEnd = cpStart;
+                    breakResume = cpStart;
+                    breakWidth = width;
+                }
+
+                uint8_t w = advance(cp, context);
+                if (width + w > maxWidth && cpStart > lineStart) {
+                    softWrap = true;
+                    if (hasBreak) {
+                        lineEnd = breakEnd;
+                        resume = breakResume;
+                        lineWidth = breakWidth;
+                    } else {
+                        // 没有可断行的位置（超长单词）：在当前字符前强制断开
+                        lineEnd = cpStart;
+                        resume = cpStart;
+                        lineWidth = width;
+                    }
+                    break;
+                }
+
+                width += w;
+                prev = cp;
+                lineWidth = width;
+            }
+
+            lines[count].start = lineStart;
+            lines[count].length = lineEnd - lineStart;
+            lines[count].width = lineWidth;
+            count++;
+            pos = resume;
+
+            // 自动换行后跳过下一行开头的空格
+            if (softWrap) {
+                while (pos < length && text[pos] == ' ') {
+                    pos++;
+                }
+            }
+        }
+
+        return count;
+    }
+}
+
+#endif // TEXT_LAYOUT_H
@@ -0,0 +1,177 @@
+/**
+ * 智能桌面伴侣 - 文本渲染器
+ *
+ * 负责显示多行文本消息（如AI回复）
+ * 每条消息只排版和光栅化一次，结果缓存为页格式位图；
+ * 滚动时按像素移位复制缓存位图，不再重新绘制字形
+ */
+
+#ifndef TEXT_RENDERER_H
+#define TEXT_RENDERER_H
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include "config.h"
+#include "FrameBuffer.h"
+#include "TextLayout.h"
+#include "GlyphStore.h"
+
+// 西文字体（码点 <= 0xFF）；中文字形从flash字库分区按需读取
+#define TEXT_FONT               u8g2_font_6x13_tf
+#define TEXT_LATIN_MAX          0xFF
+
+// 缓存可容纳的最大行数（每行2页）
+#define TEXT_MAX_LINES          (TEXT_CACHE_PAGES * 8 / TEXT_LINE_HEIGHT)
+
+// 跑马灯模式下缓存作为2页高的长条使用，可容纳的最大宽度（像素）
+#define TEXT_MARQUEE_MAX_WIDTH  (TEXT_CACHE_PAGES * FrameBuffer::ROW_BYTES * 8 / TEXT_LINE_HEIGHT)
+
+// 跑马灯长条在屏幕上的起始页（占2页，垂直居中）
+#define TEXT_MARQUEE_FIRST_PAGE ((FrameBuffer::TILE_ROWS - 2) / 2)
+
+// 单个字形绘制时可能覆盖的最大宽度（像素）
+#define TEXT_GLYPH_MAX_WIDTH    16
+
+/**
+ * 文本滚动方式
+ */
+enum TextScrollMode {
+    TEXT_SCROLL_VERTICAL = 0,   // 自动换行，超过一屏时纵向逐像素滚动
+    TEXT_SCROLL_MARQUEE         // 单行显示，超过屏幕宽度时横向跑马灯
+};
+
+class TextRenderer {
+public:
+    TextRenderer();
+    
+    /**
+     * 初始化文本渲染器（打开中文字库分区）
+     */
+    void init();
+    
+    /**
+     * 设置要显示的文本（下一次render时排版并光栅化）
+     * @param text UTF-8文本，超过TEXT_MAX_BYTES的部分被截断
+     * @param mode 滚动方式
+     */
+    void setText(const char* text, TextScrollMode mode = TEXT_SCROLL_VERTICAL);
+    
+    /**
+     * 渲染文本
+     * 新文本在首次渲染时排版并光栅化到缓存，之后每帧只从缓存移位复制
+     * @param display U8g2显示对象指针
+     */
+    void render(U8G2* display);
+    
+    /**
+     * 推进滚动位置（到达getNextDeadline时调用）
+     * @param now 当前时间（millis）
+     */
+    void updateScroll(unsigned long now);
+    
+    /**
+     * 检查画面是否需要重绘
+     */
+    bool isDirty() const;
+    
+    /**
+     * 标记画面需要重绘
+     */
+    void markDirty();
+    
+    /**
+     * 获取距离下一次滚动的时间
+     * @param now 当前时间（millis）
+     * @return 剩余毫秒数，0表示已到期，DEADLINE_NONE表示不需要滚动
+     */
+    unsigned long getNextDeadline(unsigned long now) const;
+    
+    /**
+     * 获取排版后的行数
+     */
+    uint8_t getLineCount() const;
+    
+    /**
+     * 获取上一次排版与光栅化的耗时（微秒）
+     */
+    uint32_t getLastLayoutMicros() const;
+    
+    /**
+     * 获取上一帧从缓存合成画面的耗时（微秒）
+     */
+    uint32_t getLastScrollMicros() const;
+    
+    /**
+     * 获取中文字库（命中率、查找耗时等统计）
+     */
+    const GlyphStore& getGlyphStore() const;
+
+private:
+    // 文本内容
+    char text[TEXT_MAX_BYTES + 1];
+    uint16_t textLength;
+    
+    // 滚动方式
+    TextScrollMode scrollMode;
+    
+    // 排版结果
+    TextLayout::Line lines[TEXT_MAX_LINES];
+    uint8_t lineCount;
+    
+    // 光栅化后的页格式位图
+    // 纵向模式：宽128、TEXT_CACHE_PAGES页；跑马灯模式：宽TEXT_MARQUEE_MAX_WIDTH、2页
+    uint8_t cache[TEXT_CACHE_PAGES * FrameBuffer::ROW_BYTES] __attribute__((aligned(4)));
+    bool rasterized;
+    
+    // 滚动状态
+    uint16_t scrollOffset;      // 纵向：窗口顶端行号；跑马灯：窗口左端列号
+    uint16_t scrollRange;       // 纵向：最大偏移；跑马灯：一圈的宽度；0表示不滚动
+    unsigned long lastScrollTime;
+    unsigned long scrollWait;
+    
+    // 画面是否需要重绘
+    bool dirty;
+    
+    // 耗时统计（微秒）
+    uint32_t lastLayoutMicros;
+    uint32_t lastScrollMicros;
+    
+    // 中文字库（flash分区 + RAM中的LRU缓存）
+    GlyphStore glyphStore;
+    
+    // 排版期间使用的显示对象（字形宽度回调中获取西文字形宽度）
+    U8G2* layoutDisplay;
+    
+    /**
+     * 排版并将所有行光栅化到缓存
+     */
+    void rasterize(U8G2* display);
+    
+    /**
+     * 将一行文字绘制到临时缓冲的前2页
+     */
+    void drawLine(U8G2* display, uint8_t* scratch, const TextLayout::Line& line, int16_t x);
+    
+    /**
+     * 绘制单个字符到临时缓冲：西文用U8g2字体，其他从中文字库读取
+     * @return 前进宽度
+     */
+    uint8_t drawChar(U8G2* display, uint8_t* scratch, int16_t x, uint32_t codepoint);
+    
+    /**
+     * 字形宽度回调（context为TextRenderer对象）
+     */
+    static uint8_t glyphAdvance(uint32_t codepoint, void* context);
+    
+    /**
+     * 从字库分区读取数据（GlyphStore回调）
+     */
+    static bool readFontPartition(uint32_t offset, void* dst, uint32_t length, void* context);
+    
+    /**
+     * 微秒时钟（GlyphStore回调）
+     */
+    static uint32_t glyphClock();
+};
+
+#endif // TEXT_RENDERER_H
@@ -16,6 +16,7 @@
 #endif
 
 #include "config.h"
+#include "AppEvents.h"
 
 // 时间同步状态枚举
 enum TimeSyncState {
@@ -25,9 +26,6 @@ enum TimeSyncState {
     TIME_SYNC_FAILED        // 同步失败
 };
 
-// 时间同步回调函数类型
-typedef void (*TimeSyncCallback)(TimeSyncState state);
-
 /**
  * 时间管理器类
  * 
@@ -122,10 +120,11 @@ public:
     TimeSyncState getState();
     
     /**
-     * 设置同步状态回调函数
-     * @param callback 回调函数指针
+     * 设置事件总线：之后的同步状态变化投递为 EVENT_TIME_SYNC 事件
+     * @param bus 事件总线
+     * @param producer 生产者编号（syncNTP()/update() 所在的任务）
      */
-    void setSyncCallback(TimeSyncCallback callback);
+    void setEventBus(AppEventBus* bus, uint8_t producer);
     
     /**
      * 获取上次同步时间（毫秒）
@@ -137,10 +136,18 @@ public:
      * 强制重新同步
      */
     void forceSync();
+    
+    /**
+     * 获取下一次需要调用 update() 的时间：缓存的时间在下一整秒刷新，已同步时还有定期重新同步
+     * @param now 当前时间（毫秒）
+     * @return 剩余毫秒数，0表示应立即调用update
+     */
+    unsigned long getNextDeadline(unsigned long now) const;
 
 private:
     TimeSyncState _state;               // 当前同步状态
-    TimeSyncCallback _syncCallback;     // 同步状态回调函数
+    AppEventBus* _bus;                  // 事件总线
+    uint8_t _producer;                  // 在总线上的生产者编号
     
     unsigned long _lastSyncTime;        // 上次同步时间
     unsigned long _lastSyncAttempt;     // 上次同步尝试时间
@@ -155,9 +162,10 @@ private:
     uint8_t _cachedMonth;
     uint8_t _cachedDay;
     unsigned long _cacheUpdateTime;     // 缓存更新时间
+    unsigned long _msToNextSecond;      // 缓存更新时距下一整秒的毫秒数
     
     /**
-     * 更新同步状态并触发回调
+     * 更新同步状态并投递状态变化事件
      * @param newState 新状态
      */
     void setState(TimeSyncState newState);
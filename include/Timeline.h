@@ -0,0 +1,348 @@
+/**
+ * 智能桌面伴侣 - 关键帧动画引擎
+ *
+ * 表情动画以关键帧表描述（时间、眼睛参数、嘴巴状态、缓动方式），
+ * 表格为constexpr常量，存放在flash中；播放器为每个动画层维护一个游标，
+ * 每次推进只比较下一个关键帧，开销与动画长度无关。
+ *
+ * 多个动画层可同时播放并叠加（如眨眼过程中的触摸反应）：
+ * 每个动画声明自己驱动的通道，按层顺序覆盖或按比例缩放基础参数；
+ * 每层可排队后续动画，当前动画结束后无缝衔接。
+ */
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <stdint.h>
+#include "EyeModel.h"
+
+#define TIMELINE_LAYERS         3       // 动画层数
+#define TIMELINE_QUEUE_SIZE     4       // 每层可排队的动画数
+
+namespace Timeline {
+    // 没有待处理的关键帧（与 DEADLINE_NONE 相同）
+    const uint32_t NO_DEADLINE = 0xFFFFFFFFUL;
+
+    // 关键帧中表示"不改变嘴巴"的取值
+    const uint8_t MOUTH_KEEP = 0xFF;
+
+    /**
+     * 从上一个关键帧到本关键帧的缓动方式
+     */
+    enum Easing {
+        EASE_STEP = 0,      // 到达本关键帧时跳变
+        EASE_LINEAR,        // 线性插值
+        EASE_IN_OUT         // 平滑插值（smoothstep）
+    };
+
+    /**
+     * 动画驱动的通道
+     */
+    enum Channel {
+        CHANNEL_OPENNESS = 0x01,
+        CHANNEL_PUPIL    = 0x02,
+        CHANNEL_SQUINT   = 0x04,
+        CHANNEL_SIZE     = 0x08,
+        CHANNEL_MOUTH    = 0x10
+    };
+
+    /**
+     * 动画与下层参数的混合方式
+     */
+    enum Blend {
+        BLEND_OVERRIDE = 0, // 驱动的通道直接替换
+        BLEND_MULTIPLY      // 睁开程度和大小按Q8比例缩放，瞳孔和眯眼相加
+    };
+
+    /**
+     * 关键帧
+     */
+    struct Keyframe {
+        uint16_t time;          // 距动画开始的时间（毫秒）
+        EyeModel::Params eye;   // 眼睛参数
+        uint8_t mouth;          // 嘴巴状态（MouthState），MOUTH_KEEP 表示不改变
+        uint8_t easing;         // 从上一个关键帧过渡到本关键帧的缓动方式
+    };
+
+    /**
+     * 动画：关键帧表 + 驱动的通道 + 混合方式
+     */
+    struct Animation {
+        const Keyframe* frames; // 按时间升序，第一个关键帧的时间为0
+        uint8_t count;          // 关键帧数量
+        uint8_t channels;       // Channel 组合
+        uint8_t blend;          // Blend
+    };
+
+    /**
+     * 按缓动方式计算插值比例
+     * @param t 线性进度 Q8（0-256）
+     * @return 缓动后的进度 Q8
+     */
+    inline int32_t ease(uint8_t easing, int32_t t) {
+        switch (easing) {
+            case EASE_STEP:
+                return t >= EYE_Q8_ONE ? EYE_Q8_ONE : 0;
+            case EASE_IN_OUT:
+                // smoothstep: t^2 * (3 - 2t)
+                return t * t * (3 * EYE_Q8_ONE - 2 * t) >> 16;
+            default:
+                return t;
+        }
+    }
+
+    /**
+     * 动画总时长（最后一个关键帧的时间）
+     */
+    inline uint16_t duration(const Animation& animation) {
+        return animation.frames[animation.count - 1].time;
+    }
+
+    inline int16_t lerp(int16_t a, int16_t b, int32_t t) {
+        return (int16_t)(a + (((int32_t)b - a) * t >> 8));
+    }
+
+    /**
+     * 单层动画的播放状态
+     */
+    struct Track {
+        const Animation* animation;     // 正在播放的动画，nullptr表示空闲
+        uint32_t startTime;             // 动画开始时间
+        uint8_t cursor;                 // 当前所在区间的起始关键帧
+        const Animation* queue[TIMELINE_QUEUE_SIZE];
+        uint8_t queued;
+        EyeModel::Params eye;           // 上一次推进时的采样值
+        uint8_t mouth;
+    };
+
+    /**
+     * 多层动画播放器
+     */
+    class Player {
+    public:
+        Player() {
+            for (uint8_t i = 0; i < TIMELINE_LAYERS; i++) {
+                stop(i);
+            }
+        }
+
+        /**
+         * 立即在指定层播放动画（替换该层正在播放和排队的动画）
+         */
+        void play(uint8_t layer, const Animation& animation, uint32_t now) {
+            if (layer >= TIMELINE_LAYERS) return;
+            tracks[layer].queued = 0;
+            start(tracks[layer], &animation, now);
+        }
+
+        /**
+         * 在指定层排队播放动画（该层空闲时立即开始）
+         * @return false 队列已满
+         */
+        bool enqueue(uint8_t layer, const Animation& animation, uint32_t now) {
+            if (layer >= TIMELINE_LAYERS) return false;
+            Track& track = tracks[layer];
+            if (track.animation == nullptr) {
+                start(track, &animation, now);
+                return true;
+            }
+            if (track.queued >= TIMELINE_QUEUE_SIZE) {
+                return false;
+            }
+            track.queue[track.queued++] = &animation;
+            return true;
+        }
+
+        /**
+         * 停止指定层（清空队列）
+         */
+        void stop(uint8_t layer) {
+            if (layer >= TIMELINE_LAYERS) return;
+            tracks[layer].animation = nullptr;
+            tracks[layer].queued = 0;
+            tracks[layer].cursor = 0;
+            tracks[layer].startTime = 0;
+            tracks[layer].mouth = MOUTH_KEEP;
+        }
+
+        /**
+         * 指定层是否正在播放
+         */
+        bool isPlaying(uint8_t layer) const {
+            return layer < TIMELINE_LAYERS && tracks[layer].animation != nullptr;
+        }
+
+        /**
+         * 指定层正在播放的动画
+         */
+        const Animation* current(uint8_t layer) const {
+            return layer < TIMELINE_LAYERS ? tracks[layer].animation : nullptr;
+        }
+
+        /**
+         * 指定层当前动画已播放的时间（毫秒）
+         */
+        uint32_t elapsed(uint8_t layer, uint32_t now) const {
+            return layer < TIMELINE_LAYERS && tracks[layer].animation != nullptr ? now - tracks[layer].startTime : 0;
+        }
+
+        /**
+         * 是否有任何层在播放
+         */
+        bool isActive() const {
+            for (uint8_t i = 0; i < TIMELINE_LAYERS; i++) {
+                if (tracks[i].animation != nullptr) return true;
+            }
+            return false;
+        }
+
+        /**
+         * 推进所有层到当前时间并采样
+         * 游标只向前移动，每层每次推进通常只比较一个关键帧
+         * @return true 采样结果有变化（包括动画开始或结束）
+         */
+        bool update(uint32_t now) {
+            bool changed = false;
+            for (uint8_t i = 0; i < TIMELINE_LAYERS; i++) {
+                Track& track = tracks[i];
+                if (track.animation == nullptr) continue;
+
+                // 动画结束：衔接队列中的下一个动画
+                while (track.animation != nullptr && now - track.startTime >= duration(*track.animation)) {
+                    uint32_t end = track.startTime + duration(*track.animation);
+                    changed = true;
+                    if (track.queued == 0) {
+                        track.animation = nullptr;
+                        track.mouth = MOUTH_KEEP;
+                        break;
+                    }
+                    const Animation* next = track.queue[0];
+                    for (uint8_t q = 1; q < track.queued; q++) {
+                        track.queue[q - 1] = track.queue[q];
+                    }
+                    track.queued--;
+                    start(track, next, end);
+                }
+                if (track.animation == nullptr) continue;
+
+                // 游标前进到包含当前时间的区间
+                uint32_t elapsed = now - track.startTime;
+                const Keyframe* frames = track.animation->frames;
+                while (track.cursor + 1 < track.animation->count && elapsed >= frames[track.cursor + 1].time) {
+                    track.cursor++;
+                }
+
+                EyeModel::Params eye;
+                uint8_t mouth;
+                sample(track, elapsed, eye, mouth);
+                if (!EyeModel::equals(eye, track.eye) || mouth != track.mouth) {
+                    track.eye = eye;
+                    track.mouth = mouth;
+                    changed = true;
+                }
+            }
+            return changed;
+        }
+
+        /**
+         * 将所有层的采样结果按层顺序叠加到基础参数上
+         * @param eye 基础眼睛参数（原地修改）
+         * @param mouth 基础嘴巴状态（原地修改）
+         */
+        void apply(EyeModel::Params& eye, uint8_t& mouth) const {
+            for (uint8_t i = 0; i < TIMELINE_LAYERS; i++) {
+                const Track& track = tracks[i];
+                if (track.animation == nullptr) continue;
+                uint8_t channels = track.animation->channels;
+                bool multiply = track.animation->blend == BLEND_MULTIPLY;
+
+                if (channels & CHANNEL_OPENNESS) {
+                    eye.openness = multiply ? (int16_t)((int32_t)eye.openness * track.eye.openness >> 8)
+                                            : track.eye.openness;
+                }
+                if (channels & CHANNEL_PUPIL) {
+                    eye.pupilX = multiply ? (int16_t)(eye.pupilX + track.eye.pupilX) : track.eye.pupilX;
+                    eye.pupilY = multiply ? (int16_t)(eye.pupilY + track.eye.pupilY) : track.eye.pupilY;
+                }
+                if (channels & CHANNEL_SQUINT) {
+                    eye.squint = multiply ? (int16_t)(eye.squint + track.eye.squint) : track.eye.squint;
+                }
+                if (channels & CHANNEL_SIZE) {
+                    eye.size = multiply ? (int16_t)((int32_t)eye.size * track.eye.size >> 8) : track.eye.size;
+                }
+                if ((channels & CHANNEL_MOUTH) && track.mouth != MOUTH_KEEP) {
+                    mouth = track.mouth;
+                }
+            }
+        }
+
+        /**
+         * 距离下一次需要推进的时间
+         * 跳变区间等到下一个关键帧；插值区间按帧间隔推进
+         * @param now 当前时间
+         * @param lastUpdate 上一次调用update的时间
+         * @param frameMs 插值时的帧间隔
+         * @return 剩余毫秒数，0表示已到期，NO_DEADLINE表示没有动画
+         */
+        uint32_t getNextDeadline(uint32_t now, uint32_t lastUpdate, uint32_t frameMs) const {
+            uint32_t next = NO_DEADLINE;
+            for (uint8_t i = 0; i < TIMELINE_LAYERS; i++) {
+                const Track& track = tracks[i];
+                if (track.animation == nullptr) continue;
+
+                uint32_t elapsed = now - track.startTime;
+                uint8_t target = (uint8_t)(track.cursor + 1);
+                if (target >= track.animation->count) {
+                    return 0;
+                }
+                uint32_t keyTime = track.animation->frames[target].time;
+                uint32_t remaining = elapsed >= keyTime ? 0 : keyTime - elapsed;
+                if (track.animation->frames[target].easing != EASE_STEP) {
+                    uint32_t sinceUpdate = now - lastUpdate;
+                    uint32_t frame = sinceUpdate >= frameMs ? 0 : frameMs - sinceUpdate;
+                    if (frame < remaining) {
+                        remaining = frame;
+                    }
+                }
+                if (remaining < next) {
+                    next = remaining;
+                }
+            }
+            return next;
+        }
+
+    private:
+        Track tracks[TIMELINE_LAYERS];
+
+        void start(Track& track, const Animation* animation, uint32_t now) {
+            track.animation = animation;
+            track.startTime = now;
+            track.cursor = 0;
+            sample(track, 0, track.eye, track.mouth);
+        }
+
+        /**
+         * 在当前区间内插值采样
+         */
+        static void sample(const Track& track, uint32_t elapsed, EyeModel::Params& eye, uint8_t& mouth) {
+            const Keyframe& from = track.animation->frames[track.cursor];
+            mouth = from.mouth;
+            if (track.cursor + 1 >= track.animation->count) {
+                eye = from.eye;
+                return;
+            }
+            const Keyframe& to = track.animation->frames[track.cursor + 1];
+            uint32_t span = (uint32_t)(to.time - from.time);
+            uint32_t into = elapsed - from.time;
+            int32_t t = span == 0 ? EYE_Q8_ONE : (int32_t)(into >= span ? EYE_Q8_ONE : into * EYE_Q8_ONE / span);
+            t = ease(to.easing, t);
+            eye.openness = lerp(from.eye.openness, to.eye.openness, t);
+            eye.pupilX = lerp(from.eye.pupilX, to.eye.pupilX, t);
+            eye.pupilY = lerp(from.eye.pupilY, to.eye.pupilY, t);
+            eye.squint = lerp(from.eye.squint, to.eye.squint, t);
+            eye.size = lerp(from.eye.size, to.eye.size, t);
+        }
+    };
+}
+
+#endif // TIMELINE_H
@@ -0,0 +1,190 @@
+/**
+ * 智能桌面伴侣 - 通知队列
+ *
+ * WiFi、时间同步、AI 等模块可以在任意任务中投递一条短通知（文本、优先级、显示时长），
+ * 显示管理器在正常出帧流程中把当前通知合成到当前模式之上，到期后自动移除，没有阻塞等待。
+ *
+ * 队列是固定数量的槽位，每个槽位有一个原子状态：
+ *   空闲 --(投递者CAS抢占)--> 写入中 --(写完，release)--> 就绪 --(显示到期，release)--> 空闲
+ * 多个投递者之间只通过CAS竞争槽位，不加锁；渲染路径只读取各槽位状态，不会被投递阻塞。
+ * 就绪之后的槽位只由渲染路径（单一消费者）访问。
+ *
+ * 同时显示一条：优先级最高的先显示，同优先级按投递顺序；
+ * 更高优先级的通知到来时暂停当前通知，剩余时间在它重新显示时继续计算。
+ */
+
+#ifndef TOAST_QUEUE_H
+#define TOAST_QUEUE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+#define TOAST_SLOTS         8       // 同时排队的通知数
+#define TOAST_TEXT_BYTES    32      // 单条通知文本最大字节数（含结尾0）
+
+/**
+ * 通知优先级
+ */
+enum ToastPriority {
+    TOAST_INFO = 0,     // 一般状态（连接成功、同步完成）
+    TOAST_NOTICE,       // 需要留意（断线、同步失败）
+    TOAST_ALERT         // 紧急（工厂重置等），优先显示
+};
+
+class ToastQueue {
+public:
+    /**
+     * 一条通知（就绪后内容不再变化）
+     */
+    struct Toast {
+        char text[TOAST_TEXT_BYTES];
+        uint16_t icon;          // 图标字形（open_iconic 1x 字体），0表示没有图标
+        uint8_t priority;       // ToastPriority
+        uint32_t sequence;      // 投递顺序
+        uint32_t remainingMs;   // 剩余显示时间（只由消费者修改）
+    };
+
+    ToastQueue() : nextSequence(0), dropped(0), current(-1), shownSince(0) {
+        for (uint8_t i = 0; i < TOAST_SLOTS; i++) {
+            states[i].store(SLOT_FREE, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * 投递一条通知（任意任务，无锁）
+     * @param text 文本（超出 TOAST_TEXT_BYTES - 1 的部分截断）
+     * @param priority 优先级
+     * @param durationMs 显示时长
+     * @param icon 图标字形，0表示没有图标
+     * @return false 队列已满，通知被丢弃
+     */
+    bool post(const char* text, ToastPriority priority, uint32_t durationMs, uint16_t icon = 0) {
+        for (uint8_t i = 0; i < TOAST_SLOTS; i++) {
+            uint8_t expected = SLOT_FREE;
+            if (!states[i].compare_exchange_strong(expected, SLOT_WRITING, std::memory_order_acquire,
+                                                   std::memory_order_relaxed)) {
+                continue;
+            }
+            if (text == nullptr) {
+                text = "";
+            }
+            Toast& toast = slots[i];
+            size_t length = strlen(text);
+            if (length > TOAST_TEXT_BYTES - 1) {
+                length = TOAST_TEXT_BYTES - 1;
+            }
+            memcpy(toast.text, text, length);
+            toast.text[length] = '\0';
+            toast.icon = icon;
+            toast.priority = (uint8_t)priority;
+            toast.sequence = nextSequence.fetch_add(1, std::memory_order_relaxed);
+            toast.remainingMs = durationMs;
+            states[i].store(SLOT_READY, std::memory_order_release);
+            return true;
+        }
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /**
+     * 推进显示状态（渲染路径，单一消费者）：移除到期的通知，选出应显示的通知
+     * @param now 当前时间（毫秒）
+     * @return true 应显示的通知有变化（需要重新绘制覆盖内容）
+     */
+    bool update(uint32_t now) {
+        bool changed = false;
+
+        // 当前通知到期：释放槽位
+        if (current >= 0 && now - shownSince >= slots[current].remainingMs) {
+            states[current].store(SLOT_FREE, std::memory_order_release);
+            current = -1;
+            changed = true;
+        }
+
+        int8_t best = selectBest();
+        if (best != current) {
+            // 被更高优先级抢占的通知暂停计时
+            if (current >= 0) {
+                uint32_t shown = now - shownSince;
+                Toast& paused = slots[current];
+                paused.remainingMs = shown < paused.remainingMs ? paused.remainingMs - shown : 0;
+            }
+            current = best;
+            shownSince = now;
+            changed = true;
+        }
+        return changed;
+    }
+
+    /**
+     * 当前应显示的通知（渲染路径）
+     * @return nullptr 没有通知
+     */
+    const Toast* getCurrent() const {
+        return current >= 0 ? &slots[current] : nullptr;
+    }
+
+    /**
+     * 是否有就绪但尚未被 update 选中的通知（渲染路径，用于决定是否需要提前出帧）
+     */
+    bool hasPending() const {
+        return selectBest() != current;
+    }
+
+    /**
+     * 当前通知的剩余显示时间（渲染路径）
+     * @param now 当前时间（毫秒）
+     * @return 剩余毫秒数，没有通知时返回 0xFFFFFFFF
+     */
+    uint32_t getRemaining(uint32_t now) const {
+        if (current < 0) {
+            return 0xFFFFFFFFUL;
+        }
+        uint32_t shown = now - shownSince;
+        return shown < slots[current].remainingMs ? slots[current].remainingMs - shown : 0;
+    }
+
+    /**
+     * 因队列已满被丢弃的通知数
+     */
+    uint32_t getDropped() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    enum SlotState : uint8_t {
+        SLOT_FREE = 0,
+        SLOT_WRITING,
+        SLOT_READY
+    };
+
+    Toast slots[TOAST_SLOTS];
+    std::atomic<uint8_t> states[TOAST_SLOTS];
+    std::atomic<uint32_t> nextSequence;
+    std::atomic<uint32_t> dropped;
+
+    // 消费者状态
+    int8_t current;         // 正在显示的槽位，-1表示没有
+    uint32_t shownSince;    // 本次开始显示的时刻
+
+    /**
+     * 就绪的通知中优先级最高、同优先级中最早投递的一条
+     */
+    int8_t selectBest() const {
+        int8_t best = -1;
+        for (uint8_t i = 0; i < TOAST_SLOTS; i++) {
+            if (states[i].load(std::memory_order_acquire) != SLOT_READY) {
+                continue;
+            }
+            if (best < 0 || slots[i].priority > slots[best].priority ||
+                (slots[i].priority == slots[best].priority &&
+                 (int32_t)(slots[i].sequence - slots[best].sequence) < 0)) {
+                best = (int8_t)i;
+            }
+        }
+        return best;
+    }
+};
+
+#endif // TOAST_QUEUE_H
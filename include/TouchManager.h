@@ -1,8 +1,8 @@
 /**
  * 智能桌面伴侣 - 触摸管理器
  * 
- * 处理TTP223触摸传感器的输入，支持短按、长按和工厂重置检测
- * 实现防抖逻辑确保触摸输入的可靠性
+ * 处理TTP223触摸传感器的输入，支持按下、短按、长按和工厂重置检测
+ * 实现防抖逻辑确保触摸输入的可靠性，并由GPIO中断把按下的边沿时刻投递到事件总线
  */
 
 #ifndef TOUCH_MANAGER_H
@@ -10,9 +10,7 @@
 
 #include <Arduino.h>
 #include "config.h"
-
-// 触摸回调函数类型定义
-typedef void (*TouchCallback)(TouchEvent event);
+#include "AppEvents.h"
 
 /**
  * 触摸管理器类
@@ -20,8 +18,9 @@ typedef void (*TouchCallback)(TouchEvent event);
  * 负责：
  * - GPIO触摸状态读取
  * - 防抖处理（50ms）
+ * - 按下边沿时刻记录（GPIO中断投递 EVENT_TOUCH_EDGE，esp_timer微秒）
  * - 按压时长检测（短按/长按/工厂重置）
- * - 触摸事件回调机制
+ * - 触摸事件投递到事件总线
  */
 class TouchManager {
 public:
@@ -72,10 +71,18 @@ public:
     void clearEvent();
     
     /**
-     * 设置触摸事件回调函数
-     * @param callback 回调函数指针
+     * 设置事件总线：之后的触摸事件（带按下边沿时刻）投递到总线，由订阅者在自己的任务中处理；
+     * 边沿中断以 PRODUCER_TOUCH_ISR 投递 EVENT_TOUCH_EDGE，订阅它的任务（SUBSCRIBER_INPUT）由中断唤醒
+     * @param bus 事件总线
+     * @param producer 生产者编号（update() 所在的任务）
+     */
+    void setEventBus(AppEventBus* bus, uint8_t producer);
+    
+    /**
+     * 处理边沿中断投递的 EVENT_TOUCH_EDGE（调用 update() 的任务，在 update() 之前取出）
+     * @param event 边沿事件
      */
-    void setCallback(TouchCallback callback);
+    void handleEdge(const AppEvent& event);
     
     /**
      * 检查当前是否正在触摸
@@ -88,6 +95,29 @@ public:
      * @return 按压时间（毫秒），未按压时返回0
      */
     unsigned long getPressDuration();
+    
+    /**
+     * 获取最近一次按下的GPIO上升沿时刻
+     * 防抖确认按下（TOUCH_PRESS）时已经过去至少 TOUCH_DEBOUNCE_MS，
+     * 需要精确时刻的功能（如秒表）应使用这个时刻而不是事件处理的时刻
+     * @return esp_timer微秒
+     */
+    int64_t getPressEdgeMicros() const;
+    
+    /**
+     * 获取下一次需要轮询的时间
+     * 按下或防抖期间按 TOUCH_POLL_MS 轮询；未按下时由边沿中断唤醒，不需要轮询
+     * @param now 当前时间（毫秒）
+     * @return 剩余毫秒数，0表示应立即调用update，DEADLINE_NONE表示等待边沿中断
+     */
+    unsigned long getNextDeadline(unsigned long now) const;
+    
+    /**
+     * 记录设备被触摸引脚从light sleep唤醒的时刻
+     * 睡眠期间边沿中断不会触发，这一次按下的边沿时刻以唤醒时刻为准（已捕获到边沿时忽略）
+     * @param wakeMicros 唤醒时刻（esp_timer微秒）
+     */
+    void setWakeTime(int64_t wakeMicros);
 
 private:
     uint8_t _touchPin;              // 触摸传感器引脚
@@ -97,9 +127,12 @@ private:
     
     unsigned long _lastDebounceTime;    // 上次状态变化时间（用于防抖）
     unsigned long _pressStartTime;      // 按压开始时间
+    int64_t _pressEdgeMicros;           // 按压开始的GPIO边沿时刻
+    int64_t _edgeMicros;                // 最近取出的边沿时刻（0表示还没有取出）
     
     TouchEvent _currentEvent;       // 当前触摸事件
-    TouchCallback _callback;        // 回调函数指针
+    AppEventBus* _bus;              // 事件总线
+    uint8_t _producer;              // 在总线上的生产者编号
     
     bool _eventPending;             // 是否有待处理的事件
     bool _longPressTriggered;       // 长按是否已触发
@@ -2,7 +2,7 @@
  * 智能桌面伴侣 - WiFi管理器
  * 
  * 管理WiFi连接，支持自动连接和AP配网模式
- * 实现断线自动重连和连接状态回调
+ * 实现断线自动重连，连接状态变化投递到事件总线
  */
 
 #ifndef WIFI_MGR_H
@@ -16,6 +16,7 @@
 #endif
 
 #include "config.h"
+#include "AppEvents.h"
 
 // WiFi连接状态枚举
 enum WiFiConnectionState {
@@ -26,9 +27,6 @@ enum WiFiConnectionState {
     WIFI_STATE_FAILED               // 连接失败
 };
 
-// 连接状态回调函数类型
-typedef void (*WiFiStateCallback)(WiFiConnectionState state);
-
 /**
  * WiFi管理器类
  * 
@@ -36,7 +34,7 @@ typedef void (*WiFiStateCallback)(WiFiConnectionState state);
  * - 自动连接已保存的WiFi
  * - AP配网模式（连接超时后启动）
  * - 断线自动重连
- * - 连接状态指示器回调
+ * - 连接状态变化事件
  */
 class WiFiMgr {
 public:
@@ -98,10 +96,11 @@ public:
     WiFiConnectionState getState();
     
     /**
-     * 设置状态变化回调函数
-     * @param callback 回调函数指针
+     * 设置事件总线：之后的状态变化投递为 EVENT_WIFI 事件
+     * @param bus 事件总线
+     * @param producer 生产者编号（connect()/update() 所在的任务）
      */
-    void setStateCallback(WiFiStateCallback callback);
+    void setEventBus(AppEventBus* bus, uint8_t producer);
     
     /**
      * 获取重连尝试次数
@@ -118,10 +117,35 @@ public:
      * 断开WiFi连接
      */
     void disconnect();
+    
+    /**
+     * 关闭WiFi（长时间空闲时，之后设备可以进入light sleep）
+     * 主动关闭不投递断线事件，也不会触发重连；AP配网模式下不关闭
+     */
+    void suspend();
+    
+    /**
+     * 重新打开WiFi，用保存的凭据异步连接（连上后由update投递 WIFI_STATE_CONNECTED）
+     */
+    void resume();
+    
+    /**
+     * WiFi是否已被 suspend() 关闭
+     */
+    bool isSuspended() const;
+    
+    /**
+     * 获取下一次需要调用 update() 的时间
+     * 已连接时定期检查连接状态，断开时等待重连间隔，AP配网模式下等待配网超时
+     * @param now 当前时间（毫秒）
+     * @return 剩余毫秒数，0表示应立即调用update，DEADLINE_NONE表示不需要调用
+     */
+    unsigned long getNextDeadline(unsigned long now) const;
 
 private:
     WiFiConnectionState _state;             // 当前连接状态
-    WiFiStateCallback _stateCallback;       // 状态回调函数
+    AppEventBus* _bus;                      // 事件总线
+    uint8_t _producer;                      // 在总线上的生产者编号
     
     uint8_t _reconnectAttempts;             // 重连尝试次数
     unsigned long _lastReconnectTime;       // 上次重连时间
@@ -129,13 +153,14 @@ private:
     
     bool _apModeActive;                     // AP模式是否激活
     unsigned long _apModeStartTime;         // AP模式启动时间
+    bool _suspended;                        // 是否已被 suspend() 关闭
     
 #ifndef UNIT_TEST
     WiFiManager _wifiManager;               // WiFiManager实例
 #endif
     
     /**
-     * 更新连接状态并触发回调
+     * 更新连接状态并投递状态变化事件
      * @param newState 新状态
      */
     void setState(WiFiConnectionState newState);
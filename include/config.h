@@ -30,6 +30,10 @@
 #define I2S_SAMPLE_RATE     44100   // 采样率
 #define I2S_BITS_PER_SAMPLE 16      // 位深度
 #define DEFAULT_VOLUME      80      // 默认音量 (0-100)
+#define SPEAK_SYLLABLES     4       // 问候语的音节数（合成PCM经 playPcm 播放，表情口型随之开合）
+#define SPEAK_SYLLABLE_MS   120     // 每个音节的时长（后1/4为音节间的停顿）
+#define SPEAK_HOUR_FIRST    8       // 整点问候的时段（时间已同步时，这两个整点之间每小时说一次）
+#define SPEAK_HOUR_LAST     22
 
 // ============================================================================
 // I2S 麦克风配置 (INMP441)
@@ -60,6 +64,44 @@
 #define OLED_HEIGHT         64      // OLED高度（像素）
 #define DEFAULT_BRIGHTNESS  200     // 默认亮度 (0-255)
 
+// I2C超频：SSD1306标称最高400kHz（快速模式）。多数模块在更高的时钟下也能工作，
+// 但取决于屏幕的驱动芯片批次、走线和上拉电阻，必须逐块屏幕验证（长时间观察花屏、错位）后再开启
+#ifndef OLED_I2C_OVERCLOCK
+#define OLED_I2C_OVERCLOCK      0
+#endif
+#if OLED_I2C_OVERCLOCK
+#define OLED_I2C_CLOCK_HZ       800000  // 全屏变化的过渡帧约12ms
+#else
+#define OLED_I2C_CLOCK_HZ       400000  // I2C总线时钟（全屏变化的过渡帧约25ms）
+#endif
+
+// 显示刷新任务：1 = 双缓冲 + 独立FreeRTOS任务异步发送帧，0 = 在主循环中同步发送
+#ifndef DISPLAY_ASYNC_FLUSH
+#define DISPLAY_ASYNC_FLUSH     1
+#endif
+#define DISPLAY_TASK_STACK      3072    // 显示刷新任务栈大小（字节）
+#define DISPLAY_TASK_PRIORITY   2       // 显示刷新任务优先级（低于界面任务，高于网络和后台任务）
+
+// SSD1306硬件效果：1 = 睡眠呼吸和关屏渐暗由屏幕自行完成（期间CPU和I2C空闲），
+// 0 = 软件实现（兼容不支持0x23渐暗命令的屏幕）
+#ifndef OLED_HW_EFFECTS
+#define OLED_HW_EFFECTS         1
+#endif
+#define OLED_FRAME_HZ           100     // 屏幕刷新率（默认振荡器设置下约100Hz），用于换算硬件效果的步进
+#define OLED_OSC_FREQ           0x80    // 屏幕振荡器/时钟分频设置（0xD5命令参数，U8g2初始化默认值）
+
+// 灰度模式：2位灰度精灵拆成3个位平面，由定时器锁定速率轮流发送（需要 DISPLAY_ASYNC_FLUSH）
+// 每个平面要在一个节拍内发完：400kHz下约每毫秒40字节（64x64精灵的灰度tile约400字节，约10ms）
+#if OLED_I2C_OVERCLOCK
+#define GRAY_PLANE_HZ           150     // 位平面速率（完整灰度周期 150 / 3 = 50Hz）
+#define GRAY_I2C_CLOCK_HZ       1000000 // 灰度模式下的I2C总线时钟（超频，同样须逐块屏幕验证）
+#else
+#define GRAY_PLANE_HZ           75      // 位平面速率（完整灰度周期 25Hz，能看到轻微闪烁）
+#define GRAY_I2C_CLOCK_HZ       400000  // 灰度模式下的I2C总线时钟
+#endif
+#define GRAY_OSC_FREQ           0xF0    // 灰度模式下的振荡器设置（提高屏幕扫描率，减轻与平面速率的拍频）
+#define GRAY_TASK_PRIORITY      5       // 灰度模式下刷新任务的优先级（减小平面节拍抖动）
+
 // ============================================================================
 // 触摸检测时间配置 (毫秒)
 // ============================================================================
@@ -67,6 +109,8 @@
 #define SHORT_PRESS_MAX_MS      500     // 短按最大时间
 #define LONG_PRESS_MIN_MS       2000    // 长按最小时间
 #define FACTORY_RESET_MIN_MS    10000   // 工厂重置最小时间
+#define TOUCH_POLL_MS           10      // 按下和防抖期间的轮询间隔（未按下时由边沿中断唤醒）
+#define TOUCH_IDLE_POLL_MS      200     // 自动light sleep时未按下的兜底轮询（睡眠期间边沿中断可能丢失）
 
 // ============================================================================
 // 屏幕保护配置 (秒)
@@ -81,6 +125,7 @@
 #define WIFI_RECONNECT_INTERVAL_MS  5000    // 重连间隔
 #define WIFI_MAX_RECONNECT_ATTEMPTS 3       // 最大重连次数
 #define AP_CONFIG_TIMEOUT_SEC       300     // AP配网超时 (5分钟)
+#define WIFI_STATUS_CHECK_MS        1000    // 已连接时检查连接状态的间隔
 
 // ============================================================================
 // NTP时间配置
@@ -96,7 +141,68 @@
 #define BLINK_INTERVAL_MIN_MS   3000    // 眨眼最小间隔
 #define BLINK_INTERVAL_MAX_MS   8000    // 眨眼最大间隔
 #define BLINK_DURATION_MS       150     // 眨眼动画持续时间
-#define ANIMATION_FRAME_MS      50      // 动画帧间隔
+#define ANIMATION_FRAME_MS      30      // 动画帧间隔（眼睛参数按此帧率插值）
+#define FACE_STREAM_POOL_BYTES  4096    // 空闲动画预计算增量流的存储区大小（实际约2.6KB）
+#define PARTICLE_BUDGET_US      800     // 粒子效果每帧（更新 + 绘制）的CPU预算，同时存在的粒子数量据此换算
+#define PARTICLE_SLEEP_MS       10000   // 进入睡眠后飘落 "z" 的时长（之后只保留静态画面）
+#define PARTICLE_Z_INTERVAL_MS  900     // 睡眠时发射 "z" 的间隔
+
+// ============================================================================
+// 帧调度配置 (毫秒)
+// ============================================================================
+#define CLOCK_FRAME_MS          100     // 时钟模式最小帧间隔
+#define SYSINFO_FRAME_MS        1000    // 系统信息模式刷新间隔 (1Hz)
+#define SLEEP_FRAME_MS          1000    // 睡眠模式最小帧间隔
+#define TRANSITION_FRAME_MS     20      // 过渡动画帧间隔 (50fps)
+#define STOPWATCH_FRAME_MS      25      // 秒表模式帧间隔 (40fps，百分之一秒位每帧都变化)
+#define TRANSITION_FRAME_BUDGET_US  4000    // 过渡动画每帧合成的CPU预算（微秒）
+#define DEADLINE_NONE           0xFFFFFFFFUL    // 没有待处理的截止时间
+
+// ============================================================================
+// 睡眠显示配置
+// ============================================================================
+#define SLEEP_BREATH_STEP_MS    250     // 呼吸效果对比度步进间隔
+#define SLEEP_BREATH_STEPS      8       // 半个呼吸周期的步数（周期 = 2 x 8 x 250ms = 4秒）
+#define SLEEP_BREATH_MIN        4       // 呼吸最暗对比度
+#define SLEEP_BREATH_MAX        64      // 呼吸最亮对比度
+#define SLEEP_PANEL_OFF_SEC     300     // 进入睡眠后关闭屏幕和电荷泵的时间
+#define SLEEP_FADE_FRAMES       64      // 硬件呼吸/渐暗每级亮度的屏幕帧数（8-128）
+#define SLEEP_FADE_OUT_MS       3000    // 关屏前等待硬件渐暗完成的时间
+
+// ============================================================================
+// 文本显示配置
+// ============================================================================
+#define TEXT_MAX_BYTES          512     // 单条消息最大字节数
+#define TEXT_LINE_HEIGHT        16      // 行高（2页，行与页对齐）
+#define TEXT_BASELINE           12      // 行内基线位置
+#define TEXT_MARGIN             2       // 左右边距
+#define TEXT_CACHE_PAGES        24      // 文本位图缓存页数 (192行 = 12行文字，3KB)
+#define TEXT_SCROLL_FRAME_MS    40      // 每滚动1像素的间隔
+#define TEXT_SCROLL_PAUSE_MS    1500    // 滚动到首尾时的停顿
+#define TEXT_MARQUEE_GAP        32      // 跑马灯首尾间隔（像素）
+#define TEXT_CJK_TOP            1       // 中文字形在行内的顶端位置
+#define FONT_PARTITION_LABEL    "font"  // 中文字库分区名（见 partitions.csv）
+
+// ============================================================================
+// 秒表配置
+// ============================================================================
+#define STOPWATCH_COUNTDOWN_SEC 180     // 长按切换到倒计时时的时长
+#define STOPWATCH_BLINK_MS      500     // 倒计时结束后数字闪烁的半周期
+
+// ============================================================================
+// 通知配置
+// ============================================================================
+#define TOAST_DEFAULT_MS        2000    // 通知默认显示时长
+#define TOAST_PAGE              6       // 通知栏起始页（屏幕底部）
+#define TOAST_PAGES             2       // 通知栏占用页数（16行）
+#define TOAST_ICON_WIFI         0x0048  // open_iconic_www_1x 字体中的WiFi图标
+#define TOAST_MAX_CHARS         20      // 通知栏一行可容纳的字符数（6x10西文字体），更长或含中文的消息用文本模式显示
+#define FACTORY_RESET_NOTICE_MS 500     // 工厂重置前显示提示的时间
+
+// ============================================================================
+// 表情包配置
+// ============================================================================
+#define EXPRESSION_PARTITION_LABEL  "expr"  // 表情包分区名（见 partitions.csv）
 
 // ============================================================================
 // 系统监控配置
@@ -104,6 +210,41 @@
 #define LOW_MEMORY_THRESHOLD_BYTES  10240   // 低内存警告阈值 (10KB)
 #define CRITICAL_MEMORY_BYTES       5120    // 临界内存阈值 (5KB)
 
+// ============================================================================
+// 任务配置
+// ============================================================================
+// 1 = 输入/界面/音频/网络/后台五个FreeRTOS任务，通过事件总线通信；0 = 单个协作式 loop()（用于对比延迟）
+#ifndef APP_RTOS_TASKS
+#define APP_RTOS_TASKS          1
+#endif
+#define INPUT_TASK_STACK        2048    // 触摸轮询（回调只投递事件）
+#define INPUT_TASK_PRIORITY     6       // 最高：工作量只有几微秒，保证按下边沿和防抖的时序
+#define AUDIO_TASK_STACK        3072    // 音效合成缓冲在栈上（约1KB）
+#define AUDIO_TASK_PRIORITY     4       // 高于界面：I2S DMA缓冲（8 x 64帧，约11ms）不能断流
+#define UI_TASK_STACK           6144    // 模式逻辑、渲染和合成（U8g2绘制、文本排版）
+#define UI_TASK_PRIORITY        3
+#define NETWORK_TASK_STACK      8192    // WiFi连接/配网门户、NTP同步、HTTPS请求
+#define NETWORK_TASK_PRIORITY   1       // 最低：连接和同步可以阻塞数秒
+#define HOUSEKEEPING_TASK_STACK 3072    // 系统监控、状态汇总、统计输出
+#define HOUSEKEEPING_TASK_PRIORITY  1
+#define SLEEP_TASK_STACK        2048    // 关屏后进入light sleep（与空闲任务同优先级，只在其他任务都阻塞时运行）
+#define TASK_REPORT_INTERVAL_MS 60000   // 输出延迟统计、空闲比例和任务栈余量的间隔
+
+// ============================================================================
+// 空闲配置
+// ============================================================================
+#define IDLE_MAX_WAIT_MS        1000    // 单次空闲等待的上限（所有模块都没有截止时间时也按此醒来）
+// 1 = 空闲时进入light sleep：睡眠模式关屏后关闭WiFi，用 esp_light_sleep_start 睡到下一个截止时间，
+//     由定时器或触摸引脚的高电平唤醒（多任务时由最低优先级的睡眠任务在其他任务都阻塞时进入）；
+//     SDK开启电源管理和tickless idle时改用自动light sleep（保持WiFi）。
+//     light sleep期间USB串口断开，调试时可设为0
+#ifndef IDLE_LIGHT_SLEEP
+#define IDLE_LIGHT_SLEEP        1
+#endif
+#define LIGHT_SLEEP_MIN_MS      20      // 距下一个截止时间不足此值时只阻塞等待（进入和唤醒约需1ms）
+#define PM_MAX_FREQ_MHZ         160     // 自动light sleep的CPU频率范围
+#define PM_MIN_FREQ_MHZ         40
+
 // ============================================================================
 // 显示模式枚举
 // ============================================================================
@@ -112,6 +253,8 @@ enum DisplayMode {
     MODE_CLOCK,         // 时钟模式
     MODE_SYSINFO,       // 系统信息模式
     MODE_SLEEP,         // 睡眠模式
+    MODE_TEXT,          // 文本消息模式（不参与循环切换）
+    MODE_STOPWATCH,     // 秒表/倒计时模式
     MODE_COUNT          // 模式总数（用于循环）
 };
 
@@ -131,7 +274,8 @@ enum TouchEvent {
     TOUCH_NONE = 0,         // 无事件
     TOUCH_SHORT,            // 短按
     TOUCH_LONG,             // 长按
-    TOUCH_FACTORY_RESET     // 工厂重置
+    TOUCH_FACTORY_RESET,    // 工厂重置
+    TOUCH_PRESS             // 按下（防抖确认后立即触发，之后仍会有短按/长按事件）
 };
 
 // ============================================================================
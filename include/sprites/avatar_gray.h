@@ -0,0 +1,82 @@
+/**
+ * 由 tools/make_gray_sprite.py 从 tools/avatar.pgm 生成，请勿手工修改
+ */
+
+#ifndef AVATAR_GRAY_H
+#define AVATAR_GRAY_H
+
+#include "GrayPlanes.h"
+
+static const uint8_t AVATAR_HI[512] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x80, 0xC0, 0xC0, 0xE0, 0xE0, 0xE0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF8, 0xF8, 0xF8, 0xF8, 0xF8,
+    0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0xF0, 0xF0, 0xF0, 0xF0, 0xE0, 0xE0, 0xE0, 0xC0, 0xC0, 0x80, 0x80,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC, 0xFE, 0xFE, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFB,
+    0xFF, 0xD6, 0xAE, 0x6C, 0x98, 0x30, 0xE0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xE0, 0xF8, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0x3F, 0xFF, 0xFF,
+    0xFF, 0xB6, 0x6D, 0xDB, 0x24, 0xDB, 0x00, 0x49, 0x03, 0x0E, 0x78, 0xE0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xF0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x01, 0x00, 0x07, 0x07, 0x07, 0x00, 0x00, 0x00, 0x00, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x00, 0x07, 0x07, 0x07, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0xEE, 0x1B, 0xE5, 0x1A, 0x25, 0x42, 0x08, 0x02, 0x00, 0x00, 0x00, 0x03, 0xFF, 0xF0, 0x00, 0x00,
+    0x00, 0x00, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F, 0x7F, 0x9F, 0x5F, 0x5F, 0x9F, 0x3F,
+    0x7F, 0xBE, 0xF8, 0xF8, 0xF8, 0x78, 0x78, 0x78, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xBE, 0x78, 0x58, 0x28, 0xF8, 0x08, 0x70, 0x8A, 0x55,
+    0x2A, 0x01, 0x2A, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x3F, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x03, 0x1F, 0x7F, 0xDF, 0x6F, 0xBF, 0x7F, 0xBE, 0xFE, 0x7D, 0xFC, 0xFE, 0x7D,
+    0xFE, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0x7E, 0xFC, 0x78, 0xF1, 0xB3, 0xE3, 0xA7, 0x67, 0x87, 0x47,
+    0xC7, 0x07, 0x63, 0x87, 0x23, 0x52, 0x21, 0x88, 0x10, 0x26, 0x08, 0x05, 0x22, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x78, 0x1F, 0x03, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03, 0x0E, 0x1D, 0x32, 0x65, 0xC3, 0x8C, 0x93, 0x05,
+    0x2B, 0x16, 0x09, 0x16, 0x23, 0x0E, 0x11, 0x4F, 0x01, 0x16, 0x09, 0x26, 0x01, 0x0A, 0x25, 0x02,
+    0x11, 0x04, 0x01, 0x04, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x80, 0x80, 0xC0, 0x60, 0x30, 0x1C, 0x0E, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x03,
+    0x06, 0x04, 0x0C, 0x08, 0x18, 0x18, 0x10, 0x30, 0x30, 0x20, 0x20, 0x60, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x60, 0x60, 0x20, 0x20, 0x30, 0x30, 0x10, 0x18, 0x18, 0x08, 0x0C, 0x04, 0x06,
+    0x03, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const uint8_t AVATAR_LO[512] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x80, 0xC0, 0xC0, 0xE0, 0xE0, 0x60, 0xF0, 0xB0, 0xF0, 0xD0, 0xB8, 0x78, 0xD8, 0xB8, 0xD8,
+    0xB8, 0x58, 0xB8, 0x58, 0x98, 0x50, 0x90, 0x30, 0xB0, 0x20, 0x60, 0x60, 0x40, 0xC0, 0x80, 0x80,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xE0, 0xF0, 0x78, 0xFC, 0xDE, 0xFE, 0xEF,
+    0xFF, 0xFB, 0xFF, 0xFE, 0xFF, 0xFF, 0xFB, 0xFF, 0xFF, 0xDE, 0xFB, 0xFF, 0xED, 0xBF, 0xFA, 0x6F,
+    0xDA, 0xB7, 0x6C, 0xDB, 0xA4, 0x5B, 0xA4, 0x5A, 0xA0, 0x0A, 0xA0, 0x08, 0x40, 0x00, 0x00, 0x05,
+    0x03, 0x2E, 0x56, 0x9C, 0x78, 0xF0, 0xE0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xE0, 0xF8, 0x5E, 0xB7, 0xFF, 0x6D, 0xFF, 0xF7, 0xFF, 0xBF, 0xFF, 0xFF,
+    0xBF, 0xFF, 0x1F, 0x3F, 0x3F, 0x3F, 0x2F, 0x3E, 0xFF, 0xB7, 0xFF, 0xBA, 0xEF, 0xBF, 0x6A, 0xDF,
+    0xB3, 0x5E, 0xB3, 0x4E, 0xB1, 0x4E, 0xB1, 0x06, 0x28, 0x15, 0x00, 0x12, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x49, 0x92, 0x24, 0xDB, 0x24, 0xFF, 0xB7, 0xFF, 0xFE, 0xF8, 0xE0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xF0, 0xFF, 0x0B, 0xF6, 0x15, 0xEF, 0xB5, 0x5B, 0xEF, 0xBE, 0x6B, 0xBF, 0xED, 0xBF,
+    0x01, 0x00, 0x07, 0x07, 0x07, 0x00, 0x00, 0x00, 0x00, 0x01, 0xEE, 0x1B, 0xE6, 0x3D, 0xC3, 0x3E,
+    0x41, 0x9F, 0x20, 0x4B, 0x24, 0x89, 0x00, 0x00, 0x07, 0x07, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x11, 0xE4, 0x1A, 0xE5, 0xDA, 0xBD, 0xF7, 0xFD, 0xFF, 0xFF, 0xAF, 0xFB, 0xFF, 0xF0, 0x00, 0x00,
+    0x00, 0x00, 0x3F, 0xFF, 0x00, 0x15, 0x02, 0x2C, 0x83, 0xEC, 0x93, 0x6E, 0xB1, 0xAF, 0x70, 0xCF,
+    0x8A, 0x72, 0x08, 0xB0, 0x48, 0x10, 0x28, 0x40, 0x1A, 0x44, 0x13, 0x24, 0x89, 0x12, 0x44, 0x01,
+    0x0A, 0x00, 0x01, 0x04, 0x00, 0x00, 0x00, 0x40, 0x00, 0x20, 0x50, 0x00, 0xF0, 0x88, 0x74, 0xAA,
+    0xD5, 0xFE, 0xD5, 0xFF, 0xFE, 0xFF, 0xFF, 0xBF, 0xEF, 0x5B, 0xFE, 0xD5, 0xFF, 0x3F, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x03, 0x1F, 0x78, 0xE0, 0x90, 0x40, 0x80, 0x41, 0x01, 0x82, 0x03, 0x01, 0x82,
+    0x01, 0x03, 0x00, 0x00, 0x02, 0x00, 0x80, 0x00, 0x80, 0x00, 0x41, 0x00, 0x40, 0x80, 0x40, 0x80,
+    0x00, 0xC0, 0x84, 0x60, 0xC0, 0xA1, 0xD0, 0x70, 0xEC, 0xD8, 0xF7, 0xFA, 0xDD, 0xFE, 0xFF, 0xFF,
+    0x7F, 0xFF, 0x5F, 0xFF, 0x57, 0xFD, 0x56, 0xFF, 0x55, 0xFF, 0x7A, 0x1F, 0x03, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03, 0x0F, 0x1E, 0x3D, 0x7A, 0xFC, 0xF3, 0xEC, 0xFA,
+    0xD4, 0xE9, 0xF6, 0xE9, 0xDC, 0xF1, 0xEE, 0xB0, 0xFE, 0xE9, 0xF6, 0xD9, 0xFE, 0xF5, 0xDA, 0xFD,
+    0xEE, 0xFB, 0x7E, 0xFB, 0xFE, 0xBF, 0xFD, 0x5F, 0xFF, 0xAF, 0xFF, 0x57, 0xFF, 0x5B, 0xF6, 0x5F,
+    0xF5, 0xDF, 0xF5, 0xDF, 0x75, 0x3F, 0x1D, 0x0F, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x03,
+    0x07, 0x07, 0x0F, 0x0F, 0x1B, 0x1F, 0x1F, 0x3B, 0x3F, 0x37, 0x3B, 0x7F, 0x77, 0x7D, 0x6B, 0x7F,
+    0x6A, 0x7F, 0x75, 0x7F, 0x76, 0x3D, 0x37, 0x3D, 0x3F, 0x1A, 0x1F, 0x1D, 0x0F, 0x0D, 0x07, 0x07,
+    0x03, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const GraySprite AVATAR = {64, 8, AVATAR_HI, AVATAR_LO};
+
+#endif // AVATAR_GRAY_H
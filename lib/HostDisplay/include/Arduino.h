@@ -0,0 +1,54 @@
+/**
+ * 智能桌面伴侣 - 主机端 Arduino 子集
+ *
+ * 只用于native环境：提供渲染器用到的时间、随机数和串口输出，
+ * 时间由测试手动推进（hostSetMillis / hostAdvanceMillis），渲染结果与运行快慢无关
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#define PROGMEM
+#define IRAM_ATTR
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+int analogRead(uint8_t pin);
+
+/**
+ * 串口输出到标准输出
+ */
+class HostSerial {
+public:
+    void begin(unsigned long baud) {}
+    size_t print(const char* text);
+    size_t println(const char* text = "");
+    int printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+extern HostSerial Serial;
+
+/**
+ * 主机时钟：设置当前时间（毫秒，micros同步为 ms * 1000）
+ */
+void hostSetMillis(unsigned long ms);
+
+/**
+ * 主机时钟：向前推进
+ */
+void hostAdvanceMillis(unsigned long ms);
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,54 @@
+/**
+ * 智能桌面伴侣 - 主机端无头显示
+ *
+ * 只用于native环境：HostDisplay 使用U8g2的SSD1306 128x64全缓冲配置，
+ * 字节/GPIO回调为空操作，绘制结果只保存在内存中的页格式帧缓冲里（与设备上完全相同的光栅化代码）。
+ * HostSnapshot 把帧缓冲保存为PBM图片并与基准图片逐像素比较，用于渲染回归测试
+ */
+
+#ifndef HOST_DISPLAY_H
+#define HOST_DISPLAY_H
+
+#include <U8g2lib.h>
+#include <stdint.h>
+
+class HostDisplay : public U8G2 {
+public:
+    HostDisplay();
+
+private:
+    // 与DisplayManager一样使用4字节对齐的帧缓冲（FrameBuffer按32位字合成）
+    uint8_t buffer[128 * 64 / 8] __attribute__((aligned(4)));
+};
+
+namespace HostSnapshot {
+    const uint8_t WIDTH = 128;
+    const uint8_t HEIGHT = 64;
+    const uint16_t FRAME_BYTES = WIDTH * HEIGHT / 8;
+
+    /**
+     * 读取页格式帧缓冲中的像素
+     */
+    inline bool pixel(const uint8_t* frame, uint8_t x, uint8_t y) {
+        return (frame[(y >> 3) * WIDTH + x] >> (y & 7)) & 1;
+    }
+
+    /**
+     * 保存为二进制PBM（P4，点亮的像素为黑色）
+     * @return false 文件无法写入
+     */
+    bool writePbm(const char* path, const uint8_t* frame);
+
+    /**
+     * 读取二进制PBM到页格式帧缓冲（尺寸必须为128x64）
+     * @return false 文件不存在或格式不符
+     */
+    bool readPbm(const char* path, uint8_t* frame);
+
+    /**
+     * 两帧之间不同的像素数
+     */
+    uint16_t diffPixels(const uint8_t* a, const uint8_t* b);
+}
+
+#endif // HOST_DISPLAY_H
@@ -0,0 +1,89 @@
+/**
+ * 智能桌面伴侣 - 主机端 Arduino 子集实现
+ */
+
+#include "Arduino.h"
+#include "esp_partition.h"
+#include <stdarg.h>
+
+HostSerial Serial;
+
+// 主机时钟（微秒），只由测试推进
+static uint64_t hostMicros = 0;
+
+// 随机数状态（固定的线性同余生成器，不同平台结果一致）
+static uint32_t hostRandomState = 1;
+
+unsigned long millis() {
+    return (unsigned long)(hostMicros / 1000);
+}
+
+unsigned long micros() {
+    return (unsigned long)hostMicros;
+}
+
+void delay(unsigned long ms) {
+    hostMicros += (uint64_t)ms * 1000;
+}
+
+void hostSetMillis(unsigned long ms) {
+    hostMicros = (uint64_t)ms * 1000;
+}
+
+void hostAdvanceMillis(unsigned long ms) {
+    hostMicros += (uint64_t)ms * 1000;
+}
+
+long random(long howbig) {
+    if (howbig <= 0) {
+        return 0;
+    }
+    hostRandomState = hostRandomState * 1103515245u + 12345u;
+    return (long)((hostRandomState >> 1) % (uint32_t)howbig);
+}
+
+long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) {
+        return howsmall;
+    }
+    return howsmall + random(howbig - howsmall);
+}
+
+void randomSeed(unsigned long seed) {
+    hostRandomState = (uint32_t)seed;
+}
+
+int analogRead(uint8_t pin) {
+    return 0;
+}
+
+size_t HostSerial::print(const char* text) {
+    return (size_t)fputs(text, stdout);
+}
+
+size_t HostSerial::println(const char* text) {
+    return print(text) + (size_t)fputs("\n", stdout);
+}
+
+int HostSerial::printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int written = vprintf(format, args);
+    va_end(args);
+    return written;
+}
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label) {
+    return nullptr;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t* partition, size_t offset, void* dst, size_t size) {
+    return ESP_FAIL;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t* partition, size_t offset, size_t size,
+                             esp_partition_mmap_memory_t memory, const void** out_ptr,
+                             esp_partition_mmap_handle_t* out_handle) {
+    return ESP_FAIL;
+}
@@ -0,0 +1,81 @@
+/**
+ * 智能桌面伴侣 - 主机端无头显示实现
+ */
+
+#include "HostDisplay.h"
+#include <stdio.h>
+#include <string.h>
+
+HostDisplay::HostDisplay() {
+    // 与设备相同的全缓冲配置；没有总线，字节和GPIO回调都是空操作
+    u8g2_Setup_ssd1306_128x64_noname_f(getU8g2(), U8G2_R0, u8x8_byte_empty, u8x8_dummy_cb);
+    getU8g2()->tile_buf_ptr = buffer;
+    clearBuffer();
+}
+
+namespace HostSnapshot {
+
+bool writePbm(const char* path, const uint8_t* frame) {
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    fprintf(file, "P4\n%u %u\n", WIDTH, HEIGHT);
+
+    // PBM按行存放，每字节8个像素（高位在左）
+    uint8_t row[WIDTH / 8];
+    for (uint8_t y = 0; y < HEIGHT; y++) {
+        memset(row, 0, sizeof(row));
+        for (uint8_t x = 0; x < WIDTH; x++) {
+            if (pixel(frame, x, y)) {
+                row[x >> 3] |= (uint8_t)(0x80 >> (x & 7));
+            }
+        }
+        fwrite(row, 1, sizeof(row), file);
+    }
+
+    bool ok = ferror(file) == 0;
+    fclose(file);
+    return ok;
+}
+
+bool readPbm(const char* path, uint8_t* frame) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    unsigned width = 0, height = 0;
+    bool ok = fscanf(file, "P4 %u %u", &width, &height) == 2 && width == WIDTH && height == HEIGHT &&
+              fgetc(file) != EOF;
+
+    memset(frame, 0, FRAME_BYTES);
+    uint8_t row[WIDTH / 8];
+    for (uint8_t y = 0; ok && y < HEIGHT; y++) {
+        if (fread(row, 1, sizeof(row), file) != sizeof(row)) {
+            ok = false;
+            break;
+        }
+        for (uint8_t x = 0; x < WIDTH; x++) {
+            if (row[x >> 3] & (0x80 >> (x & 7))) {
+                frame[(y >> 3) * WIDTH + x] |= (uint8_t)(1 << (y & 7));
+            }
+        }
+    }
+
+    fclose(file);
+    return ok;
+}
+
+uint16_t diffPixels(const uint8_t* a, const uint8_t* b) {
+    uint16_t count = 0;
+    for (uint16_t i = 0; i < FRAME_BYTES; i++) {
+        uint8_t diff = a[i] ^ b[i];
+        while (diff != 0) {
+            diff &= (uint8_t)(diff - 1);
+            count++;
+        }
+    }
+    return count;
+}
+
+}
@@ -12,7 +12,9 @@ AudioManager::AudioManager()
     : volume(DEFAULT_VOLUME)
     , muted(false)
     , playing(false)
-    , initialized(false) {
+    , initialized(false)
+    , queuedEnvelope()
+    , queuedSamples(0) {
 }
 
 bool AudioManager::begin() {
@@ -90,20 +92,69 @@ void AudioManager::playTone(uint16_t frequency, uint16_t duration) {
         }
         
         // 写入 I2S
-        size_t bytesWritten;
-        i2s_write(I2S_PORT, buffer, samplesToWrite * 4, &bytesWritten, portMAX_DELAY);
+        writeI2S(buffer, samplesToWrite);
         
         samplesWritten += samplesToWrite;
     }
     
     // 短暂静音，避免爆音
     memset(buffer, 0, sizeof(buffer));
-    size_t bytesWritten;
-    i2s_write(I2S_PORT, buffer, sizeof(buffer), &bytesWritten, portMAX_DELAY);
+    writeI2S(buffer, bufferSize);
+    
+    finishEnvelope();
+    playing = false;
+}
+
+void AudioManager::playPcm(const int16_t* samples, size_t count) {
+    if (!initialized || muted || samples == nullptr) return;
+    
+    playing = true;
+    
+    const size_t bufferSize = 256;
+    int16_t buffer[bufferSize * 2];  // 立体声，左右声道
+    
+    for (size_t offset = 0; offset < count && playing; offset += bufferSize) {
+        size_t samplesToWrite = min(count - offset, bufferSize);
+        for (size_t i = 0; i < samplesToWrite; i++) {
+            int16_t value = (int16_t)((int32_t)samples[offset + i] * volume / 100);
+            buffer[i * 2] = value;
+            buffer[i * 2 + 1] = value;
+        }
+        writeI2S(buffer, samplesToWrite);
+    }
     
+    finishEnvelope();
     playing = false;
 }
 
+void AudioManager::writeI2S(int16_t* buffer, size_t samples) {
+    // 按写入的这一块计算包络（定点，只取左声道），256个样本约5.8ms
+    LipSync::Envelope measured = LipSync::measure(buffer, samples, 2, 0);
+    
+    size_t bytesWritten;
+    i2s_write(I2S_PORT, buffer, samples * 4, &bytesWritten, portMAX_DELAY);
+    
+    // 这一块排在DMA缓冲（8 x 64帧，约11.6ms）中上一块之后；写入返回时DMA刚放出一块的空间，
+    // 上一块开始播放，所以包络晚一块发布，嘴型与听到的声音同步
+    if (queuedSamples > 0) {
+        queuedEnvelope.time = (uint16_t)millis();
+        envelope.publish(queuedEnvelope);
+    }
+    queuedEnvelope = measured;
+    queuedSamples = samples;
+}
+
+void AudioManager::finishEnvelope() {
+    // 最后一块此时开始播放：发布它的包络，播完后再清除（嘴巴闭合）
+    if (queuedSamples > 0) {
+        queuedEnvelope.time = (uint16_t)millis();
+        envelope.publish(queuedEnvelope);
+        delay(queuedSamples * 1000 / I2S_SAMPLE_RATE);
+        queuedSamples = 0;
+    }
+    envelope.clear();
+}
+
 void AudioManager::playMelody(const uint16_t* notes, const uint16_t* durations, uint8_t count) {
     if (!initialized || muted) return;
     
@@ -175,7 +226,56 @@ void AudioManager::playSound(SoundEffect effect) {
             playMelody(notes, durations, 3);
             break;
         }
+        
+        case SOUND_GREETING:
+            playGreeting();
+            break;
+    }
+}
+
+void AudioManager::playGreeting() {
+    if (!initialized || muted) return;
+    
+    // 一个音节的PCM（约10KB）在堆上，逐个音节合成后播放
+    const size_t syllableSamples = (size_t)I2S_SAMPLE_RATE * SPEAK_SYLLABLE_MS / 1000;
+    const size_t voiced = syllableSamples * 3 / 4;
+    const size_t attack = voiced / 8;
+    int16_t* pcm = (int16_t*)malloc(syllableSamples * sizeof(int16_t));
+    if (pcm == nullptr) return;
+    
+    // 一个周期的波形表：基频加两个谐波，近似元音的音色（逐样本只查表，不计算sin）
+    // 第一次说话时生成，之后直接使用（只在音频任务中调用）
+    static int16_t wave[256];
+    static bool waveReady = false;
+    if (!waveReady) {
+        for (int i = 0; i < 256; i++) {
+            float phase = 2.0f * M_PI * i / 256;
+            float sample = (sin(phase) + 0.5f * sin(2 * phase) + 0.25f * sin(3 * phase)) / 1.75f;
+            wave[i] = (int16_t)(sample * 20000.0f);
+        }
+        waveReady = true;
     }
+    
+    // 问候的语调：上扬后回落
+    const uint16_t pitches[] = {260, 330, 290, 220};
+    for (uint8_t s = 0; s < SPEAK_SYLLABLES && !muted; s++) {
+        uint32_t phase = 0;
+        uint32_t step = (uint32_t)(((uint64_t)pitches[s % 4] << 32) / I2S_SAMPLE_RATE);
+        for (size_t i = 0; i < syllableSamples; i++) {
+            // 包络：线性起音和衰减（Q8），音节末尾为停顿
+            int32_t gain = 0;
+            if (i < attack) {
+                gain = (int32_t)(i * 256 / attack);
+            } else if (i < voiced) {
+                gain = (int32_t)((voiced - i) * 256 / (voiced - attack));
+            }
+            pcm[i] = (int16_t)(wave[phase >> 24] * gain / 256);
+            phase += step;
+        }
+        playPcm(pcm, syllableSamples);
+    }
+    
+    free(pcm);
 }
 
 void AudioManager::setVolume(uint8_t vol) {
@@ -193,5 +293,6 @@ void AudioManager::stop() {
     if (initialized) {
         i2s_zero_dma_buffer(I2S_PORT);
     }
+    envelope.clear();
     playing = false;
 }
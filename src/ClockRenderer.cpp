@@ -3,6 +3,7 @@
  */
 
 #include "ClockRenderer.h"
+#include <stdlib.h>
 
 // 迷你表情图标位图 (16x16 像素)
 const uint8_t MINI_FACE[] PROGMEM = {
@@ -19,7 +20,24 @@ ClockRenderer::ClockRenderer()
     , currentYear(2024)
     , currentMonth(1)
     , currentDay(1)
-    , isOffline(false) {
+    , isOffline(false)
+    , dirty(true)
+    , lastSecondTick(0)
+    , staticVersion(0)
+    , face(CLOCK_FACE_DIGITAL)
+    , handsDrawn(false)
+    , glyphsReady(false)
+    , timePage(0)
+    , timePages(0)
+    , timeX0(0)
+    , timeX1(0)
+    , lastRedrawnChars(0) {
+    memset(glyphWidth, 0, sizeof(glyphWidth));
+    memset(charX, 0, sizeof(charX));
+    memset(lastChars, 0, sizeof(lastChars));
+    memset(changedTiles, 0, sizeof(changedTiles));
+    memset(handTiles, 0, sizeof(handTiles));
+    memset(renderMicros, 0, sizeof(renderMicros));
 }
 
 void ClockRenderer::init() {
@@ -59,22 +77,171 @@ char* ClockRenderer::formatDate(uint16_t year, uint8_t month, uint8_t day, char*
 void ClockRenderer::render(U8G2* display) {
     if (display == nullptr) return;
     
+    unsigned long start = micros();
+    uint8_t* frame = display->getBufferPtr();
+    memset(changedTiles, 0, sizeof(changedTiles));
+    
+    if (face == CLOCK_FACE_ANALOG) {
+        renderAnalog(frame);
+    } else {
+        renderDigital(frame, display);
+    }
+    
+    renderMicros[face] = micros() - start;
+    dirty = false;
+}
+
+void ClockRenderer::renderDigital(uint8_t* frame, U8G2* display) {
+    // 首次渲染时建立字形条（需要U8g2计算字体度量）
+    if (!glyphsReady && !buildGlyphStrip(display)) {
+        return;
+    }
+    
     char timeBuffer[9];
-    char dateBuffer[11];
     
-    // 格式化时间和日期
+    // 格式化时间
     formatTime(currentHour, currentMinute, currentSecond, timeBuffer);
+    
+    // 只把变化的字符从字形条复制到时间行缓存
+    uint8_t redrawn = 0;
+    for (uint8_t i = 0; i < CLOCK_TIME_CHARS; i++) {
+        if (timeBuffer[i] == lastChars[i]) {
+            continue;
+        }
+        uint8_t g = glyphIndex(timeBuffer[i]);
+        uint8_t width = glyphWidth[g];
+        if (charX[i] + width > timeX1) {
+            width = timeX1 - charX[i];
+        }
+        for (uint8_t p = 0; p < timePages; p++) {
+            memcpy(&timeLine[p][charX[i]], glyphStrip[g][p], width);
+        }
+        FrameBuffer::markColumns(changedTiles, charX[i], width, timePage, timePages);
+        lastChars[i] = timeBuffer[i];
+        redrawn++;
+    }
+    lastRedrawnChars = redrawn;
+    
+    // 时间行按页合成到帧缓冲（按位或，不覆盖背景层中的迷你表情）
+    for (uint8_t p = 0; p < timePages; p++) {
+        uint8_t* dst = frame + (timePage + p) * FrameBuffer::ROW_BYTES;
+        for (uint8_t x = timeX0; x < timeX1; x++) {
+            dst[x] |= timeLine[p][x];
+        }
+    }
+}
+
+void ClockRenderer::renderAnalog(uint8_t* frame) {
+    // 刻度在背景层中，这里只画指针；时针每12分钟前进一格
+    uint8_t hourPos = (uint8_t)((currentHour % 12) * 5 + currentMinute / 12);
+    FrameBuffer::DirtyMask tiles;
+    memset(tiles, 0, sizeof(tiles));
+    AnalogDial::drawHand(frame, hourPos, CLOCK_HOUR_HAND, CLOCK_DIAL_X, CLOCK_DIAL_Y, tiles);
+    AnalogDial::drawHand(frame, currentMinute, CLOCK_MINUTE_HAND, CLOCK_DIAL_X, CLOCK_DIAL_Y, tiles);
+    AnalogDial::drawHand(frame, currentSecond, CLOCK_SECOND_HAND, CLOCK_DIAL_X, CLOCK_DIAL_Y, tiles);
+    
+    // 与上一帧相比，只有新旧指针经过的tile可能变化（第一帧为整个表盘）
+    for (uint8_t ty = 0; ty < FrameBuffer::TILE_ROWS; ty++) {
+        changedTiles[ty] = (uint16_t)(tiles[ty] | handTiles[ty]);
+    }
+    if (!handsDrawn) {
+        FrameBuffer::markColumns(changedTiles, CLOCK_DIAL_X - CLOCK_DIAL_RADIUS, 2 * CLOCK_DIAL_RADIUS + 1,
+                                 0, FrameBuffer::TILE_ROWS);
+        handsDrawn = true;
+    }
+    memcpy(handTiles, tiles, sizeof(handTiles));
+}
+
+bool ClockRenderer::buildGlyphStrip(U8G2* display) {
+    static const char GLYPHS[CLOCK_GLYPH_COUNT + 1] = "0123456789:";
+    
+    // 在临时缓冲中逐个绘制字形，再按页取出
+    uint8_t* scratch = (uint8_t*)malloc(FrameBuffer::SIZE);
+    if (scratch == nullptr) {
+        return false;
+    }
+    u8g2_t* u8g2 = display->getU8g2();
+    uint8_t* frame = u8g2->tile_buf_ptr;
+    u8g2->tile_buf_ptr = scratch;
+    
+    display->setFont(u8g2_font_logisoso22_tn);
+    
+    // 时间行覆盖 [基线 - 字体上升高度, 基线) 所在的页
+    int16_t top = CLOCK_TIME_BASELINE - display->getAscent();
+    if (top < 0) top = 0;
+    timePage = (uint8_t)(top >> 3);
+    timePages = (uint8_t)(((CLOCK_TIME_BASELINE - 1) >> 3) - timePage + 1);
+    if (timePages > CLOCK_GLYPH_MAX_PAGES) {
+        timePages = CLOCK_GLYPH_MAX_PAGES;
+    }
+    
+    memset(glyphStrip, 0, sizeof(glyphStrip));
+    for (uint8_t g = 0; g < CLOCK_GLYPH_COUNT; g++) {
+        display->clearBuffer();
+        uint16_t advance = display->drawGlyph(0, CLOCK_TIME_BASELINE, GLYPHS[g]);
+        glyphWidth[g] = advance > CLOCK_GLYPH_MAX_WIDTH ? CLOCK_GLYPH_MAX_WIDTH : (uint8_t)advance;
+        for (uint8_t p = 0; p < timePages; p++) {
+            memcpy(glyphStrip[g][p], scratch + (timePage + p) * FrameBuffer::ROW_BYTES, glyphWidth[g]);
+        }
+    }
+    
+    u8g2->tile_buf_ptr = frame;
+    free(scratch);
+    
+    // 布局：数字等宽，整行宽度固定，居中位置只需计算一次
+    uint16_t totalWidth = 6 * glyphWidth[0] + 2 * glyphWidth[glyphIndex(':')];
+    int16_t x = (OLED_WIDTH - (int16_t)totalWidth) / 2;
+    if (x < 0) x = 0;
+    timeX0 = (uint8_t)x;
+    for (uint8_t i = 0; i < CLOCK_TIME_CHARS; i++) {
+        charX[i] = (uint8_t)x;
+        x += (i == 2 || i == 5) ? glyphWidth[glyphIndex(':')] : glyphWidth[0];
+        if (x > OLED_WIDTH) x = OLED_WIDTH;
+    }
+    timeX1 = (uint8_t)x;
+    
+    // 时间行需要完整重建
+    memset(timeLine, 0, sizeof(timeLine));
+    memset(lastChars, 0, sizeof(lastChars));
+    glyphsReady = true;
+    return true;
+}
+
+uint8_t ClockRenderer::glyphIndex(char c) {
+    return (c >= '0' && c <= '9') ? (uint8_t)(c - '0') : (uint8_t)(CLOCK_GLYPH_COUNT - 1);
+}
+
+uint8_t ClockRenderer::getLastRedrawnChars() const {
+    return lastRedrawnChars;
+}
+
+void ClockRenderer::renderStatic(U8G2* display) {
+    if (display == nullptr) return;
+    
+    char dateBuffer[11];
+    
+    // 格式化日期
     formatDate(currentYear, currentMonth, currentDay, dateBuffer);
     
+    if (face == CLOCK_FACE_ANALOG) {
+        // 刻度光栅化到背景层，之后每秒只画指针
+        AnalogDial::drawTicks(display->getBufferPtr(), CLOCK_DIAL_X, CLOCK_DIAL_Y,
+                              CLOCK_DIAL_RADIUS, CLOCK_DIAL_TICK);
+        
+        // 右半屏：迷你表情和日期
+        drawMiniFace(display, 88, 16);
+        display->setFont(u8g2_font_6x10_tf);
+        int16_t dateWidth = display->getStrWidth(dateBuffer);
+        display->drawStr(OLED_WIDTH / 2 + (OLED_WIDTH / 2 - dateWidth) / 2, 56, dateBuffer);
+        if (isOffline) {
+            drawOfflineIndicator(display);
+        }
+        return;
+    }
+    
     // 绘制迷你表情图标（左上角）
     drawMiniFace(display, 4, 4);
     
-    // 绘制时间（大字体，居中）
-    display->setFont(u8g2_font_logisoso22_tn);
-    int16_t timeWidth = display->getStrWidth(timeBuffer);
-    int16_t timeX = (OLED_WIDTH - timeWidth) / 2;
-    display->drawStr(timeX, 38, timeBuffer);
-    
     // 绘制日期（小字体，居中）
     display->setFont(u8g2_font_6x10_tf);
     int16_t dateWidth = display->getStrWidth(dateBuffer);
@@ -87,20 +254,102 @@ void ClockRenderer::render(U8G2* display) {
     }
 }
 
+uint16_t ClockRenderer::getStaticVersion() const {
+    return staticVersion;
+}
+
 void ClockRenderer::setTime(uint8_t hour, uint8_t minute, uint8_t second) {
+    if (hour == currentHour && minute == currentMinute && second == currentSecond) {
+        return;
+    }
     currentHour = hour;
     currentMinute = minute;
     currentSecond = second;
+    lastSecondTick = millis();
+    dirty = true;
 }
 
 void ClockRenderer::setDate(uint16_t year, uint8_t month, uint8_t day) {
+    if (year == currentYear && month == currentMonth && day == currentDay) {
+        return;
+    }
     currentYear = year;
     currentMonth = month;
     currentDay = day;
+    staticVersion++;
+    dirty = true;
 }
 
 void ClockRenderer::setOffline(bool offline) {
-    isOffline = offline;
+    if (offline != isOffline) {
+        isOffline = offline;
+        staticVersion++;
+        dirty = true;
+    }
+}
+
+void ClockRenderer::setFace(ClockFace newFace) {
+    if (newFace == face || newFace >= CLOCK_FACE_COUNT) {
+        return;
+    }
+    face = newFace;
+    
+    // 背景层换成另一种表盘，内容层从头绘制
+    memset(lastChars, 0, sizeof(lastChars));
+    memset(timeLine, 0, sizeof(timeLine));
+    memset(handTiles, 0, sizeof(handTiles));
+    handsDrawn = false;
+    staticVersion++;
+    dirty = true;
+}
+
+ClockFace ClockRenderer::getFace() const {
+    return face;
+}
+
+void ClockRenderer::toggleFace() {
+    setFace(face == CLOCK_FACE_DIGITAL ? CLOCK_FACE_ANALOG : CLOCK_FACE_DIGITAL);
+    
+    // 两种表盘的对比（耗时为各自最近一次渲染，尚未显示过的表盘为0）
+    uint32_t digitalRam, analogRam;
+    uint32_t digitalFlash = getFlashBytes(CLOCK_FACE_DIGITAL, digitalRam);
+    uint32_t analogFlash = getFlashBytes(CLOCK_FACE_ANALOG, analogRam);
+    Serial.printf("[ClockRenderer] 数字表盘: 每秒 %lu us, flash %lu 字节, RAM %lu 字节; "
+                  "指针表盘: 每秒 %lu us, flash %lu 字节, RAM %lu 字节\n",
+                  (unsigned long)renderMicros[CLOCK_FACE_DIGITAL], (unsigned long)digitalFlash,
+                  (unsigned long)digitalRam, (unsigned long)renderMicros[CLOCK_FACE_ANALOG],
+                  (unsigned long)analogFlash, (unsigned long)analogRam);
+}
+
+void ClockRenderer::getChangedTiles(FrameBuffer::DirtyMask tiles) const {
+    memcpy(tiles, changedTiles, sizeof(changedTiles));
+}
+
+uint32_t ClockRenderer::getRenderMicros(ClockFace which) const {
+    return which < CLOCK_FACE_COUNT ? renderMicros[which] : 0;
+}
+
+uint32_t ClockRenderer::getFlashBytes(ClockFace which, uint32_t& ramBytes) {
+    if (which == CLOCK_FACE_ANALOG) {
+        ramBytes = sizeof(FrameBuffer::DirtyMask);
+        return sizeof(AnalogDial::SIN_TABLE);
+    }
+    ramBytes = sizeof(glyphStrip) + sizeof(timeLine);
+    return (uint32_t)u8g2_GetFontSize(u8g2_font_logisoso22_tn);
+}
+
+bool ClockRenderer::isDirty() const {
+    return dirty;
+}
+
+void ClockRenderer::markDirty() {
+    dirty = true;
+}
+
+unsigned long ClockRenderer::getNextDeadline(unsigned long now) const {
+    // 下一次秒数跳变在上次跳变的1秒之后
+    unsigned long elapsed = now - lastSecondTick;
+    return elapsed >= 1000 ? 0 : 1000 - elapsed;
 }
 
 void ClockRenderer::drawMiniFace(U8G2* display, int16_t x, int16_t y) {
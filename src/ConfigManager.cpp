@@ -6,6 +6,7 @@
 
 #include <Arduino.h>
 #include "ConfigManager.h"
+#include "DeadlineSet.h"
 
 // NVS命名空间和键名定义
 const char* ConfigManager::NVS_NAMESPACE = "companion";
@@ -162,6 +163,13 @@ bool ConfigManager::isDirty() const {
     return dirty;
 }
 
+unsigned long ConfigManager::getNextDeadline(unsigned long now) const {
+    if (!initialized || !dirty) {
+        return DEADLINE_NONE;
+    }
+    return DeadlineSet::remaining(now, lastChangeTime, AUTO_SAVE_DELAY_MS);
+}
+
 // ============================================================================
 // 配置项访问器实现
 // ============================================================================
@@ -5,6 +5,10 @@
 #include "DisplayManager.h"
 #include <Wire.h>
 
+// 刷新任务的通知位
+static const uint32_t FLUSH_NOTIFY_FRAME = 1u << 0;    // 主循环提交了新帧
+static const uint32_t FLUSH_NOTIFY_GRAY  = 1u << 1;    // 灰度平面定时器到期
+
 DisplayManager::DisplayManager()
     : display(U8G2_R0, /* reset=*/ U8X8_PIN_NONE)
     , currentMode(MODE_FACE)
@@ -12,20 +16,74 @@ DisplayManager::DisplayManager()
     , brightness(DEFAULT_BRIGHTNESS)
     , isTransitioning(false)
     , transitionStartTime(0)
+    , transitionType(TRANSITION_SLIDE)
+    , transitionMicros(0)
+    , transitionFrames(0)
+    , transitionOverBudget(0)
+    , lastTransitionMicros(0)
+    , lastTransitionFrames(0)
+    , lastTransitionOverBudget(0)
+    , lastFrameTime(0)
+    , forceRedraw(true)
+    , renderedFrames(0)
+    , frontBuffer(frameBuffers[1])
+    , forceFullFlush(true)
+    , lastFlushBytes(0)
+    , totalFlushBytes(0)
+    , flushedFrames(0)
+    , queuedFrames(0)
+    , droppedFrames(0)
+    , flushTask(nullptr)
+    , frontFree(nullptr)
+    , busMutex(nullptr)
+    , staticLayerValid(false)
+    , staticLayerMode(MODE_FACE)
+    , staticLayerVersion(0)
+    , overlayDraw(nullptr)
+    , overlayContext(nullptr)
+    , overlayValid(false)
+    , toastValid(false)
+    , faceStreamsReady(false)
+    , streamedFrames(0)
+    , streamComposed(false)
+    , presentedStream(false)
+    , presentedTiled(false)
+    , presentedTiledMode(MODE_FACE)
+    , presentedTiledVersion(0)
+    , flushHintValid(false)
+    , grayActive(false)
+    , graySprite()
+    , grayX(0)
+    , grayPage(0)
+    , grayPlaneIndex(0)
+    , grayTimer(nullptr)
+    , sleepStage(SLEEP_STAGE_NONE)
+    , sleepStartTime(0)
+    , lastBreathTime(0)
+    , breathStep(0)
+    , panelOn(true)
+    , lastRenderMicros(0)
+    , lastStaticRenderMicros(0)
     , faceRenderer()
     , clockRenderer()
-    , sysInfoRenderer() {
+    , sysInfoRenderer()
+    , textRenderer()
+    , stopwatchRenderer() {
 }
 
 bool DisplayManager::init() {
     // 初始化I2C引脚
     Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN);
     
-    // 初始化U8g2显示
+    // 初始化U8g2显示（总线时钟需在begin之前设置）
+    display.setBusClock(OLED_I2C_CLOCK_HZ);
     if (!display.begin()) {
         return false;
     }
     
+    // 使用自有的对齐缓冲作为渲染缓冲
+    display.getU8g2()->tile_buf_ptr = frameBuffers[0];
+    
     // 设置默认亮度
     display.setContrast(brightness);
     
@@ -34,42 +92,233 @@ bool DisplayManager::init() {
     
     // 清空显示
     display.clearBuffer();
-    display.sendBuffer();
+    forceFullFlush = true;
+    flushFrame(display.getBufferPtr());
+    
+#if DISPLAY_ASYNC_FLUSH
+    // 创建显示刷新任务：主循环渲染下一帧的同时由该任务发送上一帧
+    busMutex = xSemaphoreCreateMutex();
+    frontFree = xSemaphoreCreateBinary();
+    if (busMutex == nullptr || frontFree == nullptr) {
+        return false;
+    }
+    xSemaphoreGive(frontFree);
+    if (xTaskCreate(flushTaskEntry, "display", DISPLAY_TASK_STACK, this,
+                    DISPLAY_TASK_PRIORITY, &flushTask) != pdPASS) {
+        return false;
+    }
+#endif
     
     // 初始化渲染器
     faceRenderer.init();
     clockRenderer.init();
     sysInfoRenderer.init();
+    textRenderer.init();
+    stopwatchRenderer.init();
+    
+    // 预计算空闲表情动画
+    bakeFaceStreams();
     
     return true;
 }
 
+void DisplayManager::bakeFaceStreams() {
+    unsigned long start = micros();
+    
+    // 单独的渲染器实例：默认就是基础表情，生成过程不影响正在使用的表情
+    FaceRenderer* baker = new FaceRenderer();
+    u8g2_t* u8g2 = display.getU8g2();
+    uint8_t* frame = u8g2->tile_buf_ptr;
+    
+    u8g2->tile_buf_ptr = faceBaseFrame;
+    display.clearBuffer();
+    baker->render(&display);
+    
+    // 各段动画按动画帧率（以及关键帧时刻）逐帧绘制到离屏缓冲，依次使用存储区
+    u8g2->tile_buf_ptr = transitionTo;
+    uint16_t poolUsed = 0;
+    for (uint8_t i = 0; i < FACE_IDLE_ANIMATIONS; i++) {
+        const Timeline::Animation& animation = FaceRenderer::getIdleAnimation(i);
+        uint16_t duration = (uint16_t)Timeline::duration(animation);
+        DeltaStream& stream = faceStreams[i];
+        stream.begin(faceStreamPool + poolUsed, FACE_STREAM_POOL_BYTES - poolUsed);
+        
+        uint8_t key = 1;
+        for (uint16_t t = 0; t < duration; ) {
+            display.clearBuffer();
+            baker->renderIdleFrame(&display, i, t);
+            if (!stream.addFrame(t, transitionTo, faceBaseFrame)) {
+                break;
+            }
+            uint16_t next = t + ANIMATION_FRAME_MS;
+            while (key < animation.count && animation.frames[key].time <= t) {
+                key++;
+            }
+            if (key < animation.count && animation.frames[key].time < next) {
+                next = animation.frames[key].time;
+            }
+            t = next;
+        }
+        
+        if (stream.finish(duration)) {
+            poolUsed += stream.getDataBytes();
+            Serial.printf("[DisplayManager] 空闲动画 %u: %u 帧, %u 字节\n",
+                          i, stream.getFrameCount(), stream.getBytes());
+        } else {
+            Serial.printf("[DisplayManager] 空闲动画 %u: 存储区不足，完整绘制\n", i);
+        }
+    }
+    
+    u8g2->tile_buf_ptr = frame;
+    delete baker;
+    faceStreamsReady = true;
+    Serial.printf("[DisplayManager] 增量流共 %u / %u 字节，生成耗时 %lu us\n",
+                  poolUsed, FACE_STREAM_POOL_BYTES, micros() - start);
+}
+
 void DisplayManager::update() {
-    // 更新表情动画（即使不在表情模式也需要更新，以便切换时动画连贯）
-    if (currentMode == MODE_FACE || currentMode == MODE_SLEEP) {
+    // 灰度模式：位平面由定时器驱动刷新任务发送，主循环不出帧
+    if (grayActive) {
+        return;
+    }
+    
+    unsigned long now = millis();
+    
+    // 表情动画只在到达下一个动画时刻时推进
+    if ((currentMode == MODE_FACE || currentMode == MODE_SLEEP) &&
+        faceRenderer.getNextDeadline(now) == 0) {
         faceRenderer.updateAnimation();
     }
     
+    // 文本滚动只在到达下一个滚动时刻时推进
+    if (currentMode == MODE_TEXT && textRenderer.getNextDeadline(now) == 0) {
+        textRenderer.updateScroll(now);
+    }
+    
+    // 倒计时在其他模式下也会到期
+    stopwatchRenderer.update();
+    
     // 检查是否正在进行过渡动画
     if (isTransitioning) {
-        unsigned long elapsed = millis() - transitionStartTime;
+        unsigned long elapsed = now - transitionStartTime;
         if (elapsed >= TRANSITION_DURATION_MS) {
-            // 过渡动画结束
+            // 过渡动画结束，记录本次过渡的CPU耗时
             isTransitioning = false;
-            // 恢复正常亮度
-            display.setContrast(brightness);
+            lastTransitionMicros = transitionMicros;
+            lastTransitionFrames = transitionFrames;
+            lastTransitionOverBudget = transitionOverBudget;
+            forceRedraw = true;
         } else {
-            // 渲染过渡动画
-            renderTransition();
+            // 过渡动画按固定帧率渲染
+            if (now - lastFrameTime >= TRANSITION_FRAME_MS) {
+                lastFrameTime = now;
+                renderTransition();
+            }
             return;
         }
     }
     
+    // 睡眠：静态画面已发送，只做对比度呼吸；屏幕关闭后不再出帧
+    if (currentMode == MODE_SLEEP) {
+        updateSleep(now);
+        if (sleepStage == SLEEP_STAGE_PANEL_OFF) {
+            return;
+        }
+    }
+    
+    // 通知：显示的通知出现、切换或到期时重绘（屏幕关闭期间保留在队列中）
+    if (toasts.update(now)) {
+        toastValid = false;
+        forceRedraw = true;
+    }
+    
+    // 没有变化或未到最小帧间隔时不出帧
+    if (!forceRedraw && !isCurrentModeDirty()) {
+        return;
+    }
+    if (!forceRedraw && now - lastFrameTime < getFrameInterval()) {
+        return;
+    }
+    
     // 渲染当前模式内容
+    lastFrameTime = now;
     renderCurrentMode();
 }
 
+unsigned long DisplayManager::getNextDeadline() const {
+    if (grayActive) {
+        return DEADLINE_NONE;
+    }
+    
+    unsigned long now = millis();
+    unsigned long elapsed = now - lastFrameTime;
+    
+    if (isTransitioning || forceRedraw) {
+        return elapsed >= TRANSITION_FRAME_MS ? 0 : TRANSITION_FRAME_MS - elapsed;
+    }
+    
+    // 屏幕关闭后没有任何定时工作
+    if (currentMode == MODE_SLEEP && sleepStage == SLEEP_STAGE_PANEL_OFF) {
+        return DEADLINE_NONE;
+    }
+    
+    unsigned long next = DEADLINE_NONE;
+    if (isCurrentModeDirty()) {
+        unsigned long interval = getFrameInterval();
+        next = elapsed >= interval ? 0 : interval - elapsed;
+    }
+    
+    // 表情动画的下一个时刻
+    if (currentMode == MODE_FACE || currentMode == MODE_SLEEP) {
+        unsigned long faceNext = faceRenderer.getNextDeadline(now);
+        if (faceNext < next) {
+            next = faceNext;
+        }
+        if (currentMode == MODE_SLEEP) {
+            unsigned long sleepNext = getSleepDeadline(now);
+            if (sleepNext < next) {
+                next = sleepNext;
+            }
+        }
+    } else if (currentMode == MODE_CLOCK) {
+        unsigned long clockNext = clockRenderer.getNextDeadline(now);
+        if (clockNext < next) {
+            next = clockNext;
+        }
+    } else if (currentMode == MODE_SYSINFO) {
+        unsigned long sysInfoNext = sysInfoRenderer.getNextDeadline(now);
+        if (sysInfoNext < next) {
+            next = sysInfoNext;
+        }
+    } else if (currentMode == MODE_TEXT) {
+        unsigned long textNext = textRenderer.getNextDeadline(now);
+        if (textNext < next) {
+            next = textNext;
+        }
+    } else if (currentMode == MODE_STOPWATCH) {
+        unsigned long stopwatchNext = stopwatchRenderer.getNextDeadline(now);
+        if (stopwatchNext < next) {
+            next = stopwatchNext;
+        }
+    }
+    
+    // 通知：新投递的通知尽快显示，当前通知到期时移除
+    if (toasts.hasPending()) {
+        next = 0;
+    } else {
+        unsigned long toastNext = toasts.getRemaining(now);
+        if (toastNext < next) {
+            next = toastNext;
+        }
+    }
+    
+    return next;
+}
+
 void DisplayManager::setMode(DisplayMode mode) {
+    // 切换模式（包括重新选择当前模式）时退出灰度模式
+    stopGrayscale();
+    
     if (mode == currentMode) {
         return;
     }
@@ -77,20 +326,40 @@ void DisplayManager::setMode(DisplayMode mode) {
     // 如果从睡眠模式唤醒，触发唤醒动画
     if (currentMode == MODE_SLEEP && mode != MODE_SLEEP) {
         faceRenderer.wakeUp();
+        
+        // 显存内容在关屏期间保留：直接打开屏幕、恢复亮度，后续帧只发送变化的tile
+        if (!panelOn) {
+            setPanelPower(true);
+        }
+#if OLED_HW_EFFECTS
+        setPanelFade(PanelEffects::FADE_OFF);
+#endif
+        setContrastLocked(brightness);
+        sleepStage = SLEEP_STAGE_NONE;
     }
     
     // 如果进入睡眠模式，设置表情为睡眠状态
     if (mode == MODE_SLEEP) {
         faceRenderer.enterSleep();
+        sleepStage = SLEEP_STAGE_ENTERING;
+        breathStep = 0;
     }
     
     // 保存上一个模式
     previousMode = currentMode;
     currentMode = mode;
     
+    // 快照当前屏幕内容作为过渡的旧画面（过渡中再次切换时从过渡帧继续）
+    FrameBuffer::copyFrame(transitionFrom, getPresentedFrame());
+    
     // 开始过渡动画
+    transitionType = selectTransition(previousMode, currentMode);
     isTransitioning = true;
     transitionStartTime = millis();
+    transitionMicros = 0;
+    transitionFrames = 0;
+    transitionOverBudget = 0;
+    forceRedraw = true;
 }
 
 DisplayMode DisplayManager::getMode() const {
@@ -108,6 +377,9 @@ void DisplayManager::nextMode() {
             next = MODE_SYSINFO;
             break;
         case MODE_SYSINFO:
+            next = MODE_STOPWATCH;
+            break;
+        case MODE_STOPWATCH:
         case MODE_SLEEP:
         default:
             next = MODE_FACE;
@@ -119,13 +391,116 @@ void DisplayManager::nextMode() {
 
 void DisplayManager::setBrightness(uint8_t level) {
     brightness = level;
-    display.setContrast(brightness);
+    setContrastLocked(brightness);
 }
 
 uint8_t DisplayManager::getBrightness() const {
     return brightness;
 }
 
+bool DisplayManager::showGrayscale(const GraySprite& sprite, int16_t x, uint8_t page) {
+#if DISPLAY_ASYNC_FLUSH
+    stopGrayscale();
+    
+    if (grayTimer == nullptr) {
+        esp_timer_create_args_t args = {};
+        args.callback = grayTimerEntry;
+        args.arg = this;
+        args.name = "gray";
+        if (esp_timer_create(&args, &grayTimer) != ESP_OK) {
+            grayTimer = nullptr;
+            return false;
+        }
+    }
+    
+    // 等待上一帧发送完成；灰度模式期间一直占用前缓冲，主循环不能提交帧
+    if (xSemaphoreTake(frontFree, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return false;
+    }
+    
+    graySprite = sprite;
+    grayX = x;
+    grayPage = page;
+    grayPlaneIndex = 0;
+    memset(grayFrame, 0, sizeof(grayFrame));
+    uint8_t tiles = GrayPlanes::changingTiles(sprite, x, page, grayTiles);
+    
+    // 第一个平面整屏发送（清空精灵以外的区域），之后只发送含中间灰度的tile
+    forceFullFlush = true;
+    
+    // 提高总线时钟和屏幕扫描率；刷新任务提高优先级，平面节拍不被其他任务推迟
+    static const uint8_t FAST_OSC[] = {0xD5, GRAY_OSC_FREQ};
+    sendCommands(FAST_OSC, sizeof(FAST_OSC));
+    xSemaphoreTake(busMutex, portMAX_DELAY);
+    display.setBusClock(GRAY_I2C_CLOCK_HZ);
+    grayTiming.reset(1000000UL / GRAY_PLANE_HZ);
+    grayActive = true;
+    xSemaphoreGive(busMutex);
+    vTaskPrioritySet(flushTask, GRAY_TASK_PRIORITY);
+    
+    esp_timer_start_periodic(grayTimer, 1000000UL / GRAY_PLANE_HZ);
+    Serial.printf("[DisplayManager] 灰度模式: %u 个tile按 %u Hz 轮流发送位平面\n", tiles, GRAY_PLANE_HZ);
+    return true;
+#else
+    // 同步刷新时主循环无法保证平面节拍
+    return false;
+#endif
+}
+
+void DisplayManager::stopGrayscale() {
+#if DISPLAY_ASYNC_FLUSH
+    if (!grayActive) {
+        return;
+    }
+    
+    // 持有总线锁清除标志：刷新任务不会在此之后再发送平面
+    esp_timer_stop(grayTimer);
+    xSemaphoreTake(busMutex, portMAX_DELAY);
+    grayActive = false;
+    display.setBusClock(OLED_I2C_CLOCK_HZ);
+    xSemaphoreGive(busMutex);
+    vTaskPrioritySet(flushTask, DISPLAY_TASK_PRIORITY);
+    
+    static const uint8_t NORMAL_OSC[] = {0xD5, OLED_OSC_FREQ};
+    sendCommands(NORMAL_OSC, sizeof(NORMAL_OSC));
+    
+    // 影子缓冲已与最后一个平面同步，释放前缓冲后正常出帧
+    xSemaphoreGive(frontFree);
+    forceRedraw = true;
+    
+    uint32_t rate = grayTiming.getRateMilliHz();
+    Serial.printf("[DisplayManager] 灰度模式结束: %lu 个平面，%lu.%03lu Hz，抖动 平均 %lu us / 最大 %lu us，丢失 %lu\n",
+                  (unsigned long)grayTiming.getPlanes(), (unsigned long)(rate / 1000), (unsigned long)(rate % 1000),
+                  (unsigned long)grayTiming.getMeanJitterMicros(), (unsigned long)grayTiming.getMaxJitterMicros(),
+                  (unsigned long)grayTiming.getMissed());
+#endif
+}
+
+bool DisplayManager::isGrayscale() const {
+    return grayActive;
+}
+
+const GrayPlanes::PlaneTiming& DisplayManager::getGrayTiming() const {
+    return grayTiming;
+}
+
+bool DisplayManager::isPanelOn() const {
+    return panelOn;
+}
+
+bool DisplayManager::isFlushIdle() const {
+#if DISPLAY_ASYNC_FLUSH
+    return uxSemaphoreGetCount(frontFree) > 0 && xSemaphoreGetMutexHolder(busMutex) == nullptr;
+#else
+    // 同步刷新：update() 返回时帧已经发送完
+    return true;
+#endif
+}
+
+SleepStage DisplayManager::getSleepStage() const {
+    return sleepStage;
+}
+
 U8G2* DisplayManager::getDisplay() {
     return &display;
 }
@@ -147,40 +522,58 @@ void DisplayManager::showBootScreen() {
     display.setFont(u8g2_font_6x10_tf);
     display.drawStr(44, 60, "v1.0.0");
     
-    display.sendBuffer();
+    presentFrame(true);
+    
+    // 临时画面覆盖了当前模式，下一次update需要重绘
+    forceRedraw = true;
 }
 
 void DisplayManager::showConnectionStatus(const char* message) {
-    display.clearBuffer();
-    
-    // 显示WiFi图标区域
-    display.setFont(u8g2_font_open_iconic_www_2x_t);
-    display.drawGlyph(56, 24, 0x0048);  // WiFi图标
-    
-    // 显示状态消息
-    display.setFont(u8g2_font_6x10_tf);
-    int16_t msgWidth = display.getStrWidth(message);
-    display.drawStr((OLED_WIDTH - msgWidth) / 2, 48, message);
-    
-    display.sendBuffer();
+    postToast(message, TOAST_INFO, TOAST_DEFAULT_MS, TOAST_ICON_WIFI);
 }
 
 void DisplayManager::showMessage(const char* message) {
-    display.clearBuffer();
-    
-    // 居中显示消息
-    display.setFont(u8g2_font_helvB10_tf);
-    int16_t msgWidth = display.getStrWidth(message);
-    int16_t x = (OLED_WIDTH - msgWidth) / 2;
-    int16_t y = OLED_HEIGHT / 2 + 4;  // 垂直居中
-    display.drawStr(x, y, message);
-    
-    display.sendBuffer();
+    // 通知栏只有一行西文字体：超长或含多字节字符（中文）时换行滚动显示
+    size_t length = 0;
+    bool ascii = true;
+    for (const char* p = message; *p != '\0'; p++) {
+        ascii = ascii && (uint8_t)*p < 0x80;
+        length++;
+    }
+    if (ascii && length <= TOAST_MAX_CHARS) {
+        postToast(message, TOAST_NOTICE);
+    } else {
+        showText(message);
+    }
+}
+
+bool DisplayManager::postToast(const char* text, ToastPriority priority, uint32_t durationMs, uint16_t icon) {
+    // 只写入通知队列，由主循环的update在下一帧显示
+    if (!toasts.post(text, priority, durationMs, icon)) {
+        Serial.printf("[DisplayManager] 通知队列已满，丢弃: %s\n", text);
+        return false;
+    }
+    return true;
+}
+
+bool DisplayManager::isToastShowing() const {
+    return toasts.getCurrent() != nullptr;
+}
+
+void DisplayManager::showText(const char* text, TextScrollMode mode) {
+    textRenderer.setText(text, mode);
+    if (currentMode == MODE_TEXT) {
+        // 已在文本模式：直接替换内容
+        forceRedraw = true;
+    } else {
+        setMode(MODE_TEXT);
+    }
 }
 
 void DisplayManager::clear() {
     display.clearBuffer();
-    display.sendBuffer();
+    presentFrame(true);
+    forceRedraw = true;
 }
 
 FaceRenderer& DisplayManager::getFaceRenderer() {
@@ -195,32 +588,350 @@ SysInfoRenderer& DisplayManager::getSysInfoRenderer() {
     return sysInfoRenderer;
 }
 
+TextRenderer& DisplayManager::getTextRenderer() {
+    return textRenderer;
+}
+
+StopwatchRenderer& DisplayManager::getStopwatchRenderer() {
+    return stopwatchRenderer;
+}
+
+uint16_t DisplayManager::getLastFlushBytes() const {
+    return lastFlushBytes;
+}
+
+uint32_t DisplayManager::getTotalFlushBytes() const {
+    return totalFlushBytes;
+}
+
+uint32_t DisplayManager::getFlushedFrameCount() const {
+    return flushedFrames;
+}
+
+uint32_t DisplayManager::getRenderedFrameCount() const {
+    return renderedFrames;
+}
+
+uint32_t DisplayManager::getQueuedFrameCount() const {
+    return queuedFrames;
+}
+
+uint32_t DisplayManager::getDroppedFrameCount() const {
+    return droppedFrames;
+}
+
+uint32_t DisplayManager::getStreamedFrameCount() const {
+    return streamedFrames;
+}
+
+const DeltaStream& DisplayManager::getFaceStream(uint8_t index) const {
+    return faceStreams[index];
+}
+
+uint32_t DisplayManager::getLastRenderMicros() const {
+    return lastRenderMicros;
+}
+
+uint32_t DisplayManager::getLastStaticRenderMicros() const {
+    return lastStaticRenderMicros;
+}
+
+uint32_t DisplayManager::getLastTransitionMicros() const {
+    return lastTransitionMicros;
+}
+
+uint16_t DisplayManager::getLastTransitionFrames() const {
+    return lastTransitionFrames;
+}
+
+uint16_t DisplayManager::getLastTransitionOverBudget() const {
+    return lastTransitionOverBudget;
+}
+
+void DisplayManager::setOverlay(OverlayDrawFunc draw, void* context) {
+    overlayDraw = draw;
+    overlayContext = context;
+    overlayValid = false;
+    forceRedraw = true;
+}
+
+void DisplayManager::invalidateLayer(DisplayLayer layer) {
+    if (layer == LAYER_BACKGROUND) {
+        staticLayerValid = false;
+    } else if (layer == LAYER_OVERLAY) {
+        overlayValid = false;
+    }
+    forceRedraw = true;
+}
+
+bool DisplayManager::hasOverlay() const {
+    return overlayDraw != nullptr || toasts.getCurrent() != nullptr;
+}
+
+void DisplayManager::rasterizeToast(const ToastQueue::Toast& toast) {
+    // 临时把U8g2的绘制目标切换到通知缓存
+    u8g2_t* u8g2 = display.getU8g2();
+    uint8_t* frame = u8g2->tile_buf_ptr;
+    u8g2->tile_buf_ptr = toastLayer;
+    display.clearBuffer();
+    
+    // 紧急通知为反色实心框，其余为空心框；框内的空白同样遮住下面的内容
+    int16_t top = TOAST_PAGE * 8;
+    int16_t height = TOAST_PAGES * 8;
+    int16_t baseline = top + height - 4;
+    if (toast.priority == TOAST_ALERT) {
+        display.drawRBox(0, top, OLED_WIDTH, height, 3);
+        display.setDrawColor(0);
+    } else {
+        display.drawRFrame(0, top, OLED_WIDTH, height, 3);
+    }
+    
+    int16_t x = 4;
+    if (toast.icon != 0) {
+        display.setFont(u8g2_font_open_iconic_www_1x_t);
+        display.drawGlyph(x, baseline, toast.icon);
+        x += 10;
+    }
+    
+    // 文本在图标右侧的剩余宽度内居中
+    display.setFont(u8g2_font_6x10_tf);
+    int16_t textWidth = display.getStrWidth(toast.text);
+    int16_t space = OLED_WIDTH - 4 - x;
+    if (textWidth < space) {
+        x += (space - textWidth) / 2;
+    }
+    display.drawStr(x, baseline, toast.text);
+    display.setDrawColor(1);
+    
+    u8g2->tile_buf_ptr = frame;
+    toastValid = true;
+}
+
+bool DisplayManager::hasStaticLayer() const {
+    return currentMode == MODE_CLOCK || currentMode == MODE_SYSINFO || currentMode == MODE_STOPWATCH;
+}
+
+uint16_t DisplayManager::getStaticLayerVersion() const {
+    switch (currentMode) {
+        case MODE_CLOCK:
+            return clockRenderer.getStaticVersion();
+        case MODE_SYSINFO:
+            return sysInfoRenderer.getStaticVersion();
+        case MODE_STOPWATCH:
+            return stopwatchRenderer.getStaticVersion();
+        default:
+            return 0;
+    }
+}
+
+void DisplayManager::rasterizeStaticLayer() {
+    unsigned long start = micros();
+    
+    // 临时把U8g2的绘制目标切换到背景层缓存
+    u8g2_t* u8g2 = display.getU8g2();
+    uint8_t* frame = u8g2->tile_buf_ptr;
+    u8g2->tile_buf_ptr = staticLayer;
+    display.clearBuffer();
+    
+    switch (currentMode) {
+        case MODE_CLOCK:
+            clockRenderer.renderStatic(&display);
+            break;
+        case MODE_SYSINFO:
+            sysInfoRenderer.renderStatic(&display);
+            break;
+        case MODE_STOPWATCH:
+            stopwatchRenderer.renderStatic(&display);
+            break;
+        default:
+            break;
+    }
+    
+    u8g2->tile_buf_ptr = frame;
+    
+    staticLayerValid = true;
+    staticLayerMode = currentMode;
+    staticLayerVersion = getStaticLayerVersion();
+    lastStaticRenderMicros = micros() - start;
+}
+
+unsigned long DisplayManager::getFrameInterval() const {
+    switch (currentMode) {
+        case MODE_FACE:
+            return ANIMATION_FRAME_MS;
+        case MODE_CLOCK:
+            return CLOCK_FRAME_MS;
+        case MODE_SYSINFO:
+            return SYSINFO_FRAME_MS;
+        case MODE_SLEEP:
+            // 睡眠开始时落下的 "z" 按动画帧率播放
+            return faceRenderer.hasParticles() ? ANIMATION_FRAME_MS : SLEEP_FRAME_MS;
+        case MODE_TEXT:
+            return TEXT_SCROLL_FRAME_MS;
+        case MODE_STOPWATCH:
+            return STOPWATCH_FRAME_MS;
+        default:
+            return ANIMATION_FRAME_MS;
+    }
+}
+
+bool DisplayManager::getChangedContentTiles(FrameBuffer::DirtyMask tiles) const {
+    switch (currentMode) {
+        case MODE_CLOCK:
+            clockRenderer.getChangedTiles(tiles);
+            return true;
+        case MODE_STOPWATCH:
+            stopwatchRenderer.getChangedTiles(tiles);
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool DisplayManager::isCurrentModeDirty() const {
+    switch (currentMode) {
+        case MODE_FACE:
+        case MODE_SLEEP:
+            return faceRenderer.isDirty();
+        case MODE_CLOCK:
+            return clockRenderer.isDirty();
+        case MODE_SYSINFO:
+            return sysInfoRenderer.isDirty();
+        case MODE_TEXT:
+            return textRenderer.isDirty();
+        case MODE_STOPWATCH:
+            return stopwatchRenderer.isDirty();
+        default:
+            return false;
+    }
+}
+
+TransitionType DisplayManager::selectTransition(DisplayMode from, DisplayMode to) const {
+    // 进入睡眠：画面渐隐；唤醒：新画面从上往下展开；其余模式间：水平滑动
+    if (to == MODE_SLEEP) {
+        return TRANSITION_DISSOLVE;
+    }
+    if (from == MODE_SLEEP) {
+        return TRANSITION_WIPE;
+    }
+    return TRANSITION_SLIDE;
+}
+
+const uint8_t* DisplayManager::getPresentedFrame() {
+#if DISPLAY_ASYNC_FLUSH
+    // 前缓冲只被刷新任务读取，主循环可以安全读取
+    return frontBuffer;
+#else
+    // 同步模式下渲染缓冲保留着上一次提交的帧
+    return display.getBufferPtr();
+#endif
+}
+
 void DisplayManager::renderTransition() {
-    // 简单的淡入淡出过渡效果
+    unsigned long start = micros();
+    
+    // 定点进度 (0-256)
     unsigned long elapsed = millis() - transitionStartTime;
-    float progress = (float)elapsed / TRANSITION_DURATION_MS;
+    uint16_t progress = (uint16_t)((elapsed << 8) / TRANSITION_DURATION_MS);
+    if (progress > 256) {
+        progress = 256;
+    }
     
-    // 前半段：淡出
-    if (progress < 0.5f) {
-        uint8_t fadeLevel = brightness * (1.0f - progress * 2);
-        display.setContrast(fadeLevel);
+    // 新画面渲染到离屏缓冲
+    u8g2_t* u8g2 = display.getU8g2();
+    uint8_t* frame = u8g2->tile_buf_ptr;
+    u8g2->tile_buf_ptr = transitionTo;
+    composeCurrentMode();
+    u8g2->tile_buf_ptr = frame;
+    
+    // 按32位字合成旧画面与新画面
+    switch (transitionType) {
+        case TRANSITION_SLIDE:
+            FrameBuffer::slideHorizontal(frame, transitionFrom, transitionTo,
+                                         (uint8_t)((progress * OLED_WIDTH) >> 8));
+            break;
+        case TRANSITION_WIPE:
+            FrameBuffer::wipeVertical(frame, transitionFrom, transitionTo,
+                                      (uint8_t)((progress * OLED_HEIGHT) >> 8));
+            break;
+        case TRANSITION_DISSOLVE:
+        default:
+            FrameBuffer::ditherCrossfade(frame, transitionFrom, transitionTo,
+                                         (uint8_t)((progress * 16) >> 8));
+            break;
     }
-    // 后半段：淡入
-    else {
-        uint8_t fadeLevel = brightness * ((progress - 0.5f) * 2);
-        display.setContrast(fadeLevel);
-        // 在淡入阶段渲染新内容
-        renderCurrentMode();
+    
+    // 每帧CPU预算统计
+    uint32_t cost = micros() - start;
+    transitionMicros += cost;
+    transitionFrames++;
+    if (cost > TRANSITION_FRAME_BUDGET_US) {
+        transitionOverBudget++;
     }
+    lastRenderMicros = cost;
+    renderedFrames++;
+    
+    presentFrame();
 }
 
 void DisplayManager::renderCurrentMode() {
-    display.clearBuffer();
+    forceRedraw = false;
+    renderedFrames++;
+    
+    unsigned long start = micros();
+    composeCurrentMode();
+    lastRenderMicros = micros() - start;
+    
+    // 连续两帧都来自增量流时，屏幕上只有两帧增量涉及的tile可能变化，刷新只比较这些tile
+    bool streamed = streamComposed && !hasOverlay();
+    FrameBuffer::DirtyMask hint;
+    if (streamed && presentedStream) {
+        for (uint8_t ty = 0; ty < FrameBuffer::TILE_ROWS; ty++) {
+            hint[ty] = streamDirty[ty] | presentedStreamDirty[ty];
+        }
+    }
+    
+    // 时钟、秒表：连续两帧为同一模式且背景层相同时，屏幕上只有渲染器报告的tile可能变化
+    // （变化的字符、新旧指针）；上一帧被丢弃时（presentedTiled 被清除）逐tile比较整帧
+    FrameBuffer::DirtyMask changed;
+    bool tiled = !hasOverlay() && getChangedContentTiles(changed);
+    uint16_t version = getStaticLayerVersion();
+    const uint16_t* candidates = streamed && presentedStream ? hint : nullptr;
+    if (tiled && presentedTiled && presentedTiledMode == currentMode && presentedTiledVersion == version) {
+        candidates = changed;
+    }
+    
+    if (presentFrame(false, candidates)) {
+        presentedStream = streamed;
+        memcpy(presentedStreamDirty, streamDirty, sizeof(presentedStreamDirty));
+        presentedTiled = tiled;
+        presentedTiledMode = currentMode;
+        presentedTiledVersion = version;
+    }
+}
+
+void DisplayManager::composeCurrentMode() {
+    uint8_t* frame = display.getBufferPtr();
+    streamComposed = false;
+    
+    // 背景层：缓存有效时直接整帧复制，否则重新光栅化
+    if (hasStaticLayer()) {
+        if (!staticLayerValid || staticLayerMode != currentMode ||
+            staticLayerVersion != getStaticLayerVersion()) {
+            rasterizeStaticLayer();
+        }
+        FrameBuffer::copyFrame(frame, staticLayer);
+    } else {
+        display.clearBuffer();
+    }
     
+    // 内容层
     switch (currentMode) {
         case MODE_FACE:
-            // 使用表情渲染器
-            faceRenderer.render(&display);
+            // 空闲动画直接由基础表情和增量流合成，其余情况使用表情渲染器
+            if (!composeFaceStream(frame)) {
+                faceRenderer.render(&display);
+            }
             break;
             
         case MODE_CLOCK:
@@ -238,9 +949,322 @@ void DisplayManager::renderCurrentMode() {
             faceRenderer.render(&display);
             break;
             
+        case MODE_TEXT:
+            // 文本模式：从缓存的文本位图复制
+            textRenderer.render(&display);
+            break;
+            
+        case MODE_STOPWATCH:
+            // 秒表模式：只更新变化的字符
+            stopwatchRenderer.render(&display);
+            break;
+            
         default:
             break;
     }
     
-    display.sendBuffer();
+    // 覆盖层
+    if (overlayDraw != nullptr) {
+        if (!overlayValid) {
+            u8g2_t* u8g2 = display.getU8g2();
+            u8g2->tile_buf_ptr = overlayLayer;
+            display.clearBuffer();
+            overlayDraw(&display, overlayContext);
+            u8g2->tile_buf_ptr = frame;
+            overlayValid = true;
+        }
+        FrameBuffer::orFrame(frame, overlayLayer);
+    }
+    
+    // 通知栏：整页复制，遮住下面的内容
+    const ToastQueue::Toast* toast = toasts.getCurrent();
+    if (toast != nullptr) {
+        if (!toastValid) {
+            rasterizeToast(*toast);
+        }
+        memcpy(frame + TOAST_PAGE * FrameBuffer::ROW_BYTES, toastLayer + TOAST_PAGE * FrameBuffer::ROW_BYTES,
+               TOAST_PAGES * FrameBuffer::ROW_BYTES);
+    }
+}
+
+bool DisplayManager::composeFaceStream(uint8_t* frame) {
+    if (!faceStreamsReady) {
+        return false;
+    }
+    uint32_t elapsed = 0;
+    int8_t idle = faceRenderer.getIdleFrame(millis(), elapsed);
+    if (idle == FACE_IDLE_NONE || (idle >= 0 && !faceStreams[idle].isReady())) {
+        return false;
+    }
+    
+    // 基础表情整帧复制，再写入当前帧的增量tile
+    FrameBuffer::copyFrame(frame, faceBaseFrame);
+    if (idle >= 0) {
+        const DeltaStream& stream = faceStreams[idle];
+        stream.apply(stream.frameAt(elapsed), frame, streamDirty);
+    } else {
+        memset(streamDirty, 0, sizeof(streamDirty));
+    }
+    
+    faceRenderer.markRendered();
+    streamComposed = true;
+    streamedFrames++;
+    return true;
+}
+
+bool DisplayManager::presentFrame(bool waitForFlush, const uint16_t* hint) {
+    // 一次性画面（消息等）替代灰度画面（灰度模式占用前缓冲，结束时释放，下面才能取得）
+    stopGrayscale();
+    
+    // 提交的帧不再是连续的增量流帧或报告变化tile的帧（由renderCurrentMode在提交成功后重新设置）
+    presentedStream = false;
+    presentedTiled = false;
+    
+#if DISPLAY_ASYNC_FLUSH
+    // 刷新任务仍在发送上一帧：丢弃本帧，下一次update重新渲染
+    TickType_t timeout = waitForFlush ? pdMS_TO_TICKS(100) : 0;
+    if (xSemaphoreTake(frontFree, timeout) != pdTRUE) {
+        droppedFrames++;
+        forceRedraw = true;
+        return false;
+    }
+    
+    // 刷新任务空闲，可以安全地写入候选tile
+    if (hint != nullptr) {
+        memcpy(flushHint, hint, sizeof(flushHint));
+    }
+    flushHintValid = hint != nullptr;
+    
+    // 交换前后缓冲（只交换指针），后续渲染写入另一个缓冲
+    u8g2_t* u8g2 = display.getU8g2();
+    uint8_t* rendered = u8g2->tile_buf_ptr;
+    u8g2->tile_buf_ptr = frontBuffer;
+    frontBuffer = rendered;
+    
+    queuedFrames++;
+    xTaskNotify(flushTask, FLUSH_NOTIFY_FRAME, eSetBits);
+#else
+    if (hint != nullptr) {
+        memcpy(flushHint, hint, sizeof(flushHint));
+    }
+    flushHintValid = hint != nullptr;
+    queuedFrames++;
+    flushFrame(display.getBufferPtr());
+#endif
+    return true;
+}
+
+void DisplayManager::setContrastLocked(uint8_t level) {
+    if (busMutex != nullptr) {
+        xSemaphoreTake(busMutex, portMAX_DELAY);
+        display.setContrast(level);
+        xSemaphoreGive(busMutex);
+    } else {
+        display.setContrast(level);
+    }
+}
+
+void DisplayManager::sendCommands(const uint8_t* commands, uint8_t length) {
+    if (busMutex != nullptr) {
+        xSemaphoreTake(busMutex, portMAX_DELAY);
+    }
+    
+    u8x8_t* u8x8 = display.getU8x8();
+    u8x8_cad_StartTransfer(u8x8);
+    for (uint8_t i = 0; i < length; i++) {
+        u8x8_cad_SendCmd(u8x8, commands[i]);
+    }
+    u8x8_cad_EndTransfer(u8x8);
+    
+    if (busMutex != nullptr) {
+        xSemaphoreGive(busMutex);
+    }
+}
+
+void DisplayManager::setPanelFade(uint8_t mode) {
+    uint8_t commands[PanelEffects::MAX_SEQUENCE_BYTES];
+    uint8_t length = PanelEffects::fade(commands, mode, SLEEP_FADE_FRAMES);
+    sendCommands(commands, length);
+}
+
+void DisplayManager::setPanelPower(bool on) {
+    // SSD1306：0xAE/0xAF 显示关/开，0x8D 电荷泵设置（0x10 关，0x14 开）
+    static const uint8_t PANEL_ON[] = {0x8D, 0x14, 0xAF};
+    static const uint8_t PANEL_OFF[] = {0xAE, 0x8D, 0x10};
+    
+    if (on) {
+        sendCommands(PANEL_ON, sizeof(PANEL_ON));
+    } else {
+        sendCommands(PANEL_OFF, sizeof(PANEL_OFF));
+    }
+    panelOn = on;
+}
+
+void DisplayManager::updateSleep(unsigned long now) {
+    // 过渡动画和静态画面发送完成后才开始计时
+    if (isTransitioning || forceRedraw) {
+        return;
+    }
+    if (sleepStage == SLEEP_STAGE_ENTERING) {
+        sleepStage = SLEEP_STAGE_BREATHING;
+        sleepStartTime = now;
+        lastBreathTime = now;
+#if OLED_HW_EFFECTS
+        // 屏幕自行渐暗、渐亮循环，之后不再发送对比度命令
+        setContrastLocked(SLEEP_BREATH_MAX);
+        setPanelFade(PanelEffects::FADE_BLINK);
+#endif
+    }
+    
+#if OLED_HW_EFFECTS
+    // 渐暗完成后关闭屏幕
+    if (sleepStage == SLEEP_STAGE_FADING_OUT) {
+        if (now - sleepStartTime >= SLEEP_FADE_OUT_MS) {
+            setPanelPower(false);
+            sleepStage = SLEEP_STAGE_PANEL_OFF;
+        }
+        return;
+    }
+#endif
+    
+    if (sleepStage != SLEEP_STAGE_BREATHING) {
+        return;
+    }
+    
+    // 长时间无操作：关闭屏幕和电荷泵
+    if (now - sleepStartTime >= SLEEP_PANEL_OFF_SEC * 1000UL) {
+#if OLED_HW_EFFECTS
+        // 先由屏幕渐暗到熄灭（渐暗阶段从此时重新计时）
+        setPanelFade(PanelEffects::FADE_OUT);
+        sleepStage = SLEEP_STAGE_FADING_OUT;
+        sleepStartTime = now;
+#else
+        setPanelPower(false);
+        sleepStage = SLEEP_STAGE_PANEL_OFF;
+#endif
+        return;
+    }
+    
+#if !OLED_HW_EFFECTS
+    // 呼吸：对比度按三角波步进，每步只发送一条对比度命令
+    if (now - lastBreathTime >= SLEEP_BREATH_STEP_MS) {
+        lastBreathTime = now;
+        breathStep = (breathStep + 1) % (2 * SLEEP_BREATH_STEPS);
+        uint8_t level = breathStep < SLEEP_BREATH_STEPS ? breathStep : 2 * SLEEP_BREATH_STEPS - breathStep;
+        setContrastLocked(SLEEP_BREATH_MIN + (SLEEP_BREATH_MAX - SLEEP_BREATH_MIN) * level / SLEEP_BREATH_STEPS);
+    }
+#endif
+}
+
+unsigned long DisplayManager::getSleepDeadline(unsigned long now) const {
+#if OLED_HW_EFFECTS
+    // 呼吸和渐暗由屏幕完成，只在开始渐暗和关屏时唤醒
+    unsigned long elapsed = now - sleepStartTime;
+    if (sleepStage == SLEEP_STAGE_BREATHING) {
+        return elapsed >= SLEEP_PANEL_OFF_SEC * 1000UL ? 0 : SLEEP_PANEL_OFF_SEC * 1000UL - elapsed;
+    }
+    if (sleepStage == SLEEP_STAGE_FADING_OUT) {
+        return elapsed >= SLEEP_FADE_OUT_MS ? 0 : SLEEP_FADE_OUT_MS - elapsed;
+    }
+    return DEADLINE_NONE;
+#else
+    if (sleepStage != SLEEP_STAGE_BREATHING) {
+        return DEADLINE_NONE;
+    }
+    unsigned long elapsed = now - lastBreathTime;
+    return elapsed >= SLEEP_BREATH_STEP_MS ? 0 : SLEEP_BREATH_STEP_MS - elapsed;
+#endif
+}
+
+void DisplayManager::flushTaskEntry(void* arg) {
+    DisplayManager* self = static_cast<DisplayManager*>(arg);
+    
+    for (;;) {
+        // 等待主循环提交新帧或灰度平面定时器到期
+        uint32_t events = 0;
+        xTaskNotifyWait(0, 0xFFFFFFFFUL, &events, portMAX_DELAY);
+        
+        // 灰度平面：退出灰度模式后残留的定时器通知直接忽略
+        if (events & FLUSH_NOTIFY_GRAY) {
+            xSemaphoreTake(self->busMutex, portMAX_DELAY);
+            if (self->grayActive) {
+                self->flushGrayPlane();
+            }
+            xSemaphoreGive(self->busMutex);
+        }
+        
+        if (events & FLUSH_NOTIFY_FRAME) {
+            xSemaphoreTake(self->busMutex, portMAX_DELAY);
+            self->flushFrame(self->frontBuffer);
+            xSemaphoreGive(self->busMutex);
+            
+            // 前缓冲发送完毕，允许下一次交换
+            xSemaphoreGive(self->frontFree);
+        }
+    }
+}
+
+void DisplayManager::grayTimerEntry(void* arg) {
+    DisplayManager* self = static_cast<DisplayManager*>(arg);
+    xTaskNotify(self->flushTask, FLUSH_NOTIFY_GRAY, eSetBits);
+}
+
+void DisplayManager::flushGrayPlane() {
+    // 记录平面开始发送的时刻（定时器节拍 + 任务切换延迟）
+    grayTiming.record(micros());
+    
+    GrayPlanes::renderPlane(grayFrame, graySprite, grayX, grayPage, grayPlaneIndex);
+    grayPlaneIndex = (grayPlaneIndex + 1) % GrayPlanes::PLANES;
+    
+    // 只有含中间灰度的tile在平面之间变化
+    memcpy(flushHint, grayTiles, sizeof(flushHint));
+    flushHintValid = true;
+    flushFrame(grayFrame);
+}
+
+void DisplayManager::flushFrame(uint8_t* frame) {
+    FrameBuffer::DirtyMask dirty;
+    bool hinted = flushHintValid;
+    flushHintValid = false;
+    
+    // 与屏幕上的内容逐tile比较，只发送有变化的tile
+    // 增量流帧已知可能变化的tile，只比较这些tile
+    uint8_t changed;
+    if (forceFullFlush) {
+        FrameBuffer::markAll(dirty);
+        forceFullFlush = false;
+        changed = FrameBuffer::TILE_ROWS * FrameBuffer::TILE_COLS;
+    } else if (hinted) {
+        memcpy(dirty, flushHint, sizeof(dirty));
+        changed = FrameBuffer::diffCandidateTiles(frame, shadowBuffer, dirty);
+    } else {
+        changed = FrameBuffer::diffTiles(frame, shadowBuffer, dirty);
+    }
+    if (changed == 0) {
+        // 画面没有变化，不占用I2C总线
+        lastFlushBytes = 0;
+        return;
+    }
+    
+    uint16_t bytes = 0;
+    for (uint8_t ty = 0; ty < FrameBuffer::TILE_ROWS; ty++) {
+        uint8_t tx = 0;
+        uint8_t length = 0;
+        // 同一行中连续的脏tile合并为一次传输
+        while (FrameBuffer::nextRun(dirty[ty], tx, length)) {
+            // 同一页中的tile在缓冲区中连续存放，直接从指定帧发送
+            uint16_t offset = ty * FrameBuffer::ROW_BYTES + tx * FrameBuffer::TILE_BYTES;
+            uint16_t runBytes = length * FrameBuffer::TILE_BYTES;
+            u8x8_DrawTile(display.getU8x8(), tx, ty, length, frame + offset);
+            
+            // 同步影子缓冲
+            memcpy(shadowBuffer + offset, frame + offset, runBytes);
+            bytes += runBytes;
+            tx += length;
+        }
+    }
+    
+    lastFlushBytes = bytes;
+    totalFlushBytes += bytes;
+    flushedFrames++;
 }
@@ -3,162 +3,82 @@
  */
 
 #include "FaceRenderer.h"
+#include "FaceSprites.h"
+#include "FaceAnimations.h"
+#include <esp_partition.h>
 
 // ============================================================================
-// 眼睛位图数据 (20x20 像素，每只眼睛 - 更大更可爱)
+// 默认表情布局（调整位置让表情更居中）
 // ============================================================================
-
-// 正常睁眼 - 大圆眼睛
-const uint8_t EYE_NORMAL_BITMAP[] PROGMEM = {
-    0x00, 0x00, 0x00, 0xE0, 0x07, 0x00, 0x18, 0x18, 0x00, 0x04, 0x20, 0x00,
-    0x02, 0x40, 0x00, 0xE2, 0x47, 0x00, 0xF1, 0x8F, 0x00, 0xF1, 0x8F, 0x00,
-    0xF1, 0x8F, 0x00, 0xF1, 0x8F, 0x00, 0xF1, 0x8F, 0x00, 0xE2, 0x47, 0x00,
-    0x02, 0x40, 0x00, 0x04, 0x20, 0x00, 0x18, 0x18, 0x00, 0xE0, 0x07, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
-// 眨眼帧1（半闭）
-const uint8_t EYE_BLINK_1[] PROGMEM = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x07, 0x00,
-    0x18, 0x18, 0x00, 0x04, 0x20, 0x00, 0xE2, 0x47, 0x00, 0xF1, 0x8F, 0x00,
-    0xF1, 0x8F, 0x00, 0xF1, 0x8F, 0x00, 0xE2, 0x47, 0x00, 0x04, 0x20, 0x00,
-    0x18, 0x18, 0x00, 0xE0, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
-// 眨眼帧2（更闭）
-const uint8_t EYE_BLINK_2[] PROGMEM = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0xE0, 0x07, 0x00, 0x18, 0x18, 0x00, 0xFC, 0x3F, 0x00,
-    0xFC, 0x3F, 0x00, 0xFC, 0x3F, 0x00, 0x18, 0x18, 0x00, 0xE0, 0x07, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
-// 眨眼帧3（闭眼）/ 睡眠闭眼 - 弯弯的眼睛
-const uint8_t EYE_CLOSED[] PROGMEM = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x06, 0x00, 0x00, 0x0E, 0x00, 0x00, 0xFC, 0x3F, 0x00, 0xF8, 0x1F, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
-// 看左（瞳孔偏左）
-const uint8_t EYE_LOOK_LEFT_BITMAP[] PROGMEM = {
-    0x00, 0x00, 0x00, 0xE0, 0x07, 0x00, 0x18, 0x18, 0x00, 0x04, 0x20, 0x00,
-    0x02, 0x40, 0x00, 0x72, 0x40, 0x00, 0x79, 0x80, 0x00, 0x79, 0x80, 0x00,
-    0x79, 0x80, 0x00, 0x79, 0x80, 0x00, 0x79, 0x80, 0x00, 0x72, 0x40, 0x00,
-    0x02, 0x40, 0x00, 0x04, 0x20, 0x00, 0x18, 0x18, 0x00, 0xE0, 0x07, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
-// 看右（瞳孔偏右）
-const uint8_t EYE_LOOK_RIGHT_BITMAP[] PROGMEM = {
-    0x00, 0x00, 0x00, 0xE0, 0x07, 0x00, 0x18, 0x18, 0x00, 0x04, 0x20, 0x00,
-    0x02, 0x40, 0x00, 0x02, 0x4E, 0x00, 0x01, 0x9E, 0x00, 0x01, 0x9E, 0x00,
-    0x01, 0x9E, 0x00, 0x01, 0x9E, 0x00, 0x01, 0x9E, 0x00, 0x02, 0x4E, 0x00,
-    0x02, 0x40, 0x00, 0x04, 0x20, 0x00, 0x18, 0x18, 0x00, 0xE0, 0x07, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+const FaceLayout DEFAULT_LAYOUT = {
+    .leftEyeX = FACE_LEFT_EYE_X,     // 左眼 X 坐标
+    .leftEyeY = FACE_EYE_Y,          // 左眼 Y 坐标
+    .rightEyeX = FACE_RIGHT_EYE_X,   // 右眼 X 坐标
+    .rightEyeY = FACE_EYE_Y,         // 右眼 Y 坐标
+    .mouthX = FACE_MOUTH_X,          // 嘴巴 X 坐标
+    .mouthY = FACE_MOUTH_Y           // 嘴巴 Y 坐标
 };
 
-// 开心眼睛 - 弯弯的笑眼
-const uint8_t EYE_HAPPY_BITMAP[] PROGMEM = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x06, 0x00, 0x00, 0x0E, 0x00, 0x00,
-    0x1C, 0x00, 0x00, 0xF8, 0x1F, 0x00, 0xF0, 0x0F, 0x00, 0xE0, 0x07, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
+// 说话动画帧间隔（毫秒）
+static const unsigned long TALKING_FRAME_MS = 200;
 
-// ============================================================================
-// 嘴巴位图数据 (40x16 像素 - 更宽更可爱)
-// ============================================================================
+// 随机看左右的间隔范围（毫秒）
+static const long LOOK_INTERVAL_MIN_MS = 8000;
+static const long LOOK_INTERVAL_MAX_MS = 15000;
 
-// 微笑 - 更圆润的弧线
-const uint8_t MOUTH_SMILE_BITMAP[] PROGMEM = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0xC0, 0x00,
-    0x03, 0x00, 0x00, 0xC0, 0x00, 0x06, 0x00, 0x00, 0x60, 0x00,
-    0x0C, 0x00, 0x00, 0x30, 0x00, 0x18, 0x00, 0x00, 0x18, 0x00,
-    0x70, 0x00, 0x00, 0x0E, 0x00, 0xE0, 0x01, 0x80, 0x07, 0x00,
-    0x80, 0x0F, 0xF0, 0x01, 0x00, 0x00, 0xFE, 0x7F, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+// 各眼睛状态对应的眼睛参数（睁开程度、瞳孔X、瞳孔Y、眯眼、大小），按 EyeState 顺序
+static const EyeModel::Params EYE_PRESETS[] = {
+    {EYE_Q8_ONE, 0, 0, 0, EYE_Q8_ONE},                  // EYE_NORMAL
+    {0, 0, 0, 0, EYE_Q8_ONE},                           // EYE_BLINK
+    {EYE_Q8_ONE, -3 * EYE_Q8_ONE, 0, 0, EYE_Q8_ONE},    // EYE_LOOK_LEFT
+    {EYE_Q8_ONE, 3 * EYE_Q8_ONE, 0, 0, EYE_Q8_ONE},     // EYE_LOOK_RIGHT
+    {0, 0, 0, 0, EYE_Q8_ONE}                            // EYE_SLEEP
 };
 
-// 大笑 - 张开的笑嘴
-const uint8_t MOUTH_LAUGH_BITMAP[] PROGMEM = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0x3F, 0x00, 0x00,
-    0x00, 0x03, 0xC0, 0x00, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00,
-    0x40, 0x00, 0x00, 0x02, 0x00, 0x20, 0x00, 0x00, 0x04, 0x00,
-    0x10, 0x00, 0x00, 0x08, 0x00, 0x10, 0x00, 0x00, 0x08, 0x00,
-    0x10, 0x00, 0x00, 0x08, 0x00, 0x20, 0x00, 0x00, 0x04, 0x00,
-    0x40, 0x00, 0x00, 0x02, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00,
-    0x00, 0x03, 0xC0, 0x00, 0x00, 0x00, 0xFC, 0x3F, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+// 口型同步各张嘴档位对应的嘴巴精灵（闭嘴、微张、张开、大张）
+static const PageSprite* const LIP_SYNC_SPRITES[LIPSYNC_LEVELS] = {
+    &MOUTH_NEUTRAL_SPRITE,
+    &MOUTH_TALKING_2_SPRITE,
+    &MOUTH_TALKING_1_SPRITE,
+    &MOUTH_SURPRISED_SPRITE
 };
 
-// 中性 - 小嘴
-const uint8_t MOUTH_NEUTRAL_BITMAP[] PROGMEM = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x1F, 0x00, 0x00,
-    0x00, 0xF8, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
-// 惊讶（O形嘴）
-const uint8_t MOUTH_SURPRISED_BITMAP[] PROGMEM = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x0F, 0x00, 0x00,
-    0x00, 0x0C, 0x30, 0x00, 0x00, 0x00, 0x03, 0xC0, 0x00, 0x00,
-    0x80, 0x00, 0x00, 0x01, 0x00, 0x40, 0x00, 0x00, 0x02, 0x00,
-    0x40, 0x00, 0x00, 0x02, 0x00, 0x40, 0x00, 0x00, 0x02, 0x00,
-    0x40, 0x00, 0x00, 0x02, 0x00, 0x80, 0x00, 0x00, 0x01, 0x00,
-    0x00, 0x03, 0xC0, 0x00, 0x00, 0x00, 0x0C, 0x30, 0x00, 0x00,
-    0x00, 0xF0, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+/**
+ * 预计算为增量流的空闲动画及其所在的动画层，按增量流序号
+ */
+struct IdleAnimation {
+    const Timeline::Animation* animation;
+    uint8_t layer;
 };
 
-// 说话帧1
-const uint8_t MOUTH_TALKING_1[] PROGMEM = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x07, 0x00, 0x00,
-    0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x06, 0x60, 0x00, 0x00,
-    0x00, 0x02, 0x40, 0x00, 0x00, 0x00, 0x02, 0x40, 0x00, 0x00,
-    0x00, 0x06, 0x60, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00,
-    0x00, 0xE0, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+static const IdleAnimation IDLE_ANIMATIONS[FACE_IDLE_ANIMATIONS] = {
+    {&BLINK_ANIMATION,      FACE_LAYER_BLINK},
+    {&LOOK_LEFT_ANIMATION,  FACE_LAYER_ACTION},
+    {&LOOK_RIGHT_ANIMATION, FACE_LAYER_ACTION},
+    {&REACTION_ANIMATION,   FACE_LAYER_REACTION}
 };
 
-// 说话帧2
-const uint8_t MOUTH_TALKING_2[] PROGMEM = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0xF8, 0x1F, 0x00, 0x00, 0x00, 0x06, 0x60, 0x00, 0x00,
-    0x00, 0x01, 0x80, 0x00, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00,
-    0x00, 0x06, 0x60, 0x00, 0x00, 0x00, 0xF8, 0x1F, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
+/**
+ * 表情包加载计时（微秒）
+ */
+static uint32_t packClock() {
+    return micros();
+}
 
+/**
+ * 粒子效果计时（微秒）
+ */
+static uint32_t particleClock() {
+    return micros();
+}
 
-// ============================================================================
-// 默认表情布局（调整位置让表情更居中）
-// ============================================================================
-const FaceLayout DEFAULT_LAYOUT = {
-    .leftEyeX = 20,      // 左眼 X 坐标
-    .leftEyeY = 12,      // 左眼 Y 坐标
-    .rightEyeX = 84,     // 右眼 X 坐标
-    .rightEyeY = 12,     // 右眼 Y 坐标
-    .mouthX = 44,        // 嘴巴 X 坐标
-    .mouthY = 42         // 嘴巴 Y 坐标
-};
+/**
+ * 计算从start开始持续duration的计时还剩多少毫秒
+ */
+static unsigned long remainingMs(unsigned long start, unsigned long duration, unsigned long now) {
+    unsigned long elapsed = now - start;
+    return elapsed >= duration ? 0 : duration - elapsed;
+}
 
 // ============================================================================
 // FaceRenderer 实现
@@ -169,16 +89,22 @@ FaceRenderer::FaceRenderer()
     , mouthState(MOUTH_SMILE)
     , lastBlinkTime(0)
     , nextBlinkInterval(5000)
-    , isBlinking(false)
-    , blinkFrame(0)
-    , blinkStartTime(0)
     , lastLookTime(0)
     , nextLookInterval(10000)
-    , isReacting(false)
-    , reactionStartTime(0)
-    , isWakingUp(false)
-    , wakeUpStartTime(0)
-    , wakeUpFrame(0)
+    , eyeParams(EYE_PRESETS[EYE_NORMAL])
+    , lastEyeUpdate(0)
+    , timeline()
+    , talkingFrame(0)
+    , lipSync(nullptr)
+    , lipSyncLive(false)
+    , lipSyncLevel()
+    , expressionPack()
+    , packFrame(0)
+    , particles()
+    , lastParticleUpdate(0)
+    , sleepStartTime(0)
+    , lastZTime(0)
+    , dirty(true)
     , layout(DEFAULT_LAYOUT) {
 }
 
@@ -191,8 +117,24 @@ void FaceRenderer::init() {
     lastBlinkTime = millis();
     
     // 设置初始看左右间隔
-    nextLookInterval = random(8000, 15000);
+    nextLookInterval = random(LOOK_INTERVAL_MIN_MS, LOOK_INTERVAL_MAX_MS);
     lastLookTime = millis();
+    
+    // 粒子数按每帧耗时预算换算
+    particles.begin(particleClock, PARTICLE_BUDGET_US);
+    
+    // 映射表情包分区（只读，映射后一直有效）
+    const esp_partition_t* partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, EXPRESSION_PARTITION_LABEL);
+    const void* mapped = nullptr;
+    esp_partition_mmap_handle_t handle;
+    if (partition == nullptr ||
+        esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA, &mapped, &handle) != ESP_OK ||
+        !expressionPack.begin(static_cast<const uint8_t*>(mapped), partition->size, packClock)) {
+        Serial.println("[FaceRenderer] 未找到表情包，只使用内置表情");
+        return;
+    }
+    Serial.printf("[FaceRenderer] 表情包: %u 个表情\n", expressionPack.getExpressionCount());
 }
 
 unsigned long FaceRenderer::generateBlinkInterval() {
@@ -211,46 +153,193 @@ void FaceRenderer::render(U8G2* display) {
     
     // 绘制嘴巴
     drawMouth(display);
+    
+    // 睡眠时绘制 "zZ"（呼吸效果由DisplayManager通过对比度实现）
+    if (eyeState == EYE_SLEEP) {
+        drawSleepMark(display);
+    }
+    
+    // 粒子效果叠加在表情之上
+    particles.render(display->getBufferPtr());
+    
+    dirty = false;
 }
 
 void FaceRenderer::updateAnimation() {
-    // 如果在睡眠状态，不执行动画更新
-    if (eyeState == EYE_SLEEP && !isWakingUp) {
+    unsigned long now = millis();
+    
+    // 粒子效果在睡眠中也推进
+    updateParticles(now);
+    
+    // 如果在睡眠状态，不执行其他动画更新
+    if (eyeState == EYE_SLEEP) {
         return;
     }
     
-    // 处理唤醒动画
-    if (isWakingUp) {
-        handleWakeUpAnimation();
-        return;
+    MouthState prevMouth = getDisplayedMouth();
+    uint8_t prevTalkingFrame = talkingFrame;
+    talkingFrame = (now / TALKING_FRAME_MS) % 2;
+    uint8_t prevPackFrame = packFrame;
+    if (expressionPack.getSpriteCount() > 1) {
+        packFrame = (now / expressionPack.getFrameMs()) % expressionPack.getSpriteCount();
     }
     
-    // 处理触摸反应动画
-    if (isReacting) {
-        handleReactionAnimation();
-        return;
+    // 随机眨眼和看左右（只是按时间启动对应的动画）
+    scheduleBlink(now);
+    scheduleRandomLook(now);
+    
+    // 推进关键帧动画
+    bool changed = timeline.update(now);
+    
+    // 口型同步（只在说话嘴型时跟随音量）
+    bool lipSyncChanged = updateLipSync(now);
+    
+    // 基础眼睛参数向目标插值（长时间静止后的第一帧按一帧的时间计算，避免跳变）
+    unsigned long eyeElapsed = now - lastEyeUpdate;
+    if (eyeElapsed > ANIMATION_FRAME_MS) {
+        eyeElapsed = ANIMATION_FRAME_MS;
+    }
+    changed |= EyeModel::approach(eyeParams, getEyeTarget(), eyeElapsed);
+    lastEyeUpdate = now;
+    
+    MouthState mouth = getDisplayedMouth();
+    if (changed || mouth != prevMouth ||
+        (mouth == MOUTH_TALKING && (lipSyncChanged || (!lipSyncLive && talkingFrame != prevTalkingFrame))) ||
+        (usePackMouth() && packFrame != prevPackFrame)) {
+        dirty = true;
+    }
+}
+
+bool FaceRenderer::isDirty() const {
+    return dirty;
+}
+
+void FaceRenderer::markDirty() {
+    dirty = true;
+}
+
+void FaceRenderer::markRendered() {
+    dirty = false;
+}
+
+int8_t FaceRenderer::getIdleFrame(unsigned long now, uint32_t& elapsed) const {
+    if (eyeState != EYE_NORMAL || mouthState != MOUTH_SMILE || expressionPack.getActive() >= 0 ||
+        particles.isActive() || !EyeModel::equals(eyeParams, EYE_PRESETS[EYE_NORMAL])) {
+        return FACE_IDLE_NONE;
     }
     
-    // 处理眨眼动画
-    handleBlinkAnimation();
+    int8_t idle = FACE_IDLE_BASE;
+    for (uint8_t layer = 0; layer < TIMELINE_LAYERS; layer++) {
+        const Timeline::Animation* animation = timeline.current(layer);
+        if (animation == nullptr) {
+            continue;
+        }
+        // 多段动画叠加（如看左右时眨眼）的组合没有预计算
+        if (idle != FACE_IDLE_BASE) {
+            return FACE_IDLE_NONE;
+        }
+        idle = FACE_IDLE_NONE;
+        for (uint8_t i = 0; i < FACE_IDLE_ANIMATIONS; i++) {
+            if (IDLE_ANIMATIONS[i].animation == animation && IDLE_ANIMATIONS[i].layer == layer) {
+                idle = (int8_t)i;
+            }
+        }
+        if (idle == FACE_IDLE_NONE) {
+            return FACE_IDLE_NONE;
+        }
+        elapsed = timeline.elapsed(layer, now);
+    }
+    return idle;
+}
+
+void FaceRenderer::renderIdleFrame(U8G2* display, uint8_t index, uint32_t elapsed) {
+    const IdleAnimation& idle = IDLE_ANIMATIONS[index];
+    timeline.play(idle.layer, *idle.animation, 0);
+    timeline.update(elapsed);
+    render(display);
+    timeline.stop(idle.layer);
+}
+
+const Timeline::Animation& FaceRenderer::getIdleAnimation(uint8_t index) {
+    return *IDLE_ANIMATIONS[index].animation;
+}
+
+unsigned long FaceRenderer::getNextDeadline(unsigned long now) const {
+    // 睡眠中只有粒子效果
+    unsigned long particleNext = getParticleDeadline(now);
+    if (eyeState == EYE_SLEEP) {
+        return particleNext;
+    }
+    
+    // 关键帧动画：跳变区间等到下一个关键帧，插值区间按动画帧率
+    unsigned long next = timeline.getNextDeadline(now, lastEyeUpdate, ANIMATION_FRAME_MS);
+    if (particleNext < next) {
+        next = particleNext;
+    }
+    
+    // 随机眨眼和看左右
+    if (!timeline.isPlaying(FACE_LAYER_BLINK)) {
+        unsigned long blinkNext = remainingMs(lastBlinkTime, nextBlinkInterval, now);
+        if (blinkNext < next) {
+            next = blinkNext;
+        }
+    }
+    if (!timeline.isPlaying(FACE_LAYER_ACTION)) {
+        unsigned long lookNext = remainingMs(lastLookTime, nextLookInterval, now);
+        if (lookNext < next) {
+            next = lookNext;
+        }
+    }
+    
+    // 基础眼睛参数插值
+    if (!EyeModel::equals(eyeParams, getEyeTarget())) {
+        unsigned long eyeNext = remainingMs(lastEyeUpdate, ANIMATION_FRAME_MS, now);
+        if (eyeNext < next) {
+            next = eyeNext;
+        }
+    }
+    
+    // 说话动画：口型同步时每帧读取一次包络（延迟不超过一帧），否则按固定帧间隔切换
+    if (getDisplayedMouth() == MOUTH_TALKING) {
+        unsigned long talkingNext = TALKING_FRAME_MS - (now % TALKING_FRAME_MS);
+        if (lipSync != nullptr) {
+            unsigned long frameNext = remainingMs(lastEyeUpdate, ANIMATION_FRAME_MS, now);
+            if (frameNext < talkingNext) {
+                talkingNext = frameNext;
+            }
+        }
+        if (talkingNext < next) {
+            next = talkingNext;
+        }
+    }
     
-    // 处理随机看左右
-    if (!isBlinking) {
-        handleRandomLook();
+    // 表情包嘴巴帧
+    if (usePackMouth() && expressionPack.getSpriteCount() > 1) {
+        unsigned long frameMs = expressionPack.getFrameMs();
+        unsigned long packNext = frameMs - (now % frameMs);
+        if (packNext < next) {
+            next = packNext;
+        }
     }
+    
+    return next;
 }
 
 void FaceRenderer::setExpression(Expression expr) {
+    clearPackExpression();
     eyeState = expr.eyes;
     mouthState = expr.mouth;
+    dirty = true;
 }
 
 void FaceRenderer::setEyeState(EyeState state) {
     eyeState = state;
+    dirty = true;
 }
 
 void FaceRenderer::setMouthState(MouthState state) {
     mouthState = state;
+    dirty = true;
 }
 
 EyeState FaceRenderer::getEyeState() const {
@@ -261,95 +350,187 @@ MouthState FaceRenderer::getMouthState() const {
     return mouthState;
 }
 
+bool FaceRenderer::playAnimation(const Timeline::Animation& animation, uint8_t layer, bool queue) {
+    bool accepted = true;
+    if (queue) {
+        accepted = timeline.enqueue(layer, animation, millis());
+    } else {
+        timeline.play(layer, animation, millis());
+    }
+    dirty = true;
+    return accepted;
+}
+
+bool FaceRenderer::showPackExpression(uint16_t index) {
+    if (eyeState == EYE_SLEEP) {
+        return false;
+    }
+    // 加载会覆盖缓存中的关键帧，先停止正在播放的表情包动画
+    if (expressionPack.getActive() != (int32_t)index) {
+        clearPackExpression();
+    }
+    if (!expressionPack.load(index)) {
+        return false;
+    }
+    
+    packFrame = 0;
+    const Timeline::Animation* animation = expressionPack.getAnimation();
+    if (animation != nullptr) {
+        playAnimation(*animation, FACE_LAYER_ACTION);
+    }
+    dirty = true;
+    return true;
+}
+
+bool FaceRenderer::nextPackExpression() {
+    int32_t next = expressionPack.getActive() + 1;
+    if (next >= expressionPack.getExpressionCount()) {
+        clearPackExpression();
+        return false;
+    }
+    return showPackExpression((uint16_t)next);
+}
+
+void FaceRenderer::clearPackExpression() {
+    if (expressionPack.getActive() < 0) {
+        return;
+    }
+    // 表情包动画的关键帧在缓存中，卸载前先停止
+    if (timeline.current(FACE_LAYER_ACTION) == expressionPack.getAnimation()) {
+        timeline.stop(FACE_LAYER_ACTION);
+    }
+    expressionPack.unload();
+    dirty = true;
+}
+
+const ExpressionPack& FaceRenderer::getExpressionPack() const {
+    return expressionPack;
+}
+
+void FaceRenderer::setLipSyncSource(const LipSync::Channel* channel) {
+    lipSync = channel;
+    lipSyncLive = false;
+    lipSyncLevel.reset();
+    dirty = true;
+}
+
 void FaceRenderer::triggerBlink() {
-    if (!isBlinking && eyeState != EYE_SLEEP) {
-        isBlinking = true;
-        blinkFrame = 0;
-        blinkStartTime = millis();
+    if (!timeline.isPlaying(FACE_LAYER_BLINK) && eyeState != EYE_SLEEP) {
+        playAnimation(BLINK_ANIMATION, FACE_LAYER_BLINK);
     }
 }
 
 void FaceRenderer::triggerReaction() {
-    if (!isReacting && eyeState != EYE_SLEEP) {
-        isReacting = true;
-        reactionStartTime = millis();
-        // 显示惊讶表情
-        mouthState = MOUTH_SURPRISED;
+    // 反应层独立于眨眼层，眨眼过程中触摸会与眨眼叠加
+    if (!timeline.isPlaying(FACE_LAYER_REACTION) && eyeState != EYE_SLEEP) {
+        playAnimation(REACTION_ANIMATION, FACE_LAYER_REACTION);
+        // 从嘴巴上方飘起几颗爱心
+        particles.emit(PARTICLE_HEART, layout.mouthX + MOUTH_WIDTH / 2 - 2, layout.mouthY - 2, 4);
+    }
+}
+
+void FaceRenderer::speak() {
+    if (eyeState != EYE_SLEEP) {
+        playAnimation(SPEAK_ANIMATION, FACE_LAYER_REACTION);
+    }
+}
+
+void FaceRenderer::celebrate() {
+    if (eyeState == EYE_SLEEP) {
+        return;
     }
+    // 彩纸从屏幕上方中央炸开
+    particles.emit(PARTICLE_CONFETTI, OLED_WIDTH / 2, 8, 32);
+    dirty = true;
+}
+
+bool FaceRenderer::hasParticles() const {
+    return particles.isActive();
+}
+
+const ParticleSystem& FaceRenderer::getParticles() const {
+    return particles;
 }
 
 void FaceRenderer::enterSleep() {
+    clearPackExpression();
     eyeState = EYE_SLEEP;
     mouthState = MOUTH_NEUTRAL;
-    isBlinking = false;
-    isReacting = false;
+    for (uint8_t layer = 0; layer < TIMELINE_LAYERS; layer++) {
+        timeline.stop(layer);
+    }
+    eyeParams = EYE_PRESETS[EYE_SLEEP];
+    
+    // 清除表情上的粒子，之后一段时间内飘落 "z"
+    particles.clear();
+    sleepStartTime = millis();
+    lastZTime = sleepStartTime;
+    dirty = true;
 }
 
 void FaceRenderer::wakeUp() {
-    isWakingUp = true;
-    wakeUpStartTime = millis();
-    wakeUpFrame = 0;
+    // 基础状态直接切换为正常，唤醒动画在动作层上覆盖眼睛和嘴巴
+    particles.clear();
+    eyeState = EYE_NORMAL;
+    mouthState = MOUTH_SMILE;
+    playAnimation(WAKE_UP_ANIMATION, FACE_LAYER_ACTION);
+    
+    // 唤醒动画结束后才开始下一次眨眼计时
+    lastBlinkTime = millis();
+    nextBlinkInterval = Timeline::duration(WAKE_UP_ANIMATION) + generateBlinkInterval();
 }
 
 void FaceRenderer::drawEyes(U8G2* display) {
-    const uint8_t* eyeBitmap = nullptr;
-    
-    // 根据当前状态选择眼睛位图
-    if (isBlinking) {
-        // 眨眼动画帧
-        switch (blinkFrame) {
-            case 0:
-                eyeBitmap = EYE_BLINK_1;
-                break;
-            case 1:
-                eyeBitmap = EYE_BLINK_2;
-                break;
-            case 2:
-                eyeBitmap = EYE_CLOSED;
-                break;
-            case 3:
-                eyeBitmap = EYE_BLINK_2;
-                break;
-            case 4:
-                eyeBitmap = EYE_BLINK_1;
-                break;
-            default:
-                eyeBitmap = EYE_NORMAL_BITMAP;
-                break;
-        }
-    } else {
-        switch (eyeState) {
-            case EYE_NORMAL:
-                eyeBitmap = EYE_NORMAL_BITMAP;
-                break;
-            case EYE_BLINK:
-                eyeBitmap = EYE_CLOSED;
-                break;
-            case EYE_LOOK_LEFT:
-                eyeBitmap = EYE_LOOK_LEFT_BITMAP;
-                break;
-            case EYE_LOOK_RIGHT:
-                eyeBitmap = EYE_LOOK_RIGHT_BITMAP;
-                break;
-            case EYE_SLEEP:
-                eyeBitmap = EYE_CLOSED;
-                break;
-            default:
-                eyeBitmap = EYE_NORMAL_BITMAP;
-                break;
-        }
-    }
+    // 基础参数叠加关键帧动画（眨眼、反应、动作）
+    EyeModel::Params params = eyeParams;
+    uint8_t mouth = mouthState;
+    timeline.apply(params, mouth);
+    
+    uint8_t* buffer = display->getBufferPtr();
     
-    // 绘制左眼（20x20 像素）
-    display->drawXBMP(layout.leftEyeX, layout.leftEyeY, 20, 20, eyeBitmap);
+    // 按列扫描直接填充页格式缓冲（眼睛中心位于原20x20区域内）
+    EyeModel::render(buffer, layout.leftEyeX + EYE_RADIUS, layout.leftEyeY + EYE_RADIUS, params);
+    EyeModel::render(buffer, layout.rightEyeX + EYE_RADIUS, layout.rightEyeY + EYE_RADIUS, params);
+}
+
+bool FaceRenderer::updateLipSync(unsigned long now) {
+    if (lipSync == nullptr || getDisplayedMouth() != MOUTH_TALKING) {
+        return false;
+    }
     
-    // 绘制右眼（20x20 像素）
-    display->drawXBMP(layout.rightEyeX, layout.rightEyeY, 20, 20, eyeBitmap);
+    // 没有新包络（音频未播放或已停止）时回到定时交替的说话动画
+    LipSync::Envelope envelope;
+    bool live = lipSync->read(now, envelope);
+    bool changed = live != lipSyncLive;
+    lipSyncLive = live;
+    if (!live) {
+        lipSyncLevel.reset();
+        return changed;
+    }
+    return lipSyncLevel.update(LipSync::levelFor(envelope), now) || changed;
+}
+
+const EyeModel::Params& FaceRenderer::getEyeTarget() const {
+    if (expressionPack.getActive() >= 0 && eyeState != EYE_SLEEP) {
+        return expressionPack.getEyeParams();
+    }
+    return EYE_PRESETS[eyeState];
+}
+
+bool FaceRenderer::usePackMouth() const {
+    return expressionPack.getSpriteCount() > 0 && getDisplayedMouth() == mouthState;
+}
+
+MouthState FaceRenderer::getDisplayedMouth() const {
+    EyeModel::Params params = eyeParams;
+    uint8_t mouth = mouthState;
+    timeline.apply(params, mouth);
+    return (MouthState)mouth;
 }
 
 void FaceRenderer::drawBlush(U8G2* display) {
     // 只在开心或正常状态显示腮红
-    if (mouthState == MOUTH_SMILE || eyeState == EYE_NORMAL) {
+    if (getDisplayedMouth() == MOUTH_SMILE || eyeState == EYE_NORMAL) {
         // 左腮红（小椭圆）
         display->drawEllipse(14, 30, 4, 3, U8G2_DRAW_ALL);
         
@@ -358,127 +539,102 @@ void FaceRenderer::drawBlush(U8G2* display) {
     }
 }
 
+void FaceRenderer::drawSleepMark(U8G2* display) {
+    display->setFont(u8g2_font_6x10_tf);
+    display->drawStr(108, 12, "z");
+    display->drawStr(116, 8, "Z");
+}
+
 void FaceRenderer::drawMouth(U8G2* display) {
-    const uint8_t* mouthBitmap = nullptr;
+    const PageSprite* mouthSprite = nullptr;
     
-    // 根据当前状态选择嘴巴位图
-    switch (mouthState) {
+    // 表情包中的嘴巴帧（已解压在RAM缓存中）
+    if (usePackMouth()) {
+        mouthSprite = expressionPack.getSprite(packFrame);
+        blitPageSprite(display->getBufferPtr(), layout.mouthX, layout.mouthY, *mouthSprite);
+        return;
+    }
+    
+    // 根据当前状态（叠加动画后）选择嘴巴精灵
+    switch (getDisplayedMouth()) {
         case MOUTH_SMILE:
-            mouthBitmap = MOUTH_SMILE_BITMAP;
+            mouthSprite = &MOUTH_SMILE_SPRITE;
             break;
         case MOUTH_NEUTRAL:
-            mouthBitmap = MOUTH_NEUTRAL_BITMAP;
+            mouthSprite = &MOUTH_NEUTRAL_SPRITE;
             break;
         case MOUTH_SURPRISED:
-            mouthBitmap = MOUTH_SURPRISED_BITMAP;
+            mouthSprite = &MOUTH_SURPRISED_SPRITE;
             break;
         case MOUTH_TALKING:
-            // 说话动画：交替显示两帧
-            if ((millis() / 200) % 2 == 0) {
-                mouthBitmap = MOUTH_TALKING_1;
+            // 口型同步：播放声音时按音量选择张嘴档位，否则交替显示两帧
+            if (lipSync != nullptr && lipSyncLive) {
+                mouthSprite = LIP_SYNC_SPRITES[lipSyncLevel.getLevel()];
+            } else if (talkingFrame == 0) {
+                mouthSprite = &MOUTH_TALKING_1_SPRITE;
             } else {
-                mouthBitmap = MOUTH_TALKING_2;
+                mouthSprite = &MOUTH_TALKING_2_SPRITE;
             }
             break;
         default:
-            mouthBitmap = MOUTH_SMILE_BITMAP;
+            mouthSprite = &MOUTH_SMILE_SPRITE;
             break;
     }
     
-    // 绘制嘴巴（40x16 像素）
-    display->drawXBMP(layout.mouthX, layout.mouthY, 40, 16, mouthBitmap);
+    // 绘制嘴巴（40x16 像素，页格式整块复制）
+    blitPageSprite(display->getBufferPtr(), layout.mouthX, layout.mouthY, *mouthSprite);
 }
 
-void FaceRenderer::handleBlinkAnimation() {
-    unsigned long currentTime = millis();
-    
-    if (isBlinking) {
-        // 眨眼动画进行中
-        unsigned long elapsed = currentTime - blinkStartTime;
-        uint8_t newFrame = elapsed / (BLINK_DURATION_MS / 5);
-        
-        if (newFrame != blinkFrame) {
-            blinkFrame = newFrame;
-        }
-        
-        // 眨眼动画结束
-        if (elapsed >= BLINK_DURATION_MS) {
-            isBlinking = false;
-            blinkFrame = 0;
-            lastBlinkTime = currentTime;
-            nextBlinkInterval = generateBlinkInterval();
-        }
-    } else {
-        // 检查是否需要触发眨眼
-        if (currentTime - lastBlinkTime >= nextBlinkInterval) {
-            triggerBlink();
-        }
+void FaceRenderer::updateParticles(unsigned long now) {
+    // 睡眠开始后的一段时间内，从右上方定时落下 "z"
+    if (eyeState == EYE_SLEEP && now - sleepStartTime < PARTICLE_SLEEP_MS &&
+        now - lastZTime >= PARTICLE_Z_INTERVAL_MS) {
+        lastZTime = now;
+        particles.emit(PARTICLE_Z, OLED_WIDTH - 20, -4, 1);
     }
-}
-
-void FaceRenderer::handleRandomLook() {
-    unsigned long currentTime = millis();
     
-    // 如果眼睛正在看左或看右，检查是否需要恢复正常
-    if (eyeState == EYE_LOOK_LEFT || eyeState == EYE_LOOK_RIGHT) {
-        if (currentTime - lastLookTime >= 1000) {  // 看1秒后恢复
-            eyeState = EYE_NORMAL;
-            lastLookTime = currentTime;
-            nextLookInterval = random(8000, 15000);
-        }
+    if (!particles.isActive() || now - lastParticleUpdate < ANIMATION_FRAME_MS) {
         return;
     }
+    lastParticleUpdate = now;
+    particles.update();
     
-    // 检查是否需要随机看左右
-    if (currentTime - lastLookTime >= nextLookInterval) {
-        // 随机决定看左还是看右
-        if (random(2) == 0) {
-            eyeState = EYE_LOOK_LEFT;
-        } else {
-            eyeState = EYE_LOOK_RIGHT;
-        }
-        lastLookTime = currentTime;
-    }
+    // 最后一个粒子消失后也要再出一帧擦除
+    dirty = true;
 }
 
-void FaceRenderer::handleReactionAnimation() {
-    unsigned long elapsed = millis() - reactionStartTime;
-    
-    // 反应动画持续500ms
-    if (elapsed >= 500) {
-        isReacting = false;
-        mouthState = MOUTH_SMILE;  // 恢复微笑
+unsigned long FaceRenderer::getParticleDeadline(unsigned long now) const {
+    if (particles.isActive()) {
+        return remainingMs(lastParticleUpdate, ANIMATION_FRAME_MS, now);
+    }
+    if (eyeState == EYE_SLEEP && now - sleepStartTime < PARTICLE_SLEEP_MS) {
+        return remainingMs(lastZTime, PARTICLE_Z_INTERVAL_MS, now);
     }
+    return DEADLINE_NONE;
 }
 
-void FaceRenderer::handleWakeUpAnimation() {
-    unsigned long elapsed = millis() - wakeUpStartTime;
-    
-    // 唤醒动画分为几个阶段，总共1.5秒
-    if (elapsed < 300) {
-        // 阶段1：眼睛半开
-        eyeState = EYE_BLINK;
-        mouthState = MOUTH_NEUTRAL;
-    } else if (elapsed < 600) {
-        // 阶段2：眼睛睁开，打哈欠
-        eyeState = EYE_NORMAL;
-        mouthState = MOUTH_SURPRISED;
-    } else if (elapsed < 1000) {
-        // 阶段3：伸懒腰（眼睛闭上）
-        eyeState = EYE_BLINK;
-        mouthState = MOUTH_TALKING;
-    } else if (elapsed < 1500) {
-        // 阶段4：恢复正常
-        eyeState = EYE_NORMAL;
-        mouthState = MOUTH_SMILE;
-    } else {
-        // 动画结束
-        isWakingUp = false;
-        eyeState = EYE_NORMAL;
-        mouthState = MOUTH_SMILE;
-        
-        // 重置眨眼计时器
-        lastBlinkTime = millis();
+void FaceRenderer::scheduleBlink(unsigned long now) {
+    // 眨眼结束后（眨眼层空闲）开始计时，到达随机间隔时眨眼
+    if (timeline.isPlaying(FACE_LAYER_BLINK)) {
+        lastBlinkTime = now;
+        return;
+    }
+    if (now - lastBlinkTime >= nextBlinkInterval) {
+        triggerBlink();
+        lastBlinkTime = now;
         nextBlinkInterval = generateBlinkInterval();
     }
 }
+
+void FaceRenderer::scheduleRandomLook(unsigned long now) {
+    // 动作层被其他动画（如唤醒）占用时不看左右
+    if (timeline.isPlaying(FACE_LAYER_ACTION)) {
+        lastLookTime = now;
+        return;
+    }
+    if (now - lastLookTime >= nextLookInterval) {
+        playAnimation(random(2) == 0 ? LOOK_LEFT_ANIMATION : LOOK_RIGHT_ANIMATION, FACE_LAYER_ACTION);
+        lastLookTime = now;
+        nextLookInterval = random(LOOK_INTERVAL_MIN_MS, LOOK_INTERVAL_MAX_MS);
+    }
+}
@@ -0,0 +1,228 @@
+/**
+ * 智能桌面伴侣 - 空闲管理器实现
+ */
+
+#include "IdleManager.h"
+
+#ifndef UNIT_TEST
+#include <esp_timer.h>
+#include <esp_sleep.h>
+#include <esp_pm.h>
+#include <esp_freertos_hooks.h>
+#include <driver/gpio.h>
+#endif
+
+// 系统节拍中断中采样：当前运行的不是空闲任务时计为忙
+static TaskHandle_t idleTask = nullptr;
+static volatile uint32_t busyTicks = 0;
+
+#ifndef UNIT_TEST
+static void IRAM_ATTR onIdleSampleTick() {
+    if (xTaskGetCurrentTaskHandle() != idleTask) {
+        busyTicks = busyTicks + 1;
+    }
+}
+#endif
+
+IdleManager::IdleManager()
+    : _autoLightSleep(false)
+    , _lightSleepAllowed(false)
+    , _wakeMicros(0)
+    , _touchWake(false)
+    , _periodStart(0)
+    , _periodBusyTicks(0)
+    , _lightSleepMicros(0)
+    , _lightSleeps(0) {
+    for (uint8_t i = 0; i <= DEADLINE_SOURCE_COUNT; i++) {
+        _wakeups[i] = 0;
+    }
+    for (uint8_t i = 0; i < IDLE_SLOT_COUNT; i++) {
+        _taskWakeAt[i] = 0;
+        _tasks[i] = nullptr;
+    }
+}
+
+void IdleManager::init() {
+#ifndef UNIT_TEST
+    idleTask = xTaskGetIdleTaskHandle();
+    esp_register_freertos_tick_hook(onIdleSampleTick);
+    _periodStart = esp_timer_get_time();
+    _periodBusyTicks = busyTicks;
+    
+#if IDLE_LIGHT_SLEEP && CONFIG_PM_ENABLE && CONFIG_FREERTOS_USE_TICKLESS_IDLE
+    // 所有任务都阻塞超过几个节拍时由系统进入light sleep，WiFi按DTIM间隔醒来保持连接
+    esp_pm_config_esp32c3_t pm = {};
+    pm.max_freq_mhz = PM_MAX_FREQ_MHZ;
+    pm.min_freq_mhz = PM_MIN_FREQ_MHZ;
+    pm.light_sleep_enable = true;
+    _autoLightSleep = esp_pm_configure(&pm) == ESP_OK;
+#endif
+    
+    Serial.printf("[IdleManager] 空闲方式: %s\n", _autoLightSleep ? "自动light sleep (tickless idle)" :
+                  IDLE_LIGHT_SLEEP ? "阻塞等待，关屏关闭WiFi后light sleep" : "阻塞等待");
+#endif
+}
+
+bool IdleManager::idle(const DeadlineSet& deadlines, bool allowLightSleep) {
+    uint32_t waitMs = deadlines.getWait(IDLE_MAX_WAIT_MS);
+    if (waitMs == 0) {
+        return false;
+    }
+    
+#if IDLE_LIGHT_SLEEP && !defined(UNIT_TEST)
+    if (allowLightSleep && !_autoLightSleep && waitMs >= LIGHT_SLEEP_MIN_MS) {
+        Serial.flush();
+        bool touched = lightSleep(waitMs);
+        _wakeups[touched ? (uint8_t)DEADLINE_TOUCH : deadlines.getSource()]++;
+        return touched;
+    }
+#endif
+    
+    // 触摸的边沿中断通知提前结束等待
+    bool notified = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs)) != 0;
+    _wakeups[notified ? (uint8_t)DEADLINE_TOUCH : deadlines.getSource()]++;
+    return false;
+}
+
+void IdleManager::setLightSleepAllowed(bool allowed) {
+    _lightSleepAllowed = allowed;
+}
+
+bool IdleManager::isLightSleepAllowed() const {
+    return _lightSleepAllowed && !_autoLightSleep;
+}
+
+uint32_t IdleManager::waitTask(uint8_t slot, uint32_t waitMs) {
+    _tasks[slot] = xTaskGetCurrentTaskHandle();
+    _taskWakeAt[slot] = millis() + waitMs;
+    return ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs));
+}
+
+bool IdleManager::sleepTasks() {
+#if IDLE_LIGHT_SLEEP && !defined(UNIT_TEST)
+    // 睡眠期间串口时钟停止，先把缓冲的日志发完（暂停调度后不能再阻塞）
+    Serial.flush();
+    
+    // 暂停调度：检查登记的时刻到进入睡眠之间，被中断唤醒的任务只能排队，不会改写登记后被错过
+    vTaskSuspendAll();
+    unsigned long now = millis();
+    uint32_t waitMs = IDLE_MAX_WAIT_MS;
+    for (uint8_t i = 0; i < IDLE_SLOT_COUNT; i++) {
+        if (_tasks[i] == nullptr) {
+            continue;
+        }
+        int32_t remaining = (int32_t)(_taskWakeAt[i] - now);
+        uint32_t slotWait = remaining > 0 ? (uint32_t)remaining : 0;
+        if (slotWait < waitMs) {
+            waitMs = slotWait;
+        }
+    }
+    bool slept = _lightSleepAllowed && waitMs >= LIGHT_SLEEP_MIN_MS;
+    if (slept) {
+        lightSleep(waitMs);
+    }
+    xTaskResumeAll();
+    return slept;
+#else
+    return false;
+#endif
+}
+
+void IdleManager::wakeTasks() {
+    for (uint8_t i = 0; i < IDLE_SLOT_COUNT; i++) {
+        if (_tasks[i] != nullptr) {
+            xTaskNotifyGive(_tasks[i]);
+        }
+    }
+}
+
+bool IdleManager::wasTouchWake() const {
+    return _touchWake;
+}
+
+bool IdleManager::lightSleep(uint32_t waitMs) {
+#ifndef UNIT_TEST
+    gpio_num_t pin = (gpio_num_t)TOUCH_PIN;
+    
+    // 唤醒配置会把引脚改成电平触发：先关掉边沿中断，否则唤醒后按住期间会反复进入中断
+    gpio_intr_disable(pin);
+    gpio_wakeup_enable(pin, GPIO_INTR_HIGH_LEVEL);
+    esp_sleep_enable_gpio_wakeup();
+    esp_sleep_enable_timer_wakeup((uint64_t)waitMs * 1000ULL);
+    
+    int64_t start = esp_timer_get_time();
+    esp_light_sleep_start();
+    int64_t end = esp_timer_get_time();
+    bool touched = esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_GPIO;
+    
+    // 恢复上升沿中断
+    gpio_wakeup_disable(pin);
+    gpio_set_intr_type(pin, GPIO_INTR_POSEDGE);
+    gpio_intr_enable(pin);
+    
+    _lightSleepMicros += end - start;
+    _lightSleeps++;
+    _touchWake = touched;
+    if (touched) {
+        _wakeMicros = end;
+    }
+    return touched;
+#else
+    return false;
+#endif
+}
+
+int64_t IdleManager::getWakeMicros() const {
+    return _wakeMicros;
+}
+
+bool IdleManager::isAutoLightSleep() const {
+    return _autoLightSleep;
+}
+
+void IdleManager::report() {
+#ifndef UNIT_TEST
+    int64_t now = esp_timer_get_time();
+    uint32_t ticks = busyTicks;
+    int64_t elapsed = now - _periodStart;
+    if (elapsed <= 0) {
+        return;
+    }
+    
+    // 忙的时间按节拍数估算（每个节拍 portTICK_PERIOD_MS），其余为空闲
+    int64_t busyMicros = (int64_t)(ticks - _periodBusyTicks) * portTICK_PERIOD_MS * 1000;
+    if (busyMicros > elapsed) {
+        busyMicros = elapsed;
+    }
+    uint32_t idlePermille = (uint32_t)((elapsed - busyMicros) * 1000 / elapsed);
+    uint32_t sleepPermille = (uint32_t)(_lightSleepMicros * 1000 / elapsed);
+    
+    // 结束空闲次数最多的来源
+    uint8_t top = 0;
+    uint32_t total = 0;
+    for (uint8_t i = 0; i <= DEADLINE_SOURCE_COUNT; i++) {
+        total += _wakeups[i];
+        if (_wakeups[i] > _wakeups[top]) {
+            top = i;
+        }
+    }
+    
+    Serial.printf("[IdleManager] 空闲 %lu.%lu%%, light sleep %lu.%lu%% (%lu 次)\n",
+                  (unsigned long)(idlePermille / 10), (unsigned long)(idlePermille % 10),
+                  (unsigned long)(sleepPermille / 10), (unsigned long)(sleepPermille % 10),
+                  (unsigned long)_lightSleeps);
+    // 只有通过 idle() 等待时（单循环）才有唤醒来源的统计（多任务各自等待）
+    if (total > 0) {
+        Serial.printf("[IdleManager] 唤醒 %lu 次, 最多来自 %s (%lu 次)\n", (unsigned long)total,
+                      DeadlineSet::sourceName(top), (unsigned long)_wakeups[top]);
+    }
+    
+    _periodStart = now;
+    _periodBusyTicks = ticks;
+    _lightSleepMicros = 0;
+    _lightSleeps = 0;
+    for (uint8_t i = 0; i <= DEADLINE_SOURCE_COUNT; i++) {
+        _wakeups[i] = 0;
+    }
+#endif
+}
@@ -0,0 +1,291 @@
+/**
+ * 智能桌面伴侣 - 秒表/倒计时渲染器实现
+ */
+
+#include "StopwatchRenderer.h"
+#include <esp_timer.h>
+#include <stdlib.h>
+
+StopwatchRenderer::StopwatchRenderer()
+    : stopwatch()
+    , beforeToggle()
+    , toggledByPress(false)
+    , expiredAt(0)
+    , dirty(true)
+    , renderedCentis(0)
+    , lineVisible(true)
+    , staticVersion(0)
+    , lastLatencyMicros(0)
+    , glyphsReady(false)
+    , timePage(0)
+    , timePages(0)
+    , timeX0(0)
+    , timeX1(0) {
+    memset(glyphWidth, 0, sizeof(glyphWidth));
+    memset(charX, 0, sizeof(charX));
+    memset(lastChars, 0, sizeof(lastChars));
+    memset(changedTiles, 0, sizeof(changedTiles));
+}
+
+void StopwatchRenderer::init() {
+    // 初始化完成
+}
+
+void StopwatchRenderer::update() {
+    int64_t now = esp_timer_get_time();
+    if (stopwatch.update(now)) {
+        expiredAt = now;
+        stateChanged();
+        Serial.println("[StopwatchRenderer] 倒计时结束");
+    }
+}
+
+void StopwatchRenderer::render(U8G2* display) {
+    if (display == nullptr) return;
+
+    // 首次渲染时建立字形条（需要U8g2计算字体度量）
+    if (!glyphsReady && !buildGlyphStrip(display)) {
+        return;
+    }
+
+    // 显示值由出帧时刻算出，与主循环何时运行无关
+    int64_t now = esp_timer_get_time();
+    uint32_t centis = stopwatch.getCentis(now);
+    bool visible = isLineVisible(now);
+
+    char timeBuffer[9];
+    Stopwatch::format(centis, timeBuffer);
+
+    // 只把变化的字符从字形条复制到时间行缓存，并记下它们覆盖的tile
+    memset(changedTiles, 0, sizeof(changedTiles));
+    for (uint8_t i = 0; i < STOPWATCH_CHARS; i++) {
+        if (timeBuffer[i] == lastChars[i]) {
+            continue;
+        }
+        uint8_t g = glyphIndex(timeBuffer[i]);
+        uint8_t width = glyphWidth[g];
+        if (charX[i] + width > timeX1) {
+            width = timeX1 - charX[i];
+        }
+        for (uint8_t p = 0; p < timePages; p++) {
+            memcpy(&timeLine[p][charX[i]], glyphStrip[g][p], width);
+        }
+        FrameBuffer::markColumns(changedTiles, charX[i], width, timePage, timePages);
+        lastChars[i] = timeBuffer[i];
+    }
+
+    // 闪烁时整行出现或消失
+    if (visible != lineVisible) {
+        FrameBuffer::markColumns(changedTiles, timeX0, timeX1 - timeX0, timePage, timePages);
+        lineVisible = visible;
+    }
+
+    // 时间行按页合成到帧缓冲（按位或，不覆盖背景层）
+    if (visible) {
+        uint8_t* frame = display->getBufferPtr();
+        for (uint8_t p = 0; p < timePages; p++) {
+            uint8_t* dst = frame + (timePage + p) * FrameBuffer::ROW_BYTES;
+            for (uint8_t x = timeX0; x < timeX1; x++) {
+                dst[x] |= timeLine[p][x];
+            }
+        }
+    }
+
+    renderedCentis = centis;
+    dirty = false;
+}
+
+bool StopwatchRenderer::buildGlyphStrip(U8G2* display) {
+    static const char GLYPHS[STOPWATCH_GLYPH_COUNT + 1] = "0123456789:.";
+
+    // 在临时缓冲中逐个绘制字形，再按页取出
+    uint8_t* scratch = (uint8_t*)malloc(FrameBuffer::SIZE);
+    if (scratch == nullptr) {
+        return false;
+    }
+    u8g2_t* u8g2 = display->getU8g2();
+    uint8_t* frame = u8g2->tile_buf_ptr;
+    u8g2->tile_buf_ptr = scratch;
+
+    display->setFont(u8g2_font_logisoso22_tn);
+
+    // 时间行覆盖 [基线 - 字体上升高度, 基线) 所在的页
+    int16_t top = STOPWATCH_BASELINE - display->getAscent();
+    if (top < 0) top = 0;
+    timePage = (uint8_t)(top >> 3);
+    timePages = (uint8_t)(((STOPWATCH_BASELINE - 1) >> 3) - timePage + 1);
+    if (timePages > STOPWATCH_GLYPH_MAX_PAGES) {
+        timePages = STOPWATCH_GLYPH_MAX_PAGES;
+    }
+
+    memset(glyphStrip, 0, sizeof(glyphStrip));
+    for (uint8_t g = 0; g < STOPWATCH_GLYPH_COUNT; g++) {
+        display->clearBuffer();
+        uint16_t advance = display->drawGlyph(0, STOPWATCH_BASELINE, GLYPHS[g]);
+        glyphWidth[g] = advance > STOPWATCH_GLYPH_MAX_WIDTH ? STOPWATCH_GLYPH_MAX_WIDTH : (uint8_t)advance;
+        for (uint8_t p = 0; p < timePages; p++) {
+            memcpy(glyphStrip[g][p], scratch + (timePage + p) * FrameBuffer::ROW_BYTES, glyphWidth[g]);
+        }
+    }
+
+    u8g2->tile_buf_ptr = frame;
+    free(scratch);
+
+    // 布局：数字等宽，整行宽度固定，居中位置只需计算一次
+    uint8_t colonWidth = glyphWidth[glyphIndex(':')];
+    uint8_t dotWidth = glyphWidth[glyphIndex('.')];
+    uint16_t totalWidth = 6 * glyphWidth[0] + colonWidth + dotWidth;
+    int16_t x = (OLED_WIDTH - (int16_t)totalWidth) / 2;
+    if (x < 0) x = 0;
+    timeX0 = (uint8_t)x;
+    for (uint8_t i = 0; i < STOPWATCH_CHARS; i++) {
+        charX[i] = (uint8_t)x;
+        x += (i == 2) ? colonWidth : (i == 5) ? dotWidth : glyphWidth[0];
+        if (x > OLED_WIDTH) x = OLED_WIDTH;
+    }
+    timeX1 = (uint8_t)x;
+
+    // 时间行需要完整重建
+    memset(timeLine, 0, sizeof(timeLine));
+    memset(lastChars, 0, sizeof(lastChars));
+    glyphsReady = true;
+    return true;
+}
+
+uint8_t StopwatchRenderer::glyphIndex(char c) {
+    if (c >= '0' && c <= '9') {
+        return (uint8_t)(c - '0');
+    }
+    return c == ':' ? 10 : 11;
+}
+
+void StopwatchRenderer::renderStatic(U8G2* display) {
+    if (display == nullptr) return;
+
+    int64_t now = esp_timer_get_time();
+    display->setFont(u8g2_font_6x10_tf);
+
+    // 标题（居中）
+    const char* title = stopwatch.getKind() == STOPWATCH_COUNTDOWN ? "TIMER" : "STOPWATCH";
+    display->drawStr((OLED_WIDTH - display->getStrWidth(title)) / 2, 10, title);
+
+    // 操作提示（底部居中）
+    const char* hint;
+    if (stopwatch.isRunning()) {
+        hint = "TAP: stop";
+    } else if (stopwatch.isExpired(now)) {
+        hint = "TAP: reset";
+    } else if (!stopwatch.isReset()) {
+        hint = "TAP: go  HOLD: reset";
+    } else if (stopwatch.getKind() == STOPWATCH_UP) {
+        hint = "TAP: go  HOLD: timer";
+    } else {
+        hint = "TAP: go  HOLD: exit";
+    }
+    display->drawStr((OLED_WIDTH - display->getStrWidth(hint)) / 2, 62, hint);
+}
+
+uint16_t StopwatchRenderer::getStaticVersion() const {
+    return staticVersion;
+}
+
+void StopwatchRenderer::toggle(int64_t edgeMicros) {
+    int64_t now = esp_timer_get_time();
+    // 没有记录到边沿时以当前时刻为准
+    if (edgeMicros <= 0 || edgeMicros > now) {
+        edgeMicros = now;
+    }
+
+    // 开始/暂停的时刻取触摸边沿，防抖和主循环的延迟不计入计时
+    beforeToggle = stopwatch;
+    toggledByPress = true;
+    bool running = stopwatch.toggle(edgeMicros);
+    lastLatencyMicros = (uint32_t)(now - edgeMicros);
+    stateChanged();
+
+    Serial.printf("[StopwatchRenderer] %s，触摸边沿到处理 %lu us\n",
+                  running ? "开始" : (stopwatch.isReset() ? "清零" : "暂停"),
+                  (unsigned long)lastLatencyMicros);
+}
+
+bool StopwatchRenderer::longPress() {
+    // 长按的按下阶段已经切换过一次开始/暂停，先撤销
+    if (toggledByPress) {
+        stopwatch = beforeToggle;
+        toggledByPress = false;
+    }
+
+    bool stay = true;
+    if (!stopwatch.isReset()) {
+        stopwatch.reset();
+    } else if (stopwatch.getKind() == STOPWATCH_UP) {
+        setCountdown(STOPWATCH_COUNTDOWN_SEC);
+    } else {
+        stopwatch.setStopwatch();
+        stay = false;
+    }
+    stateChanged();
+    return stay;
+}
+
+void StopwatchRenderer::setCountdown(uint32_t seconds) {
+    stopwatch.setCountdown((int64_t)seconds * 1000000);
+    stateChanged();
+}
+
+const Stopwatch& StopwatchRenderer::getStopwatch() const {
+    return stopwatch;
+}
+
+bool StopwatchRenderer::isRunning() const {
+    return stopwatch.isRunning();
+}
+
+bool StopwatchRenderer::isDirty() const {
+    if (dirty) {
+        return true;
+    }
+    int64_t now = esp_timer_get_time();
+    return stopwatch.getCentis(now) != renderedCentis || isLineVisible(now) != lineVisible;
+}
+
+void StopwatchRenderer::markDirty() {
+    dirty = true;
+}
+
+unsigned long StopwatchRenderer::getNextDeadline(unsigned long now) const {
+    int64_t micros = esp_timer_get_time();
+
+    // 计时中：下一个百分之一秒
+    int64_t next = stopwatch.getNextChange(micros);
+    if (next >= 0) {
+        return (unsigned long)((next + 999) / 1000);
+    }
+
+    // 倒计时结束：下一次闪烁切换
+    if (stopwatch.isExpired(micros)) {
+        unsigned long phase = (unsigned long)((micros - expiredAt) / 1000) % STOPWATCH_BLINK_MS;
+        return STOPWATCH_BLINK_MS - phase;
+    }
+    return DEADLINE_NONE;
+}
+
+void StopwatchRenderer::getChangedTiles(FrameBuffer::DirtyMask tiles) const {
+    memcpy(tiles, changedTiles, sizeof(changedTiles));
+}
+
+uint32_t StopwatchRenderer::getLastLatencyMicros() const {
+    return lastLatencyMicros;
+}
+
+bool StopwatchRenderer::isLineVisible(int64_t now) const {
+    if (!stopwatch.isExpired(now) || now < expiredAt) {
+        return true;
+    }
+    return ((now - expiredAt) / 1000 / STOPWATCH_BLINK_MS) % 2 == 0;
+}
+
+void StopwatchRenderer::stateChanged() {
+    staticVersion++;
+    dirty = true;
+}
@@ -11,7 +11,9 @@ SysInfoRenderer::SysInfoRenderer()
     : freeHeapBytes(0)
     , uptimeSeconds(0)
     , wifiRSSI(0)
-    , wifiConnected(false) {
+    , wifiConnected(false)
+    , dirty(true)
+    , lastRenderTime(0) {
 }
 
 void SysInfoRenderer::init() {
@@ -26,66 +28,123 @@ char* SysInfoRenderer::formatUptime(uint32_t seconds, char* buffer) {
     
     if (days > 0) {
         // 格式: Xd HH:MM:SS
-        sprintf(buffer, "%lud %02lu:%02lu:%02lu", days, hours, minutes, secs);
+        sprintf(buffer, "%lud %02lu:%02lu:%02lu", (unsigned long)days, (unsigned long)hours,
+                (unsigned long)minutes, (unsigned long)secs);
     } else {
         // 格式: HH:MM:SS
-        sprintf(buffer, "%02lu:%02lu:%02lu", hours, minutes, secs);
+        sprintf(buffer, "%02lu:%02lu:%02lu", (unsigned long)hours, (unsigned long)minutes, (unsigned long)secs);
     }
     
     return buffer;
 }
 
+// 内存条位置和尺寸
+static const int16_t MEM_BAR_X = 70;
+static const int16_t MEM_BAR_Y = 18;
+static const int MEM_BAR_WIDTH = 50;
+static const int MEM_BAR_HEIGHT = 6;
+
 void SysInfoRenderer::render(U8G2* display) {
     if (display == nullptr) return;
     
+    // 数值紧跟在静态标签之后（6x10等宽字体，每字符6像素）
     display->setFont(u8g2_font_6x10_tf);
     
-    // 标题
-    display->drawStr(0, 10, "System Info");
-    display->drawHLine(0, 12, OLED_WIDTH);
-    
-    // 内存信息
+    // 内存信息（标签 "Mem: " 占5个字符）
     char memBuffer[20];
     uint32_t freeKB = freeHeapBytes / 1024;
-    sprintf(memBuffer, "Mem: %luKB", freeKB);
-    display->drawStr(0, 26, memBuffer);
+    sprintf(memBuffer, "%luKB", (unsigned long)freeKB);
+    display->drawStr(30, 26, memBuffer);
     
     // 绘制内存使用条
-    drawMemoryBar(display, 70, 18, freeHeapBytes);
+    drawMemoryBar(display, MEM_BAR_X, MEM_BAR_Y, freeHeapBytes);
     
     // 运行时间
     char uptimeBuffer[20];
     formatUptime(uptimeSeconds, uptimeBuffer);
-    display->drawStr(0, 40, "Up:");
     display->drawStr(24, 40, uptimeBuffer);
     
-    // WiFi信号
+    // WiFi信号（标签 "WiFi: " 占6个字符）
     if (wifiConnected) {
         char rssiBuffer[16];
-        sprintf(rssiBuffer, "WiFi: %ddBm", wifiRSSI);
-        display->drawStr(0, 54, rssiBuffer);
+        sprintf(rssiBuffer, "%ddBm", wifiRSSI);
+        display->drawStr(36, 54, rssiBuffer);
         
         // 绘制信号图标
         drawSignalIcon(display, 100, 46, wifiRSSI);
     } else {
-        display->drawStr(0, 54, "WiFi: --");
+        display->drawStr(36, 54, "--");
     }
+    
+    dirty = false;
+    lastRenderTime = millis();
+}
+
+void SysInfoRenderer::renderStatic(U8G2* display) {
+    if (display == nullptr) return;
+    
+    display->setFont(u8g2_font_6x10_tf);
+    
+    // 标题
+    display->drawStr(0, 10, "System Info");
+    display->drawHLine(0, 12, OLED_WIDTH);
+    
+    // 标签
+    display->drawStr(0, 26, "Mem:");
+    display->drawStr(0, 40, "Up:");
+    display->drawStr(0, 54, "WiFi:");
+    
+    // 内存条外框
+    display->drawFrame(MEM_BAR_X, MEM_BAR_Y, MEM_BAR_WIDTH, MEM_BAR_HEIGHT);
+}
+
+uint16_t SysInfoRenderer::getStaticVersion() const {
+    return 0;
 }
 
 void SysInfoRenderer::setFreeHeap(uint32_t bytes) {
+    // 界面以KB显示，只有KB数变化才需要重绘
+    if (bytes / 1024 != freeHeapBytes / 1024) {
+        dirty = true;
+    }
     freeHeapBytes = bytes;
 }
 
 void SysInfoRenderer::setUptime(uint32_t seconds) {
-    uptimeSeconds = seconds;
+    if (seconds != uptimeSeconds) {
+        uptimeSeconds = seconds;
+        dirty = true;
+    }
 }
 
 void SysInfoRenderer::setRSSI(int8_t rssi) {
-    wifiRSSI = rssi;
+    if (rssi != wifiRSSI) {
+        wifiRSSI = rssi;
+        dirty = true;
+    }
 }
 
 void SysInfoRenderer::setWiFiConnected(bool connected) {
-    wifiConnected = connected;
+    if (connected != wifiConnected) {
+        wifiConnected = connected;
+        dirty = true;
+    }
+}
+
+bool SysInfoRenderer::isDirty() const {
+    return dirty;
+}
+
+void SysInfoRenderer::markDirty() {
+    dirty = true;
+}
+
+unsigned long SysInfoRenderer::getNextDeadline(unsigned long now) const {
+    if (!dirty) {
+        return DEADLINE_NONE;
+    }
+    unsigned long elapsed = now - lastRenderTime;
+    return elapsed >= SYSINFO_FRAME_MS ? 0 : SYSINFO_FRAME_MS - elapsed;
 }
 
 void SysInfoRenderer::drawSignalIcon(U8G2* display, int16_t x, int16_t y, int8_t rssi) {
@@ -120,9 +179,9 @@ void SysInfoRenderer::drawSignalIcon(U8G2* display, int16_t x, int16_t y, int8_t
 }
 
 void SysInfoRenderer::drawMemoryBar(U8G2* display, int16_t x, int16_t y, uint32_t freeBytes) {
-    // 绘制内存使用进度条
-    const int barWidth = 50;
-    const int barHeight = 6;
+    // 绘制内存使用进度条（外框在静态背景层中）
+    const int barWidth = MEM_BAR_WIDTH;
+    const int barHeight = MEM_BAR_HEIGHT;
     
     // 计算使用百分比
     uint32_t usedBytes = TOTAL_HEAP_ESTIMATE - freeBytes;
@@ -130,9 +189,6 @@ void SysInfoRenderer::drawMemoryBar(U8G2* display, int16_t x, int16_t y, uint32_
     
     int usedWidth = (usedBytes * barWidth) / TOTAL_HEAP_ESTIMATE;
     
-    // 绘制外框
-    display->drawFrame(x, y, barWidth, barHeight);
-    
     // 绘制已使用部分
     if (usedWidth > 0) {
         display->drawBox(x + 1, y + 1, usedWidth - 2, barHeight - 2);
@@ -4,6 +4,7 @@
 
 #include <Arduino.h>
 #include "SystemMonitor.h"
+#include "DeadlineSet.h"
 
 #ifndef UNIT_TEST
 #include <esp_system.h>
@@ -53,6 +54,10 @@ void SystemMonitor::update() {
     }
 }
 
+unsigned long SystemMonitor::getNextDeadline(unsigned long now) const {
+    return DeadlineSet::remaining(now, lastCheckTime, CHECK_INTERVAL_MS);
+}
+
 uint32_t SystemMonitor::getFreeHeap() const {
 #ifndef UNIT_TEST
     return esp_get_free_heap_size();
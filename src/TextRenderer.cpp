@@ -0,0 +1,268 @@
+/**
+ * 智能桌面伴侣 - 文本渲染器实现
+ */
+
+#include "TextRenderer.h"
+#include <esp_partition.h>
+
+TextRenderer::TextRenderer()
+    : textLength(0)
+    , scrollMode(TEXT_SCROLL_VERTICAL)
+    , lineCount(0)
+    , rasterized(false)
+    , scrollOffset(0)
+    , scrollRange(0)
+    , lastScrollTime(0)
+    , scrollWait(0)
+    , dirty(false)
+    , lastLayoutMicros(0)
+    , lastScrollMicros(0)
+    , glyphStore()
+    , layoutDisplay(nullptr) {
+    text[0] = '\0';
+}
+
+void TextRenderer::init() {
+    // 打开中文字库分区
+    const esp_partition_t* partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, FONT_PARTITION_LABEL);
+    if (partition == nullptr ||
+        !glyphStore.begin(readFontPartition, const_cast<esp_partition_t*>(partition), glyphClock)) {
+        Serial.println("[TextRenderer] 未找到中文字库，只能显示西文字符");
+        return;
+    }
+    Serial.printf("[TextRenderer] 中文字库: %u 个字形\n", glyphStore.getGlyphCount());
+}
+
+void TextRenderer::setText(const char* newText, TextScrollMode mode) {
+    if (newText == nullptr) {
+        newText = "";
+    }
+    
+    // 截断到缓冲区大小（不拆开多字节字符）
+    uint16_t length = 0;
+    while (newText[length] != '\0' && length < TEXT_MAX_BYTES) {
+        length++;
+    }
+    while (length > 0 && newText[length] != '\0' && ((uint8_t)newText[length] & 0xC0) == 0x80) {
+        length--;
+    }
+    memcpy(text, newText, length);
+    text[length] = '\0';
+    textLength = length;
+    
+    scrollMode = mode;
+    rasterized = false;
+    scrollOffset = 0;
+    scrollRange = 0;
+    dirty = true;
+}
+
+void TextRenderer::render(U8G2* display) {
+    if (display == nullptr) return;
+    
+    if (!rasterized) {
+        rasterize(display);
+    }
+    
+    unsigned long start = micros();
+    uint8_t* frame = display->getBufferPtr();
+    
+    if (scrollMode == TEXT_SCROLL_VERTICAL) {
+        // 从缓存中按行偏移取出一屏
+        FrameBuffer::scrollWindow(frame, cache, TEXT_CACHE_PAGES, scrollOffset);
+    } else {
+        // 跑马灯：长条放在屏幕中间两页，按列偏移循环复制
+        const uint8_t firstPage = TEXT_MARQUEE_FIRST_PAGE;
+        memset(frame, 0, FrameBuffer::SIZE);
+        uint16_t period = scrollRange > 0 ? scrollRange : TEXT_MARQUEE_MAX_WIDTH;
+        for (uint8_t p = 0; p < 2; p++) {
+            const uint8_t* strip = cache + p * TEXT_MARQUEE_MAX_WIDTH;
+            uint8_t* dst = frame + (firstPage + p) * FrameBuffer::ROW_BYTES;
+            uint16_t head = period - scrollOffset;
+            if (head > FrameBuffer::ROW_BYTES) {
+                head = FrameBuffer::ROW_BYTES;
+            }
+            memcpy(dst, strip + scrollOffset, head);
+            memcpy(dst + head, strip, FrameBuffer::ROW_BYTES - head);
+        }
+    }
+    
+    lastScrollMicros = micros() - start;
+    dirty = false;
+}
+
+void TextRenderer::rasterize(U8G2* display) {
+    unsigned long start = micros();
+    
+    display->setFont(TEXT_FONT);
+    layoutDisplay = display;
+    memset(cache, 0, sizeof(cache));
+    
+    // 帧缓冲此时会被整帧覆盖，光栅化期间用作临时缓冲
+    uint8_t* scratch = display->getBufferPtr();
+    
+    if (scrollMode == TEXT_SCROLL_MARQUEE) {
+        // 单行，不换行
+        lineCount = TextLayout::breakLines(text, textLength, TEXT_MARQUEE_MAX_WIDTH - TEXT_MARQUEE_GAP,
+                                           glyphAdvance, this, lines, 1);
+        uint16_t width = lineCount > 0 ? lines[0].width : 0;
+    
+        if (width > OLED_WIDTH) {
+            // 逐个字形绘制后按列或合成到长条
+            uint16_t x = 0;
+            uint16_t pos = lines[0].start;
+            uint16_t end = lines[0].start + lines[0].length;
+            while (pos < end) {
+                uint32_t cp = TextLayout::decodeUtf8(text, pos, end);
+                memset(scratch, 0, 2 * FrameBuffer::ROW_BYTES);
+                uint8_t advance = drawChar(display, scratch, 0, cp);
+                for (uint8_t p = 0; p < 2; p++) {
+                    uint8_t* dst = cache + p * TEXT_MARQUEE_MAX_WIDTH;
+                    for (uint16_t i = 0; i < TEXT_GLYPH_MAX_WIDTH && x + i < TEXT_MARQUEE_MAX_WIDTH; i++) {
+                        dst[x + i] |= scratch[p * FrameBuffer::ROW_BYTES + i];
+                    }
+                }
+                x += advance;
+            }
+            scrollRange = width + TEXT_MARQUEE_GAP;
+        } else {
+            // 不超过屏幕宽度：居中显示，不滚动
+            memset(scratch, 0, 2 * FrameBuffer::ROW_BYTES);
+            if (lineCount > 0) {
+                drawLine(display, scratch, lines[0], (OLED_WIDTH - width) / 2);
+            }
+            for (uint8_t p = 0; p < 2; p++) {
+                memcpy(cache + p * TEXT_MARQUEE_MAX_WIDTH, scratch + p * FrameBuffer::ROW_BYTES,
+                       FrameBuffer::ROW_BYTES);
+            }
+            scrollRange = 0;
+        }
+    } else {
+        lineCount = TextLayout::breakLines(text, textLength, OLED_WIDTH - 2 * TEXT_MARGIN,
+                                           glyphAdvance, this, lines, TEXT_MAX_LINES);
+    
+        // 行高与页对齐，不足一屏时垂直居中
+        const uint8_t pagesPerLine = TEXT_LINE_HEIGHT / 8;
+        uint8_t firstPage = 0;
+        if (lineCount * pagesPerLine < FrameBuffer::TILE_ROWS) {
+            firstPage = (FrameBuffer::TILE_ROWS - lineCount * pagesPerLine) / 2;
+        }
+    
+        for (uint8_t i = 0; i < lineCount; i++) {
+            memset(scratch, 0, pagesPerLine * FrameBuffer::ROW_BYTES);
+            // 单行消息居中，多行左对齐
+            int16_t x = lineCount == 1 ? (OLED_WIDTH - lines[i].width) / 2 : TEXT_MARGIN;
+            drawLine(display, scratch, lines[i], x);
+            memcpy(cache + (firstPage + i * pagesPerLine) * FrameBuffer::ROW_BYTES, scratch,
+                   pagesPerLine * FrameBuffer::ROW_BYTES);
+        }
+    
+        uint16_t contentRows = (firstPage + lineCount * pagesPerLine) * 8;
+        scrollRange = contentRows > OLED_HEIGHT ? contentRows - OLED_HEIGHT : 0;
+    }
+    
+    // 新消息先停顿再开始滚动
+    scrollOffset = 0;
+    lastScrollTime = millis();
+    scrollWait = TEXT_SCROLL_PAUSE_MS;
+    rasterized = true;
+    lastLayoutMicros = micros() - start;
+}
+
+void TextRenderer::drawLine(U8G2* display, uint8_t* scratch, const TextLayout::Line& line, int16_t x) {
+    uint16_t pos = line.start;
+    uint16_t end = line.start + line.length;
+    while (pos < end) {
+        uint32_t cp = TextLayout::decodeUtf8(text, pos, end);
+        x += drawChar(display, scratch, x, cp);
+    }
+}
+
+uint8_t TextRenderer::drawChar(U8G2* display, uint8_t* scratch, int16_t x, uint32_t codepoint) {
+    if (codepoint <= TEXT_LATIN_MAX) {
+        return display->drawGlyph(x, TEXT_BASELINE, (uint16_t)codepoint);
+    }
+    
+    // 中文字形为页格式，直接按字节写入临时缓冲
+    PageSprite sprite;
+    if (!glyphStore.findSprite(codepoint, sprite)) {
+        return 0;
+    }
+    blitPageSprite(scratch, x, TEXT_CJK_TOP, sprite);
+    return glyphStore.getAdvance();
+}
+
+uint8_t TextRenderer::glyphAdvance(uint32_t codepoint, void* context) {
+    TextRenderer* self = static_cast<TextRenderer*>(context);
+    if (codepoint <= TEXT_LATIN_MAX) {
+        int8_t width = u8g2_GetGlyphWidth(self->layoutDisplay->getU8g2(), (uint16_t)codepoint);
+        return width > 0 ? (uint8_t)width : 0;
+    }
+    // 排版时顺便把字形读入缓存，光栅化时直接命中
+    return self->glyphStore.find(codepoint) != nullptr ? self->glyphStore.getAdvance() : 0;
+}
+
+bool TextRenderer::readFontPartition(uint32_t offset, void* dst, uint32_t length, void* context) {
+    const esp_partition_t* partition = static_cast<const esp_partition_t*>(context);
+    return esp_partition_read(partition, offset, dst, length) == ESP_OK;
+}
+
+uint32_t TextRenderer::glyphClock() {
+    return micros();
+}
+
+void TextRenderer::updateScroll(unsigned long now) {
+    if (!rasterized || scrollRange == 0) {
+        return;
+    }
+    
+    if (scrollMode == TEXT_SCROLL_VERTICAL) {
+        if (scrollOffset >= scrollRange) {
+            // 已停在末尾：回到开头并停顿
+            scrollOffset = 0;
+            scrollWait = TEXT_SCROLL_PAUSE_MS;
+        } else {
+            scrollOffset++;
+            scrollWait = scrollOffset >= scrollRange ? TEXT_SCROLL_PAUSE_MS : TEXT_SCROLL_FRAME_MS;
+        }
+    } else {
+        scrollOffset = (scrollOffset + 1) % scrollRange;
+        scrollWait = TEXT_SCROLL_FRAME_MS;
+    }
+    
+    lastScrollTime = now;
+    dirty = true;
+}
+
+bool TextRenderer::isDirty() const {
+    return dirty;
+}
+
+void TextRenderer::markDirty() {
+    dirty = true;
+}
+
+unsigned long TextRenderer::getNextDeadline(unsigned long now) const {
+    if (!rasterized || scrollRange == 0) {
+        return DEADLINE_NONE;
+    }
+    unsigned long elapsed = now - lastScrollTime;
+    return elapsed >= scrollWait ? 0 : scrollWait - elapsed;
+}
+
+uint8_t TextRenderer::getLineCount() const {
+    return lineCount;
+}
+
+uint32_t TextRenderer::getLastLayoutMicros() const {
+    return lastLayoutMicros;
+}
+
+uint32_t TextRenderer::getLastScrollMicros() const {
+    return lastScrollMicros;
+}
+
+const GlyphStore& TextRenderer::getGlyphStore() const {
+    return glyphStore;
+}
@@ -6,10 +6,13 @@
 
 #include <Arduino.h>
 #include "TimeManager.h"
+#include "DeadlineSet.h"
+#include <sys/time.h>
 
 TimeManager::TimeManager()
     : _state(TIME_NOT_SYNCED)
-    , _syncCallback(nullptr)
+    , _bus(nullptr)
+    , _producer(0)
     , _lastSyncTime(0)
     , _lastSyncAttempt(0)
     , _synced(false)
@@ -19,7 +22,8 @@ TimeManager::TimeManager()
     , _cachedYear(2024)
     , _cachedMonth(1)
     , _cachedDay(1)
-    , _cacheUpdateTime(0) {
+    , _cacheUpdateTime(0)
+    , _msToNextSecond(1000) {
 }
 
 void TimeManager::init() {
@@ -84,8 +88,8 @@ bool TimeManager::syncNTP() {
 
 void TimeManager::update() {
 #ifndef UNIT_TEST
-    // 更新缓存的时间（每秒更新一次）
-    if (millis() - _cacheUpdateTime >= 1000) {
+    // 更新缓存的时间（在整秒变化时更新）
+    if (millis() - _cacheUpdateTime >= _msToNextSecond) {
         updateCachedTime();
     }
     
@@ -151,8 +155,20 @@ TimeSyncState TimeManager::getState() {
     return _state;
 }
 
-void TimeManager::setSyncCallback(TimeSyncCallback callback) {
-    _syncCallback = callback;
+void TimeManager::setEventBus(AppEventBus* bus, uint8_t producer) {
+    _bus = bus;
+    _producer = producer;
+}
+
+unsigned long TimeManager::getNextDeadline(unsigned long now) const {
+    unsigned long next = DeadlineSet::remaining(now, _cacheUpdateTime, _msToNextSecond);
+    if (_synced) {
+        unsigned long resync = DeadlineSet::remaining(now, _lastSyncTime, NTP_SYNC_INTERVAL_MS);
+        if (resync < next) {
+            next = resync;
+        }
+    }
+    return next;
 }
 
 unsigned long TimeManager::getLastSyncTime() {
@@ -174,25 +190,33 @@ void TimeManager::setState(TimeSyncState newState) {
         Serial.print("时间同步状态变化: ");
         Serial.println(stateNames[newState]);
         
-        // 触发回调
-        if (_syncCallback != nullptr) {
-            _syncCallback(newState);
+        // 投递状态变化事件
+        if (_bus != nullptr) {
+            _bus->publish(_producer, makeEvent(EVENT_TIME_SYNC, newState, micros()));
         }
     }
 }
 
 void TimeManager::updateCachedTime() {
 #ifndef UNIT_TEST
+    // 直接读取系统时间（getLocalTime 在未同步时会等待5秒），未同步时下一秒再试
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
     struct tm timeinfo;
-    if (getLocalTime(&timeinfo)) {
+    localtime_r(&tv.tv_sec, &timeinfo);
+    if (timeinfo.tm_year > (2016 - 1900)) {
         _cachedHour = timeinfo.tm_hour;
         _cachedMinute = timeinfo.tm_min;
         _cachedSecond = timeinfo.tm_sec;
         _cachedYear = timeinfo.tm_year + 1900;
         _cachedMonth = timeinfo.tm_mon + 1;
         _cachedDay = timeinfo.tm_mday;
-        _cacheUpdateTime = millis();
+        // 下一次刷新对齐到下一整秒，而不是距这次刷新满1秒
+        _msToNextSecond = 1000 - tv.tv_usec / 1000;
+    } else {
+        _msToNextSecond = 1000;
     }
+    _cacheUpdateTime = millis();
 #else
     // 单元测试模式：模拟时间流逝
     unsigned long elapsed = millis() - _cacheUpdateTime;
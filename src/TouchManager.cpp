@@ -6,6 +6,30 @@
  */
 
 #include "TouchManager.h"
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+
+// 每次按压只投递第一个上升沿，防抖确认释放后重新开放
+static volatile bool touchEdgeArmed = true;
+
+// 边沿事件投递到的总线（PRODUCER_TOUCH_ISR 只由这个中断写入）
+static AppEventBus* touchEdgeBus = nullptr;
+
+static void IRAM_ATTR onTouchEdge() {
+    if (!touchEdgeArmed || touchEdgeBus == nullptr) {
+        return;
+    }
+    touchEdgeArmed = false;
+    
+    int64_t edgeMicros = esp_timer_get_time();
+    AppEvent event = makeEvent(EVENT_TOUCH_EDGE, 0, (uint32_t)edgeMicros);
+    event.touch.edgeMicros = edgeMicros;
+    bool woken = false;
+    touchEdgeBus->publishFromISR(PRODUCER_TOUCH_ISR, event, &woken);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
 
 TouchManager::TouchManager() 
     : _touchPin(TOUCH_PIN)
@@ -14,8 +38,11 @@ TouchManager::TouchManager()
     , _lastDebouncedState(false)
     , _lastDebounceTime(0)
     , _pressStartTime(0)
+    , _pressEdgeMicros(0)
+    , _edgeMicros(0)
     , _currentEvent(TOUCH_NONE)
-    , _callback(nullptr)
+    , _bus(nullptr)
+    , _producer(0)
     , _eventPending(false)
     , _longPressTriggered(false)
     , _factoryResetTriggered(false)
@@ -40,6 +67,12 @@ void TouchManager::init(uint8_t pin) {
     _longPressTriggered = false;
     _factoryResetTriggered = false;
     _pressStartTime = 0;
+    _pressEdgeMicros = 0;
+    _edgeMicros = 0;
+    
+    // 上升沿中断投递按下的精确时刻（防抖仍在主循环中完成）
+    touchEdgeArmed = !_lastRawState;
+    attachInterrupt(digitalPinToInterrupt(_touchPin), onTouchEdge, RISING);
 }
 
 bool TouchManager::debounce(bool rawState) {
@@ -71,10 +104,12 @@ void TouchManager::update() {
     // 检测状态变化
     if (currentState != _lastDebouncedState) {
         if (currentState) {
-            // 按下：记录开始时间
+            // 按下：记录开始时间和边沿时刻（没有捕获到边沿时以当前时刻为准）
             _pressStartTime = currentTime;
+            _pressEdgeMicros = (touchEdgeArmed || _edgeMicros == 0) ? esp_timer_get_time() : _edgeMicros;
             _longPressTriggered = false;
             _factoryResetTriggered = false;
+            triggerEvent(TOUCH_PRESS);
         } else {
             // 释放：计算按压时长并处理
             if (_pressStartTime > 0) {
@@ -86,6 +121,12 @@ void TouchManager::update() {
         _lastDebouncedState = currentState;
     }
     
+    // 未按下且电平为低时重新开放边沿记录（被防抖滤掉的毛刺不会留下过期的时刻）
+    if (!currentState && !rawState) {
+        _edgeMicros = 0;
+        touchEdgeArmed = true;
+    }
+    
     // 持续按压时检测长按和工厂重置
     if (currentState && _pressStartTime > 0) {
         unsigned long pressDuration = currentTime - _pressStartTime;
@@ -120,9 +161,11 @@ void TouchManager::triggerEvent(TouchEvent event) {
     _currentEvent = event;
     _eventPending = true;
     
-    // 如果设置了回调函数，立即调用
-    if (_callback != nullptr) {
-        _callback(event);
+    // 投递到事件总线（只复制事件，不执行订阅者的代码）
+    if (_bus != nullptr) {
+        AppEvent busEvent = makeEvent(EVENT_TOUCH, event, micros());
+        busEvent.touch.edgeMicros = _pressEdgeMicros;
+        _bus->publish(_producer, busEvent);
     }
 }
 
@@ -156,14 +199,42 @@ void TouchManager::clearEvent() {
     _eventPending = false;
 }
 
-void TouchManager::setCallback(TouchCallback callback) {
-    _callback = callback;
+void TouchManager::setEventBus(AppEventBus* bus, uint8_t producer) {
+    _bus = bus;
+    _producer = producer;
+    touchEdgeBus = bus;
+}
+
+void TouchManager::handleEdge(const AppEvent& event) {
+    if (!touchEdgeArmed) {
+        _edgeMicros = event.touch.edgeMicros;
+    }
 }
 
 bool TouchManager::isTouching() {
     return _debouncedState;
 }
 
+int64_t TouchManager::getPressEdgeMicros() const {
+    return _pressEdgeMicros;
+}
+
+unsigned long TouchManager::getNextDeadline(unsigned long now) const {
+    // 按下、防抖中或边沿已捕获但还没确认：固定间隔轮询（释放、长按和防抖都靠轮询检测）
+    if (_debouncedState || _lastRawState || _lastDebouncedState || !touchEdgeArmed) {
+        return TOUCH_POLL_MS;
+    }
+    // 未按下：等待边沿中断（light sleep时为触摸引脚唤醒）
+    return DEADLINE_NONE;
+}
+
+void TouchManager::setWakeTime(int64_t wakeMicros) {
+    if (touchEdgeArmed) {
+        touchEdgeArmed = false;
+        _edgeMicros = wakeMicros;
+    }
+}
+
 unsigned long TouchManager::getPressDuration() {
     if (_debouncedState && _pressStartTime > 0) {
         return millis() - _pressStartTime;
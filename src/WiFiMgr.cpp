@@ -5,6 +5,7 @@
  */
 
 #include "WiFiMgr.h"
+#include "DeadlineSet.h"
 
 // AP配网热点名称
 static const char* AP_NAME = "SmartCompanion";
@@ -13,12 +14,14 @@ static const char* AP_PASSWORD = "";
 
 WiFiMgr::WiFiMgr() 
     : _state(WIFI_STATE_DISCONNECTED)
-    , _stateCallback(nullptr)
+    , _bus(nullptr)
+    , _producer(0)
     , _reconnectAttempts(0)
     , _lastReconnectTime(0)
     , _connectStartTime(0)
     , _apModeActive(false)
-    , _apModeStartTime(0) {
+    , _apModeStartTime(0)
+    , _suspended(false) {
 }
 
 void WiFiMgr::init() {
@@ -80,6 +83,11 @@ bool WiFiMgr::connect() {
 
 void WiFiMgr::update() {
 #ifndef UNIT_TEST
+    // 已主动关闭，不检查也不重连
+    if (_suspended) {
+        return;
+    }
+    
     // 如果在AP模式，检查是否超时
     if (_apModeActive) {
         if (millis() - _apModeStartTime > (AP_CONFIG_TIMEOUT_SEC * 1000UL)) {
@@ -101,6 +109,13 @@ void WiFiMgr::update() {
     
     // 处理断线重连
     if (_state == WIFI_STATE_DISCONNECTED && !_apModeActive) {
+        // 异步连接已经成功（resume() 之后），不再重连
+        if (WiFi.status() == WL_CONNECTED) {
+            setState(WIFI_STATE_CONNECTED);
+            _reconnectAttempts = 0;
+            return;
+        }
+        
         // 检查是否需要重连
         if (_reconnectAttempts < WIFI_MAX_RECONNECT_ATTEMPTS) {
             // 检查重连间隔
@@ -186,8 +201,9 @@ WiFiConnectionState WiFiMgr::getState() {
     return _state;
 }
 
-void WiFiMgr::setStateCallback(WiFiStateCallback callback) {
-    _stateCallback = callback;
+void WiFiMgr::setEventBus(AppEventBus* bus, uint8_t producer) {
+    _bus = bus;
+    _producer = producer;
 }
 
 uint8_t WiFiMgr::getReconnectAttempts() {
@@ -205,6 +221,60 @@ void WiFiMgr::disconnect() {
     setState(WIFI_STATE_DISCONNECTED);
 }
 
+void WiFiMgr::suspend() {
+    if (_suspended || _apModeActive) {
+        return;
+    }
+#ifndef UNIT_TEST
+    Serial.println("关闭WiFi（长时间空闲）");
+    WiFi.disconnect(true);
+    WiFi.mode(WIFI_OFF);
+#endif
+    _suspended = true;
+    // 主动关闭不是断线：不投递事件，恢复后按断开状态检查连接结果
+    _state = WIFI_STATE_DISCONNECTED;
+}
+
+void WiFiMgr::resume() {
+    if (!_suspended) {
+        return;
+    }
+#ifndef UNIT_TEST
+    Serial.println("重新打开WiFi");
+    WiFi.mode(WIFI_STA);
+    WiFi.begin();
+#endif
+    _suspended = false;
+    _reconnectAttempts = 0;
+    _lastReconnectTime = millis();
+}
+
+bool WiFiMgr::isSuspended() const {
+    return _suspended;
+}
+
+unsigned long WiFiMgr::getNextDeadline(unsigned long now) const {
+    if (_suspended) {
+        return DEADLINE_NONE;
+    }
+    if (_apModeActive) {
+        return DeadlineSet::remaining(now, _apModeStartTime, AP_CONFIG_TIMEOUT_SEC * 1000UL);
+    }
+    if (_state == WIFI_STATE_CONNECTED) {
+        return WIFI_STATUS_CHECK_MS;
+    }
+    if (_state == WIFI_STATE_DISCONNECTED) {
+        // 断开时也要及时发现异步连接的结果
+        if (_reconnectAttempts >= WIFI_MAX_RECONNECT_ATTEMPTS) {
+            return 0;
+        }
+        unsigned long retry = DeadlineSet::remaining(now, _lastReconnectTime, WIFI_RECONNECT_INTERVAL_MS);
+        return retry < WIFI_STATUS_CHECK_MS ? retry : WIFI_STATUS_CHECK_MS;
+    }
+    // 连接中（connect() 内部等待）或失败（等待重新配网）
+    return DEADLINE_NONE;
+}
+
 void WiFiMgr::setState(WiFiConnectionState newState) {
     if (_state != newState) {
         _state = newState;
@@ -216,9 +286,9 @@ void WiFiMgr::setState(WiFiConnectionState newState) {
         Serial.print("WiFi状态变化: ");
         Serial.println(stateNames[newState]);
         
-        // 触发回调
-        if (_stateCallback != nullptr) {
-            _stateCallback(newState);
+        // 投递状态变化事件（订阅者在自己的任务中处理，不会阻塞这里）
+        if (_bus != nullptr) {
+            _bus->publish(_producer, makeEvent(EVENT_WIFI, newState, micros()));
         }
     }
 }
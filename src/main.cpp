@@ -3,6 +3,19 @@
  * 
  * 基于ESP32-C3 Super Mini的智能桌面伴侣
  * 使用0.96寸OLED显示屏和TTP223触摸传感器
+ * 
+ * 模块之间通过事件总线（AppEvents.h）通信：生产者只投递事件，订阅者在自己的任务中取出处理。
+ * APP_RTOS_TASKS 为1时按优先级分成五个任务：
+ *   输入(6)  按下时轮询触摸，未按下时等待边沿中断，触摸事件投递到总线
+ *   音频(4)  取出触摸和WiFi事件播放按键音/提示音，阻塞在I2S写入上
+ *   界面(3)  显示管理器和模式逻辑的唯一使用者，等待总线唤醒或下一帧、屏保、自动保存的截止时间
+ *   网络(1)  WiFi连接/重连和NTP同步（可以阻塞数秒），状态变化和当前时间投递到总线
+ *   后台(1)  系统监控，状态汇总投递到总线
+ *   睡眠(0)  睡眠模式关屏、WiFi关闭后，在其他任务都阻塞时进入light sleep
+ * 为0时回到单个协作式 loop()，各订阅者在循环中依次取出事件；两种方式输出同样的延迟统计便于对比
+ *
+ * 没有固定周期的轮询：每个任务（单循环时是整个循环）向各模块询问下一次需要醒来的时间，
+ * 阻塞到最早的一个（DeadlineSet.h），触摸的边沿中断提前唤醒；空闲方式见 IdleManager.h
  */
 
 #include <Arduino.h>
@@ -13,6 +26,15 @@
 #include "TimeManager.h"
 #include "ConfigManager.h"
 #include "SystemMonitor.h"
+#include "AudioManager.h"
+#include "IdleManager.h"
+#include "AppEvents.h"
+#include "sprites/avatar_gray.h"
+#include "DeadlineSet.h"
+#include "LatencyStats.h"
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 // 全局对象实例
 DisplayManager displayManager;
@@ -21,6 +43,9 @@ WiFiMgr wifiMgr;
 TimeManager timeManager;
 ConfigManager configManager;
 SystemMonitor systemMonitor;
+AudioManager audioManager;
+IdleManager idleManager;
+AppEventBus eventBus;
 
 // 系统状态
 SystemState systemState = STATE_BOOT;
@@ -28,10 +53,98 @@ SystemState systemState = STATE_BOOT;
 // 上次触摸时间（用于屏幕保护）
 unsigned long lastTouchTime = 0;
 
+// 工厂重置：提示显示后再执行（不阻塞主循环）
+bool factoryResetPending = false;
+unsigned long factoryResetRequestTime = 0;
+
 // 屏幕保护状态
 bool isDimmed = false;           // 是否已调暗
 DisplayMode modeBeforeSleep;     // 睡眠前的显示模式
 
+// 延迟统计：按下边沿到事件处理完并更新显示（界面），相邻两次触摸轮询的间隔（输入），
+// 按下唤醒CPU（边沿中断或从light sleep唤醒）到界面处理完按下事件
+LatencyStats inputLatency;
+LatencyStats pollGap;
+LatencyStats touchWakeLatency;
+int64_t pendingPressEdge = 0;
+int64_t lastTouchPoll = 0;
+unsigned long lastInputReport = 0;
+unsigned long lastPollReport = 0;
+unsigned long lastBusReport[SUBSCRIBER_COUNT] = {};
+unsigned long lastIdleReport = 0;
+
+#if APP_RTOS_TASKS
+TaskHandle_t inputTask = nullptr;
+TaskHandle_t uiTask = nullptr;
+TaskHandle_t audioTask = nullptr;
+TaskHandle_t networkTask = nullptr;
+TaskHandle_t housekeepingTask = nullptr;
+TaskHandle_t sleepTask = nullptr;
+unsigned long lastTaskReport = 0;
+
+/**
+ * 事件总线的唤醒函数：通知收到事件的订阅者任务（任务创建之前投递的事件在任务第一次取出时处理）
+ */
+void wakeSubscribers(uint8_t subscribers, void* context) {
+    TaskHandle_t tasks[SUBSCRIBER_COUNT] = {uiTask, audioTask, networkTask, inputTask};
+    for (uint8_t i = 0; i < SUBSCRIBER_COUNT; i++) {
+        if ((subscribers & (1 << i)) != 0 && tasks[i] != nullptr) {
+            xTaskNotifyGive(tasks[i]);
+        }
+    }
+}
+
+/**
+ * 事件总线的中断唤醒函数：在中断中通知收到事件的订阅者任务（如触摸边沿唤醒输入任务）
+ */
+bool wakeSubscribersFromISR(uint8_t subscribers, void* context) {
+    TaskHandle_t tasks[SUBSCRIBER_COUNT] = {uiTask, audioTask, networkTask, inputTask};
+    BaseType_t woken = pdFALSE;
+    for (uint8_t i = 0; i < SUBSCRIBER_COUNT; i++) {
+        if ((subscribers & (1 << i)) != 0 && tasks[i] != nullptr) {
+            vTaskNotifyGiveFromISR(tasks[i], &woken);
+        }
+    }
+    return woken == pdTRUE;
+}
+#else
+/**
+ * 单循环的中断唤醒函数：通知loop任务（context）结束空闲等待
+ */
+bool wakeLoopFromISR(uint8_t subscribers, void* context) {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR((TaskHandle_t)context, &woken);
+    return woken == pdTRUE;
+}
+#endif
+
+/**
+ * 输出一组延迟统计并开始新的统计周期
+ */
+void reportLatency(const char* name, LatencyStats& stats) {
+    Serial.printf("[Tasks] %s: %lu 次, 最小 %lu / 平均 %lu / p99 %lu / 最大 %lu us\n", name,
+                  (unsigned long)stats.getCount(), (unsigned long)stats.getMin(),
+                  (unsigned long)stats.getMean(), (unsigned long)stats.getPercentile(99),
+                  (unsigned long)stats.getMax());
+    stats.reset();
+}
+
+/**
+ * 每个统计周期输出一次订阅者的总线统计（订阅者自己的任务）
+ */
+void reportSubscriber(uint8_t subscriber, const char* name) {
+    if (millis() - lastBusReport[subscriber] < TASK_REPORT_INTERVAL_MS) {
+        return;
+    }
+    lastBusReport[subscriber] = millis();
+    Serial.printf("[EventBus] %s: 已处理 %lu, 排队 %lu (峰值 %lu), 丢弃 %lu\n", name,
+                  (unsigned long)eventBus.getDispatched(subscriber), (unsigned long)eventBus.getDepth(subscriber),
+                  (unsigned long)eventBus.getHighWater(subscriber), (unsigned long)eventBus.getDropped(subscriber));
+    char label[32];
+    snprintf(label, sizeof(label), "%s 分发延迟", name);
+    reportLatency(label, eventBus.getLatency(subscriber));
+}
+
 /**
  * 检查并处理空闲状态（屏幕保护）
  */
@@ -45,6 +158,11 @@ void checkIdleState() {
     
     DisplayMode currentMode = displayManager.getMode();
     
+    // 秒表计时中不调暗也不睡眠
+    if (displayManager.getStopwatchRenderer().isRunning()) {
+        return;
+    }
+    
     // 检查睡眠超时（优先级高于调暗）
     if (idleTime >= sleepTimeoutMs && currentMode != MODE_SLEEP) {
         Serial.println("空闲超时，进入睡眠模式");
@@ -64,6 +182,29 @@ void checkIdleState() {
     }
 }
 
+/**
+ * 屏幕保护和工厂重置的下一个截止时间（界面）
+ * @return 剩余毫秒数，DEADLINE_NONE表示没有
+ */
+unsigned long getScreenSaverDeadline(unsigned long now) {
+    if (factoryResetPending) {
+        return DeadlineSet::remaining(now, factoryResetRequestTime, FACTORY_RESET_NOTICE_MS);
+    }
+    
+    // 与 checkIdleState 的条件一致：秒表计时中和睡眠模式下没有超时
+    if (displayManager.getStopwatchRenderer().isRunning() || displayManager.getMode() == MODE_SLEEP) {
+        return DEADLINE_NONE;
+    }
+    unsigned long next = DeadlineSet::remaining(now, lastTouchTime, configManager.getSleepTimeout() * 1000UL);
+    if (!isDimmed) {
+        unsigned long dim = DeadlineSet::remaining(now, lastTouchTime, configManager.getDimTimeout() * 1000UL);
+        if (dim < next) {
+            next = dim;
+        }
+    }
+    return next;
+}
+
 /**
  * 重置空闲状态（有触摸输入时调用）
  */
@@ -77,19 +218,65 @@ void resetIdleState() {
 }
 
 /**
- * WiFi状态变化回调函数
+ * 处理网络订阅的事件（网络任务）：WiFi连接后同步时间
  */
-void onWiFiStateChange(WiFiConnectionState state) {
+void handleNetworkEvent(const AppEvent& event) {
+    if (event.type == EVENT_WIFI && event.value == WIFI_STATE_CONNECTED) {
+        Serial.println("WiFi已连接，开始同步时间");
+        timeManager.syncNTP();
+    }
+    
+#if IDLE_LIGHT_SLEEP
+    // 睡眠模式关屏后关闭WiFi，空闲时可以进入light sleep；唤醒离开睡眠模式后重新连接
+    if (event.type == EVENT_DORMANT) {
+        if (event.value != 0 && !wifiMgr.isSuspended()) {
+            wifiMgr.suspend();
+        } else if (event.value == 0 && wifiMgr.isSuspended()) {
+            wifiMgr.resume();
+        }
+        idleManager.setLightSleepAllowed(wifiMgr.isSuspended());
+#if APP_RTOS_TASKS
+        if (wifiMgr.isSuspended() && sleepTask != nullptr) {
+            xTaskNotifyGive(sleepTask);
+        }
+#endif
+    }
+#endif
+}
+
+/**
+ * 处理音频订阅的事件（音频任务）：短按的按键音、WiFi连接成功的提示音和整点问候语
+ */
+void handleAudioEvent(const AppEvent& event) {
+    if (event.type == EVENT_TOUCH && event.value == TOUCH_SHORT) {
+        audioManager.playSound(SOUND_CLICK);
+    } else if (event.type == EVENT_WIFI && event.value == WIFI_STATE_CONNECTED) {
+        audioManager.playSound(SOUND_SUCCESS);
+    } else if (event.type == EVENT_SPEAK) {
+        audioManager.playSound(SOUND_GREETING);
+    }
+}
+
+/**
+ * 处理WiFi状态变化（界面）
+ */
+void handleWiFiState(WiFiConnectionState state) {
     switch (state) {
         case WIFI_STATE_CONNECTED:
-            Serial.println("WiFi已连接，开始同步时间");
-            timeManager.syncNTP();
+            // 配网说明还在显示时回到之前的模式
+            if (displayManager.getMode() == MODE_TEXT) {
+                displayManager.setMode(configManager.getLastDisplayMode());
+            }
+            displayManager.getFaceRenderer().celebrate();
+            displayManager.postToast("WiFi connected", TOAST_INFO, TOAST_DEFAULT_MS, TOAST_ICON_WIFI);
             break;
         case WIFI_STATE_DISCONNECTED:
             Serial.println("WiFi断开连接");
+            displayManager.postToast("WiFi lost", TOAST_NOTICE, TOAST_DEFAULT_MS, TOAST_ICON_WIFI);
             break;
         case WIFI_STATE_AP_MODE:
             Serial.println("进入AP配网模式");
+            displayManager.showMessage("配网：用手机连接WiFi热点 SmartCompanion，在自动弹出的页面中选择网络并输入密码");
             break;
         default:
             break;
@@ -97,15 +284,17 @@ void onWiFiStateChange(WiFiConnectionState state) {
 }
 
 /**
- * 时间同步状态回调函数
+ * 处理时间同步状态变化（界面）
  */
-void onTimeSyncStateChange(TimeSyncState state) {
+void handleTimeSync(TimeSyncState state) {
     switch (state) {
         case TIME_SYNCED:
             Serial.println("时间同步成功");
+            displayManager.postToast("Time synced");
             break;
         case TIME_SYNC_FAILED:
             Serial.println("时间同步失败");
+            displayManager.postToast("Time sync failed", TOAST_NOTICE);
             break;
         default:
             break;
@@ -113,10 +302,11 @@ void onTimeSyncStateChange(TimeSyncState state) {
 }
 
 /**
- * 触摸事件回调函数
+ * 处理触摸事件（界面）
  * 处理短按、长按和工厂重置事件
+ * @param edgeMicros 按下边沿时刻（esp_timer微秒）
  */
-void onTouchEvent(TouchEvent event) {
+void handleTouch(TouchEvent event, int64_t edgeMicros) {
     // 更新最后触摸时间
     lastTouchTime = millis();
     
@@ -124,9 +314,21 @@ void onTouchEvent(TouchEvent event) {
     resetIdleState();
     
     switch (event) {
+        case TOUCH_PRESS:
+            // 秒表在按下时（而不是松开时）开始/暂停，计时取GPIO边沿时刻
+            if (displayManager.getMode() == MODE_STOPWATCH) {
+                displayManager.getStopwatchRenderer().toggle(edgeMicros);
+            }
+            break;
+            
         case TOUCH_SHORT:
             Serial.println("触摸事件: 短按");
             
+            // 秒表模式：按下时已经处理
+            if (displayManager.getMode() == MODE_STOPWATCH) {
+                break;
+            }
+            
             // 如果在睡眠模式，唤醒设备
             if (displayManager.getMode() == MODE_SLEEP) {
                 displayManager.getFaceRenderer().wakeUp();
@@ -149,20 +351,41 @@ void onTouchEvent(TouchEvent event) {
             
         case TOUCH_LONG:
             Serial.println("触摸事件: 长按");
-            // TODO: 进入设置模式（预留）
-            // 目前仅触发表情反应
-            if (displayManager.getMode() == MODE_FACE) {
+            // 时钟模式：切换数字表盘和指针表盘
+            if (displayManager.getMode() == MODE_CLOCK) {
+                displayManager.getClockRenderer().toggleFace();
+                break;
+            }
+            // 系统信息模式：显示/关闭4级灰度的设备形象（短按切换模式时也会关闭）
+            if (displayManager.getMode() == MODE_SYSINFO) {
+                if (displayManager.isGrayscale()) {
+                    displayManager.stopGrayscale();
+                } else if (!displayManager.showGrayscale(AVATAR, (OLED_WIDTH - AVATAR.width) / 2, 0)) {
+                    displayManager.postToast("Grayscale N/A", TOAST_NOTICE);
+                }
+                break;
+            }
+            // 秒表模式：清零 / 切换正计时与倒计时，两者都已清零时回到表情模式
+            if (displayManager.getMode() == MODE_STOPWATCH) {
+                if (!displayManager.getStopwatchRenderer().longPress()) {
+                    displayManager.setMode(MODE_FACE);
+                    configManager.setLastDisplayMode(MODE_FACE);
+                }
+                break;
+            }
+            // 目前在表情模式下轮换表情包中的表情，轮换完（或没有表情包）时触发表情反应
+            if (displayManager.getMode() == MODE_FACE &&
+                !displayManager.getFaceRenderer().nextPackExpression()) {
                 displayManager.getFaceRenderer().triggerReaction();
             }
             break;
             
         case TOUCH_FACTORY_RESET:
             Serial.println("触摸事件: 工厂重置");
-            // 显示重置提示
-            displayManager.showMessage("工厂重置中...");
-            delay(500);
-            // 执行工厂重置（清除NVS配置并重启设备）
-            configManager.factoryReset();
+            // 显示重置提示，主循环在提示显示 FACTORY_RESET_NOTICE_MS 后执行重置
+            displayManager.postToast("Factory reset...", TOAST_ALERT, FACTORY_RESET_NOTICE_MS * 2);
+            factoryResetPending = true;
+            factoryResetRequestTime = millis();
             break;
             
         default:
@@ -170,12 +393,374 @@ void onTouchEvent(TouchEvent event) {
     }
 }
 
+/**
+ * 处理界面订阅的事件（界面任务）
+ */
+void handleUiEvent(const AppEvent& event) {
+    switch (event.type) {
+        case EVENT_TOUCH:
+            handleTouch((TouchEvent)event.value, event.touch.edgeMicros);
+            // 按下事件：边沿时刻（从light sleep唤醒时为唤醒时刻）到处理完，显示延迟在下一次更新显示后记录
+            if (event.value == TOUCH_PRESS && event.touch.edgeMicros != 0) {
+                touchWakeLatency.record((uint32_t)(esp_timer_get_time() - event.touch.edgeMicros));
+                pendingPressEdge = event.touch.edgeMicros;
+            }
+            break;
+            
+        case EVENT_WIFI:
+            handleWiFiState((WiFiConnectionState)event.value);
+            break;
+            
+        case EVENT_TIME_SYNC:
+            handleTimeSync((TimeSyncState)event.value);
+            break;
+            
+        case EVENT_CLOCK: {
+            // 数值不变时不会触发重绘
+            ClockRenderer& clock = displayManager.getClockRenderer();
+            clock.setTime(event.clock.hour, event.clock.minute, event.clock.second);
+            clock.setDate(event.clock.year, event.clock.month, event.clock.day);
+            clock.setOffline(!event.clock.synced);
+            break;
+        }
+            
+        case EVENT_SPEAK:
+            // 整点问候：表情模式下嘴巴跟随音频任务播放的声音开合
+            if (displayManager.getMode() == MODE_FACE) {
+                displayManager.getFaceRenderer().speak();
+            }
+            break;
+            
+        case EVENT_STATUS: {
+            SysInfoRenderer& sysInfo = displayManager.getSysInfoRenderer();
+            sysInfo.setFreeHeap(event.status.freeHeap);
+            sysInfo.setUptime(event.status.uptime);
+            sysInfo.setWiFiConnected(event.status.wifiConnected);
+            if (event.status.wifiConnected) {
+                sysInfo.setRSSI(event.status.rssi);
+            }
+            break;
+        }
+            
+        default:
+            break;
+    }
+}
+
+/**
+ * 取出各订阅者的事件（各自的任务，单循环时依次调用）
+ */
+void drainUi() {
+    eventBus.drain(SUBSCRIBER_UI, micros(), handleUiEvent);
+    reportSubscriber(SUBSCRIBER_UI, "ui");
+}
+
+void drainAudio() {
+    eventBus.drain(SUBSCRIBER_AUDIO, micros(), handleAudioEvent);
+    reportSubscriber(SUBSCRIBER_AUDIO, "audio");
+}
+
+void drainNetwork() {
+    eventBus.drain(SUBSCRIBER_NETWORK, micros(), handleNetworkEvent);
+    reportSubscriber(SUBSCRIBER_NETWORK, "network");
+}
+
+/**
+ * 处理输入订阅的事件（输入任务）
+ */
+void handleInputEvent(const AppEvent& event) {
+    if (event.type == EVENT_TOUCH_EDGE) {
+        touchManager.handleEdge(event);
+    }
+}
+
+/**
+ * 轮询触摸传感器（输入），同时统计轮询间隔
+ */
+void pollTouch() {
+    int64_t now = esp_timer_get_time();
+    if (lastTouchPoll != 0) {
+        pollGap.record((uint32_t)(now - lastTouchPoll));
+    }
+    lastTouchPoll = now;
+    
+    // 先取出边沿中断投递的按下时刻，再做防抖
+    eventBus.drain(SUBSCRIBER_INPUT, micros(), handleInputEvent);
+    reportSubscriber(SUBSCRIBER_INPUT, "input");
+    touchManager.update();
+    
+    if (millis() - lastPollReport >= TASK_REPORT_INTERVAL_MS) {
+        lastPollReport = millis();
+        reportLatency("触摸轮询间隔", pollGap);
+    }
+}
+
+/**
+ * 投递当前时间（网络），只在秒或同步状态变化时投递；问候时段内每个整点投递一次问候
+ */
+void publishClock() {
+    static uint8_t lastSecond = 0xFF;
+    static bool lastSynced = false;
+    
+    uint8_t second = timeManager.getSecond();
+    bool synced = timeManager.isSynced();
+    if (second == lastSecond && synced == lastSynced) {
+        return;
+    }
+    lastSecond = second;
+    lastSynced = synced;
+    
+    AppEvent event = makeEvent(EVENT_CLOCK, 0, micros());
+    event.clock.year = timeManager.getYear();
+    event.clock.month = timeManager.getMonth();
+    event.clock.day = timeManager.getDay();
+    event.clock.hour = timeManager.getHour();
+    event.clock.minute = timeManager.getMinute();
+    event.clock.second = second;
+    event.clock.synced = synced;
+    eventBus.publish(PRODUCER_NETWORK, event);
+    
+    // 整点问候（时间已同步且在问候时段内，每个整点一次）
+    static uint8_t lastSpokenHour = 0xFF;
+    uint8_t hour = event.clock.hour;
+    if (synced && event.clock.minute == 0 && hour != lastSpokenHour &&
+        hour >= SPEAK_HOUR_FIRST && hour <= SPEAK_HOUR_LAST) {
+        lastSpokenHour = hour;
+        eventBus.publish(PRODUCER_NETWORK, makeEvent(EVENT_SPEAK, 0, micros()));
+    }
+}
+
+/**
+ * 投递睡眠模式关屏/唤醒（界面），只在变化时投递
+ */
+void publishDormancy() {
+    static bool lastDormant = false;
+    
+    bool dormant = displayManager.getMode() == MODE_SLEEP && !displayManager.isPanelOn();
+    if (dormant == lastDormant) {
+        return;
+    }
+    lastDormant = dormant;
+    eventBus.publish(PRODUCER_UI, makeEvent(EVENT_DORMANT, dormant ? 1 : 0, micros()));
+}
+
+/**
+ * 触摸的下一次轮询时间（输入）：未按下时等待边沿中断，
+ * 自动light sleep期间边沿中断可能丢失，保留 TOUCH_IDLE_POLL_MS 的兜底轮询
+ */
+unsigned long getTouchDeadline(unsigned long now) {
+    unsigned long next = touchManager.getNextDeadline(now);
+    if (idleManager.isAutoLightSleep() && next > TOUCH_IDLE_POLL_MS) {
+        return TOUCH_IDLE_POLL_MS;
+    }
+    return next;
+}
+
+/**
+ * 投递系统状态汇总（后台）
+ */
+void publishStatus() {
+    AppEvent event = makeEvent(EVENT_STATUS, 0, micros());
+    event.status.freeHeap = systemMonitor.getFreeHeap();
+    event.status.uptime = systemMonitor.getUptime();
+    event.status.wifiConnected = wifiMgr.isConnected();
+    if (event.status.wifiConnected) {
+        event.status.rssi = wifiMgr.getRSSI();
+    }
+    eventBus.publish(PRODUCER_HOUSEKEEPING, event);
+}
+
+/**
+ * 界面的一次更新：自动保存配置、出帧、记录输入延迟，然后检查工厂重置和空闲状态，投递关屏/唤醒
+ */
+void updateUi() {
+    // 更新配置管理器（处理自动保存）
+    configManager.update();
+    
+    // 更新显示管理器（只在有内容变化或动画到期时出帧）
+    displayManager.update();
+    
+    if (pendingPressEdge != 0) {
+        inputLatency.record((uint32_t)(esp_timer_get_time() - pendingPressEdge));
+        pendingPressEdge = 0;
+    }
+    if (millis() - lastInputReport >= TASK_REPORT_INTERVAL_MS) {
+        lastInputReport = millis();
+        reportLatency("输入延迟", inputLatency);
+        reportLatency("触摸唤醒到处理", touchWakeLatency);
+    }
+    
+    // 工厂重置（清除NVS配置并重启设备）
+    if (factoryResetPending && millis() - factoryResetRequestTime >= FACTORY_RESET_NOTICE_MS) {
+        configManager.factoryReset();
+    }
+    
+    // 检查空闲状态（屏幕保护）
+    checkIdleState();
+    publishDormancy();
+}
+
+#if APP_RTOS_TASKS
+/**
+ * 输入任务：按下和防抖期间轮询触摸，未按下时等待边沿中断投递的事件，触摸事件由触摸管理器投递到总线
+ */
+void inputTaskEntry(void* arg) {
+    DeadlineSet deadlines;
+    for (;;) {
+        pollTouch();
+        
+        deadlines.clear();
+        deadlines.offer(DEADLINE_TOUCH, getTouchDeadline(millis()));
+        idleManager.waitTask(IDLE_SLOT_INPUT, deadlines.getWait(IDLE_MAX_WAIT_MS));
+    }
+}
+
+/**
+ * 界面任务：等待总线唤醒或下一帧、屏幕保护、自动保存的截止时间，取出全部事件后更新一次
+ */
+void uiTaskEntry(void* arg) {
+    DeadlineSet deadlines;
+    for (;;) {
+        unsigned long now = millis();
+        deadlines.clear();
+        deadlines.offer(DEADLINE_DISPLAY, displayManager.getNextDeadline());
+        deadlines.offer(DEADLINE_SCREEN_SAVER, getScreenSaverDeadline(now));
+        deadlines.offer(DEADLINE_CONFIG, configManager.getNextDeadline(now));
+        idleManager.waitTask(IDLE_SLOT_UI, deadlines.getWait(IDLE_MAX_WAIT_MS));
+        
+        drainUi();
+        updateUi();
+    }
+}
+
+/**
+ * 音频任务：等待总线唤醒，依次播放音效（播放期间阻塞在I2S写入上，不影响其他任务）
+ */
+void audioTaskEntry(void* arg) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        drainAudio();
+    }
+}
+
+/**
+ * 网络任务：连接WiFi（可能进入配网门户），之后处理断线重连和NTP同步，这些调用可以阻塞数秒
+ */
+void networkTaskEntry(void* arg) {
+    Serial.println("正在连接WiFi...");
+    wifiMgr.connect();
+    
+    DeadlineSet deadlines;
+    for (;;) {
+        wifiMgr.update();
+        timeManager.update();
+        publishClock();
+        drainNetwork();
+        
+        // 等到下一秒、重连或连接检查的时间，总线上的WiFi事件提前唤醒
+        unsigned long now = millis();
+        deadlines.clear();
+        deadlines.offer(DEADLINE_WIFI, wifiMgr.getNextDeadline(now));
+        deadlines.offer(DEADLINE_TIME, timeManager.getNextDeadline(now));
+        idleManager.waitTask(IDLE_SLOT_NETWORK, deadlines.getWait(IDLE_MAX_WAIT_MS));
+    }
+}
+
+/**
+ * 后台任务：系统监控、状态汇总和任务栈余量输出
+ */
+void housekeepingTaskEntry(void* arg) {
+    DeadlineSet deadlines;
+    for (;;) {
+        systemMonitor.update();
+        publishStatus();
+        
+        if (millis() - lastTaskReport >= TASK_REPORT_INTERVAL_MS) {
+            lastTaskReport = millis();
+            idleManager.report();
+            Serial.printf("[Tasks] 栈余量 input %u / ui %u / audio %u / network %u / housekeeping %u 字节\n",
+                          (unsigned)uxTaskGetStackHighWaterMark(inputTask),
+                          (unsigned)uxTaskGetStackHighWaterMark(uiTask),
+                          (unsigned)uxTaskGetStackHighWaterMark(audioTask),
+                          (unsigned)uxTaskGetStackHighWaterMark(networkTask),
+                          (unsigned)uxTaskGetStackHighWaterMark(housekeepingTask));
+        }
+        
+        deadlines.clear();
+        deadlines.offer(DEADLINE_MONITOR, systemMonitor.getNextDeadline(millis()));
+        idleManager.waitTask(IDLE_SLOT_HOUSEKEEPING, deadlines.getWait(IDLE_MAX_WAIT_MS));
+    }
+}
+
+/**
+ * 睡眠任务：WiFi关闭后，在其他任务都阻塞时睡到它们登记的最早的醒来时刻；
+ * 灰度刷新、异步刷新和音频播放依赖的时钟在睡眠期间停止，这些工作进行中时只让出CPU
+ */
+void sleepTaskEntry(void* arg) {
+    for (;;) {
+        if (!idleManager.isLightSleepAllowed()) {
+            // 等待网络任务关闭WiFi后通知
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+        if (displayManager.isGrayscale() || !displayManager.isFlushIdle() || audioManager.isPlaying() ||
+            !idleManager.sleepTasks()) {
+            vTaskDelay(pdMS_TO_TICKS(LIGHT_SLEEP_MIN_MS));
+            continue;
+        }
+        
+        // 睡眠期间边沿中断不触发，按下时刻以唤醒时刻为准
+        if (idleManager.wasTouchWake()) {
+            touchManager.setWakeTime(idleManager.getWakeMicros());
+        }
+        // 睡眠期间系统节拍停止，通知各任务按 millis() 重新计算截止时间
+        idleManager.wakeTasks();
+    }
+}
+
+/**
+ * 创建任务（初始化期间投递的事件已在总线中排队，由各订阅者任务第一次取出时处理）
+ * @return 全部创建成功
+ */
+bool startTasks() {
+    bool ok = xTaskCreate(inputTaskEntry, "input", INPUT_TASK_STACK, nullptr,
+                          INPUT_TASK_PRIORITY, &inputTask) == pdPASS;
+    ok = ok && xTaskCreate(audioTaskEntry, "audio", AUDIO_TASK_STACK, nullptr,
+                           AUDIO_TASK_PRIORITY, &audioTask) == pdPASS;
+    ok = ok && xTaskCreate(uiTaskEntry, "ui", UI_TASK_STACK, nullptr,
+                           UI_TASK_PRIORITY, &uiTask) == pdPASS;
+    ok = ok && xTaskCreate(networkTaskEntry, "network", NETWORK_TASK_STACK, nullptr,
+                           NETWORK_TASK_PRIORITY, &networkTask) == pdPASS;
+    ok = ok && xTaskCreate(housekeepingTaskEntry, "housekeeping", HOUSEKEEPING_TASK_STACK, nullptr,
+                           HOUSEKEEPING_TASK_PRIORITY, &housekeepingTask) == pdPASS;
+#if IDLE_LIGHT_SLEEP
+    ok = ok && xTaskCreate(sleepTaskEntry, "sleep", SLEEP_TASK_STACK, nullptr,
+                           tskIDLE_PRIORITY, &sleepTask) == pdPASS;
+#endif
+    return ok;
+}
+#endif
+
 void setup() {
     // 初始化串口
     Serial.begin(115200);
     delay(1000);
     Serial.println("智能桌面伴侣启动中...");
     
+    // 事件总线：订阅关系在开始投递之前确定
+    eventBus.subscribe(SUBSCRIBER_UI, eventBit(EVENT_TOUCH) | eventBit(EVENT_WIFI) | eventBit(EVENT_TIME_SYNC) |
+                                      eventBit(EVENT_CLOCK) | eventBit(EVENT_STATUS) | eventBit(EVENT_SPEAK));
+    eventBus.subscribe(SUBSCRIBER_AUDIO, eventBit(EVENT_TOUCH) | eventBit(EVENT_WIFI) | eventBit(EVENT_SPEAK));
+    eventBus.subscribe(SUBSCRIBER_NETWORK, eventBit(EVENT_WIFI) | eventBit(EVENT_DORMANT));
+    eventBus.subscribe(SUBSCRIBER_INPUT, eventBit(EVENT_TOUCH_EDGE));
+#if APP_RTOS_TASKS
+    eventBus.setWake(wakeSubscribers, nullptr);
+    eventBus.setWakeFromISR(wakeSubscribersFromISR, nullptr);
+#else
+    // 单循环：触摸边沿中断通知loop任务结束空闲等待
+    eventBus.setWakeFromISR(wakeLoopFromISR, xTaskGetCurrentTaskHandle());
+#endif
+    
     // 初始化配置管理器（优先初始化，其他模块可能依赖配置）
     if (configManager.init()) {
         Serial.println("配置管理器初始化成功");
@@ -192,29 +777,44 @@ void setup() {
         Serial.println("显示管理器初始化失败!");
     }
     
+    // 初始化音频
+    if (audioManager.begin()) {
+        Serial.println("音频管理器初始化成功");
+    } else {
+        Serial.println("音频管理器初始化失败!");
+    }
+    // 说话嘴型跟随实际播放的声音（音频任务写入包络，界面按帧读取）
+    displayManager.getFaceRenderer().setLipSyncSource(&audioManager.getEnvelope());
+    
     // 初始化触摸管理器
     touchManager.init(TOUCH_PIN);
-    touchManager.setCallback(onTouchEvent);
+    touchManager.setEventBus(&eventBus, PRODUCER_INPUT);
     Serial.println("触摸管理器初始化成功");
     
     // 初始化WiFi管理器
     wifiMgr.init();
-    wifiMgr.setStateCallback(onWiFiStateChange);
+    wifiMgr.setEventBus(&eventBus, PRODUCER_NETWORK);
     Serial.println("WiFi管理器初始化成功");
     
     // 初始化时间管理器
     timeManager.init();
-    timeManager.setSyncCallback(onTimeSyncStateChange);
+    timeManager.setEventBus(&eventBus, PRODUCER_NETWORK);
     Serial.println("时间管理器初始化成功");
     
     // 初始化系统监控器
     systemMonitor.init();
     Serial.println("系统监控器初始化成功");
     
-    // 尝试连接WiFi
-    Serial.println("正在连接WiFi...");
+    // 初始化空闲管理器（空闲统计、自动light sleep）
+    idleManager.init();
+    
     displayManager.showConnectionStatus("Connecting WiFi...");
+#if !APP_RTOS_TASKS
+    // 尝试连接WiFi（单循环时在这里阻塞，先出一帧显示通知）
+    Serial.println("正在连接WiFi...");
+    displayManager.update();
     wifiMgr.connect();
+#endif
     
     // 记录启动时间
     lastTouchTime = millis();
@@ -229,40 +829,64 @@ void setup() {
     // 应用保存的亮度设置
     displayManager.setBrightness(configManager.getBrightness());
     
+#if APP_RTOS_TASKS
+    // 启动任务（WiFi连接在网络任务中进行，连接期间界面和触摸照常响应）
+    if (!startTasks()) {
+        Serial.println("[Tasks] 创建任务失败!");
+    }
+#endif
+    
     Serial.println("系统启动完成");
 }
 
 void loop() {
-    // 更新触摸管理器
-    touchManager.update();
+#if APP_RTOS_TASKS
+    // 全部工作都在任务中进行，删除Arduino的loop任务
+    vTaskDelete(nullptr);
+#else
+    // 单循环：依次处理输入、网络、后台和界面，任何阻塞调用都会推迟其余部分
+    pollTouch();
     
     // 更新WiFi管理器（处理断线重连）
     wifiMgr.update();
     
     // 更新时间管理器（处理定期同步）
     timeManager.update();
-    
-    // 更新配置管理器（处理自动保存）
-    configManager.update();
+    publishClock();
     
     // 更新系统监控器
     systemMonitor.update();
+    publishStatus();
     
-    // 更新系统信息渲染器的数据
-    SysInfoRenderer& sysInfo = displayManager.getSysInfoRenderer();
-    sysInfo.setFreeHeap(systemMonitor.getFreeHeap());
-    sysInfo.setUptime(systemMonitor.getUptime());
-    sysInfo.setWiFiConnected(wifiMgr.isConnected());
-    if (wifiMgr.isConnected()) {
-        sysInfo.setRSSI(wifiMgr.getRSSI());
-    }
+    // 各订阅者依次取出事件（同步时间、播放音效都会阻塞整个循环）
+    drainNetwork();
+    drainAudio();
+    drainUi();
     
-    // 更新显示管理器
-    displayManager.update();
+    updateUi();
     
-    // 检查空闲状态（屏幕保护）
-    checkIdleState();
+    if (millis() - lastIdleReport >= TASK_REPORT_INTERVAL_MS) {
+        lastIdleReport = millis();
+        idleManager.report();
+    }
+    
+    // 睡到最早的截止时间，触摸的边沿中断（light sleep时为触摸引脚）提前唤醒
+    unsigned long now = millis();
+    DeadlineSet deadlines;
+    deadlines.offer(DEADLINE_TOUCH, getTouchDeadline(now));
+    deadlines.offer(DEADLINE_DISPLAY, displayManager.getNextDeadline());
+    deadlines.offer(DEADLINE_SCREEN_SAVER, getScreenSaverDeadline(now));
+    deadlines.offer(DEADLINE_CONFIG, configManager.getNextDeadline(now));
+    deadlines.offer(DEADLINE_TIME, timeManager.getNextDeadline(now));
+    deadlines.offer(DEADLINE_WIFI, wifiMgr.getNextDeadline(now));
+    deadlines.offer(DEADLINE_MONITOR, systemMonitor.getNextDeadline(now));
     
-    // 短暂延时，避免过度占用CPU
-    delay(10);
+    // 关屏/唤醒事件在下一轮循环由网络订阅者处理（关闭WiFi后才允许）
+    bool lightSleepOk = idleManager.isLightSleepAllowed() && !displayManager.isGrayscale() &&
+                        displayManager.isFlushIdle() && !audioManager.isPlaying();
+    if (idleManager.idle(deadlines, lightSleepOk)) {
+        // 睡眠期间边沿中断不触发，按下时刻以唤醒时刻为准
+        touchManager.setWakeTime(idleManager.getWakeMicros());
+    }
+#endif
 }
@@ -0,0 +1,30 @@
+/**
+ * 智能桌面伴侣 - 测试用伪随机数
+ *
+ * 固定种子的线性同余发生器（与C标准库示例 rand() 相同的参数），
+ * 各测试用它生成可重复的随机数据；只有头文件，由测试以相对路径包含
+ */
+
+#ifndef TEST_RANDOM_H
+#define TEST_RANDOM_H
+
+#include <stdint.h>
+
+class TestRandom {
+public:
+    explicit TestRandom(uint32_t seed) : state(seed) {}
+
+    /**
+     * 推进一步
+     * @return 新的32位状态（低位周期短，取用时使用高位）
+     */
+    uint32_t next() {
+        state = state * 1103515245 + 12345;
+        return state;
+    }
+
+private:
+    uint32_t state;
+};
+
+#endif // TEST_RANDOM_H
@@ -0,0 +1,167 @@
+/**
+ * 智能桌面伴侣 - 指针表盘测试
+ *
+ * 验证编译期正弦表的精度与对称性、指针端点、画线经过的tile标记，
+ * 以及每秒只有秒针经过的tile变化（统计需要发送的字节数）
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "AnalogDial.h"
+
+// 正弦表在编译期生成
+static_assert(AnalogDial::SIN_TABLE.values[0] == 0, "sin(0)");
+static_assert(AnalogDial::SIN_TABLE.values[15] == AnalogDial::Q14_ONE, "sin(90)");
+static_assert(AnalogDial::SIN_TABLE.values[45] == -AnalogDial::Q14_ONE, "sin(270)");
+
+static const int16_t CX = 32;
+static const int16_t CY = 32;
+
+static uint8_t dial[FrameBuffer::SIZE] __attribute__((aligned(4)));
+static uint8_t before[FrameBuffer::SIZE] __attribute__((aligned(4)));
+static uint8_t after[FrameBuffer::SIZE] __attribute__((aligned(4)));
+
+static bool pixel(const uint8_t* frame, int16_t x, int16_t y) {
+    return (frame[(y >> 3) * FrameBuffer::ROW_BYTES + x] >> (y & 7)) & 1;
+}
+
+void setUp(void) {
+    memset(dial, 0, sizeof(dial));
+    memset(before, 0, sizeof(before));
+    memset(after, 0, sizeof(after));
+}
+
+void tearDown(void) {
+    // 清理
+}
+
+/**
+ * 每个位置与浮点结果相差不超过1个 Q14 单位；sin(-x) = -sin(x)，cos = sin 后移15格
+ */
+void test_table_accuracy(void) {
+    for (uint8_t i = 0; i < AnalogDial::POSITIONS; i++) {
+        double expected = sin(i * 2.0 * M_PI / 60) * AnalogDial::Q14_ONE;
+        TEST_ASSERT_INT_WITHIN(1, (int32_t)lround(expected), AnalogDial::sinQ14(i));
+        TEST_ASSERT_EQUAL(-AnalogDial::sinQ14(i), AnalogDial::sinQ14((uint8_t)((60 - i) % 60)));
+        double expectedCos = cos(i * 2.0 * M_PI / 60) * AnalogDial::Q14_ONE;
+        TEST_ASSERT_INT_WITHIN(1, (int32_t)lround(expectedCos), AnalogDial::cosQ14(i));
+    }
+}
+
+/**
+ * 指针端点：0指向12点、顺时针；所有位置的长度误差不超过1像素
+ */
+void test_hand_end(void) {
+    int16_t x, y;
+    AnalogDial::handEnd(0, 20, CX, CY, x, y);
+    TEST_ASSERT_EQUAL(CX, x);
+    TEST_ASSERT_EQUAL(CY - 20, y);
+    AnalogDial::handEnd(15, 20, CX, CY, x, y);
+    TEST_ASSERT_EQUAL(CX + 20, x);
+    TEST_ASSERT_EQUAL(CY, y);
+    AnalogDial::handEnd(30, 20, CX, CY, x, y);
+    TEST_ASSERT_EQUAL(CX, x);
+    TEST_ASSERT_EQUAL(CY + 20, y);
+    AnalogDial::handEnd(45, 20, CX, CY, x, y);
+    TEST_ASSERT_EQUAL(CX - 20, x);
+    TEST_ASSERT_EQUAL(CY, y);
+
+    for (uint8_t pos = 0; pos < AnalogDial::POSITIONS; pos++) {
+        AnalogDial::handEnd(pos, 27, CX, CY, x, y);
+        double length = sqrt((double)(x - CX) * (x - CX) + (double)(y - CY) * (y - CY));
+        TEST_ASSERT_TRUE(fabs(length - 27) <= 1.0);
+    }
+}
+
+/**
+ * 画线：两端点都点亮，标记的tile正好是含有点亮像素的tile；超出屏幕的部分忽略
+ */
+void test_line_tiles(void) {
+    FrameBuffer::DirtyMask tiles;
+    memset(tiles, 0, sizeof(tiles));
+    AnalogDial::drawLine(dial, 3, 60, 45, 2, tiles);
+    TEST_ASSERT_TRUE(pixel(dial, 3, 60));
+    TEST_ASSERT_TRUE(pixel(dial, 45, 2));
+
+    FrameBuffer::DirtyMask lit;
+    FrameBuffer::diffTiles(dial, before, lit);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(lit, tiles, FrameBuffer::TILE_ROWS);
+
+    // 越界的线不写出帧缓冲
+    memset(tiles, 0, sizeof(tiles));
+    memset(dial, 0, sizeof(dial));
+    AnalogDial::drawLine(dial, -20, 70, 140, -5, tiles);
+    FrameBuffer::diffTiles(dial, before, lit);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(lit, tiles, FrameBuffer::TILE_ROWS);
+}
+
+/**
+ * 刻度：12个整点刻度和48个点，中心区域为空
+ */
+void test_ticks(void) {
+    AnalogDial::drawTicks(dial, CX, CY, 31, 4);
+    TEST_ASSERT_TRUE(pixel(dial, CX, CY - 31));
+    TEST_ASSERT_TRUE(pixel(dial, CX, CY - 28));
+    TEST_ASSERT_TRUE(pixel(dial, CX + 31, CY));
+    TEST_ASSERT_TRUE(pixel(dial, CX, CY + 31));
+    TEST_ASSERT_TRUE(pixel(dial, CX - 28, CY));
+    TEST_ASSERT_FALSE(pixel(dial, CX, CY));
+    TEST_ASSERT_FALSE(pixel(dial, CX - 25, CY));
+}
+
+/**
+ * 每秒：刻度层 + 时针 + 分针 + 秒针，秒针前进一格时屏幕上只有新旧秒针经过的tile变化
+ */
+void test_second_tick_tiles(void) {
+    AnalogDial::drawTicks(dial, CX, CY, 31, 4);
+    uint16_t maxBytes = 0;
+    uint32_t totalBytes = 0;
+    for (uint8_t second = 0; second < AnalogDial::POSITIONS; second++) {
+        uint8_t next = (uint8_t)((second + 1) % AnalogDial::POSITIONS);
+        FrameBuffer::DirtyMask oldTiles, newTiles;
+        memset(oldTiles, 0, sizeof(oldTiles));
+        memset(newTiles, 0, sizeof(newTiles));
+
+        FrameBuffer::copyFrame(before, dial);
+        AnalogDial::drawHand(before, 50, 15, CX, CY, nullptr);
+        AnalogDial::drawHand(before, 9, 23, CX, CY, nullptr);
+        AnalogDial::drawHand(before, second, 27, CX, CY, oldTiles);
+
+        FrameBuffer::copyFrame(after, dial);
+        AnalogDial::drawHand(after, 50, 15, CX, CY, nullptr);
+        AnalogDial::drawHand(after, 9, 23, CX, CY, nullptr);
+        AnalogDial::drawHand(after, next, 27, CX, CY, newTiles);
+
+        FrameBuffer::DirtyMask changed;
+        FrameBuffer::diffTiles(after, before, changed);
+        uint16_t bytes = 0;
+        for (uint8_t ty = 0; ty < FrameBuffer::TILE_ROWS; ty++) {
+            TEST_ASSERT_EQUAL_HEX16(0, changed[ty] & ~(oldTiles[ty] | newTiles[ty]));
+            for (uint8_t tx = 0; tx < FrameBuffer::TILE_COLS; tx++) {
+                bytes += ((oldTiles[ty] | newTiles[ty]) >> tx & 1) ? FrameBuffer::TILE_BYTES : 0;
+            }
+        }
+        if (bytes > maxBytes) maxBytes = bytes;
+        totalBytes += bytes;
+    }
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "second hand region: avg %lu / max %u bytes per second (full frame %u), table %u bytes",
+             (unsigned long)(totalBytes / AnalogDial::POSITIONS), maxBytes, FrameBuffer::SIZE,
+             (unsigned)sizeof(AnalogDial::SIN_TABLE));
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(maxBytes < FrameBuffer::SIZE / 8);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_table_accuracy);
+    RUN_TEST(test_hand_end);
+    RUN_TEST(test_line_tiles);
+    RUN_TEST(test_ticks);
+    RUN_TEST(test_second_tick_tiles);
+
+    return UNITY_END();
+}
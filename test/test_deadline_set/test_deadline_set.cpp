@@ -0,0 +1,77 @@
+/**
+ * 智能桌面伴侣 - 截止时间汇总测试
+ *
+ * 验证取最早的截止时间及其来源、没有截止时间时按上限等待、相同时间保留先提交的来源，
+ * 以及剩余时间在millis()回绕时仍然正确
+ */
+
+#include <unity.h>
+#include "DeadlineSet.h"
+
+static DeadlineSet* deadlines;
+
+void setUp(void) {
+    deadlines = new DeadlineSet();
+}
+
+void tearDown(void) {
+    delete deadlines;
+}
+
+void test_empty(void) {
+    TEST_ASSERT_EQUAL_UINT32(DeadlineSet::NONE, deadlines->getEarliest());
+    TEST_ASSERT_EQUAL_UINT8(DEADLINE_SOURCE_COUNT, deadlines->getSource());
+    TEST_ASSERT_EQUAL_UINT32(1000, deadlines->getWait(1000));
+    TEST_ASSERT_EQUAL_STRING("none", DeadlineSet::sourceName(deadlines->getSource()));
+}
+
+void test_earliest_wins(void) {
+    deadlines->offer(DEADLINE_TOUCH, DeadlineSet::NONE);
+    deadlines->offer(DEADLINE_TIME, 420);
+    deadlines->offer(DEADLINE_DISPLAY, 1800);
+    deadlines->offer(DEADLINE_CONFIG, 35);
+    deadlines->offer(DEADLINE_MONITOR, 600);
+
+    TEST_ASSERT_EQUAL_UINT32(35, deadlines->getEarliest());
+    TEST_ASSERT_EQUAL_UINT8(DEADLINE_CONFIG, deadlines->getSource());
+    TEST_ASSERT_EQUAL_UINT32(35, deadlines->getWait(1000));
+    TEST_ASSERT_EQUAL_UINT32(20, deadlines->getWait(20));
+    TEST_ASSERT_EQUAL_STRING("config", DeadlineSet::sourceName(deadlines->getSource()));
+}
+
+/**
+ * 相同的截止时间保留先提交的来源；已到期（0）的截止时间不等待
+ */
+void test_tie_and_due(void) {
+    deadlines->offer(DEADLINE_DISPLAY, 30);
+    deadlines->offer(DEADLINE_TOUCH, 30);
+    TEST_ASSERT_EQUAL_UINT8(DEADLINE_DISPLAY, deadlines->getSource());
+
+    deadlines->offer(DEADLINE_WIFI, 0);
+    TEST_ASSERT_EQUAL_UINT32(0, deadlines->getWait(1000));
+    TEST_ASSERT_EQUAL_UINT8(DEADLINE_WIFI, deadlines->getSource());
+
+    deadlines->clear();
+    TEST_ASSERT_EQUAL_UINT32(DeadlineSet::NONE, deadlines->getEarliest());
+}
+
+void test_remaining(void) {
+    TEST_ASSERT_EQUAL_UINT32(1000, DeadlineSet::remaining(5000, 5000, 1000));
+    TEST_ASSERT_EQUAL_UINT32(250, DeadlineSet::remaining(5750, 5000, 1000));
+    TEST_ASSERT_EQUAL_UINT32(0, DeadlineSet::remaining(6000, 5000, 1000));
+    TEST_ASSERT_EQUAL_UINT32(0, DeadlineSet::remaining(90000, 5000, 1000));
+
+    // millis() 回绕：起点在回绕前100ms，现在是回绕后50ms
+    TEST_ASSERT_EQUAL_UINT32(850, DeadlineSet::remaining(50, 0xFFFFFFFFUL - 99, 1000));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_empty);
+    RUN_TEST(test_earliest_wins);
+    RUN_TEST(test_tie_and_due);
+    RUN_TEST(test_remaining);
+
+    return UNITY_END();
+}
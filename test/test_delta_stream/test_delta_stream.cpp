@@ -0,0 +1,314 @@
+/**
+ * 智能桌面伴侣 - tile增量流测试与基准
+ *
+ * 用眼睛模型、关键帧动画和嘴巴精灵按与表情渲染器相同的方式绘制空闲动画，
+ * 验证由增量流还原的每一帧与完整绘制逐字节一致，
+ * 并报告每段增量流的内存占用以及与完整绘制相比每帧的耗时
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include "DeltaStream.h"
+#include "EyeModel.h"
+#include "Timeline.h"
+#include "FaceSprites.h"
+
+static const uint32_t FRAME_MS = 30;               // 与 ANIMATION_FRAME_MS 相同
+static const uint16_t POOL_BYTES = 4096;           // 与 FACE_STREAM_POOL_BYTES 相同
+static const uint8_t MOUTH_SURPRISED = 2;          // 与 MouthState 中的值相同
+static const int16_t LOOK = 3 * EYE_Q8_ONE;
+
+// 与 FaceAnimations.h 中的空闲动画相同的关键帧
+constexpr Timeline::Keyframe BLINK_FRAMES[] = {
+    {0,   {EYE_Q8_ONE, 0, 0, 0, EYE_Q8_ONE}, Timeline::MOUTH_KEEP, Timeline::EASE_STEP},
+    {75,  {0,          0, 0, 0, EYE_Q8_ONE}, Timeline::MOUTH_KEEP, Timeline::EASE_IN_OUT},
+    {150, {EYE_Q8_ONE, 0, 0, 0, EYE_Q8_ONE}, Timeline::MOUTH_KEEP, Timeline::EASE_IN_OUT}
+};
+constexpr Timeline::Keyframe LOOK_LEFT_FRAMES[] = {
+    {0,    {0, 0,     0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_STEP},
+    {150,  {0, -LOOK, 0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_IN_OUT},
+    {1000, {0, -LOOK, 0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_STEP},
+    {1150, {0, 0,     0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_IN_OUT}
+};
+constexpr Timeline::Keyframe LOOK_RIGHT_FRAMES[] = {
+    {0,    {0, 0,    0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_STEP},
+    {150,  {0, LOOK, 0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_IN_OUT},
+    {1000, {0, LOOK, 0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_STEP},
+    {1150, {0, 0,    0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_IN_OUT}
+};
+constexpr Timeline::Keyframe REACTION_FRAMES[] = {
+    {0,   {0, 0, 0, 0, EYE_Q8_ONE},         MOUTH_SURPRISED, Timeline::EASE_STEP},
+    {80,  {0, 0, 0, 0, EYE_Q8_ONE * 9 / 8}, MOUTH_SURPRISED, Timeline::EASE_IN_OUT},
+    {400, {0, 0, 0, 0, EYE_Q8_ONE * 9 / 8}, MOUTH_SURPRISED, Timeline::EASE_STEP},
+    {500, {0, 0, 0, 0, EYE_Q8_ONE},         MOUTH_SURPRISED, Timeline::EASE_LINEAR}
+};
+
+static const Timeline::Animation IDLE_ANIMATIONS[] = {
+    {BLINK_FRAMES, 3, Timeline::CHANNEL_OPENNESS, Timeline::BLEND_MULTIPLY},
+    {LOOK_LEFT_FRAMES, 4, Timeline::CHANNEL_PUPIL, Timeline::BLEND_MULTIPLY},
+    {LOOK_RIGHT_FRAMES, 4, Timeline::CHANNEL_PUPIL, Timeline::BLEND_MULTIPLY},
+    {REACTION_FRAMES, 4, Timeline::CHANNEL_SIZE | Timeline::CHANNEL_MOUTH, Timeline::BLEND_OVERRIDE}
+};
+static const char* const IDLE_NAMES[] = {"blink", "look left", "look right", "reaction"};
+static const uint8_t IDLE_COUNT = sizeof(IDLE_ANIMATIONS) / sizeof(IDLE_ANIMATIONS[0]);
+
+static const EyeModel::Params NORMAL = {EYE_Q8_ONE, 0, 0, 0, EYE_Q8_ONE};
+
+static uint8_t base[FrameBuffer::SIZE] __attribute__((aligned(4)));
+static uint8_t expected[FrameBuffer::SIZE] __attribute__((aligned(4)));
+static uint8_t frame[FrameBuffer::SIZE] __attribute__((aligned(4)));
+static uint8_t pool[POOL_BYTES];
+static DeltaStream streams[IDLE_COUNT];
+
+/**
+ * 与 FaceRenderer::render 相同的绘制顺序：眼睛（叠加动画）-> 嘴巴
+ */
+static void renderFace(uint8_t* buf, const Timeline::Player& player) {
+    EyeModel::Params params = NORMAL;
+    uint8_t mouth = Timeline::MOUTH_KEEP;
+    player.apply(params, mouth);
+    memset(buf, 0, FrameBuffer::SIZE);
+    EyeModel::render(buf, FACE_LEFT_EYE_X + EYE_RADIUS, FACE_EYE_Y + EYE_RADIUS, params);
+    EyeModel::render(buf, FACE_RIGHT_EYE_X + EYE_RADIUS, FACE_EYE_Y + EYE_RADIUS, params);
+    blitPageSprite(buf, FACE_MOUTH_X, FACE_MOUTH_Y,
+                   mouth == MOUTH_SURPRISED ? MOUTH_SURPRISED_SPRITE : MOUTH_SMILE_SPRITE);
+}
+
+/**
+ * 渲染动画在指定时刻的画面
+ */
+static void renderAt(uint8_t* buf, const Timeline::Animation& animation, uint32_t elapsed) {
+    Timeline::Player player;
+    player.play(0, animation, 0);
+    player.update(elapsed);
+    renderFace(buf, player);
+}
+
+/**
+ * 与 DisplayManager 开机时相同：按动画帧率和关键帧时刻采样，依次共用一块存储区
+ * @param used 输出增量数据总字节数
+ * @return false 有增量流不可用
+ */
+static bool bakeAll(uint16_t& used) {
+    Timeline::Player idle;
+    renderFace(base, idle);
+
+    used = 0;
+    for (uint8_t i = 0; i < IDLE_COUNT; i++) {
+        const Timeline::Animation& animation = IDLE_ANIMATIONS[i];
+        uint16_t duration = (uint16_t)Timeline::duration(animation);
+        streams[i].begin(pool + used, (uint16_t)(POOL_BYTES - used));
+        uint8_t key = 1;
+        for (uint16_t t = 0; t < duration; ) {
+            renderAt(frame, animation, t);
+            if (!streams[i].addFrame(t, frame, base)) {
+                return false;
+            }
+            uint16_t next = (uint16_t)(t + FRAME_MS);
+            while (key < animation.count && animation.frames[key].time <= t) key++;
+            if (key < animation.count && animation.frames[key].time < next) next = animation.frames[key].time;
+            t = next;
+        }
+        if (!streams[i].finish(duration)) {
+            return false;
+        }
+        used += streams[i].getDataBytes();
+    }
+    return true;
+}
+
+void setUp(void) {
+    // 初始化
+}
+
+void tearDown(void) {
+    // 清理
+}
+
+/**
+ * 单帧：增量只包含变化的tile，还原后与原画面一致；相同的相邻帧只保存一次
+ */
+void test_single_frames(void) {
+    uint8_t storage[64 * DELTA_STREAM_TILE_BYTES];
+    memset(base, 0, sizeof(base));
+    memset(frame, 0, sizeof(frame));
+    frame[3 * FrameBuffer::ROW_BYTES + 5 * FrameBuffer::TILE_BYTES + 2] = 0x40;
+    frame[7 * FrameBuffer::ROW_BYTES + 127] = 0x01;
+
+    DeltaStream stream;
+    stream.begin(storage, sizeof(storage));
+    TEST_ASSERT_TRUE(stream.addFrame(0, base, base));
+    TEST_ASSERT_TRUE(stream.addFrame(30, frame, base));
+    TEST_ASSERT_TRUE(stream.addFrame(60, frame, base));
+    TEST_ASSERT_TRUE(stream.addFrame(90, base, base));
+    TEST_ASSERT_TRUE(stream.finish(120));
+    TEST_ASSERT_EQUAL(3, stream.getFrameCount());
+    TEST_ASSERT_EQUAL(2 * DELTA_STREAM_TILE_BYTES, stream.getDataBytes());
+
+    TEST_ASSERT_EQUAL(0, stream.frameAt(0));
+    TEST_ASSERT_EQUAL(0, stream.frameAt(29));
+    TEST_ASSERT_EQUAL(1, stream.frameAt(30));
+    TEST_ASSERT_EQUAL(1, stream.frameAt(89));
+    TEST_ASSERT_EQUAL(2, stream.frameAt(90));
+    TEST_ASSERT_EQUAL(2, stream.frameAt(5000));
+
+    FrameBuffer::DirtyMask dirty;
+    FrameBuffer::copyFrame(expected, base);
+    stream.apply(1, expected, dirty);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(frame, expected, FrameBuffer::SIZE);
+    TEST_ASSERT_EQUAL_HEX16(1u << 5, dirty[3]);
+    TEST_ASSERT_EQUAL_HEX16(1u << 15, dirty[7]);
+    TEST_ASSERT_EQUAL_HEX16(0, dirty[0]);
+
+    stream.apply(2, expected, dirty);
+    for (uint8_t ty = 0; ty < FrameBuffer::TILE_ROWS; ty++) {
+        TEST_ASSERT_EQUAL_HEX16(0, dirty[ty]);
+    }
+}
+
+/**
+ * 存储区不足时增量流不可用（回退为完整绘制）
+ */
+void test_overflow_is_not_ready(void) {
+    uint8_t storage[DELTA_STREAM_TILE_BYTES];
+    memset(base, 0, sizeof(base));
+    memset(frame, 0xFF, sizeof(frame));
+
+    DeltaStream stream;
+    stream.begin(storage, sizeof(storage));
+    TEST_ASSERT_FALSE(stream.addFrame(0, frame, base));
+    TEST_ASSERT_FALSE(stream.finish(30));
+    TEST_ASSERT_FALSE(stream.isReady());
+
+    // 第一帧不从0开始
+    stream.begin(storage, sizeof(storage));
+    TEST_ASSERT_TRUE(stream.addFrame(10, base, base));
+    TEST_ASSERT_FALSE(stream.finish(30));
+}
+
+/**
+ * 空闲动画：任意时刻由 基础表情 + 增量 得到的画面与按同一采样时刻完整绘制的画面一致，
+ * 变化的tile恰好是与基础表情不同的tile
+ */
+void test_idle_streams_match_render(void) {
+    uint16_t used = 0;
+    TEST_ASSERT_TRUE(bakeAll(used));
+
+    for (uint8_t i = 0; i < IDLE_COUNT; i++) {
+        const DeltaStream& stream = streams[i];
+        for (uint32_t elapsed = 0; elapsed < stream.getDuration(); elapsed++) {
+            // 增量流在每个采样时刻之间显示同一帧
+            uint8_t index = stream.frameAt(elapsed);
+            uint32_t sampled = 0;
+            for (uint32_t t = 0; t <= elapsed; t++) {
+                if (stream.frameAt(t) == index) {
+                    sampled = t;
+                    break;
+                }
+            }
+            renderAt(expected, IDLE_ANIMATIONS[i], sampled);
+
+            FrameBuffer::DirtyMask dirty;
+            FrameBuffer::DirtyMask reference;
+            FrameBuffer::copyFrame(frame, base);
+            stream.apply(index, frame, dirty);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, frame, FrameBuffer::SIZE);
+            FrameBuffer::diffTiles(expected, base, reference);
+            TEST_ASSERT_EQUAL_HEX16_ARRAY(reference, dirty, FrameBuffer::TILE_ROWS);
+        }
+    }
+
+    char message[128];
+    for (uint8_t i = 0; i < IDLE_COUNT; i++) {
+        snprintf(message, sizeof(message), "%-10s %4u ms: %2u frames, %4u B delta + %u B table = %4u B",
+                 IDLE_NAMES[i], streams[i].getDuration(), streams[i].getFrameCount(),
+                 streams[i].getDataBytes(), (unsigned)(streams[i].getBytes() - streams[i].getDataBytes()),
+                 streams[i].getBytes());
+        TEST_MESSAGE(message);
+    }
+    snprintf(message, sizeof(message), "total delta data %u / %u B pool", used, POOL_BYTES);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_OR_EQUAL(POOL_BYTES * 3 / 4, used);
+}
+
+/**
+ * 相邻两帧之间屏幕上可能变化的tile（上一帧与本帧增量的并集）包含全部实际变化，
+ * 刷新只需比较这些tile
+ */
+void test_consecutive_frames_hint(void) {
+    uint16_t used = 0;
+    TEST_ASSERT_TRUE(bakeAll(used));
+
+    for (uint8_t i = 0; i < IDLE_COUNT; i++) {
+        const DeltaStream& stream = streams[i];
+        FrameBuffer::DirtyMask previousDirty;
+        uint8_t previous[FrameBuffer::SIZE] __attribute__((aligned(4)));
+        FrameBuffer::copyFrame(previous, base);
+        memset(previousDirty, 0, sizeof(previousDirty));
+
+        for (uint8_t index = 0; index <= stream.getFrameCount(); index++) {
+            // 最后回到基础表情（动画结束）
+            FrameBuffer::DirtyMask dirty;
+            FrameBuffer::copyFrame(frame, base);
+            stream.apply(index, frame, dirty);
+
+            FrameBuffer::DirtyMask hint;
+            FrameBuffer::DirtyMask actual;
+            for (uint8_t ty = 0; ty < FrameBuffer::TILE_ROWS; ty++) {
+                hint[ty] = (uint16_t)(dirty[ty] | previousDirty[ty]);
+            }
+            uint8_t changed = FrameBuffer::diffTiles(frame, previous, actual);
+            TEST_ASSERT_EQUAL(changed, FrameBuffer::diffCandidateTiles(frame, previous, hint));
+            TEST_ASSERT_EQUAL_HEX16_ARRAY(actual, hint, FrameBuffer::TILE_ROWS);
+
+            FrameBuffer::copyFrame(previous, frame);
+            memcpy(previousDirty, dirty, sizeof(dirty));
+        }
+    }
+}
+
+/**
+ * 每帧耗时：完整绘制 vs 复制基础表情 + 写入增量
+ */
+void test_apply_cost(void) {
+    uint16_t used = 0;
+    TEST_ASSERT_TRUE(bakeAll(used));
+    const uint32_t rounds = 2000;
+    const DeltaStream& stream = streams[1];
+    uint32_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < rounds; r++) {
+        renderAt(frame, IDLE_ANIMATIONS[1], (r * FRAME_MS) % stream.getDuration());
+        sink += frame[FrameBuffer::ROW_BYTES + 24];
+    }
+    double renderNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    FrameBuffer::DirtyMask dirty;
+    start = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < rounds; r++) {
+        FrameBuffer::copyFrame(frame, base);
+        stream.apply(stream.frameAt((r * FRAME_MS) % stream.getDuration()), frame, dirty);
+        sink += frame[FrameBuffer::ROW_BYTES + 24];
+    }
+    double applyNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    char message[128];
+    snprintf(message, sizeof(message), "per frame: full render %.0f ns, base copy + delta %.0f ns (%u)",
+             renderNs / rounds, applyNs / rounds, (unsigned)(sink & 1));
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(applyNs < renderNs);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_single_frames);
+    RUN_TEST(test_overflow_is_not_ready);
+    RUN_TEST(test_idle_streams_match_render);
+    RUN_TEST(test_consecutive_frames_hint);
+    RUN_TEST(test_apply_cost);
+
+    return UNITY_END();
+}
@@ -0,0 +1,267 @@
+/**
+ * 智能桌面伴侣 - 事件总线测试
+ *
+ * 验证按类型订阅的路由、缓冲满时丢弃新事件并计数（生产者不阻塞）、峰值深度、
+ * 各生产者之间按时间戳合并、分发延迟统计、唤醒函数按收到事件的订阅者调用（中断投递调用中断唤醒函数），
+ * 以及每个生产者一个线程（中断生产者的线程使用 publishFromISR）、与订阅者线程同时运行时事件不丢失、不重复、保持顺序，丢弃计数准确
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <thread>
+#include <atomic>
+#include "AppEvents.h"
+
+static AppEventBus* bus;
+
+// 唤醒函数收到的订阅者掩码和调用次数
+static uint8_t wokenMask;
+static uint8_t wakeCalls;
+
+static void recordWake(uint8_t subscribers, void* context) {
+    wokenMask |= subscribers;
+    wakeCalls++;
+}
+
+// 中断唤醒函数的调用次数；返回值模拟是否唤醒了更高优先级的任务
+static uint8_t isrWakeCalls;
+static bool isrWakeHigher;
+
+static bool recordWakeFromISR(uint8_t subscribers, void* context) {
+    wokenMask |= subscribers;
+    isrWakeCalls++;
+    return isrWakeHigher;
+}
+
+void setUp(void) {
+    bus = new AppEventBus();
+    wokenMask = 0;
+    wakeCalls = 0;
+    isrWakeCalls = 0;
+    isrWakeHigher = false;
+}
+
+void tearDown(void) {
+    delete bus;
+}
+
+/**
+ * 只有订阅了该类型的订阅者收到事件
+ */
+void test_routing_by_type(void) {
+    bus->subscribe(SUBSCRIBER_UI, eventBit(EVENT_TOUCH) | eventBit(EVENT_WIFI));
+    bus->subscribe(SUBSCRIBER_NETWORK, eventBit(EVENT_WIFI));
+
+    TEST_ASSERT_EQUAL_UINT8(1 << SUBSCRIBER_UI, bus->publish(PRODUCER_INPUT, makeEvent(EVENT_TOUCH, 1, 0)));
+    TEST_ASSERT_EQUAL_UINT8((1 << SUBSCRIBER_UI) | (1 << SUBSCRIBER_NETWORK),
+                            bus->publish(PRODUCER_NETWORK, makeEvent(EVENT_WIFI, 2, 0)));
+    TEST_ASSERT_EQUAL_UINT8(0, bus->publish(PRODUCER_HOUSEKEEPING, makeEvent(EVENT_STATUS, 0, 0)));
+
+    TEST_ASSERT_EQUAL_UINT32(2, bus->getDepth(SUBSCRIBER_UI));
+    TEST_ASSERT_EQUAL_UINT32(1, bus->getDepth(SUBSCRIBER_NETWORK));
+    TEST_ASSERT_FALSE(bus->hasPending(SUBSCRIBER_AUDIO));
+
+    uint8_t received = 0;
+    bus->drain(SUBSCRIBER_NETWORK, 0, [&](const AppEvent& event) {
+        TEST_ASSERT_EQUAL_UINT8(EVENT_WIFI, event.type);
+        TEST_ASSERT_EQUAL_UINT8(2, event.value);
+        received++;
+    });
+    TEST_ASSERT_EQUAL_UINT8(1, received);
+    TEST_ASSERT_FALSE(bus->hasPending(SUBSCRIBER_NETWORK));
+    TEST_ASSERT_TRUE(bus->hasPending(SUBSCRIBER_UI));
+}
+
+/**
+ * 缓冲满时新事件被丢弃并计数，已排队的事件不受影响
+ */
+void test_full_ring_drops_newest(void) {
+    bus->subscribe(SUBSCRIBER_UI, eventBit(EVENT_TOUCH));
+    for (uint8_t i = 0; i < EVENT_BUS_DEPTH + 3; i++) {
+        bus->publish(PRODUCER_INPUT, makeEvent(EVENT_TOUCH, i, i));
+    }
+    TEST_ASSERT_EQUAL_UINT32(EVENT_BUS_DEPTH, bus->getDepth(SUBSCRIBER_UI));
+    TEST_ASSERT_EQUAL_UINT32(EVENT_BUS_DEPTH, bus->getHighWater(SUBSCRIBER_UI));
+    TEST_ASSERT_EQUAL_UINT32(3, bus->getDropped(SUBSCRIBER_UI));
+
+    uint8_t expected = 0;
+    bus->drain(SUBSCRIBER_UI, 100, [&](const AppEvent& event) {
+        TEST_ASSERT_EQUAL_UINT8(expected, event.value);
+        expected++;
+    });
+    TEST_ASSERT_EQUAL_UINT8(EVENT_BUS_DEPTH, expected);
+    TEST_ASSERT_EQUAL_UINT32(0, bus->getDepth(SUBSCRIBER_UI));
+    TEST_ASSERT_EQUAL_UINT32(EVENT_BUS_DEPTH, bus->getDispatched(SUBSCRIBER_UI));
+}
+
+/**
+ * 不同生产者的事件按时间戳合并，并记录投递到处理的延迟
+ */
+void test_merge_by_timestamp(void) {
+    bus->subscribe(SUBSCRIBER_UI, eventBit(EVENT_TOUCH) | eventBit(EVENT_CLOCK) | eventBit(EVENT_STATUS));
+    bus->publish(PRODUCER_NETWORK, makeEvent(EVENT_CLOCK, 1, 1000));
+    bus->publish(PRODUCER_NETWORK, makeEvent(EVENT_CLOCK, 4, 4000));
+    bus->publish(PRODUCER_INPUT, makeEvent(EVENT_TOUCH, 2, 2000));
+    bus->publish(PRODUCER_HOUSEKEEPING, makeEvent(EVENT_STATUS, 3, 3000));
+
+    uint8_t expected = 1;
+    uint16_t handled = bus->drain(SUBSCRIBER_UI, 5000, [&](const AppEvent& event) {
+        TEST_ASSERT_EQUAL_UINT8(expected, event.value);
+        expected++;
+    });
+    TEST_ASSERT_EQUAL_UINT16(4, handled);
+
+    LatencyStats& latency = bus->getLatency(SUBSCRIBER_UI);
+    TEST_ASSERT_EQUAL_UINT32(4, latency.getCount());
+    TEST_ASSERT_EQUAL_UINT32(1000, latency.getMin());
+    TEST_ASSERT_EQUAL_UINT32(4000, latency.getMax());
+    TEST_ASSERT_EQUAL_UINT32(2500, latency.getMean());
+}
+
+/**
+ * 时间戳回绕时仍按投递先后合并
+ */
+void test_merge_across_wraparound(void) {
+    bus->subscribe(SUBSCRIBER_UI, eventBit(EVENT_TOUCH) | eventBit(EVENT_CLOCK));
+    bus->publish(PRODUCER_INPUT, makeEvent(EVENT_TOUCH, 2, 100));
+    bus->publish(PRODUCER_NETWORK, makeEvent(EVENT_CLOCK, 1, 0xFFFFFF00UL));
+
+    uint8_t expected = 1;
+    bus->drain(SUBSCRIBER_UI, 200, [&](const AppEvent& event) {
+        TEST_ASSERT_EQUAL_UINT8(expected, event.value);
+        expected++;
+    });
+    TEST_ASSERT_EQUAL_UINT8(3, expected);
+    TEST_ASSERT_EQUAL_UINT32(0x1C8, bus->getLatency(SUBSCRIBER_UI).getMax());
+}
+
+/**
+ * 投递后按收到事件的订阅者掩码调用唤醒函数（设置之前的投递只入队）
+ */
+void test_wake(void) {
+    bus->subscribe(SUBSCRIBER_UI, eventBit(EVENT_TOUCH));
+    bus->subscribe(SUBSCRIBER_AUDIO, eventBit(EVENT_TOUCH));
+
+    uint8_t mask = bus->publish(PRODUCER_INPUT, makeEvent(EVENT_TOUCH, 0, 0));
+    TEST_ASSERT_EQUAL_UINT8((1 << SUBSCRIBER_UI) | (1 << SUBSCRIBER_AUDIO), mask);
+    TEST_ASSERT_EQUAL_UINT8(0, wakeCalls);
+
+    bus->setWake(recordWake, nullptr);
+    bus->publish(PRODUCER_INPUT, makeEvent(EVENT_TOUCH, 0, 0));
+    TEST_ASSERT_EQUAL_UINT8(1, wakeCalls);
+    TEST_ASSERT_EQUAL_UINT8(mask, wokenMask);
+
+    // 没有订阅者收到（类型未订阅）时不唤醒
+    bus->publish(PRODUCER_NETWORK, makeEvent(EVENT_WIFI, 0, 0));
+    TEST_ASSERT_EQUAL_UINT8(1, wakeCalls);
+}
+
+/**
+ * 中断投递只调用中断唤醒函数，并按它的返回值报告是否需要切换任务
+ */
+void test_wake_from_isr(void) {
+    bus->subscribe(SUBSCRIBER_INPUT, eventBit(EVENT_TOUCH_EDGE));
+    bus->setWake(recordWake, nullptr);
+
+    // 没有设置中断唤醒函数时只入队
+    bool woken = false;
+    TEST_ASSERT_EQUAL_UINT8(1 << SUBSCRIBER_INPUT,
+                            bus->publishFromISR(PRODUCER_TOUCH_ISR, makeEvent(EVENT_TOUCH_EDGE, 0, 0), &woken));
+    TEST_ASSERT_FALSE(woken);
+
+    bus->setWakeFromISR(recordWakeFromISR, nullptr);
+    bus->publishFromISR(PRODUCER_TOUCH_ISR, makeEvent(EVENT_TOUCH_EDGE, 0, 1), &woken);
+    TEST_ASSERT_EQUAL_UINT8(1, isrWakeCalls);
+    TEST_ASSERT_EQUAL_UINT8(1 << SUBSCRIBER_INPUT, wokenMask);
+    TEST_ASSERT_FALSE(woken);
+
+    isrWakeHigher = true;
+    bus->publishFromISR(PRODUCER_TOUCH_ISR, makeEvent(EVENT_TOUCH_EDGE, 0, 2), &woken);
+    TEST_ASSERT_EQUAL_UINT8(2, isrWakeCalls);
+    TEST_ASSERT_TRUE(woken);
+    TEST_ASSERT_EQUAL_UINT8(0, wakeCalls);
+    TEST_ASSERT_EQUAL_UINT32(3, bus->getDepth(SUBSCRIBER_INPUT));
+}
+
+/**
+ * 每个生产者一个线程持续投递（缓冲满时让出后重试），订阅者线程同时取出：
+ * 每个生产者的事件全部按顺序到达，丢弃计数等于重试次数
+ */
+void test_concurrent_producers(void) {
+    const uint32_t PER_PRODUCER = 5000;
+    bus->subscribe(SUBSCRIBER_UI, eventBit(EVENT_TOUCH) | eventBit(EVENT_CLOCK) | eventBit(EVENT_STATUS) |
+                                  eventBit(EVENT_DORMANT) | eventBit(EVENT_TOUCH_EDGE));
+
+    std::atomic<uint8_t> finished(0);
+    std::atomic<uint32_t> retries(0);
+    uint32_t received[PRODUCER_COUNT] = {};
+    uint32_t lastSequence[PRODUCER_COUNT] = {};
+    bool ordered = true;
+
+    std::thread consumer([&]() {
+        for (;;) {
+            bool done = finished.load() == PRODUCER_COUNT;
+            bus->drain(SUBSCRIBER_UI, 0, [&](const AppEvent& event) {
+                uint8_t producer = event.value;
+                uint32_t sequence = event.status.freeHeap;
+                if (received[producer] != 0 && sequence <= lastSequence[producer]) {
+                    ordered = false;
+                }
+                lastSequence[producer] = sequence;
+                received[producer]++;
+            });
+            if (done && !bus->hasPending(SUBSCRIBER_UI)) {
+                break;
+            }
+        }
+    });
+
+    const AppEventType types[PRODUCER_COUNT] = {EVENT_TOUCH, EVENT_CLOCK, EVENT_STATUS, EVENT_DORMANT,
+                                                EVENT_TOUCH_EDGE};
+    std::thread producers[PRODUCER_COUNT];
+    for (uint8_t p = 0; p < PRODUCER_COUNT; p++) {
+        producers[p] = std::thread([&, p]() {
+            for (uint32_t i = 1; i <= PER_PRODUCER; i++) {
+                AppEvent event = makeEvent(types[p], p, i);
+                event.status.freeHeap = i;
+                bool woken = false;
+                while ((p == PRODUCER_TOUCH_ISR ? bus->publishFromISR(p, event, &woken) : bus->publish(p, event)) == 0) {
+                    retries.fetch_add(1);
+                    std::this_thread::yield();
+                }
+            }
+            finished.fetch_add(1);
+        });
+    }
+    for (uint8_t p = 0; p < PRODUCER_COUNT; p++) {
+        producers[p].join();
+    }
+    consumer.join();
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "  %lu events from %u producers delivered in order, full-ring retries %lu, high water %lu",
+             (unsigned long)bus->getDispatched(SUBSCRIBER_UI), PRODUCER_COUNT, (unsigned long)retries.load(),
+             (unsigned long)bus->getHighWater(SUBSCRIBER_UI));
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_TRUE(ordered);
+    for (uint8_t p = 0; p < PRODUCER_COUNT; p++) {
+        TEST_ASSERT_EQUAL_UINT32(PER_PRODUCER, received[p]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(retries.load(), bus->getDropped(SUBSCRIBER_UI));
+    TEST_ASSERT_EQUAL_UINT32(PER_PRODUCER * PRODUCER_COUNT, bus->getDispatched(SUBSCRIBER_UI));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_routing_by_type);
+    RUN_TEST(test_full_ring_drops_newest);
+    RUN_TEST(test_merge_by_timestamp);
+    RUN_TEST(test_merge_across_wraparound);
+    RUN_TEST(test_wake);
+    RUN_TEST(test_wake_from_isr);
+    RUN_TEST(test_concurrent_producers);
+
+    return UNITY_END();
+}
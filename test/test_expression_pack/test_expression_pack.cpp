@@ -0,0 +1,360 @@
+/**
+ * 智能桌面伴侣 - 表情包测试
+ *
+ * 按分区格式在内存中打包内置的嘴巴精灵和关键帧动画，
+ * 验证RLE编解码、表情包往返一致、损坏数据的拒绝，
+ * 并统计64个表情的压缩率、RAM占用和精灵加载耗时
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <vector>
+#include <chrono>
+#include "ExpressionPack.h"
+#include "FaceSprites.h"
+
+// 测试用的表情描述
+struct TestExpression {
+    const char* name;
+    EyeModel::Params eye;
+    const PageSprite* sprites[EXPRESSION_MAX_SPRITES];
+    uint8_t spriteCount;
+    uint16_t frameMs;
+    const Timeline::Animation* track;
+};
+
+// 嘴巴状态（与 MouthState 取值无关，只验证原样还原）
+static const uint8_t MOUTH_BASE = 0;
+static const uint8_t MOUTH_WIDE = 2;
+
+constexpr Timeline::Keyframe BOUNCE_FRAMES[] = {
+    {0,   {256, 0,    0, 0,  256}, Timeline::MOUTH_KEEP, Timeline::EASE_STEP},
+    {150, {256, 0,    0, 0,  288}, MOUTH_WIDE,           Timeline::EASE_IN_OUT},
+    {300, {128, -512, 0, 64, 256}, Timeline::MOUTH_KEEP, Timeline::EASE_LINEAR}
+};
+constexpr Timeline::Animation BOUNCE = {
+    BOUNCE_FRAMES, 3, Timeline::CHANNEL_SIZE | Timeline::CHANNEL_MOUTH, Timeline::BLEND_MULTIPLY
+};
+
+static const TestExpression EXPRESSIONS[] = {
+    {"laugh", {256, 0, 0, 96, 256}, {&MOUTH_LAUGH_SPRITE, &MOUTH_SMILE_SPRITE}, 2, 300, &BOUNCE},
+    {"wow", {256, 0, -128, 0, 288}, {&MOUTH_SURPRISED_SPRITE}, 1, 200, nullptr},
+    {"chatty", {256, 0, 0, 0, 256},
+     {&MOUTH_TALKING_1_SPRITE, &MOUTH_TALKING_2_SPRITE, &MOUTH_NEUTRAL_SPRITE, &MOUTH_SMILE_SPRITE}, 4, 150, &BOUNCE},
+    {"blank", {64, 0, 0, 0, 256}, {nullptr}, 0, 0, nullptr}
+};
+static const uint8_t EXPRESSION_COUNT = sizeof(EXPRESSIONS) / sizeof(EXPRESSIONS[0]);
+
+static std::vector<uint8_t> pack;
+static uint32_t rawBytes = 0;
+
+static void append(std::vector<uint8_t>& out, const void* data, size_t length) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    out.insert(out.end(), bytes, bytes + length);
+}
+
+static void appendInt16(std::vector<uint8_t>& out, int16_t value) {
+    out.push_back((uint8_t)(value & 0xFF));
+    out.push_back((uint8_t)((uint16_t)value >> 8));
+}
+
+static std::vector<uint8_t> compress(const std::vector<uint8_t>& raw) {
+    std::vector<uint8_t> packed(raw.size() * 2 + 2);
+    uint32_t length = ExpressionPack::rleEncode(&raw[0], (uint32_t)raw.size(), &packed[0], (uint32_t)packed.size());
+    packed.resize(length);
+    return packed;
+}
+
+/**
+ * 与 tools/make_expression_pack.py 相同的打包流程
+ * @param repeat 表情表重复次数（模拟大量表情）
+ */
+static void buildPack(uint8_t repeat) {
+    std::vector<ExpressionPack::ExpressionEntry> entries;
+    std::vector<ExpressionPack::SpriteEntry> sprites;
+    std::vector<ExpressionPack::TrackEntry> tracks;
+    std::vector<std::vector<uint8_t> > spriteData;
+    std::vector<std::vector<uint8_t> > trackData;
+    rawBytes = 0;
+
+    for (uint8_t r = 0; r < repeat; r++) {
+        for (uint8_t i = 0; i < EXPRESSION_COUNT; i++) {
+            const TestExpression& expr = EXPRESSIONS[i];
+            ExpressionPack::ExpressionEntry entry;
+            memset(&entry, 0, sizeof(entry));
+            if (r == 0) {
+                memcpy(entry.name, expr.name, strlen(expr.name));
+            } else {
+                snprintf(entry.name, EXPRESSION_NAME_LENGTH, "%.5s%u", expr.name, (unsigned)r);
+            }
+            entry.eye[0] = expr.eye.openness;
+            entry.eye[1] = expr.eye.pupilX;
+            entry.eye[2] = expr.eye.pupilY;
+            entry.eye[3] = expr.eye.squint;
+            entry.eye[4] = expr.eye.size;
+            entry.firstSprite = (uint8_t)sprites.size();
+            entry.spriteCount = expr.spriteCount;
+            entry.frameMs = expr.frameMs;
+            entry.track = EXPRESSION_NO_TRACK;
+
+            for (uint8_t s = 0; s < expr.spriteCount; s++) {
+                const PageSprite& sprite = *expr.sprites[s];
+                std::vector<uint8_t> raw(sprite.data, sprite.data + sprite.width * sprite.pages);
+                rawBytes += (uint32_t)raw.size();
+                ExpressionPack::SpriteEntry spriteEntry;
+                memset(&spriteEntry, 0, sizeof(spriteEntry));
+                spriteEntry.width = sprite.width;
+                spriteEntry.height = sprite.height;
+                spriteEntry.shift = sprite.shift;
+                spriteEntry.pages = sprite.pages;
+                spriteData.push_back(compress(raw));
+                spriteEntry.packedSize = (uint16_t)spriteData.back().size();
+                sprites.push_back(spriteEntry);
+            }
+
+            if (expr.track != nullptr) {
+                std::vector<uint8_t> raw;
+                for (uint8_t k = 0; k < expr.track->count; k++) {
+                    const Timeline::Keyframe& key = expr.track->frames[k];
+                    appendInt16(raw, (int16_t)key.time);
+                    appendInt16(raw, key.eye.openness);
+                    appendInt16(raw, key.eye.pupilX);
+                    appendInt16(raw, key.eye.pupilY);
+                    appendInt16(raw, key.eye.squint);
+                    appendInt16(raw, key.eye.size);
+                    raw.push_back(key.mouth);
+                    raw.push_back(key.easing);
+                }
+                rawBytes += (uint32_t)raw.size();
+                ExpressionPack::TrackEntry trackEntry;
+                memset(&trackEntry, 0, sizeof(trackEntry));
+                trackEntry.keyframeCount = expr.track->count;
+                trackEntry.channels = expr.track->channels;
+                trackEntry.blend = expr.track->blend;
+                trackData.push_back(compress(raw));
+                trackEntry.packedSize = (uint16_t)trackData.back().size();
+                entry.track = (uint8_t)tracks.size();
+                tracks.push_back(trackEntry);
+            }
+            entries.push_back(entry);
+        }
+    }
+
+    // 表头之后依次存放压缩数据
+    uint32_t offset = (uint32_t)(sizeof(ExpressionPack::Header) +
+                                 entries.size() * sizeof(ExpressionPack::ExpressionEntry) +
+                                 sprites.size() * sizeof(ExpressionPack::SpriteEntry) +
+                                 tracks.size() * sizeof(ExpressionPack::TrackEntry));
+    for (size_t i = 0; i < sprites.size(); i++) {
+        sprites[i].offset = offset;
+        offset += (uint32_t)spriteData[i].size();
+    }
+    for (size_t i = 0; i < tracks.size(); i++) {
+        tracks[i].offset = offset;
+        offset += (uint32_t)trackData[i].size();
+    }
+
+    ExpressionPack::Header header;
+    header.magic = EXPRESSION_PACK_MAGIC;
+    header.version = EXPRESSION_PACK_VERSION;
+    header.expressionCount = (uint16_t)entries.size();
+    header.spriteCount = (uint16_t)sprites.size();
+    header.trackCount = (uint16_t)tracks.size();
+
+    pack.clear();
+    append(pack, &header, sizeof(header));
+    append(pack, &entries[0], entries.size() * sizeof(entries[0]));
+    append(pack, &sprites[0], sprites.size() * sizeof(sprites[0]));
+    append(pack, &tracks[0], tracks.size() * sizeof(tracks[0]));
+    for (size_t i = 0; i < spriteData.size(); i++) append(pack, &spriteData[i][0], spriteData[i].size());
+    for (size_t i = 0; i < trackData.size(); i++) append(pack, &trackData[i][0], trackData[i].size());
+}
+
+static uint32_t hostMicros(void) {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static ExpressionPack expressions;
+
+void setUp(void) {
+    buildPack(1);
+    TEST_ASSERT_TRUE(expressions.begin(&pack[0], (uint32_t)pack.size(), hostMicros));
+    expressions.resetStats();
+}
+
+void tearDown(void) {
+    // 清理
+}
+
+/**
+ * RLE：长重复、刚好到达和超过单段上限的重复与原样字节都能还原
+ */
+void test_rle_round_trip(void) {
+    std::vector<uint8_t> raw;
+    raw.insert(raw.end(), 300, 0x00);                   // 超过130字节的重复
+    for (int i = 0; i < 200; i++) raw.push_back((uint8_t)(i * 37 + 1));  // 超过128字节的原样
+    raw.insert(raw.end(), 130, 0xAA);
+    raw.insert(raw.end(), 2, 0x55);                     // 2字节重复按原样处理
+    raw.push_back(0x01);
+    raw.insert(raw.end(), 3, 0x7F);
+
+    std::vector<uint8_t> packed = compress(raw);
+    TEST_ASSERT_TRUE(packed.size() > 0 && packed.size() < raw.size());
+
+    std::vector<uint8_t> decoded(raw.size());
+    TEST_ASSERT_EQUAL(raw.size(), ExpressionPack::rleDecode(&packed[0], (uint32_t)packed.size(),
+                                                            &decoded[0], (uint32_t)decoded.size()));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&raw[0], &decoded[0], raw.size());
+
+    // 输出空间不足或数据截断时失败
+    TEST_ASSERT_EQUAL(0, ExpressionPack::rleDecode(&packed[0], (uint32_t)packed.size(),
+                                                   &decoded[0], (uint32_t)raw.size() - 1));
+    TEST_ASSERT_EQUAL(0, ExpressionPack::rleDecode(&packed[0], (uint32_t)packed.size() - 1,
+                                                   &decoded[0], (uint32_t)decoded.size()));
+}
+
+/**
+ * 往返：解压出的精灵、眼睛参数和关键帧与打包前一致
+ */
+void test_pack_round_trip(void) {
+    TEST_ASSERT_EQUAL(EXPRESSION_COUNT, expressions.getExpressionCount());
+
+    for (uint8_t i = 0; i < EXPRESSION_COUNT; i++) {
+        const TestExpression& expr = EXPRESSIONS[i];
+        TEST_ASSERT_EQUAL(i, expressions.find(expr.name));
+        TEST_ASSERT_TRUE(expressions.load(i));
+        TEST_ASSERT_EQUAL(i, expressions.getActive());
+        TEST_ASSERT_TRUE(EyeModel::equals(expr.eye, expressions.getEyeParams()));
+        TEST_ASSERT_EQUAL(expr.frameMs, expressions.getFrameMs());
+
+        TEST_ASSERT_EQUAL(expr.spriteCount, expressions.getSpriteCount());
+        for (uint8_t s = 0; s < expr.spriteCount; s++) {
+            const PageSprite* sprite = expressions.getSprite(s);
+            TEST_ASSERT_NOT_NULL(sprite);
+            TEST_ASSERT_EQUAL(expr.sprites[s]->width, sprite->width);
+            TEST_ASSERT_EQUAL(expr.sprites[s]->height, sprite->height);
+            TEST_ASSERT_EQUAL(expr.sprites[s]->shift, sprite->shift);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(expr.sprites[s]->data, sprite->data, MOUTH_SPRITE_BYTES);
+        }
+        TEST_ASSERT_NULL(expressions.getSprite(expr.spriteCount));
+
+        const Timeline::Animation* animation = expressions.getAnimation();
+        if (expr.track == nullptr) {
+            TEST_ASSERT_NULL(animation);
+            continue;
+        }
+        TEST_ASSERT_NOT_NULL(animation);
+        TEST_ASSERT_EQUAL(expr.track->count, animation->count);
+        TEST_ASSERT_EQUAL(expr.track->channels, animation->channels);
+        TEST_ASSERT_EQUAL(expr.track->blend, animation->blend);
+        for (uint8_t k = 0; k < animation->count; k++) {
+            TEST_ASSERT_EQUAL(expr.track->frames[k].time, animation->frames[k].time);
+            TEST_ASSERT_TRUE(EyeModel::equals(expr.track->frames[k].eye, animation->frames[k].eye));
+            TEST_ASSERT_EQUAL(expr.track->frames[k].mouth, animation->frames[k].mouth);
+            TEST_ASSERT_EQUAL(expr.track->frames[k].easing, animation->frames[k].easing);
+        }
+    }
+
+    TEST_ASSERT_EQUAL(-1, expressions.find("missing"));
+    char name[EXPRESSION_NAME_LENGTH + 1];
+    expressions.getName(2, name);
+    TEST_ASSERT_EQUAL_STRING("chatty", name);
+}
+
+/**
+ * 从表情包加载的动画可以直接交给关键帧播放器
+ */
+void test_loaded_track_plays(void) {
+    TEST_ASSERT_TRUE(expressions.load(0));
+    Timeline::Player player;
+    player.play(0, *expressions.getAnimation(), 0);
+    player.update(150);
+
+    EyeModel::Params eye = {EYE_Q8_ONE, 0, 0, 0, EYE_Q8_ONE};
+    uint8_t mouth = MOUTH_BASE;
+    player.apply(eye, mouth);
+    TEST_ASSERT_EQUAL(288, eye.size);
+    TEST_ASSERT_EQUAL(MOUTH_WIDE, mouth);
+
+    player.update(300);
+    TEST_ASSERT_FALSE(player.isPlaying(0));
+}
+
+/**
+ * 文件头、表格或压缩数据损坏时拒绝打开或加载
+ */
+void test_rejects_corrupt_pack(void) {
+    ExpressionPack broken;
+    pack[0] ^= 0xFF;
+    TEST_ASSERT_FALSE(broken.begin(&pack[0], (uint32_t)pack.size()));
+    TEST_ASSERT_EQUAL(0, broken.getExpressionCount());
+    pack[0] ^= 0xFF;
+
+    // 表格超出数据长度
+    TEST_ASSERT_FALSE(broken.begin(&pack[0], sizeof(ExpressionPack::Header) + 4));
+
+    // 截断压缩数据：精灵解压失败，没有当前表情
+    TEST_ASSERT_TRUE(broken.begin(&pack[0], (uint32_t)pack.size() - 1));
+    TEST_ASSERT_TRUE(broken.load(1));
+    TEST_ASSERT_FALSE(broken.load(2));
+    TEST_ASSERT_EQUAL(-1, broken.getActive());
+    TEST_ASSERT_EQUAL(0, broken.getSpriteCount());
+    TEST_ASSERT_NULL(broken.getAnimation());
+    TEST_ASSERT_FALSE(broken.load(EXPRESSION_COUNT));
+}
+
+/**
+ * 64个表情：表情包大小、压缩率、RAM占用（与表情数量无关）和加载耗时
+ */
+void test_many_expressions_fixed_ram(void) {
+    const uint8_t repeat = 16;
+    buildPack(repeat);
+    ExpressionPack many;
+    TEST_ASSERT_TRUE(many.begin(&pack[0], (uint32_t)pack.size(), hostMicros));
+    TEST_ASSERT_EQUAL(repeat * EXPRESSION_COUNT, many.getExpressionCount());
+
+    // 依次切换所有表情两轮；同一表情重复加载直接命中缓存
+    for (uint8_t round = 0; round < 2; round++) {
+        for (uint16_t i = 0; i < many.getExpressionCount(); i++) {
+            TEST_ASSERT_TRUE(many.load(i));
+            TEST_ASSERT_TRUE(many.load(i));
+        }
+    }
+    TEST_ASSERT_EQUAL(many.getLoadCount() / 2, many.getHitCount());
+    TEST_ASSERT_EQUAL((repeat - 1) * EXPRESSION_COUNT + 2, many.find("chatt15"));
+
+    // 主机上单次解压不到1微秒，按纳秒统计一个4帧表情的加载耗时
+    const int iterations = 20000;
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        many.load((uint16_t)((i & 1) * EXPRESSION_COUNT + 2));
+    }
+    double loadNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+
+    char message[200];
+    snprintf(message, sizeof(message),
+             "%u expressions: %u raw bytes -> pack %u bytes; ExpressionPack RAM %u bytes; "
+             "4-frame load %.0f ns (max %u us)",
+             (unsigned)many.getExpressionCount(), (unsigned)rawBytes, (unsigned)pack.size(),
+             (unsigned)sizeof(ExpressionPack), loadNs, (unsigned)many.getMaxLoadMicros());
+    TEST_MESSAGE(message);
+
+    // 压缩后（含表格）不到原始数据的2/3
+    TEST_ASSERT_LESS_THAN(rawBytes * 2 / 3, pack.size());
+    // RAM只容纳当前表情
+    TEST_ASSERT_LESS_OR_EQUAL(1024, sizeof(ExpressionPack));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_rle_round_trip);
+    RUN_TEST(test_pack_round_trip);
+    RUN_TEST(test_loaded_track_plays);
+    RUN_TEST(test_rejects_corrupt_pack);
+    RUN_TEST(test_many_expressions_fixed_ram);
+
+    return UNITY_END();
+}
@@ -0,0 +1,249 @@
+/**
+ * 智能桌面伴侣 - 参数化眼睛测试与基准
+ *
+ * 验证眼睛模型的形状、瞳孔移动、眨眼和参数插值，
+ * 并与逐像素绘制两只20x20 XBM眼睛对比每帧耗时和数据占用
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include "EyeModel.h"
+#include "FaceSprites.h"
+
+static const int16_t CX = FACE_LEFT_EYE_X + EYE_RADIUS;
+static const int16_t CY = FACE_EYE_Y + EYE_RADIUS;
+static const EyeModel::Params OPEN = {EYE_Q8_ONE, 0, 0, 0, EYE_Q8_ONE};
+
+static uint8_t frame[FrameBuffer::SIZE];
+
+static bool pixel(int16_t x, int16_t y) {
+    return (frame[(y >> 3) * FrameBuffer::ROW_BYTES + x] >> (y & 7)) & 1;
+}
+
+/**
+ * 统计矩形范围内点亮的像素数和加权X坐标
+ */
+static uint16_t countPixels(int16_t x0, int16_t x1, int16_t y0, int16_t y1, int32_t* sumX = nullptr) {
+    uint16_t count = 0;
+    for (int16_t y = y0; y <= y1; y++) {
+        for (int16_t x = x0; x <= x1; x++) {
+            if (pixel(x, y)) {
+                count++;
+                if (sumX != nullptr) *sumX += x;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * 瞳孔像素的平均X坐标（只看眼眶内部）
+ */
+static int32_t pupilCenterX(void) {
+    int32_t sumX = 0;
+    uint16_t count = countPixels(CX - 7, CX + 6, CY - 2, CY + 1, &sumX);
+    return count == 0 ? 0 : sumX / count;
+}
+
+/**
+ * 逐像素绘制XBM（与U8g2 drawXBMP不透明模式逻辑一致）
+ */
+static void drawXbmReference(uint8_t* buf, int x, int y, int w, int h, const uint8_t* xbm) {
+    int stride = (w + 7) / 8;
+    for (int row = 0; row < h; row++) {
+        for (int col = 0; col < w; col++) {
+            int px = x + col;
+            int py = y + row;
+            if (px < 0 || px >= 128 || py < 0 || py >= 64) continue;
+            uint8_t* dst = &buf[(py / 8) * FrameBuffer::ROW_BYTES + px];
+            uint8_t bit = (uint8_t)(1 << (py & 7));
+            if ((xbm[row * stride + col / 8] >> (col & 7)) & 1) {
+                *dst |= bit;
+            } else {
+                *dst &= (uint8_t)~bit;
+            }
+        }
+    }
+}
+
+void setUp(void) {
+    memset(frame, 0, sizeof(frame));
+}
+
+void tearDown(void) {
+    // 清理
+}
+
+/**
+ * 睁眼：轮廓闭合且左右、上下对称，瞳孔在中心
+ */
+void test_open_eye_shape(void) {
+    EyeModel::render(frame, CX, CY, OPEN);
+
+    // 轮廓：中心行的最左、最右列，中心列的最上、最下行
+    TEST_ASSERT_TRUE(pixel(CX - EYE_RADIUS, CY));
+    TEST_ASSERT_TRUE(pixel(CX + EYE_RADIUS - 1, CY));
+    TEST_ASSERT_TRUE(pixel(CX, CY - EYE_RADIUS));
+    TEST_ASSERT_TRUE(pixel(CX, CY + EYE_RADIUS - 1));
+    TEST_ASSERT_FALSE(pixel(CX - EYE_RADIUS - 1, CY));
+    TEST_ASSERT_FALSE(pixel(CX, CY - EYE_RADIUS - 1));
+
+    // 眼眶与瞳孔之间留白，瞳孔实心
+    TEST_ASSERT_FALSE(pixel(CX - EYE_RADIUS + 2, CY));
+    TEST_ASSERT_TRUE(pixel(CX, CY));
+    TEST_ASSERT_TRUE(pixel(CX - EYE_PUPIL_RADIUS + 1, CY));
+
+    // 对称
+    for (int16_t dy = -EYE_RADIUS; dy < EYE_RADIUS; dy++) {
+        for (int16_t dx = 0; dx < EYE_RADIUS; dx++) {
+            TEST_ASSERT_EQUAL(pixel(CX + dx, CY + dy), pixel(CX - 1 - dx, CY + dy));
+            TEST_ASSERT_EQUAL(pixel(CX + dx, CY + dy), pixel(CX + dx, CY - 1 - dy));
+        }
+    }
+}
+
+/**
+ * 瞳孔随参数连续移动，且不会画到眼眶外
+ */
+void test_pupil_moves_with_params(void) {
+    int32_t previous = -1;
+    for (int16_t px = -3 * EYE_Q8_ONE; px <= 3 * EYE_Q8_ONE; px += EYE_Q8_ONE) {
+        memset(frame, 0, sizeof(frame));
+        EyeModel::Params params = OPEN;
+        params.pupilX = px;
+        EyeModel::render(frame, CX, CY, params);
+        int32_t center = pupilCenterX();
+        TEST_ASSERT_TRUE(center > previous);
+        previous = center;
+        TEST_ASSERT_EQUAL(0, countPixels(0, CX - EYE_RADIUS - 1, 0, 63));
+        TEST_ASSERT_EQUAL(0, countPixels(CX + EYE_RADIUS, 127, 0, 63));
+    }
+}
+
+/**
+ * 眨眼：睁开程度越小，眼睛越矮；闭眼时只剩一条弧线
+ */
+void test_openness_and_closed_eye(void) {
+    int16_t previousHeight = 2 * EYE_RADIUS + 1;
+    for (int16_t openness = EYE_Q8_ONE; openness >= 0; openness -= EYE_Q8_ONE / 8) {
+        memset(frame, 0, sizeof(frame));
+        EyeModel::Params params = OPEN;
+        params.openness = openness;
+        EyeModel::render(frame, CX, CY, params);
+
+        int16_t top = 64, bottom = -1;
+        for (int16_t y = 0; y < 64; y++) {
+            if (countPixels(CX - EYE_RADIUS, CX + EYE_RADIUS - 1, y, y) > 0) {
+                if (top == 64) top = y;
+                bottom = y;
+            }
+        }
+        int16_t height = (int16_t)(bottom - top + 1);
+        if (openness >= EYE_CLOSED_OPENNESS) {
+            TEST_ASSERT_TRUE(height <= previousHeight);
+            previousHeight = height;
+        } else {
+            // 闭眼弧线：不超过5行，且覆盖整个眼睛宽度
+            TEST_ASSERT_LESS_OR_EQUAL(5, height);
+        }
+    }
+
+    TEST_ASSERT_TRUE(countPixels(CX - EYE_RADIUS, CX - EYE_RADIUS, 0, 63) > 0);
+    TEST_ASSERT_TRUE(countPixels(CX + EYE_RADIUS - 1, CX + EYE_RADIUS - 1, 0, 63) > 0);
+}
+
+/**
+ * 不透明绘制：清除眼睛所在列的旧内容，不影响其他列
+ */
+void test_render_is_opaque_within_eye_columns(void) {
+    memset(frame, 0xFF, sizeof(frame));
+    EyeModel::Params closed = OPEN;
+    closed.openness = 0;
+    EyeModel::render(frame, CX, CY, closed);
+
+    TEST_ASSERT_FALSE(pixel(CX, CY - EYE_RADIUS));
+    TEST_ASSERT_TRUE(pixel(CX - EYE_RADIUS - 1, CY));
+    TEST_ASSERT_TRUE(pixel(CX, CY + EYE_MAX_RADIUS));
+}
+
+/**
+ * 插值：单调趋近目标，并在有限帧内精确到达
+ */
+void test_approach_converges(void) {
+    EyeModel::Params current = OPEN;
+    EyeModel::Params target = {0, 3 * EYE_Q8_ONE, -EYE_Q8_ONE, EYE_Q8_ONE / 2, EYE_Q8_ONE * 9 / 8};
+
+    int16_t previous = current.openness;
+    uint8_t frames = 0;
+    while (EyeModel::approach(current, target, 30)) {
+        TEST_ASSERT_TRUE(current.openness <= previous);
+        previous = current.openness;
+        frames++;
+        TEST_ASSERT_LESS_THAN(64, frames);
+    }
+    TEST_ASSERT_TRUE(EyeModel::equals(current, target));
+    TEST_ASSERT_GREATER_THAN(2, frames);
+
+    // 单帧不会一步跳到目标（看左右不再瞬间切换）
+    current = OPEN;
+    target = OPEN;
+    target.pupilX = -3 * EYE_Q8_ONE;
+    EyeModel::approach(current, target, 30);
+    TEST_ASSERT_TRUE(current.pupilX < 0);
+    TEST_ASSERT_TRUE(current.pupilX > target.pupilX);
+}
+
+/**
+ * 基准：每帧绘制两只眼睛，参数化绘制应快于逐像素绘制XBM，且数据更少
+ */
+void test_benchmark_eye_render(void) {
+    const int iterations = 20000;
+    typedef std::chrono::steady_clock Clock;
+    static uint8_t reference[FrameBuffer::SIZE];
+
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        drawXbmReference(reference, FACE_LEFT_EYE_X, FACE_EYE_Y, EYE_WIDTH, EYE_HEIGHT, EYE_NORMAL_BITMAP);
+        drawXbmReference(reference, FACE_RIGHT_EYE_X, FACE_EYE_Y, EYE_WIDTH, EYE_HEIGHT, EYE_NORMAL_BITMAP);
+    }
+    double xbmNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+
+    // 参数每帧变化（模拟插值中的眨眼和看左右）
+    uint32_t bytes = 0;
+    start = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        EyeModel::Params params = OPEN;
+        params.openness = (int16_t)(i & 0xFF);
+        params.pupilX = (int16_t)((i & 0x3FF) - 0x200);
+        bytes = EyeModel::render(frame, CX, CY, params);
+        bytes += EyeModel::render(frame, FACE_RIGHT_EYE_X + EYE_RADIUS, CY, params);
+    }
+    double modelNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+
+    // 数据占用：6张眼睛位图（XBM + 页格式精灵）对比圆形查表
+    unsigned bitmapBytes = 6 * (sizeof(EYE_NORMAL_BITMAP) + EYE_SPRITE_BYTES);
+    unsigned modelBytes = sizeof(EyeModel::CIRCLE_Q8) + 5 * sizeof(EyeModel::Params);
+
+    char message[160];
+    snprintf(message, sizeof(message),
+             "drawXBMP: %.0f ns/frame, EyeModel: %.0f ns/frame (%u bytes written); data %u bytes vs %u bytes",
+             xbmNs, modelNs, (unsigned)bytes, bitmapBytes, modelBytes);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_TRUE(modelNs < xbmNs);
+    TEST_ASSERT_LESS_THAN(bitmapBytes / 4, modelBytes);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_open_eye_shape);
+    RUN_TEST(test_pupil_moves_with_params);
+    RUN_TEST(test_openness_and_closed_eye);
+    RUN_TEST(test_render_is_opaque_within_eye_columns);
+    RUN_TEST(test_approach_converges);
+    RUN_TEST(test_benchmark_eye_render);
+
+    return UNITY_END();
+}
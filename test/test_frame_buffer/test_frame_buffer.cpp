@@ -0,0 +1,280 @@
+/**
+ * 智能桌面伴侣 - 帧缓冲比较测试
+ *
+ * 验证逐tile比较、连续脏tile合并、矩形区域的tile标记、图层合成、过渡合成和滚动窗口的正确性，
+ * 并统计时钟模式（仅秒数变化）下的I2C传输量
+ */
+
+#include <unity.h>
+#include "FrameBuffer.h"
+#include "../helpers/TestRandom.h"
+
+static uint8_t current[FrameBuffer::SIZE] __attribute__((aligned(4)));
+static uint8_t previous[FrameBuffer::SIZE] __attribute__((aligned(4)));
+
+/**
+ * 在页模式缓冲区中设置一个像素（与U8g2全缓冲布局一致）
+ */
+static void setPixel(uint8_t* buf, int x, int y) {
+    buf[(y / 8) * FrameBuffer::ROW_BYTES + x] |= (uint8_t)(1 << (y & 7));
+}
+
+/**
+ * 统计按连续段发送时的字节数（与DisplayManager::flushFrame逻辑一致）
+ */
+static uint16_t countFlushBytes(const FrameBuffer::DirtyMask dirty) {
+    uint16_t bytes = 0;
+    for (uint8_t ty = 0; ty < FrameBuffer::TILE_ROWS; ty++) {
+        uint8_t tx = 0;
+        uint8_t length = 0;
+        while (FrameBuffer::nextRun(dirty[ty], tx, length)) {
+            bytes += length * FrameBuffer::TILE_BYTES;
+            tx += length;
+        }
+    }
+    return bytes;
+}
+
+void setUp(void) {
+    memset(current, 0, sizeof(current));
+    memset(previous, 0, sizeof(previous));
+}
+
+void tearDown(void) {
+    // 清理
+}
+
+/**
+ * 相同的两帧不应产生任何脏tile
+ */
+void test_identical_frames_have_no_dirty_tiles(void) {
+    FrameBuffer::DirtyMask dirty;
+    setPixel(current, 10, 10);
+    setPixel(previous, 10, 10);
+
+    TEST_ASSERT_EQUAL(0, FrameBuffer::diffTiles(current, previous, dirty));
+    for (uint8_t ty = 0; ty < FrameBuffer::TILE_ROWS; ty++) {
+        TEST_ASSERT_EQUAL(0, dirty[ty]);
+    }
+}
+
+/**
+ * 单个像素变化只标记其所在的tile
+ */
+void test_single_pixel_marks_one_tile(void) {
+    FrameBuffer::DirtyMask dirty;
+    setPixel(current, 127, 63);
+
+    TEST_ASSERT_EQUAL(1, FrameBuffer::diffTiles(current, previous, dirty));
+    TEST_ASSERT_EQUAL(1u << 15, dirty[7]);
+    TEST_ASSERT_EQUAL(0, dirty[0]);
+}
+
+/**
+ * 连续的脏tile合并为一段，不连续的分为多段
+ */
+void test_runs_are_merged(void) {
+    uint8_t start = 0;
+    uint8_t length = 0;
+    uint16_t mask = 0x0E31;  // tile 0, 4-5, 9-11
+
+    TEST_ASSERT_TRUE(FrameBuffer::nextRun(mask, start, length));
+    TEST_ASSERT_EQUAL(0, start);
+    TEST_ASSERT_EQUAL(1, length);
+
+    start += length;
+    TEST_ASSERT_TRUE(FrameBuffer::nextRun(mask, start, length));
+    TEST_ASSERT_EQUAL(4, start);
+    TEST_ASSERT_EQUAL(2, length);
+
+    start += length;
+    TEST_ASSERT_TRUE(FrameBuffer::nextRun(mask, start, length));
+    TEST_ASSERT_EQUAL(9, start);
+    TEST_ASSERT_EQUAL(3, length);
+
+    start += length;
+    TEST_ASSERT_FALSE(FrameBuffer::nextRun(mask, start, length));
+}
+
+/**
+ * 时钟模式下秒数个位变化，传输量应不到全屏的1/10
+ */
+void test_clock_second_change_traffic(void) {
+    FrameBuffer::DirtyMask dirty;
+
+    // 模拟秒数个位所在区域（x: 100-112, y: 16-38）的变化
+    for (int y = 16; y <= 38; y++) {
+        for (int x = 100; x < 112; x += 2) {
+            setPixel(current, x, y);
+        }
+    }
+
+    FrameBuffer::diffTiles(current, previous, dirty);
+    uint16_t bytes = countFlushBytes(dirty);
+
+    TEST_ASSERT_GREATER_THAN(0, bytes);
+    TEST_ASSERT_LESS_THAN(FrameBuffer::SIZE / 10, bytes);
+}
+
+/**
+ * 矩形区域标记的tile覆盖区域内任意像素变化产生的脏tile，且不越出屏幕
+ */
+void test_mark_columns(void) {
+    FrameBuffer::DirtyMask marked;
+    memset(marked, 0, sizeof(marked));
+
+    // 跨越两个tile列边界的区域（x: 13-30，第2-4页）
+    FrameBuffer::markColumns(marked, 13, 18, 2, 3);
+    TEST_ASSERT_EQUAL_HEX16(0, marked[1]);
+    TEST_ASSERT_EQUAL_HEX16(0x000E, marked[2]);
+    TEST_ASSERT_EQUAL_HEX16(0x000E, marked[4]);
+    TEST_ASSERT_EQUAL_HEX16(0, marked[5]);
+
+    for (int y = 16; y < 40; y += 3) {
+        for (int x = 13; x < 31; x += 5) {
+            setPixel(current, x, y);
+        }
+    }
+    FrameBuffer::DirtyMask dirty;
+    FrameBuffer::diffTiles(current, previous, dirty);
+    for (uint8_t ty = 0; ty < FrameBuffer::TILE_ROWS; ty++) {
+        TEST_ASSERT_EQUAL_HEX16(0, dirty[ty] & ~marked[ty]);
+    }
+
+    // 超出右边界和最后一页的部分被忽略
+    memset(marked, 0, sizeof(marked));
+    FrameBuffer::markColumns(marked, 120, 20, 6, 4);
+    TEST_ASSERT_EQUAL_HEX16(0x8000, marked[6]);
+    TEST_ASSERT_EQUAL_HEX16(0x8000, marked[7]);
+    FrameBuffer::markColumns(marked, 0, 255, 0, 1);
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, marked[0]);
+}
+
+/**
+ * 背景层复制后叠加覆盖层，结果为两层像素的并集
+ */
+void test_layer_composition(void) {
+    uint8_t frame[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    memset(frame, 0xAA, sizeof(frame));
+
+    setPixel(current, 0, 0);        // 背景层
+    setPixel(previous, 127, 63);    // 覆盖层
+    setPixel(previous, 0, 1);
+
+    FrameBuffer::copyFrame(frame, current);
+    FrameBuffer::orFrame(frame, previous);
+
+    TEST_ASSERT_EQUAL_HEX8(0x03, frame[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x80, frame[FrameBuffer::SIZE - 1]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, frame[1]);
+}
+
+/**
+ * 统计帧中点亮的像素数
+ */
+static uint16_t countPixels(const uint8_t* buf) {
+    uint16_t count = 0;
+    for (uint16_t i = 0; i < FrameBuffer::SIZE; i++) {
+        for (uint8_t b = 0; b < 8; b++) {
+            count += (buf[i] >> b) & 1;
+        }
+    }
+    return count;
+}
+
+/**
+ * 三种过渡在起点等于旧画面、终点等于新画面
+ */
+void test_transitions_endpoints(void) {
+    uint8_t frame[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    memset(current, 0xFF, sizeof(current));     // 旧画面：全亮
+    memset(previous, 0x00, sizeof(previous));   // 新画面：全暗
+
+    FrameBuffer::slideHorizontal(frame, current, previous, 0);
+    TEST_ASSERT_EQUAL_MEMORY(current, frame, FrameBuffer::SIZE);
+    FrameBuffer::slideHorizontal(frame, current, previous, 128);
+    TEST_ASSERT_EQUAL_MEMORY(previous, frame, FrameBuffer::SIZE);
+
+    FrameBuffer::wipeVertical(frame, current, previous, 0);
+    TEST_ASSERT_EQUAL_MEMORY(current, frame, FrameBuffer::SIZE);
+    FrameBuffer::wipeVertical(frame, current, previous, 64);
+    TEST_ASSERT_EQUAL_MEMORY(previous, frame, FrameBuffer::SIZE);
+
+    FrameBuffer::ditherCrossfade(frame, current, previous, 0);
+    TEST_ASSERT_EQUAL_MEMORY(current, frame, FrameBuffer::SIZE);
+    FrameBuffer::ditherCrossfade(frame, current, previous, 16);
+    TEST_ASSERT_EQUAL_MEMORY(previous, frame, FrameBuffer::SIZE);
+}
+
+/**
+ * 过渡中间状态：滑动按列、擦除按行、抖动按比例混合
+ */
+void test_transitions_midpoints(void) {
+    uint8_t frame[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    memset(current, 0xFF, sizeof(current));
+    memset(previous, 0x00, sizeof(previous));
+
+    // 滑动32列：右侧32列为新画面
+    FrameBuffer::slideHorizontal(frame, current, previous, 32);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, frame[95]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, frame[96]);
+    TEST_ASSERT_EQUAL(96 * 64, countPixels(frame));
+
+    // 擦除20行：前20行为新画面
+    FrameBuffer::wipeVertical(frame, current, previous, 20);
+    TEST_ASSERT_EQUAL(44 * 128, countPixels(frame));
+    TEST_ASSERT_EQUAL_HEX8(0xF0, frame[2 * FrameBuffer::ROW_BYTES]);
+
+    // 抖动级别8：一半像素来自新画面
+    FrameBuffer::ditherCrossfade(frame, current, previous, 8);
+    TEST_ASSERT_EQUAL(128 * 64 / 2, countPixels(frame));
+}
+
+/**
+ * 从高位图中按任意行偏移取出一屏，与逐像素复制结果一致
+ */
+void test_scroll_window(void) {
+    const uint8_t srcPages = 12;
+    static uint8_t tall[12 * FrameBuffer::ROW_BYTES] __attribute__((aligned(4)));
+    uint8_t frame[FrameBuffer::SIZE] __attribute__((aligned(4)));
+
+    TestRandom rng(99);
+    for (uint16_t i = 0; i < sizeof(tall); i++) {
+        uint32_t bits = rng.next();
+        tall[i] = (uint8_t)(bits >> 16);
+    }
+
+    const uint16_t offsets[] = {0, 1, 7, 8, 13, 31, 40};
+    for (uint8_t n = 0; n < sizeof(offsets) / sizeof(offsets[0]); n++) {
+        uint16_t top = offsets[n];
+        memset(current, 0, sizeof(current));
+        for (int y = 0; y < 64; y++) {
+            int srcY = y + top;
+            for (int x = 0; x < 128; x++) {
+                if (srcY < srcPages * 8 &&
+                    (tall[(srcY / 8) * FrameBuffer::ROW_BYTES + x] >> (srcY & 7)) & 1) {
+                    setPixel(current, x, y);
+                }
+            }
+        }
+
+        FrameBuffer::scrollWindow(frame, tall, srcPages, top);
+        TEST_ASSERT_EQUAL_MEMORY(current, frame, FrameBuffer::SIZE);
+    }
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_identical_frames_have_no_dirty_tiles);
+    RUN_TEST(test_single_pixel_marks_one_tile);
+    RUN_TEST(test_runs_are_merged);
+    RUN_TEST(test_clock_second_change_traffic);
+    RUN_TEST(test_mark_columns);
+    RUN_TEST(test_layer_composition);
+    RUN_TEST(test_transitions_endpoints);
+    RUN_TEST(test_transitions_midpoints);
+    RUN_TEST(test_scroll_window);
+
+    return UNITY_END();
+}
@@ -0,0 +1,217 @@
+/**
+ * 智能桌面伴侣 - 中文字库测试
+ *
+ * 在内存中按分区格式生成一个3500字的字库，验证二分查找、LRU缓存，
+ * 并渲染一条200字的回复，统计命中率、flash读取次数和RAM占用
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "GlyphStore.h"
+#include "TextLayout.h"
+#include "../helpers/TestRandom.h"
+
+static const uint16_t FIRST_CODE = 0x4E00;
+static const uint16_t GLYPH_COUNT = 3500;
+static const uint8_t GLYPH_SIZE = 12;
+static const uint8_t GLYPH_BYTES = 24;      // 12列 x 2页
+
+// 模拟的字库分区
+static std::vector<uint8_t> partition;
+static uint32_t bytesRead = 0;
+
+/**
+ * 码点对应的测试字形（每个字节由码点和位置决定，便于校验）
+ */
+static uint8_t glyphByte(uint16_t code, uint8_t i) {
+    return (uint8_t)(code * 31 + i * 7);
+}
+
+/**
+ * 按 GlyphStore 的格式生成字库：码点为 0x4E00 起的偶数码点
+ */
+static void buildFont(void) {
+    GlyphStore::Header header;
+    header.magic = GLYPH_FONT_MAGIC;
+    header.version = GLYPH_FONT_VERSION;
+    header.glyphCount = GLYPH_COUNT;
+    header.width = GLYPH_SIZE;
+    header.height = GLYPH_SIZE;
+    header.advance = GLYPH_SIZE;
+    header.bytesPerGlyph = GLYPH_BYTES;
+
+    uint32_t bitmapStart = GlyphStore::bitmapOffset(GLYPH_COUNT);
+    partition.assign(bitmapStart + GLYPH_COUNT * GLYPH_BYTES, 0);
+    memcpy(&partition[0], &header, sizeof(header));
+    for (uint16_t i = 0; i < GLYPH_COUNT; i++) {
+        uint16_t code = FIRST_CODE + i * 2;
+        memcpy(&partition[GlyphStore::indexOffset() + i * 2], &code, 2);
+        for (uint8_t b = 0; b < GLYPH_BYTES; b++) {
+            partition[bitmapStart + i * GLYPH_BYTES + b] = glyphByte(code, b);
+        }
+    }
+}
+
+static bool readPartition(uint32_t offset, void* dst, uint32_t length, void* context) {
+    (void)context;
+    if (offset + length > partition.size()) {
+        return false;
+    }
+    memcpy(dst, &partition[offset], length);
+    bytesRead += length;
+    return true;
+}
+
+static uint32_t hostMicros(void) {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static GlyphStore store;
+
+void setUp(void) {
+    if (partition.empty()) {
+        buildFont();
+    }
+    bytesRead = 0;
+    TEST_ASSERT_TRUE(store.begin(readPartition, nullptr, hostMicros));
+    store.resetStats();
+}
+
+void tearDown(void) {
+    // 清理
+}
+
+/**
+ * 字库头无效时拒绝打开
+ */
+void test_rejects_invalid_font(void) {
+    partition[0] ^= 0xFF;
+    GlyphStore broken;
+    TEST_ASSERT_FALSE(broken.begin(readPartition, nullptr));
+    TEST_ASSERT_NULL(broken.find(FIRST_CODE));
+    partition[0] ^= 0xFF;
+}
+
+/**
+ * 二分查找：首尾、中间和不存在的码点
+ */
+void test_binary_search(void) {
+    const uint16_t present[] = {FIRST_CODE, (uint16_t)(FIRST_CODE + 2 * 1749),
+                                (uint16_t)(FIRST_CODE + 2 * (GLYPH_COUNT - 1))};
+    for (uint8_t i = 0; i < 3; i++) {
+        const uint8_t* glyph = store.find(present[i]);
+        TEST_ASSERT_NOT_NULL(glyph);
+        TEST_ASSERT_EQUAL_HEX8(glyphByte(present[i], 0), glyph[0]);
+        TEST_ASSERT_EQUAL_HEX8(glyphByte(present[i], GLYPH_BYTES - 1), glyph[GLYPH_BYTES - 1]);
+    }
+
+    TEST_ASSERT_NULL(store.find(FIRST_CODE + 1));      // 奇数码点不在字库中
+    TEST_ASSERT_NULL(store.find(FIRST_CODE - 2));
+    TEST_ASSERT_NULL(store.find(0x10000));
+    TEST_ASSERT_EQUAL(2, store.getNotFoundCount());
+
+    // 每次未命中最多 log2(3500) + 1 次索引读取，再加一次字形读取
+    TEST_ASSERT_LESS_OR_EQUAL(5 * 13, store.getFlashReadCount());
+}
+
+/**
+ * 缓存满后淘汰最久未使用的字形
+ */
+void test_lru_eviction(void) {
+    // 填满缓存，并在最后再次使用第0个
+    for (uint16_t i = 0; i < GLYPH_CACHE_SIZE; i++) {
+        store.find(FIRST_CODE + i * 2);
+    }
+    store.find(FIRST_CODE);
+    TEST_ASSERT_EQUAL(1, store.getHitCount());
+
+    // 新字形淘汰第1个（最久未使用），第0个仍在缓存中
+    store.find(FIRST_CODE + GLYPH_CACHE_SIZE * 2);
+    uint32_t misses = store.getMissCount();
+    store.find(FIRST_CODE);
+    TEST_ASSERT_EQUAL(misses, store.getMissCount());
+    store.find(FIRST_CODE + 2);
+    TEST_ASSERT_EQUAL(misses + 1, store.getMissCount());
+}
+
+static uint8_t storeAdvance(uint32_t codepoint, void* context) {
+    GlyphStore* glyphs = static_cast<GlyphStore*>(context);
+    if (codepoint <= 0xFF) {
+        return 6;
+    }
+    return glyphs->find(codepoint) != nullptr ? glyphs->getAdvance() : 0;
+}
+
+/**
+ * 渲染一条200字的回复：排版 + 逐字绘制到页格式位图
+ */
+void test_render_200_char_reply(void) {
+    // 模拟真实文本：常用字集中在少数字符上，按固定分布生成
+    std::string reply;
+    TestRandom rng(2024);
+    for (int i = 0; i < 200; i++) {
+        uint32_t bits = rng.next();
+        uint32_t r = (bits >> 16) & 0x7FFF;
+        // 约80%落在最常用的40个字，其余分布在整个字库
+        uint16_t index = (r % 10) < 8 ? (uint16_t)(r % 40) : (uint16_t)(r % GLYPH_COUNT);
+        uint16_t code = FIRST_CODE + index * 2;
+        char utf8[4] = {(char)(0xE0 | (code >> 12)), (char)(0x80 | ((code >> 6) & 0x3F)),
+                        (char)(0x80 | (code & 0x3F)), 0};
+        reply += utf8;
+    }
+
+    TextLayout::Line lines[40];
+    uint8_t lineCount = TextLayout::breakLines(reply.c_str(), (uint16_t)reply.size(), 124,
+                                               storeAdvance, &store, lines, 40);
+    TEST_ASSERT_EQUAL(20, lineCount);   // 每行10个字
+
+    // 逐行绘制，并与字库原始数据核对
+    static uint8_t line[2 * FrameBuffer::ROW_BYTES];
+    for (uint8_t n = 0; n < lineCount; n++) {
+        memset(line, 0, sizeof(line));
+        uint16_t pos = lines[n].start;
+        uint16_t end = lines[n].start + lines[n].length;
+        int16_t x = 2;
+        while (pos < end) {
+            uint32_t cp = TextLayout::decodeUtf8(reply.c_str(), pos, end);
+            PageSprite sprite;
+            TEST_ASSERT_TRUE(store.findSprite(cp, sprite));
+            blitPageSprite(line, x, 0, sprite);
+            TEST_ASSERT_EQUAL_HEX8(glyphByte((uint16_t)cp, 0), line[x]);
+            // 第2页只有上4行属于字形
+            TEST_ASSERT_EQUAL_HEX8(glyphByte((uint16_t)cp, GLYPH_SIZE) & 0x0F, line[FrameBuffer::ROW_BYTES + x]);
+            x += store.getAdvance();
+        }
+    }
+
+    char message[160];
+    snprintf(message, sizeof(message),
+             "%u lookups: hit rate %u%%, %u flash reads (%u bytes), avg %u us, max %u us, GlyphStore RAM %u bytes",
+             (unsigned)store.getLookupCount(), (unsigned)store.getHitRate(), (unsigned)store.getFlashReadCount(), (unsigned)bytesRead,
+             (unsigned)store.getAverageLookupMicros(), (unsigned)store.getMaxLookupMicros(),
+             (unsigned)sizeof(GlyphStore));
+    TEST_MESSAGE(message);
+
+    // 排版和绘制各查找一次，另外每次换行时溢出的字在下一行重新测量
+    TEST_ASSERT_EQUAL(200 + 200 + (lineCount - 1), store.getLookupCount());
+    TEST_ASSERT_GREATER_OR_EQUAL(60, store.getHitRate());
+    // RAM占用固定，与字库大小和文本长度无关
+    TEST_ASSERT_LESS_OR_EQUAL(2048, sizeof(GlyphStore));
+    // 读取量远小于整个字库
+    TEST_ASSERT_LESS_THAN(partition.size() / 10, bytesRead);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_rejects_invalid_font);
+    RUN_TEST(test_binary_search);
+    RUN_TEST(test_lru_eviction);
+    RUN_TEST(test_render_200_char_reply);
+
+    return UNITY_END();
+}
@@ -0,0 +1,226 @@
+/**
+ * 智能桌面伴侣 - 时间抖动灰度测试
+ *
+ * 验证每个像素在3个位平面中点亮的次数等于其灰度、点亮相位按像素错开，
+ * 平面之间只有含中间灰度的tile变化，以及平面节拍统计（速率、抖动、丢失）
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include "GrayPlanes.h"
+#include "../helpers/TestRandom.h"
+
+static const uint8_t SPRITE_W = 48;
+static const uint8_t SPRITE_PAGES = 4;
+
+static uint8_t spriteHi[SPRITE_W * SPRITE_PAGES];
+static uint8_t spriteLo[SPRITE_W * SPRITE_PAGES];
+static uint8_t frames[GrayPlanes::PLANES][FrameBuffer::SIZE];
+
+/**
+ * 读取精灵中一个像素的灰度
+ */
+static uint8_t spriteLevel(uint8_t col, uint8_t row) {
+    uint16_t i = (row / 8) * SPRITE_W + col;
+    uint8_t bit = (uint8_t)(1 << (row & 7));
+    return (uint8_t)(((spriteHi[i] & bit) ? 2 : 0) + ((spriteLo[i] & bit) ? 1 : 0));
+}
+
+/**
+ * 写入精灵中一个像素的灰度
+ */
+static void setSpriteLevel(uint8_t col, uint8_t row, uint8_t level) {
+    uint16_t i = (row / 8) * SPRITE_W + col;
+    uint8_t bit = (uint8_t)(1 << (row & 7));
+    spriteHi[i] = (uint8_t)((level & 2) ? spriteHi[i] | bit : spriteHi[i] & ~bit);
+    spriteLo[i] = (uint8_t)((level & 1) ? spriteLo[i] | bit : spriteLo[i] & ~bit);
+}
+
+static bool framePixel(const uint8_t* frame, int16_t x, int16_t y) {
+    return (frame[(y / 8) * FrameBuffer::ROW_BYTES + x] >> (y & 7)) & 1;
+}
+
+/**
+ * 精灵：左侧16列为四级渐变条（每页一级），中间16列全亮，右侧16列为伪随机灰度
+ */
+static void buildSprite(void) {
+    TestRandom rng(2024);
+    for (uint8_t col = 0; col < SPRITE_W; col++) {
+        for (uint8_t row = 0; row < SPRITE_PAGES * 8; row++) {
+            uint8_t level;
+            if (col < 16) {
+                level = (uint8_t)(row / 8);
+            } else if (col < 32) {
+                level = 3;
+            } else {
+                uint32_t bits = rng.next();
+                level = (uint8_t)((bits >> 16) & 3);
+            }
+            setSpriteLevel(col, row, level);
+        }
+    }
+}
+
+static GraySprite sprite() {
+    GraySprite s = {SPRITE_W, SPRITE_PAGES, spriteHi, spriteLo};
+    return s;
+}
+
+void setUp(void) {
+    buildSprite();
+    memset(frames, 0, sizeof(frames));
+}
+
+void tearDown(void) {
+    // 清理
+}
+
+/**
+ * 每个像素在一个灰度周期的3个平面中恰好点亮 灰度 次，
+ * 且点亮的平面符合 (x + y + plane) % 3 < 灰度
+ */
+void test_planes_reproduce_levels(void) {
+    const int16_t x = 37;
+    const uint8_t page = 2;
+    for (uint8_t plane = 0; plane < GrayPlanes::PLANES; plane++) {
+        GrayPlanes::renderPlane(frames[plane], sprite(), x, page, plane);
+    }
+    for (uint8_t col = 0; col < SPRITE_W; col++) {
+        for (uint8_t row = 0; row < SPRITE_PAGES * 8; row++) {
+            int16_t sx = x + col;
+            int16_t sy = page * 8 + row;
+            uint8_t level = spriteLevel(col, row);
+            uint8_t lit = 0;
+            for (uint8_t plane = 0; plane < GrayPlanes::PLANES; plane++) {
+                bool on = framePixel(frames[plane], sx, sy);
+                TEST_ASSERT_EQUAL((sx + sy + plane) % 3 < level, on);
+                lit += on ? 1 : 0;
+            }
+            TEST_ASSERT_EQUAL(level, lit);
+        }
+    }
+}
+
+/**
+ * 点亮相位按像素错开：均匀灰色区域中每个平面点亮的像素数相同
+ */
+void test_phase_is_spread(void) {
+    const GraySprite s = sprite();
+    for (uint8_t level = 1; level < 3; level++) {
+        uint16_t counts[GrayPlanes::PLANES] = {0, 0, 0};
+        for (uint8_t plane = 0; plane < GrayPlanes::PLANES; plane++) {
+            GrayPlanes::renderPlane(frames[plane], s, 0, 0, plane);
+            // 渐变条中灰度为 level 的一页（16 x 8 = 128 像素，不是3的倍数，允许差1）
+            for (uint8_t col = 0; col < 16; col++) {
+                for (uint8_t bit = 0; bit < 8; bit++) {
+                    counts[plane] += framePixel(frames[plane], col, level * 8 + bit) ? 1 : 0;
+                }
+            }
+        }
+        for (uint8_t plane = 0; plane < GrayPlanes::PLANES; plane++) {
+            TEST_ASSERT_UINT_WITHIN(1, 128 * level / 3, counts[plane]);
+        }
+    }
+}
+
+/**
+ * 平面之间只有含中间灰度的tile变化；超出屏幕的部分被裁剪
+ */
+void test_changing_tiles(void) {
+    FrameBuffer::DirtyMask tiles;
+    const GraySprite s = sprite();
+    uint8_t count = GrayPlanes::changingTiles(s, 0, 0, tiles);
+
+    // 渐变条：第1、2页为中间灰度；全亮区没有；随机区4页都有
+    TEST_ASSERT_EQUAL_HEX16(0x0030, tiles[0]);
+    TEST_ASSERT_EQUAL_HEX16(0x0033, tiles[1]);
+    TEST_ASSERT_EQUAL_HEX16(0x0033, tiles[2]);
+    TEST_ASSERT_EQUAL_HEX16(0x0030, tiles[3]);
+    TEST_ASSERT_EQUAL(12, count);
+
+    // 相邻平面之间实际变化的tile不超出这个集合
+    for (uint8_t plane = 0; plane < GrayPlanes::PLANES; plane++) {
+        GrayPlanes::renderPlane(frames[plane], s, 0, 0, plane);
+    }
+    for (uint8_t plane = 0; plane < GrayPlanes::PLANES; plane++) {
+        FrameBuffer::DirtyMask changed;
+        FrameBuffer::diffTiles(frames[(plane + 1) % GrayPlanes::PLANES], frames[plane], changed);
+        for (uint8_t ty = 0; ty < FrameBuffer::TILE_ROWS; ty++) {
+            TEST_ASSERT_EQUAL_HEX16(0, changed[ty] & ~tiles[ty]);
+        }
+    }
+
+    // 右下角越界：只剩渐变条的前两页（第6页为黑色），绘制不越界
+    count = GrayPlanes::changingTiles(s, 100, 6, tiles);
+    TEST_ASSERT_EQUAL(3, count);
+    TEST_ASSERT_EQUAL_HEX16(0, tiles[6]);
+    TEST_ASSERT_EQUAL_HEX16(0x7000, tiles[7]);
+    memset(frames, 0, sizeof(frames));
+    GrayPlanes::renderPlane(frames[0], s, 100, 6, 0);
+    for (uint16_t i = 0; i < FrameBuffer::SIZE; i++) {
+        TEST_ASSERT_EQUAL(0, frames[1][i]);
+    }
+
+    // 左侧越界：只剩随机区的后8列
+    count = GrayPlanes::changingTiles(s, -40, 0, tiles);
+    TEST_ASSERT_EQUAL(4, count);
+    TEST_ASSERT_EQUAL_HEX16(0x0001, tiles[0]);
+    TEST_ASSERT_EQUAL_HEX16(0x0001, tiles[3]);
+
+    // 每个平面需要发送的字节数
+    uint16_t bytes = 12 * FrameBuffer::TILE_BYTES;
+    char msg[96];
+    snprintf(msg, sizeof(msg), "48x32 sprite: %u bytes per plane (full frame %u)", bytes, FrameBuffer::SIZE);
+    TEST_MESSAGE(msg);
+}
+
+/**
+ * 稳定节拍：速率等于定时器频率，抖动为0
+ */
+void test_timing_steady(void) {
+    GrayPlanes::PlaneTiming timing;
+    const uint32_t period = 1000000UL / 150;
+    uint32_t now = 0xFFFF0000UL;      // 跨越计数器回绕
+    for (uint16_t i = 0; i <= 150; i++) {
+        timing.record(now);
+        now += period;
+    }
+    TEST_ASSERT_EQUAL(151, timing.getPlanes());
+    TEST_ASSERT_EQUAL(0, timing.getMissed());
+    TEST_ASSERT_EQUAL(0, timing.getMaxJitterMicros());
+    TEST_ASSERT_UINT_WITHIN(50, 150000, timing.getRateMilliHz());
+}
+
+/**
+ * 推迟的平面计入抖动，合并的节拍计入丢失
+ */
+void test_timing_jitter_and_missed(void) {
+    GrayPlanes::PlaneTiming timing;
+    timing.reset(1000);
+    timing.record(0);
+    timing.record(1000);
+    timing.record(2300);    // 推迟300us
+    timing.record(3000);    // 间隔700us
+    timing.record(5000);    // 丢失1个平面
+    TEST_ASSERT_EQUAL(5, timing.getPlanes());
+    TEST_ASSERT_EQUAL(1, timing.getMissed());
+    TEST_ASSERT_EQUAL(300, timing.getMaxJitterMicros());
+    TEST_ASSERT_EQUAL(150, timing.getMeanJitterMicros());
+    TEST_ASSERT_EQUAL(800000, timing.getRateMilliHz());
+
+    timing.reset(1000);
+    TEST_ASSERT_EQUAL(0, timing.getPlanes());
+    TEST_ASSERT_EQUAL(0, timing.getRateMilliHz());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_planes_reproduce_levels);
+    RUN_TEST(test_phase_is_spread);
+    RUN_TEST(test_changing_tiles);
+    RUN_TEST(test_timing_steady);
+    RUN_TEST(test_timing_jitter_and_missed);
+
+    return UNITY_END();
+}
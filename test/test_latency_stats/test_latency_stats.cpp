@@ -0,0 +1,90 @@
+/**
+ * 智能桌面伴侣 - 延迟统计测试
+ *
+ * 验证最小/平均/最大值、2的幂分桶和百分位估算（返回分桶上界且不超过最大值），以及清空后重新统计
+ */
+
+#include <unity.h>
+#include "LatencyStats.h"
+
+static LatencyStats* stats;
+
+void setUp(void) {
+    stats = new LatencyStats();
+}
+
+void tearDown(void) {
+    delete stats;
+}
+
+void test_empty(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, stats->getCount());
+    TEST_ASSERT_EQUAL_UINT32(0, stats->getMin());
+    TEST_ASSERT_EQUAL_UINT32(0, stats->getMax());
+    TEST_ASSERT_EQUAL_UINT32(0, stats->getMean());
+    TEST_ASSERT_EQUAL_UINT32(0, stats->getPercentile(99));
+}
+
+void test_min_mean_max(void) {
+    stats->record(100);
+    stats->record(300);
+    stats->record(200);
+    TEST_ASSERT_EQUAL_UINT32(3, stats->getCount());
+    TEST_ASSERT_EQUAL_UINT32(100, stats->getMin());
+    TEST_ASSERT_EQUAL_UINT32(200, stats->getMean());
+    TEST_ASSERT_EQUAL_UINT32(300, stats->getMax());
+}
+
+void test_bucket_of(void) {
+    TEST_ASSERT_EQUAL_UINT8(0, LatencyStats::bucketOf(0));
+    TEST_ASSERT_EQUAL_UINT8(1, LatencyStats::bucketOf(1));
+    TEST_ASSERT_EQUAL_UINT8(2, LatencyStats::bucketOf(2));
+    TEST_ASSERT_EQUAL_UINT8(2, LatencyStats::bucketOf(3));
+    TEST_ASSERT_EQUAL_UINT8(11, LatencyStats::bucketOf(1024));
+    TEST_ASSERT_EQUAL_UINT8(LATENCY_BUCKETS - 1, LatencyStats::bucketOf(0xFFFFFFFFUL));
+}
+
+/**
+ * 99个10ms附近的样本和1个500ms的离群值：p50落在10ms的分桶，p99仍在该分桶，p100为最大值
+ */
+void test_percentile(void) {
+    for (uint8_t i = 0; i < 99; i++) {
+        stats->record(10000 + i);
+    }
+    stats->record(500000);
+
+    // 10000-10098 都在 [8192, 16384) 分桶
+    TEST_ASSERT_EQUAL_UINT32(16383, stats->getPercentile(50));
+    TEST_ASSERT_EQUAL_UINT32(16383, stats->getPercentile(99));
+    TEST_ASSERT_EQUAL_UINT32(500000, stats->getPercentile(100));
+}
+
+/**
+ * 分桶上界超过实际最大值时返回最大值
+ */
+void test_percentile_clamped_to_max(void) {
+    stats->record(9000);
+    TEST_ASSERT_EQUAL_UINT32(9000, stats->getPercentile(50));
+}
+
+void test_reset(void) {
+    stats->record(1234);
+    stats->reset();
+    TEST_ASSERT_EQUAL_UINT32(0, stats->getCount());
+    stats->record(50);
+    TEST_ASSERT_EQUAL_UINT32(50, stats->getMin());
+    TEST_ASSERT_EQUAL_UINT32(50, stats->getMax());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_empty);
+    RUN_TEST(test_min_mean_max);
+    RUN_TEST(test_bucket_of);
+    RUN_TEST(test_percentile);
+    RUN_TEST(test_percentile_clamped_to_max);
+    RUN_TEST(test_reset);
+
+    return UNITY_END();
+}
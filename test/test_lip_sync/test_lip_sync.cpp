@@ -0,0 +1,217 @@
+/**
+ * 智能桌面伴侣 - 口型同步测试
+ *
+ * 验证定点包络计算、无锁通道和档位跟随，
+ * 并用合成的PCM模拟音频任务按块写入、表情按帧读取，检查嘴型变化的时机
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+#include "LipSync.h"
+
+static const uint32_t SAMPLE_RATE = 44100;
+static const uint32_t BLOCK_SAMPLES = 256;     // 与 AudioManager 每次写I2S的块大小相同
+static const uint32_t FRAME_MS = 30;           // 动画帧间隔
+
+/**
+ * 生成一段单声道正弦波
+ */
+static void appendTone(std::vector<int16_t>& pcm, uint32_t ms, int16_t amplitude, uint16_t frequency) {
+    uint32_t count = SAMPLE_RATE * ms / 1000;
+    for (uint32_t i = 0; i < count; i++) {
+        pcm.push_back((int16_t)(amplitude * sin(2.0 * M_PI * frequency * i / SAMPLE_RATE)));
+    }
+}
+
+void setUp(void) {
+    // 初始化
+}
+
+void tearDown(void) {
+    // 清理
+}
+
+/**
+ * 整数平方根与浮点结果一致（向下取整）
+ */
+void test_isqrt(void) {
+    const uint32_t values[] = {0, 1, 2, 3, 4, 15, 16, 17, 65535, 65536, 1000000, 536870912UL, 1073741824UL};
+    for (uint8_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        TEST_ASSERT_EQUAL((uint32_t)sqrt((double)values[i]), LipSync::isqrt(values[i]));
+    }
+}
+
+/**
+ * 包络：静音为0，正弦波RMS约为振幅的0.707，峰值等于振幅；立体声只取左声道
+ */
+void test_measure_envelope(void) {
+    std::vector<int16_t> pcm(BLOCK_SAMPLES, 0);
+    LipSync::Envelope envelope = LipSync::measure(&pcm[0], BLOCK_SAMPLES, 1, 0);
+    TEST_ASSERT_EQUAL(0, envelope.rms);
+    TEST_ASSERT_EQUAL(0, envelope.peak);
+    TEST_ASSERT_EQUAL(0, LipSync::levelFor(envelope));
+
+    pcm.clear();
+    appendTone(pcm, 100, 16000, 441);
+    envelope = LipSync::measure(&pcm[0], 1000, 1, 0);
+    TEST_ASSERT_INT_WITHIN(2, 16000 * 0.7071 / 128, envelope.rms);
+    TEST_ASSERT_INT_WITHIN(1, 16000 / 128, envelope.peak);
+    TEST_ASSERT_EQUAL(LIPSYNC_LEVELS - 1, LipSync::levelFor(envelope));
+
+    // 满幅方波
+    std::vector<int16_t> stereo;
+    for (uint32_t i = 0; i < BLOCK_SAMPLES; i++) {
+        stereo.push_back((i & 1) ? -32768 : 32767);  // 左声道
+        stereo.push_back(0);                          // 右声道
+    }
+    envelope = LipSync::measure(&stereo[0], BLOCK_SAMPLES, 2, 0);
+    TEST_ASSERT_EQUAL(255, envelope.rms);
+    TEST_ASSERT_EQUAL(255, envelope.peak);
+
+    // 档位随音量单调增加
+    uint8_t previous = 0;
+    for (int16_t amplitude = 0; amplitude <= 12000; amplitude += 500) {
+        pcm.clear();
+        appendTone(pcm, 20, amplitude, 441);
+        uint8_t level = LipSync::levelFor(LipSync::measure(&pcm[0], 800, 1, 0));
+        TEST_ASSERT_TRUE(level >= previous);
+        previous = level;
+    }
+    TEST_ASSERT_EQUAL(LIPSYNC_LEVELS - 1, previous);
+}
+
+/**
+ * 通道：从未写入、正常读取、超时失效、清除，以及15位时间回绕
+ */
+void test_channel(void) {
+    LipSync::Channel channel;
+    LipSync::Envelope envelope;
+    TEST_ASSERT_FALSE(channel.read(0, envelope));
+
+    LipSync::Envelope sent = {200, 250, 1000};
+    channel.publish(sent);
+    TEST_ASSERT_TRUE(channel.read(1000 + LIPSYNC_HOLD_MS - 1, envelope));
+    TEST_ASSERT_EQUAL(200, envelope.rms);
+    TEST_ASSERT_EQUAL(250, envelope.peak);
+    TEST_ASSERT_FALSE(channel.read(1000 + LIPSYNC_HOLD_MS, envelope));
+
+    channel.clear();
+    TEST_ASSERT_FALSE(channel.read(1000, envelope));
+
+    // millis() 超过15位后按低位比较
+    uint32_t now = 0x12347FF0UL;
+    channel.publish(LipSync::measure(nullptr, 0, 1, now));
+    TEST_ASSERT_TRUE(channel.read(now + 50, envelope));
+    TEST_ASSERT_FALSE(channel.read(now + LIPSYNC_HOLD_MS + 1, envelope));
+}
+
+/**
+ * 档位跟随：变大立即跟随，变小时每 LIPSYNC_RELEASE_MS 降一档
+ */
+void test_follower_attack_release(void) {
+    LipSync::Follower follower;
+    TEST_ASSERT_TRUE(follower.update(3, 0));
+    TEST_ASSERT_EQUAL(3, follower.getLevel());
+
+    TEST_ASSERT_FALSE(follower.update(0, LIPSYNC_RELEASE_MS - 1));
+    TEST_ASSERT_EQUAL(LIPSYNC_RELEASE_MS - 1, follower.getNextDeadline(0, 1));
+    TEST_ASSERT_TRUE(follower.update(0, LIPSYNC_RELEASE_MS));
+    TEST_ASSERT_EQUAL(2, follower.getLevel());
+    TEST_ASSERT_FALSE(follower.update(0, LIPSYNC_RELEASE_MS + 10));
+
+    // 声音再次变大时重新计时
+    TEST_ASSERT_TRUE(follower.update(3, LIPSYNC_RELEASE_MS + 20));
+    TEST_ASSERT_FALSE(follower.update(1, 2 * LIPSYNC_RELEASE_MS));
+    TEST_ASSERT_EQUAL(0xFFFFFFFFUL, follower.getNextDeadline(3, 2 * LIPSYNC_RELEASE_MS));
+}
+
+/**
+ * 模拟播放：音频任务按块写入并发布包络，表情每帧读取一次
+ * 音节开始后一帧内张到最大，音节之间的停顿中逐档闭合，播放结束后一帧内闭嘴
+ */
+void test_mouth_level_timing(void) {
+    // 300ms静音 + 3个音节（250ms发声 + 150ms停顿）+ 结束
+    std::vector<int16_t> pcm;
+    appendTone(pcm, 300, 0, 220);
+    const uint32_t syllableStart[] = {300, 700, 1100};
+    for (uint8_t i = 0; i < 3; i++) {
+        appendTone(pcm, 250, 12000, 220);
+        appendTone(pcm, 150, 0, 220);
+    }
+    uint32_t endMs = (uint32_t)(pcm.size() * 1000 / SAMPLE_RATE);
+
+    LipSync::Channel channel;
+    LipSync::Follower follower;
+    uint32_t written = 0;
+    uint32_t openedAt[3] = {0, 0, 0};
+    uint8_t levelBefore[3] = {0, 0, 0};
+    uint32_t closedAt = 0;
+
+    // 按1ms步进：写入时刻已到的音频块，到帧时刻时表情读取包络
+    for (uint32_t now = 0; now < endMs + 300; now++) {
+        while (written < pcm.size() && (uint64_t)written * 1000 / SAMPLE_RATE <= now) {
+            uint32_t count = (uint32_t)pcm.size() - written < BLOCK_SAMPLES
+                           ? (uint32_t)pcm.size() - written : BLOCK_SAMPLES;
+            channel.publish(LipSync::measure(&pcm[written], count, 1, now));
+            written += count;
+            if (written == pcm.size()) {
+                channel.clear();    // 播放结束
+            }
+        }
+        if (now % FRAME_MS != 0) {
+            continue;
+        }
+
+        LipSync::Envelope envelope;
+        if (channel.read(now, envelope)) {
+            follower.update(LipSync::levelFor(envelope), now);
+        } else {
+            follower.reset();
+        }
+        uint8_t level = follower.getLevel();
+
+        for (uint8_t i = 0; i < 3; i++) {
+            if (now < syllableStart[i]) {
+                levelBefore[i] = level;
+            } else if (openedAt[i] == 0 && level == LIPSYNC_LEVELS - 1) {
+                openedAt[i] = now;
+            }
+        }
+        if (now >= endMs && level == 0 && closedAt == 0) {
+            closedAt = now;
+        }
+        // 开头的静音中保持闭嘴
+        if (now < syllableStart[0]) {
+            TEST_ASSERT_EQUAL(0, level);
+        }
+    }
+
+    char message[160];
+    snprintf(message, sizeof(message), "mouth fully open %u/%u/%u ms after syllable start, closed %u ms after end",
+             (unsigned)(openedAt[0] - syllableStart[0]), (unsigned)(openedAt[1] - syllableStart[1]),
+             (unsigned)(openedAt[2] - syllableStart[2]), (unsigned)(closedAt - endMs));
+    TEST_MESSAGE(message);
+
+    for (uint8_t i = 0; i < 3; i++) {
+        // 停顿中嘴巴已经开始闭合
+        TEST_ASSERT_LESS_THAN(LIPSYNC_LEVELS - 1, levelBefore[i]);
+        TEST_ASSERT_TRUE(openedAt[i] != 0);
+        TEST_ASSERT_LESS_OR_EQUAL(FRAME_MS, openedAt[i] - syllableStart[i]);
+    }
+    TEST_ASSERT_TRUE(closedAt != 0);
+    TEST_ASSERT_LESS_OR_EQUAL(FRAME_MS, closedAt - endMs);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_isqrt);
+    RUN_TEST(test_measure_envelope);
+    RUN_TEST(test_channel);
+    RUN_TEST(test_follower_attack_release);
+    RUN_TEST(test_mouth_level_timing);
+
+    return UNITY_END();
+}
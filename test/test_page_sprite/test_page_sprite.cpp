@@ -0,0 +1,138 @@
+/**
+ * 智能桌面伴侣 - 页格式精灵测试与基准
+ *
+ * 验证编译期转换的页格式精灵与逐像素绘制XBM的结果完全一致，
+ * 并对比两种方式绘制一张完整表情（双眼 + 嘴巴）的耗时
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include "FaceSprites.h"
+#include "../helpers/TestRandom.h"
+
+static uint8_t expected[FrameBuffer::SIZE];
+static uint8_t actual[FrameBuffer::SIZE];
+
+// 逐像素绘制时的像素操作计数
+static uint32_t pixelOps = 0;
+
+/**
+ * 逐像素绘制XBM（与U8g2 drawXBMP不透明模式逻辑一致）
+ */
+static void drawXbmReference(uint8_t* buf, int x, int y, int w, int h, const uint8_t* xbm) {
+    int stride = (w + 7) / 8;
+    for (int row = 0; row < h; row++) {
+        for (int col = 0; col < w; col++) {
+            int px = x + col;
+            int py = y + row;
+            pixelOps++;
+            if (px < 0 || px >= 128 || py < 0 || py >= 64) continue;
+            uint8_t* dst = &buf[(py / 8) * FrameBuffer::ROW_BYTES + px];
+            uint8_t bit = (uint8_t)(1 << (py & 7));
+            if ((xbm[row * stride + col / 8] >> (col & 7)) & 1) {
+                *dst |= bit;
+            } else {
+                *dst &= (uint8_t)~bit;
+            }
+        }
+    }
+}
+
+/**
+ * 用伪随机内容填充两个缓冲区，验证不透明绘制不会破坏精灵范围外的像素
+ */
+static void fillNoise(void) {
+    TestRandom rng(12345);
+    for (uint16_t i = 0; i < FrameBuffer::SIZE; i++) {
+        uint32_t bits = rng.next();
+        expected[i] = (uint8_t)(bits >> 16);
+    }
+    memcpy(actual, expected, sizeof(actual));
+}
+
+void setUp(void) {
+    fillNoise();
+    pixelOps = 0;
+}
+
+void tearDown(void) {
+    // 清理
+}
+
+/**
+ * 在布局位置（页对齐快速路径）绘制，结果与逐像素绘制一致
+ */
+void test_aligned_blit_matches_xbm(void) {
+    drawXbmReference(expected, FACE_LEFT_EYE_X, FACE_EYE_Y, EYE_WIDTH, EYE_HEIGHT, EYE_NORMAL_BITMAP);
+    blitPageSprite(actual, FACE_LEFT_EYE_X, FACE_EYE_Y, EYE_NORMAL_SPRITE);
+    drawXbmReference(expected, FACE_MOUTH_X, FACE_MOUTH_Y, MOUTH_WIDTH, MOUTH_HEIGHT, MOUTH_SMILE_BITMAP);
+    blitPageSprite(actual, FACE_MOUTH_X, FACE_MOUTH_Y, MOUTH_SMILE_SPRITE);
+
+    TEST_ASSERT_EQUAL_MEMORY(expected, actual, FrameBuffer::SIZE);
+}
+
+/**
+ * 任意Y坐标（移位合并路径）和屏幕边缘裁剪，结果与逐像素绘制一致
+ */
+void test_unaligned_and_clipped_blit_matches_xbm(void) {
+    const int16_t positions[][2] = {
+        {0, 0}, {5, 3}, {-7, 13}, {115, 50}, {60, -9}, {100, 61}, {33, 7}
+    };
+
+    for (uint8_t i = 0; i < sizeof(positions) / sizeof(positions[0]); i++) {
+        int16_t x = positions[i][0];
+        int16_t y = positions[i][1];
+        drawXbmReference(expected, x, y, EYE_WIDTH, EYE_HEIGHT, EYE_LOOK_LEFT_BITMAP);
+        blitPageSprite(actual, x, y, EYE_LOOK_LEFT_SPRITE);
+        drawXbmReference(expected, x, y, MOUTH_WIDTH, MOUTH_HEIGHT, MOUTH_SURPRISED_BITMAP);
+        blitPageSprite(actual, x, y, MOUTH_SURPRISED_SPRITE);
+
+        TEST_ASSERT_EQUAL_MEMORY(expected, actual, FrameBuffer::SIZE);
+    }
+}
+
+/**
+ * 基准：绘制一张完整表情，页格式精灵应明显快于逐像素绘制
+ */
+void test_benchmark_face_render(void) {
+    const int iterations = 20000;
+    typedef std::chrono::steady_clock Clock;
+
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        drawXbmReference(expected, FACE_LEFT_EYE_X, FACE_EYE_Y, EYE_WIDTH, EYE_HEIGHT, EYE_NORMAL_BITMAP);
+        drawXbmReference(expected, FACE_RIGHT_EYE_X, FACE_EYE_Y, EYE_WIDTH, EYE_HEIGHT, EYE_NORMAL_BITMAP);
+        drawXbmReference(expected, FACE_MOUTH_X, FACE_MOUTH_Y, MOUTH_WIDTH, MOUTH_HEIGHT, MOUTH_SMILE_BITMAP);
+    }
+    double xbmNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    uint32_t opsPerFace = pixelOps / iterations;
+
+    uint32_t bytesPerFace = 0;
+    start = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        bytesPerFace = blitPageSprite(actual, FACE_LEFT_EYE_X, FACE_EYE_Y, EYE_NORMAL_SPRITE);
+        bytesPerFace += blitPageSprite(actual, FACE_RIGHT_EYE_X, FACE_EYE_Y, EYE_NORMAL_SPRITE);
+        bytesPerFace += blitPageSprite(actual, FACE_MOUTH_X, FACE_MOUTH_Y, MOUTH_SMILE_SPRITE);
+    }
+    double spriteNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+
+    char message[128];
+    snprintf(message, sizeof(message), "drawXBMP: %.0f ns/face (%u pixel ops), page sprite: %.0f ns/face (%u bytes)",
+             xbmNs, (unsigned)opsPerFace, spriteNs, (unsigned)bytesPerFace);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_EQUAL_MEMORY(expected, actual, FrameBuffer::SIZE);
+    TEST_ASSERT_LESS_THAN(opsPerFace / 4, bytesPerFace);
+    TEST_ASSERT_TRUE(spriteNs < xbmNs);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_aligned_blit_matches_xbm);
+    RUN_TEST(test_unaligned_and_clipped_blit_matches_xbm);
+    RUN_TEST(test_benchmark_face_render);
+
+    return UNITY_END();
+}
@@ -0,0 +1,174 @@
+/**
+ * 智能桌面伴侣 - SSD1306硬件效果命令测试
+ *
+ * 按数据手册验证渐暗/闪烁和滚动命令序列，
+ * 并用软件模拟的显存验证硬件跑马灯与软件跑马灯画面一致、停止滚动后必须整屏重写
+ */
+
+#include <unity.h>
+#include "PanelEffects.h"
+#include "FrameBuffer.h"
+
+static const uint8_t MARQUEE_PAGE = 3;      // 与 TEXT_MARQUEE_FIRST_PAGE 相同
+static const uint16_t FRAME_HZ = 100;       // 与 OLED_FRAME_HZ 相同
+
+static uint8_t panel[FrameBuffer::SIZE] __attribute__((aligned(4)));
+static uint8_t shadow[FrameBuffer::SIZE] __attribute__((aligned(4)));
+static uint8_t expected[FrameBuffer::SIZE] __attribute__((aligned(4)));
+
+/**
+ * 填充一帧：中间两页为居中的"文字"，其余页为固定图案
+ */
+static void fillFrame(uint8_t* frame) {
+    for (uint16_t i = 0; i < FrameBuffer::SIZE; i++) {
+        frame[i] = (uint8_t)(i * 37 + 11);
+    }
+    for (uint8_t p = MARQUEE_PAGE; p < MARQUEE_PAGE + 2; p++) {
+        uint8_t* line = frame + p * FrameBuffer::ROW_BYTES;
+        memset(line, 0, FrameBuffer::ROW_BYTES);
+        for (uint8_t x = 40; x < 88; x++) {
+            line[x] = (uint8_t)(x * 5 + p);
+        }
+    }
+}
+
+void setUp(void) {
+    // 初始化
+}
+
+void tearDown(void) {
+    // 清理
+}
+
+/**
+ * 渐暗/闪烁：0x23 + 模式 | 间隔（每级 (间隔+1) x 8 帧）
+ */
+void test_fade_commands(void) {
+    uint8_t out[PanelEffects::MAX_SEQUENCE_BYTES];
+    TEST_ASSERT_EQUAL(2, PanelEffects::fade(out, PanelEffects::FADE_BLINK, 64));
+    TEST_ASSERT_EQUAL_HEX8(0x23, out[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x37, out[1]);
+
+    PanelEffects::fade(out, PanelEffects::FADE_OUT, 8);
+    TEST_ASSERT_EQUAL_HEX8(0x20, out[1]);
+    PanelEffects::fade(out, PanelEffects::FADE_OUT, 128);
+    TEST_ASSERT_EQUAL_HEX8(0x2F, out[1]);
+    PanelEffects::fade(out, PanelEffects::FADE_OUT, 1000);
+    TEST_ASSERT_EQUAL_HEX8(0x2F, out[1]);
+    PanelEffects::fade(out, PanelEffects::FADE_OUT, 0);
+    TEST_ASSERT_EQUAL_HEX8(0x20, out[1]);
+    PanelEffects::fade(out, PanelEffects::FADE_OFF, 64);
+    TEST_ASSERT_EQUAL_HEX8(0x00, out[1]);
+}
+
+/**
+ * 滚动间隔：每个可用帧数对应自己的编码，其他值取最接近的
+ */
+void test_scroll_interval_codes(void) {
+    for (uint8_t code = 0; code < 8; code++) {
+        TEST_ASSERT_EQUAL(code, PanelEffects::scrollIntervalCode(PanelEffects::SCROLL_INTERVAL_FRAMES[code]));
+    }
+    TEST_ASSERT_EQUAL(7, PanelEffects::scrollIntervalCode(1));
+    TEST_ASSERT_EQUAL(6, PanelEffects::scrollIntervalCode(30));
+    TEST_ASSERT_EQUAL(3, PanelEffects::scrollIntervalCode(1000));
+
+    // 软件跑马灯每列40ms，在100Hz下为4帧
+    TEST_ASSERT_EQUAL(4, PanelEffects::msToFrames(40, FRAME_HZ));
+    TEST_ASSERT_EQUAL(5, PanelEffects::scrollIntervalCode(PanelEffects::msToFrames(40, FRAME_HZ)));
+    TEST_ASSERT_EQUAL(1, PanelEffects::msToFrames(0, FRAME_HZ));
+}
+
+/**
+ * 滚动命令序列：先停止，再设置参数，最后启动
+ */
+void test_scroll_sequences(void) {
+    uint8_t out[PanelEffects::MAX_SEQUENCE_BYTES];
+    const uint8_t horizontal[] = {0x2E, 0x27, 0x00, 0x03, 0x05, 0x04, 0x00, 0xFF, 0x2F};
+    uint8_t n = PanelEffects::horizontalScroll(out, true, 3, 4, 4);
+    TEST_ASSERT_EQUAL(sizeof(horizontal), n);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(horizontal, out, n);
+
+    n = PanelEffects::horizontalScroll(out, false, 0, 7, 2);
+    TEST_ASSERT_EQUAL_HEX8(0x26, out[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x07, out[4]);
+    TEST_ASSERT_EQUAL_HEX8(0x07, out[5]);
+
+    const uint8_t diagonal[] = {0x2E, 0xA3, 0x00, 0x40, 0x29, 0x00, 0x00, 0x00, 0x07, 0x01, 0x2F};
+    n = PanelEffects::diagonalScroll(out, false, 0, 7, 5, 1, 0, 64);
+    TEST_ASSERT_EQUAL(sizeof(diagonal), n);
+    TEST_ASSERT_LESS_OR_EQUAL(PanelEffects::MAX_SEQUENCE_BYTES, n);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(diagonal, out, n);
+
+    TEST_ASSERT_EQUAL(1, PanelEffects::stopScroll(out));
+    TEST_ASSERT_EQUAL_HEX8(0x2E, out[0]);
+}
+
+/**
+ * 硬件跑马灯：滚动n列后的显存与软件跑马灯（一圈128列）偏移n列的画面一致，
+ * 其余页不受影响，滚动一圈后回到原画面
+ */
+void test_hardware_marquee_matches_software(void) {
+    uint8_t frame[FrameBuffer::SIZE];
+    fillFrame(frame);
+
+    for (uint16_t columns = 0; columns <= 2 * FrameBuffer::ROW_BYTES; columns += 7) {
+        memcpy(panel, frame, sizeof(panel));
+        PanelEffects::simulateHorizontalScroll(panel, true, MARQUEE_PAGE, MARQUEE_PAGE + 1, columns);
+
+        // 与 TextRenderer::render 相同的循环复制
+        memcpy(expected, frame, sizeof(expected));
+        uint16_t offset = columns % FrameBuffer::ROW_BYTES;
+        for (uint8_t p = MARQUEE_PAGE; p < MARQUEE_PAGE + 2; p++) {
+            const uint8_t* strip = frame + p * FrameBuffer::ROW_BYTES;
+            uint8_t* dst = expected + p * FrameBuffer::ROW_BYTES;
+            uint16_t head = FrameBuffer::ROW_BYTES - offset;
+            memcpy(dst, strip + offset, head);
+            memcpy(dst + head, strip, FrameBuffer::ROW_BYTES - head);
+        }
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, panel, FrameBuffer::SIZE);
+    }
+
+    memcpy(panel, frame, sizeof(panel));
+    PanelEffects::simulateHorizontalScroll(panel, false, MARQUEE_PAGE, MARQUEE_PAGE + 1, 5);
+    PanelEffects::simulateHorizontalScroll(panel, true, MARQUEE_PAGE, MARQUEE_PAGE + 1, 5);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(frame, panel, FrameBuffer::SIZE);
+}
+
+/**
+ * 停止滚动后影子缓冲仍是滚动前的画面：按影子缓冲比较不会发现显存已被移动，
+ * 因此停止后必须整屏重写
+ */
+void test_stop_requires_full_rewrite(void) {
+    fillFrame(shadow);
+    memcpy(panel, shadow, sizeof(panel));
+    PanelEffects::simulateHorizontalScroll(panel, true, MARQUEE_PAGE, MARQUEE_PAGE + 1, 13);
+
+    // 重新提交同一帧：逐tile比较认为没有变化，屏幕却停在滚动后的位置
+    FrameBuffer::DirtyMask dirty;
+    TEST_ASSERT_EQUAL(0, FrameBuffer::diffTiles(shadow, shadow, dirty));
+    TEST_ASSERT_TRUE(memcmp(panel, shadow, FrameBuffer::SIZE) != 0);
+
+    // 整屏重写后一致；只有滚动的两页有差异
+    TEST_ASSERT_GREATER_THAN(0, FrameBuffer::diffTiles(panel, shadow, dirty));
+    for (uint8_t p = 0; p < FrameBuffer::TILE_ROWS; p++) {
+        if (p == MARQUEE_PAGE || p == MARQUEE_PAGE + 1) {
+            TEST_ASSERT_TRUE(dirty[p] != 0);
+        } else {
+            TEST_ASSERT_EQUAL_HEX16(0, dirty[p]);
+        }
+    }
+    memcpy(panel, shadow, sizeof(panel));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(shadow, panel, FrameBuffer::SIZE);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_fade_commands);
+    RUN_TEST(test_scroll_interval_codes);
+    RUN_TEST(test_scroll_sequences);
+    RUN_TEST(test_hardware_marquee_matches_software);
+    RUN_TEST(test_stop_requires_full_rewrite);
+
+    return UNITY_END();
+}
@@ -0,0 +1,197 @@
+/**
+ * 智能桌面伴侣 - 定点粒子系统测试与基准
+ *
+ * 验证 Q8.8 积分、删除后存活粒子的顺序、跨页绘制和屏幕边界裁剪，
+ * 按每帧预算换算的粒子上限，并测量每毫秒能处理的粒子数
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include "Particles.h"
+
+// 帧缓冲前后各留一帧作为越界检测区
+static uint8_t guarded[3 * FrameBuffer::SIZE];
+static uint8_t* const frame = guarded + FrameBuffer::SIZE;
+
+// 模拟计时：每次读取前进 fakeStep 微秒（update/render 各读取两次，耗时各为 fakeStep）
+static uint32_t fakeNow = 0;
+static uint32_t fakeStep = 0;
+
+static uint32_t fakeClock() {
+    uint32_t now = fakeNow;
+    fakeNow += fakeStep;
+    return now;
+}
+
+static uint32_t realClock() {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static bool pixel(int16_t x, int16_t y) {
+    return (frame[(y / 8) * FrameBuffer::ROW_BYTES + x] >> (y & 7)) & 1;
+}
+
+void setUp(void) {
+    memset(guarded, 0, sizeof(guarded));
+    fakeNow = 0;
+    fakeStep = 0;
+}
+
+void tearDown(void) {
+    // 清理
+}
+
+/**
+ * 每帧位置加上速度、速度加上重力（Q8.8 整数运算，无累计误差）
+ */
+void test_fixed_point_motion(void) {
+    ParticleSystem particles;
+    TEST_ASSERT_EQUAL(1, particles.emit(PARTICLE_CONFETTI, 64, 40, 1));
+    int32_t x = particles.getX(0);
+    int32_t y = particles.getY(0);
+    int32_t vx = particles.getVX(0);
+    int32_t vy = particles.getVY(0);
+    TEST_ASSERT_EQUAL(40 * PARTICLE_Q8_ONE, y);
+    TEST_ASSERT_TRUE(vy < 0);
+
+    for (uint8_t frameIndex = 0; frameIndex < 10 && particles.isActive(); frameIndex++) {
+        x += vx;
+        y += vy;
+        vy += ParticleDetail::KINDS[PARTICLE_CONFETTI].gravity;
+        particles.update();
+        TEST_ASSERT_EQUAL(x, particles.getX(0));
+        TEST_ASSERT_EQUAL(y, particles.getY(0));
+        TEST_ASSERT_EQUAL(vy, particles.getVY(0));
+    }
+}
+
+/**
+ * 寿命结束或离开屏幕的粒子被删除，存活粒子保持发射顺序；绘制不越出帧缓冲
+ */
+void test_removal_and_clipping(void) {
+    ParticleSystem particles;
+    // 四角附近发射，部分粒子很快离开屏幕
+    particles.emit(PARTICLE_CONFETTI, 0, 0, 20);
+    particles.emit(PARTICLE_HEART, 126, 2, 10);
+    particles.emit(PARTICLE_Z, 2, -4, 10);
+    particles.emit(PARTICLE_CONFETTI, 125, 62, 20);
+    TEST_ASSERT_EQUAL(60, particles.getCount());
+
+    uint8_t previous = particles.getCount();
+    uint16_t frames = 0;
+    while (particles.isActive()) {
+        particles.update();
+        TEST_ASSERT_TRUE(particles.getCount() <= previous);
+        previous = particles.getCount();
+        for (uint8_t i = 0; i < particles.getCount(); i++) {
+            // 存活粒子的位置在屏幕及边缘留白范围内
+            TEST_ASSERT_TRUE(particles.getX(i) >= -8 * PARTICLE_Q8_ONE);
+            TEST_ASSERT_TRUE(particles.getY(i) >= -8 * PARTICLE_Q8_ONE);
+            TEST_ASSERT_TRUE(particles.getY(i) < 64 * PARTICLE_Q8_ONE);
+        }
+        particles.render(frame);
+        frames++;
+        TEST_ASSERT_TRUE(frames <= 255);
+    }
+    for (uint16_t i = 0; i < FrameBuffer::SIZE; i++) {
+        TEST_ASSERT_EQUAL(0, guarded[i]);
+        TEST_ASSERT_EQUAL(0, guarded[2 * FrameBuffer::SIZE + i]);
+    }
+}
+
+/**
+ * 跨页绘制：每个像素与形状逐像素一致
+ */
+void test_render_across_pages(void) {
+    for (int16_t top = -3; top < 64; top += 5) {
+        memset(frame, 0, FrameBuffer::SIZE);
+        ParticleSystem particles;
+        particles.emit(PARTICLE_HEART, 60, top, 1);
+        int16_t left = (int16_t)(particles.getX(0) >> 8);
+        particles.render(frame);
+        for (int16_t yy = 0; yy < 64; yy++) {
+            for (int16_t xx = 0; xx < 128; xx++) {
+                int16_t col = xx - left;
+                int16_t row = yy - top;
+                bool expected = col >= 0 && col < 5 && row >= 0 && row < 8 &&
+                                ((ParticleDetail::HEART_SHAPE[col] >> row) & 1);
+                TEST_ASSERT_EQUAL(expected, pixel(xx, yy));
+            }
+        }
+    }
+}
+
+/**
+ * 粒子上限由预算换算：每个粒子每帧2微秒、预算100微秒时上限为50，
+ * 超出的最早的粒子被丢弃；耗时下降后上限回升
+ */
+void test_budget_limits_count(void) {
+    ParticleSystem particles;
+    particles.begin(fakeClock, 100);
+    TEST_ASSERT_EQUAL(PARTICLE_CAPACITY, particles.getLimit());
+    TEST_ASSERT_EQUAL(90, particles.emit(PARTICLE_Z, 64, 0, 90));
+    int16_t newestX = particles.getX(89);
+
+    fakeStep = particles.getCount();
+    particles.update();
+    particles.render(frame);
+    TEST_ASSERT_EQUAL(2000, particles.getCostNs());
+    TEST_ASSERT_EQUAL(50, particles.getLimit());
+    TEST_ASSERT_EQUAL(50, particles.getCount());
+    TEST_ASSERT_EQUAL(40, particles.getDroppedCount());
+    TEST_ASSERT_EQUAL(newestX + particles.getVX(49), particles.getX(49));
+
+    // 上限以内不能再发射
+    TEST_ASSERT_EQUAL(0, particles.emit(PARTICLE_Z, 64, 0, 5));
+
+    // 耗时降为每个粒子0.5微秒：上限回升到存储容量
+    for (uint8_t i = 0; i < 8; i++) {
+        fakeStep = particles.getCount() / 4;
+        particles.update();
+        particles.render(frame);
+    }
+    TEST_ASSERT_EQUAL(PARTICLE_CAPACITY, particles.getLimit());
+}
+
+/**
+ * 基准：满容量粒子的更新 + 绘制
+ */
+void test_benchmark(void) {
+    ParticleSystem particles;
+    particles.begin(realClock, 1000);
+    const uint8_t kinds[] = {PARTICLE_HEART, PARTICLE_Z, PARTICLE_CONFETTI};
+
+    uint32_t processed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint16_t frameIndex = 0; frameIndex < 20000; frameIndex++) {
+        // 每帧补满到当前上限
+        particles.emit(kinds[frameIndex % 3], 64, 32, PARTICLE_CAPACITY);
+        processed += particles.getCount();
+        particles.update();
+        particles.render(frame);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%lu particle updates in %ld us: %lu particles/ms, %u ns/particle (limit %u)",
+             (unsigned long)processed, (long)elapsed,
+             (unsigned long)(elapsed > 0 ? processed * 1000ULL / elapsed : 0),
+             (unsigned)particles.getCostNs(), particles.getLimit());
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(processed > 0);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_fixed_point_motion);
+    RUN_TEST(test_removal_and_clipping);
+    RUN_TEST(test_render_across_pages);
+    RUN_TEST(test_budget_limits_count);
+    RUN_TEST(test_benchmark);
+
+    return UNITY_END();
+}
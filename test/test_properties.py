@@ -23,6 +23,8 @@ MODE_FACE = 0
 MODE_CLOCK = 1
 MODE_SYSINFO = 2
 MODE_SLEEP = 3
+MODE_TEXT = 4
+MODE_STOPWATCH = 5
 
 class TestResults:
     def __init__(self):
@@ -155,6 +157,8 @@ def next_mode(current_mode):
     elif current_mode == MODE_CLOCK:
         return MODE_SYSINFO
     elif current_mode == MODE_SYSINFO:
+        return MODE_STOPWATCH
+    elif current_mode == MODE_STOPWATCH:
         return MODE_FACE
     elif current_mode == MODE_SLEEP:
         return MODE_FACE
@@ -173,7 +177,8 @@ def test_property_2_mode_cycle():
     expected_sequence = [
         (MODE_FACE, MODE_CLOCK),
         (MODE_CLOCK, MODE_SYSINFO),
-        (MODE_SYSINFO, MODE_FACE),  # 循环回到第一个
+        (MODE_SYSINFO, MODE_STOPWATCH),
+        (MODE_STOPWATCH, MODE_FACE),  # 循环回到第一个
         (MODE_SLEEP, MODE_FACE),    # 睡眠模式也回到FACE
     ]
     
@@ -190,12 +195,12 @@ def test_property_2_mode_cycle():
     mode = MODE_FACE
     visited = set()
     for _ in range(10):  # 多次循环验证
-        if mode in [MODE_FACE, MODE_CLOCK, MODE_SYSINFO]:
+        if mode in [MODE_FACE, MODE_CLOCK, MODE_SYSINFO, MODE_STOPWATCH]:
             visited.add(mode)
         mode = next_mode(mode)
     
-    if len(visited) != 3:
-        results.add_fail(f"Property 2 失败: 循环未访问所有3个主要模式")
+    if len(visited) != 4:
+        results.add_fail(f"Property 2 失败: 循环未访问所有4个主要模式")
         return False
     
     results.add_pass()
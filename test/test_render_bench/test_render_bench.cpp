@@ -0,0 +1,214 @@
+/**
+ * 智能桌面伴侣 - 渲染性能基准
+ *
+ * 在主机端无头显示上按各模式的帧间隔推进主机时钟，连续渲染数千帧，
+ * 统计每帧的合成耗时（ns/帧，主机CPU上的相对值）和与上一帧相比变化的字节数（按tile计，即实际需要发送的量）。
+ * 合成顺序与DisplayManager相同：背景层整帧复制 -> 内容层绘制
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include <HostDisplay.h>
+#include "FrameBuffer.h"
+#include "FaceRenderer.h"
+#include "ClockRenderer.h"
+#include "SysInfoRenderer.h"
+
+static const uint16_t FRAMES = 5000;
+
+static HostDisplay* display;
+static uint8_t staticLayer[FrameBuffer::SIZE] __attribute__((aligned(4)));
+static uint8_t previous[FrameBuffer::SIZE] __attribute__((aligned(4)));
+
+/**
+ * 一个模式的统计结果
+ */
+struct BenchResult {
+    uint64_t totalNanos;
+    uint32_t totalBytes;
+    uint16_t maxBytes;
+};
+
+void setUp(void) {
+    hostSetMillis(100000);
+    randomSeed(1);
+    display = new HostDisplay();
+}
+
+void tearDown(void) {
+    delete display;
+}
+
+/**
+ * 计时一帧的合成，并统计与上一帧相比变化的字节数
+ */
+template <typename Compose>
+static void benchFrame(BenchResult& result, Compose compose) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    compose();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    result.totalNanos += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    FrameBuffer::DirtyMask dirty;
+    uint8_t* frame = display->getBufferPtr();
+    uint16_t bytes = (uint16_t)(FrameBuffer::diffTiles(frame, previous, dirty) * FrameBuffer::TILE_BYTES);
+    result.totalBytes += bytes;
+    if (bytes > result.maxBytes) {
+        result.maxBytes = bytes;
+    }
+    FrameBuffer::copyFrame(previous, frame);
+}
+
+static void report(const char* name, const BenchResult& result) {
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%-20s %7lu ns/frame, %6.1f bytes/frame (max %u) over %u frames", name,
+             (unsigned long)(result.totalNanos / FRAMES), (double)result.totalBytes / FRAMES, result.maxBytes,
+             FRAMES);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE(result.totalNanos > 0);
+}
+
+/**
+ * 表情：按动画帧间隔推进，包含眨眼、看左右等随机动画
+ */
+void test_bench_face(void) {
+    FaceRenderer face;
+    face.init();
+    BenchResult result = {0, 0, 0};
+    memset(previous, 0, sizeof(previous));
+    for (uint16_t i = 0; i < FRAMES; i++) {
+        hostAdvanceMillis(ANIMATION_FRAME_MS);
+        benchFrame(result, [&]() {
+            face.updateAnimation();
+            display->clearBuffer();
+            face.render(display);
+        });
+    }
+    report("face", result);
+}
+
+/**
+ * 时钟：按时钟帧间隔推进，每秒更新一次时间
+ */
+static void benchClock(ClockFace clockFace, const char* name) {
+    ClockRenderer clock;
+    clock.init();
+    clock.setFace(clockFace);
+    clock.setDate(2026, 10, 17);
+    BenchResult result = {0, 0, 0};
+    memset(previous, 0, sizeof(previous));
+    uint16_t staticVersion = 0xFFFF;
+    uint32_t elapsed = 0;
+    for (uint16_t i = 0; i < FRAMES; i++) {
+        hostAdvanceMillis(CLOCK_FRAME_MS);
+        elapsed += CLOCK_FRAME_MS;
+        uint32_t seconds = 10 * 3600 + elapsed / 1000;
+        clock.setTime((uint8_t)(seconds / 3600 % 24), (uint8_t)(seconds / 60 % 60), (uint8_t)(seconds % 60));
+        benchFrame(result, [&]() {
+            // 背景层只在版本变化时重新光栅化
+            uint8_t* frame = display->getBufferPtr();
+            if (staticVersion != clock.getStaticVersion()) {
+                display->clearBuffer();
+                clock.renderStatic(display);
+                FrameBuffer::copyFrame(staticLayer, frame);
+                staticVersion = clock.getStaticVersion();
+            }
+            FrameBuffer::copyFrame(frame, staticLayer);
+            clock.render(display);
+        });
+    }
+    report(name, result);
+}
+
+void test_bench_clock_digital(void) {
+    benchClock(CLOCK_FACE_DIGITAL, "clock_digital");
+}
+
+void test_bench_clock_analog(void) {
+    benchClock(CLOCK_FACE_ANALOG, "clock_analog");
+}
+
+/**
+ * 系统信息：每秒更新运行时间和内存
+ */
+void test_bench_sysinfo(void) {
+    SysInfoRenderer sysInfo;
+    sysInfo.init();
+    sysInfo.setWiFiConnected(true);
+    BenchResult result = {0, 0, 0};
+    memset(previous, 0, sizeof(previous));
+    uint16_t staticVersion = 0xFFFF;
+    for (uint16_t i = 0; i < FRAMES; i++) {
+        hostAdvanceMillis(SYSINFO_FRAME_MS);
+        sysInfo.setUptime(i);
+        sysInfo.setFreeHeap(180000 + (i % 64) * 16);
+        sysInfo.setRSSI((int8_t)(-50 - (i % 30)));
+        benchFrame(result, [&]() {
+            uint8_t* frame = display->getBufferPtr();
+            if (staticVersion != sysInfo.getStaticVersion()) {
+                display->clearBuffer();
+                sysInfo.renderStatic(display);
+                FrameBuffer::copyFrame(staticLayer, frame);
+                staticVersion = sysInfo.getStaticVersion();
+            }
+            FrameBuffer::copyFrame(frame, staticLayer);
+            sysInfo.render(display);
+        });
+    }
+    report("sysinfo", result);
+}
+
+/**
+ * 模式切换过渡：三种效果的合成（新旧画面已渲染好，与DisplayManager的过渡帧相同）
+ */
+void test_bench_transitions(void) {
+    static uint8_t from[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    static uint8_t to[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    FaceRenderer face;
+    face.init();
+    display->clearBuffer();
+    face.render(display);
+    FrameBuffer::copyFrame(from, display->getBufferPtr());
+    ClockRenderer clock;
+    clock.setTime(10, 8, 42);
+    display->clearBuffer();
+    clock.renderStatic(display);
+    clock.render(display);
+    FrameBuffer::copyFrame(to, display->getBufferPtr());
+
+    const char* names[] = {"slide", "wipe", "dissolve"};
+    for (uint8_t type = 0; type < 3; type++) {
+        BenchResult result = {0, 0, 0};
+        FrameBuffer::copyFrame(previous, from);
+        for (uint16_t i = 0; i < FRAMES; i++) {
+            // 每10帧走完一次过渡（200ms / 20ms）
+            uint16_t progress = (uint16_t)(((i % 10) + 1) * 256 / 10);
+            benchFrame(result, [&]() {
+                uint8_t* frame = display->getBufferPtr();
+                if (type == 0) {
+                    FrameBuffer::slideHorizontal(frame, from, to, (uint8_t)((progress * OLED_WIDTH) >> 8));
+                } else if (type == 1) {
+                    FrameBuffer::wipeVertical(frame, from, to, (uint8_t)((progress * OLED_HEIGHT) >> 8));
+                } else {
+                    FrameBuffer::ditherCrossfade(frame, from, to, (uint8_t)((progress * 16) >> 8));
+                }
+            });
+        }
+        char name[24];
+        snprintf(name, sizeof(name), "transition_%s", names[type]);
+        report(name, result);
+    }
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bench_face);
+    RUN_TEST(test_bench_clock_digital);
+    RUN_TEST(test_bench_clock_analog);
+    RUN_TEST(test_bench_sysinfo);
+    RUN_TEST(test_bench_transitions);
+
+    return UNITY_END();
+}
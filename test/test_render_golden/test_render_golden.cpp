@@ -0,0 +1,209 @@
+/**
+ * 智能桌面伴侣 - 渲染基准图片测试
+ *
+ * 在主机端无头显示上运行真实的渲染器（表情、时钟、系统信息）和模式切换过渡的合成，
+ * 每个画面与 test/golden/ 中的PBM基准图片逐像素比较。
+ * 基准图片不存在时记录当前画面并标记为忽略；设置环境变量 UPDATE_GOLDEN=1 时重新记录全部基准。
+ * 不一致时把实际画面写到 <名称>.actual.pbm 便于对比
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <HostDisplay.h>
+#include "FrameBuffer.h"
+#include "FaceRenderer.h"
+#include "ClockRenderer.h"
+#include "SysInfoRenderer.h"
+
+#ifndef GOLDEN_DIR
+#define GOLDEN_DIR "test/golden"
+#endif
+
+static const unsigned long START_MS = 100000;
+
+static HostDisplay* display;
+
+// 本测试中新记录的基准数、不一致的画面数和第一条不一致的说明
+static uint8_t recorded;
+static uint8_t mismatched;
+static char mismatch[320];
+
+void setUp(void) {
+    hostSetMillis(START_MS);
+    randomSeed(1);
+    display = new HostDisplay();
+    recorded = 0;
+    mismatched = 0;
+}
+
+void tearDown(void) {
+    delete display;
+}
+
+/**
+ * 与基准图片比较（同一测试中的画面全部比较完后由 finishGolden 报告结果）
+ */
+static void checkGolden(const char* name, const uint8_t* frame) {
+    char path[128];
+    snprintf(path, sizeof(path), "%s/%s.pbm", GOLDEN_DIR, name);
+
+    static uint8_t golden[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    if (getenv("UPDATE_GOLDEN") != nullptr || !HostSnapshot::readPbm(path, golden)) {
+        TEST_ASSERT_TRUE_MESSAGE(HostSnapshot::writePbm(path, frame), path);
+        recorded++;
+        return;
+    }
+
+    uint16_t diff = HostSnapshot::diffPixels(frame, golden);
+    if (diff != 0) {
+        char actual[128];
+        snprintf(actual, sizeof(actual), "%s/%s.actual.pbm", GOLDEN_DIR, name);
+        HostSnapshot::writePbm(actual, frame);
+        if (mismatched++ == 0) {
+            snprintf(mismatch, sizeof(mismatch), "%u pixels differ from %s (see %s)", diff, path, actual);
+        }
+    }
+}
+
+static void finishGolden(void) {
+    if (mismatched != 0) {
+        TEST_FAIL_MESSAGE(mismatch);
+    }
+    if (recorded != 0) {
+        TEST_IGNORE_MESSAGE("golden recorded");
+    }
+}
+
+/**
+ * 表情：初始化后立即渲染（默认表情，睁眼）
+ */
+static void renderFace(uint8_t* frame) {
+    FaceRenderer face;
+    face.init();
+    display->clearBuffer();
+    face.render(display);
+    FrameBuffer::copyFrame(frame, display->getBufferPtr());
+}
+
+/**
+ * 时钟：按DisplayManager的合成顺序，先背景层再内容层
+ */
+static void renderClock(uint8_t* frame, ClockFace clockFace) {
+    ClockRenderer clock;
+    clock.init();
+    clock.setFace(clockFace);
+    clock.setTime(10, 8, 42);
+    clock.setDate(2026, 10, 17);
+    display->clearBuffer();
+    clock.renderStatic(display);
+    clock.render(display);
+    FrameBuffer::copyFrame(frame, display->getBufferPtr());
+}
+
+void test_face_default(void) {
+    static uint8_t frame[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    renderFace(frame);
+    checkGolden("face_default", frame);
+    finishGolden();
+}
+
+void test_face_blink(void) {
+    FaceRenderer face;
+    face.init();
+    face.triggerBlink();
+    hostAdvanceMillis(BLINK_DURATION_MS / 2);
+    face.updateAnimation();
+    display->clearBuffer();
+    face.render(display);
+    checkGolden("face_blink", display->getBufferPtr());
+    finishGolden();
+}
+
+void test_face_idle(void) {
+    FaceRenderer face;
+    face.init();
+    char name[32];
+    for (uint8_t i = 0; i < FACE_IDLE_ANIMATIONS; i++) {
+        uint32_t half = Timeline::duration(FaceRenderer::getIdleAnimation(i)) / 2;
+        display->clearBuffer();
+        face.renderIdleFrame(display, i, half);
+        snprintf(name, sizeof(name), "face_idle_%u", i);
+        checkGolden(name, display->getBufferPtr());
+    }
+    finishGolden();
+}
+
+void test_face_sleep(void) {
+    FaceRenderer face;
+    face.init();
+    face.enterSleep();
+    hostAdvanceMillis(PARTICLE_Z_INTERVAL_MS);
+    face.updateAnimation();
+    display->clearBuffer();
+    face.render(display);
+    checkGolden("face_sleep", display->getBufferPtr());
+    finishGolden();
+}
+
+void test_clock_digital(void) {
+    static uint8_t frame[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    renderClock(frame, CLOCK_FACE_DIGITAL);
+    checkGolden("clock_digital", frame);
+    finishGolden();
+}
+
+void test_clock_analog(void) {
+    static uint8_t frame[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    renderClock(frame, CLOCK_FACE_ANALOG);
+    checkGolden("clock_analog", frame);
+    finishGolden();
+}
+
+void test_sysinfo(void) {
+    SysInfoRenderer sysInfo;
+    sysInfo.init();
+    sysInfo.setFreeHeap(183456);
+    sysInfo.setUptime(3 * 86400 + 4 * 3600 + 5 * 60 + 6);
+    sysInfo.setWiFiConnected(true);
+    sysInfo.setRSSI(-58);
+    display->clearBuffer();
+    sysInfo.renderStatic(display);
+    sysInfo.render(display);
+    checkGolden("sysinfo", display->getBufferPtr());
+    finishGolden();
+}
+
+/**
+ * 模式切换过渡（表情 -> 时钟）在进度一半时的合成结果，合成函数与DisplayManager相同
+ */
+void test_transitions(void) {
+    static uint8_t from[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    static uint8_t to[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    static uint8_t frame[FrameBuffer::SIZE] __attribute__((aligned(4)));
+    renderFace(from);
+    renderClock(to, CLOCK_FACE_DIGITAL);
+
+    FrameBuffer::slideHorizontal(frame, from, to, OLED_WIDTH / 2);
+    checkGolden("transition_slide", frame);
+    FrameBuffer::wipeVertical(frame, from, to, OLED_HEIGHT / 2);
+    checkGolden("transition_wipe", frame);
+    FrameBuffer::ditherCrossfade(frame, from, to, 8);
+    checkGolden("transition_dissolve", frame);
+    finishGolden();
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_face_default);
+    RUN_TEST(test_face_blink);
+    RUN_TEST(test_face_idle);
+    RUN_TEST(test_face_sleep);
+    RUN_TEST(test_clock_digital);
+    RUN_TEST(test_clock_analog);
+    RUN_TEST(test_sysinfo);
+    RUN_TEST(test_transitions);
+
+    return UNITY_END();
+}
@@ -0,0 +1,158 @@
+/**
+ * 智能桌面伴侣 - 秒表/倒计时测试
+ *
+ * 验证按触摸边沿时刻开始/暂停的累计计时、主循环卡顿不影响显示值、
+ * 倒计时的取整与到期、显示值下一次变化的时刻和 MM:SS.cc 格式化
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "Stopwatch.h"
+#include "../helpers/TestRandom.h"
+
+void setUp(void) {
+    // 初始化
+}
+
+void tearDown(void) {
+    // 清理
+}
+
+/**
+ * 开始/暂停使用边沿时刻：处理触摸的延迟不计入计时
+ */
+void test_count_up_with_pauses(void) {
+    Stopwatch sw;
+    TEST_ASSERT_TRUE(sw.isReset());
+
+    // 边沿在 1.000000s，主循环 1.040000s 才处理到
+    TEST_ASSERT_TRUE(sw.toggle(1000000));
+    TEST_ASSERT_EQUAL(4, sw.getCentis(1040000));
+
+    // 边沿在 3.456789s 暂停，之后的时刻不再计入
+    TEST_ASSERT_FALSE(sw.toggle(3456789));
+    TEST_ASSERT_EQUAL(245, sw.getCentis(3500000));
+    TEST_ASSERT_EQUAL(245, sw.getCentis(9000000));
+    TEST_ASSERT_FALSE(sw.isReset());
+
+    // 继续计时 0.5s
+    sw.toggle(10000000);
+    sw.toggle(10500000);
+    TEST_ASSERT_EQUAL(295, sw.getCentis(20000000));
+    TEST_ASSERT_EQUAL(2956789, (int32_t)sw.getElapsed(20000000));
+
+    sw.reset();
+    TEST_ASSERT_TRUE(sw.isReset());
+    TEST_ASSERT_EQUAL(0, sw.getCentis(30000000));
+}
+
+/**
+ * 显示值只由当前时刻决定：任意间隔（模拟主循环卡顿）采样都与精确值一致，
+ * 下一次变化的时刻正好是显示值加1的时刻
+ */
+void test_stalls_do_not_affect_accuracy(void) {
+    Stopwatch sw;
+    const int64_t t0 = 123457;
+    sw.start(t0);
+
+    TestRandom rng(7);
+    int64_t now = t0;
+    for (uint16_t i = 0; i < 500; i++) {
+        uint32_t bits = rng.next();
+        // 采样间隔 1us - 131ms 不等
+        now += 1 + ((bits >> 8) % 131072);
+        uint32_t centis = sw.getCentis(now);
+        TEST_ASSERT_EQUAL((uint32_t)((now - t0) / 10000), centis);
+
+        int64_t next = sw.getNextChange(now);
+        TEST_ASSERT_TRUE(next > 0 && next <= 10000);
+        TEST_ASSERT_EQUAL(centis, sw.getCentis(now + next - 1));
+        TEST_ASSERT_EQUAL(centis + 1, sw.getCentis(now + next));
+    }
+
+    sw.stop(now);
+    TEST_ASSERT_EQUAL(-1, (int32_t)sw.getNextChange(now));
+}
+
+/**
+ * 倒计时：剩余时间向上取整，到期时停在0并只报告一次；之后触摸改为清零
+ */
+void test_countdown_expiry(void) {
+    Stopwatch sw;
+    sw.setCountdown(3000000);
+    TEST_ASSERT_EQUAL(STOPWATCH_COUNTDOWN, sw.getKind());
+    TEST_ASSERT_EQUAL(300, sw.getCentis(0));
+
+    sw.toggle(0);
+    TEST_ASSERT_EQUAL(300, sw.getCentis(1));
+    TEST_ASSERT_EQUAL(299, sw.getCentis(10000));
+    TEST_ASSERT_EQUAL(1, sw.getCentis(2999999));
+    TEST_ASSERT_FALSE(sw.update(2900000));
+
+    // 主循环在到期后 0.2s 才检查：仍停在时长处
+    TEST_ASSERT_TRUE(sw.update(3200000));
+    TEST_ASSERT_FALSE(sw.isRunning());
+    TEST_ASSERT_TRUE(sw.isExpired(3200000));
+    TEST_ASSERT_EQUAL(0, sw.getCentis(5000000));
+    TEST_ASSERT_EQUAL(3000000, (int32_t)sw.getElapsed(5000000));
+    TEST_ASSERT_FALSE(sw.update(5000000));
+
+    // 到期后不能再开始；触摸清零，再次触摸重新开始
+    sw.start(6000000);
+    TEST_ASSERT_FALSE(sw.isRunning());
+    TEST_ASSERT_FALSE(sw.toggle(6000000));
+    TEST_ASSERT_TRUE(sw.isReset());
+    TEST_ASSERT_EQUAL(300, sw.getCentis(6000000));
+    TEST_ASSERT_TRUE(sw.toggle(7000000));
+    TEST_ASSERT_EQUAL(250, sw.getCentis(7500000));
+
+    // 切回正计时
+    sw.setStopwatch();
+    TEST_ASSERT_EQUAL(STOPWATCH_UP, sw.getKind());
+    TEST_ASSERT_TRUE(sw.isReset());
+}
+
+/**
+ * 倒计时下一次变化的时刻
+ */
+void test_countdown_next_change(void) {
+    Stopwatch sw;
+    sw.setCountdown(60000000);
+    sw.start(500);
+    int64_t now = 500;
+    for (uint16_t i = 0; i < 300; i++) {
+        now += 3217;
+        uint32_t centis = sw.getCentis(now);
+        int64_t next = sw.getNextChange(now);
+        TEST_ASSERT_TRUE(next > 0 && next <= 10000);
+        TEST_ASSERT_EQUAL(centis, sw.getCentis(now + next - 1));
+        TEST_ASSERT_EQUAL(centis - 1, sw.getCentis(now + next));
+    }
+}
+
+/**
+ * MM:SS.cc 格式化，超过 99:59.99 时停在上限
+ */
+void test_format(void) {
+    char buffer[9];
+    TEST_ASSERT_EQUAL_STRING("00:00.00", Stopwatch::format(0, buffer));
+    TEST_ASSERT_EQUAL_STRING("01:01.23", Stopwatch::format(6123, buffer));
+    TEST_ASSERT_EQUAL_STRING("99:59.99", Stopwatch::format(STOPWATCH_MAX_CENTIS, buffer));
+    TEST_ASSERT_EQUAL_STRING("99:59.99", Stopwatch::format(0xFFFFFFFFUL, buffer));
+
+    Stopwatch sw;
+    sw.start(0);
+    TEST_ASSERT_EQUAL(STOPWATCH_MAX_CENTIS, sw.getCentis(2LL * 3600 * 1000000));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_count_up_with_pauses);
+    RUN_TEST(test_stalls_do_not_affect_accuracy);
+    RUN_TEST(test_countdown_expiry);
+    RUN_TEST(test_countdown_next_change);
+    RUN_TEST(test_format);
+
+    return UNITY_END();
+}
@@ -0,0 +1,150 @@
+/**
+ * 智能桌面伴侣 - 文本排版测试
+ *
+ * 验证UTF-8解码、英文按词换行、中文任意位置换行、
+ * 标点避头和强制换行的正确性
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "TextLayout.h"
+
+// 测试字体：ASCII 6像素，中日韩文字 12像素
+static uint8_t fixedAdvance(uint32_t codepoint, void* context) {
+    (void)context;
+    return TextLayout::isCjk(codepoint) ? 12 : 6;
+}
+
+static TextLayout::Line lines[16];
+
+/**
+ * 排版并返回行数
+ */
+static uint8_t layout(const char* text, uint16_t maxWidth) {
+    return TextLayout::breakLines(text, (uint16_t)strlen(text), maxWidth, fixedAdvance, nullptr, lines, 16);
+}
+
+/**
+ * 断言第n行的内容
+ */
+static void assertLine(const char* text, uint8_t n, const char* expected) {
+    TEST_ASSERT_EQUAL(strlen(expected), lines[n].length);
+    TEST_ASSERT_EQUAL_MEMORY(expected, text + lines[n].start, lines[n].length);
+}
+
+void setUp(void) {
+    memset(lines, 0, sizeof(lines));
+}
+
+void tearDown(void) {
+    // 清理
+}
+
+/**
+ * UTF-8解码：ASCII、双字节、三字节、四字节和非法序列
+ */
+void test_decode_utf8(void) {
+    const char* text = "A\xC3\xA9\xE4\xBD\xA0\xF0\x9F\x98\x80\xFF";
+    uint16_t length = (uint16_t)strlen(text);
+    uint16_t pos = 0;
+
+    TEST_ASSERT_EQUAL_HEX32(0x41, TextLayout::decodeUtf8(text, pos, length));
+    TEST_ASSERT_EQUAL_HEX32(0xE9, TextLayout::decodeUtf8(text, pos, length));
+    TEST_ASSERT_EQUAL_HEX32(0x4F60, TextLayout::decodeUtf8(text, pos, length));
+    TEST_ASSERT_EQUAL_HEX32(0x1F600, TextLayout::decodeUtf8(text, pos, length));
+    TEST_ASSERT_EQUAL_HEX32(TextLayout::REPLACEMENT_CHAR, TextLayout::decodeUtf8(text, pos, length));
+    TEST_ASSERT_EQUAL(length, pos);
+
+    // 在多字节序列中间截断
+    pos = 0;
+    TEST_ASSERT_EQUAL_HEX32(TextLayout::REPLACEMENT_CHAR, TextLayout::decodeUtf8("\xE4\xBD", pos, 2));
+    TEST_ASSERT_EQUAL(1, pos);
+}
+
+/**
+ * 英文按空格断词，行尾空格不计入行宽
+ */
+void test_latin_word_wrap(void) {
+    const char* text = "hello world foo";
+    TEST_ASSERT_EQUAL(2, layout(text, 72));    // 每行最多12个字符
+    assertLine(text, 0, "hello world");
+    assertLine(text, 1, "foo");
+    TEST_ASSERT_EQUAL(66, lines[0].width);
+}
+
+/**
+ * 超过行宽的单词强制断开
+ */
+void test_long_word_hard_break(void) {
+    const char* text = "abcdefghij";
+    TEST_ASSERT_EQUAL(3, layout(text, 24));
+    assertLine(text, 0, "abcd");
+    assertLine(text, 1, "efgh");
+    assertLine(text, 2, "ij");
+}
+
+/**
+ * 中文可在任意两个字之间换行
+ */
+void test_cjk_break_anywhere(void) {
+    const char* text = "今天天气很好";
+    TEST_ASSERT_EQUAL(2, layout(text, 48));
+    assertLine(text, 0, "今天天气");
+    assertLine(text, 1, "很好");
+}
+
+/**
+ * 中文标点不出现在行首：与前一个字一起换到下一行
+ */
+void test_cjk_punctuation_not_at_line_start(void) {
+    const char* text = "你好世界。再见";
+    TEST_ASSERT_EQUAL(2, layout(text, 48));
+    assertLine(text, 0, "你好世");
+    assertLine(text, 1, "界。再见");
+}
+
+/**
+ * 中英文混排：中文与英文单词之间可以换行，英文单词不被拆开
+ */
+void test_mixed_text(void) {
+    const char* text = "温度25度 sunny";
+    TEST_ASSERT_EQUAL(2, layout(text, 60));
+    assertLine(text, 0, "温度25度");
+    assertLine(text, 1, "sunny");
+}
+
+/**
+ * '\n' 强制换行，保留空行
+ */
+void test_explicit_newline(void) {
+    const char* text = "ab\n\ncd";
+    TEST_ASSERT_EQUAL(3, layout(text, 120));
+    assertLine(text, 0, "ab");
+    assertLine(text, 1, "");
+    assertLine(text, 2, "cd");
+}
+
+/**
+ * 超出最大行数的部分被截断
+ */
+void test_max_lines(void) {
+    const char* text = "一二三四五六七八九十";
+    TEST_ASSERT_EQUAL(3, TextLayout::breakLines(text, (uint16_t)strlen(text), 24,
+                                                fixedAdvance, nullptr, lines, 3));
+    assertLine(text, 2, "五六");
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_decode_utf8);
+    RUN_TEST(test_latin_word_wrap);
+    RUN_TEST(test_long_word_hard_break);
+    RUN_TEST(test_cjk_break_anywhere);
+    RUN_TEST(test_cjk_punctuation_not_at_line_start);
+    RUN_TEST(test_mixed_text);
+    RUN_TEST(test_explicit_newline);
+    RUN_TEST(test_max_lines);
+
+    return UNITY_END();
+}
@@ -0,0 +1,196 @@
+/**
+ * 智能桌面伴侣 - 关键帧动画引擎测试
+ *
+ * 验证关键帧插值与缓动、游标推进、截止时间、
+ * 同层排队衔接以及多层动画叠加
+ */
+
+#include <unity.h>
+#include "Timeline.h"
+
+static const uint8_t MOUTH_A = 1;
+static const uint8_t MOUTH_B = 2;
+static const uint8_t MOUTH_BASE = 7;
+static const uint32_t FRAME_MS = 30;
+
+// 睁开程度 256 -> 0（线性，100ms）-> 保持到300ms -> 跳变回256（400ms）
+constexpr Timeline::Keyframe CLOSE_FRAMES[] = {
+    {0,   {256, 0, 0, 0, 256}, MOUTH_A, Timeline::EASE_STEP},
+    {100, {0,   0, 0, 0, 256}, MOUTH_A, Timeline::EASE_LINEAR},
+    {300, {0,   0, 0, 0, 256}, MOUTH_B, Timeline::EASE_STEP},
+    {400, {256, 0, 0, 0, 256}, MOUTH_B, Timeline::EASE_STEP}
+};
+constexpr Timeline::Animation CLOSE = {
+    CLOSE_FRAMES, 4, Timeline::CHANNEL_OPENNESS | Timeline::CHANNEL_MOUTH, Timeline::BLEND_OVERRIDE
+};
+
+// 瞳孔平滑移到 +512 再回来（200ms）
+constexpr Timeline::Keyframe GLANCE_FRAMES[] = {
+    {0,   {0, 0,   0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_STEP},
+    {100, {0, 512, 0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_IN_OUT},
+    {200, {0, 0,   0, 0, 0}, Timeline::MOUTH_KEEP, Timeline::EASE_IN_OUT}
+};
+constexpr Timeline::Animation GLANCE = {
+    GLANCE_FRAMES, 3, Timeline::CHANNEL_PUPIL, Timeline::BLEND_MULTIPLY
+};
+
+// 睁开程度按比例缩放到一半（眨眼类动画）
+constexpr Timeline::Keyframe HALF_FRAMES[] = {
+    {0,   {128, 0, 0, 0, 256}, Timeline::MOUTH_KEEP, Timeline::EASE_STEP},
+    {150, {128, 0, 0, 0, 256}, Timeline::MOUTH_KEEP, Timeline::EASE_STEP}
+};
+constexpr Timeline::Animation HALF = {
+    HALF_FRAMES, 2, Timeline::CHANNEL_OPENNESS, Timeline::BLEND_MULTIPLY
+};
+
+// 大小覆盖为 288（反应类动画）
+constexpr Timeline::Keyframe WIDE_FRAMES[] = {
+    {0,   {0, 0, 0, 0, 288}, MOUTH_B, Timeline::EASE_STEP},
+    {150, {0, 0, 0, 0, 288}, MOUTH_B, Timeline::EASE_STEP}
+};
+constexpr Timeline::Animation WIDE = {
+    WIDE_FRAMES, 2, Timeline::CHANNEL_SIZE | Timeline::CHANNEL_MOUTH, Timeline::BLEND_OVERRIDE
+};
+
+static const EyeModel::Params BASE = {256, 0, 0, 0, 256};
+static Timeline::Player player;
+
+/**
+ * 在时间 now 推进并叠加到基础参数上
+ */
+static EyeModel::Params sampleAt(uint32_t now, uint8_t* mouth = nullptr) {
+    player.update(now);
+    EyeModel::Params eye = BASE;
+    uint8_t m = MOUTH_BASE;
+    player.apply(eye, m);
+    if (mouth != nullptr) *mouth = m;
+    return eye;
+}
+
+void setUp(void) {
+    for (uint8_t i = 0; i < TIMELINE_LAYERS; i++) {
+        player.stop(i);
+    }
+}
+
+void tearDown(void) {
+    // 清理
+}
+
+/**
+ * 线性插值、保持和跳变；嘴巴在关键帧处切换
+ */
+void test_keyframe_sampling(void) {
+    const uint32_t start = 1000;
+    player.play(0, CLOSE, start);
+    uint8_t mouth = 0;
+
+    TEST_ASSERT_EQUAL(256, sampleAt(start, &mouth).openness);
+    TEST_ASSERT_EQUAL(MOUTH_A, mouth);
+    TEST_ASSERT_EQUAL(128, sampleAt(start + 50).openness);
+    TEST_ASSERT_EQUAL(0, sampleAt(start + 100).openness);
+    TEST_ASSERT_EQUAL(0, sampleAt(start + 350, &mouth).openness);
+    TEST_ASSERT_EQUAL(MOUTH_B, mouth);
+    TEST_ASSERT_EQUAL(0, sampleAt(start + 399).openness);
+
+    // 动画结束后不再影响基础参数
+    TEST_ASSERT_EQUAL(256, sampleAt(start + 400, &mouth).openness);
+    TEST_ASSERT_EQUAL(MOUTH_BASE, mouth);
+    TEST_ASSERT_FALSE(player.isPlaying(0));
+}
+
+/**
+ * 平滑缓动：中点准确，两端变化慢于线性
+ */
+void test_ease_in_out(void) {
+    TEST_ASSERT_EQUAL(0, Timeline::ease(Timeline::EASE_IN_OUT, 0));
+    TEST_ASSERT_EQUAL(128, Timeline::ease(Timeline::EASE_IN_OUT, 128));
+    TEST_ASSERT_EQUAL(256, Timeline::ease(Timeline::EASE_IN_OUT, 256));
+    TEST_ASSERT_TRUE(Timeline::ease(Timeline::EASE_IN_OUT, 32) < 32);
+    TEST_ASSERT_TRUE(Timeline::ease(Timeline::EASE_IN_OUT, 224) > 224);
+    TEST_ASSERT_EQUAL(0, Timeline::ease(Timeline::EASE_STEP, 255));
+}
+
+/**
+ * 长时间没有推进（跳过多个关键帧）后仍能采样到正确位置
+ */
+void test_cursor_skips_keyframes(void) {
+    player.play(0, CLOSE, 0);
+    sampleAt(10);
+    uint8_t mouth = 0;
+    TEST_ASSERT_EQUAL(0, sampleAt(320, &mouth).openness);
+    TEST_ASSERT_EQUAL(MOUTH_B, mouth);
+}
+
+/**
+ * 截止时间：跳变区间等到下一个关键帧，插值区间按帧间隔，空闲时没有截止时间
+ */
+void test_next_deadline(void) {
+    TEST_ASSERT_EQUAL_HEX32(Timeline::NO_DEADLINE, player.getNextDeadline(0, 0, FRAME_MS));
+
+    player.play(0, CLOSE, 0);
+    player.update(10);
+    TEST_ASSERT_EQUAL(FRAME_MS - 5, player.getNextDeadline(15, 10, FRAME_MS));   // 线性区间
+    player.update(120);
+    TEST_ASSERT_EQUAL(180, player.getNextDeadline(120, 120, FRAME_MS));         // 保持到300ms
+    player.update(300);
+    TEST_ASSERT_EQUAL(100, player.getNextDeadline(300, 300, FRAME_MS));         // 400ms跳变
+    TEST_ASSERT_EQUAL(0, player.getNextDeadline(400, 300, FRAME_MS));
+}
+
+/**
+ * 同层排队：后一个动画在前一个结束时无缝开始
+ */
+void test_queue_chains_animations(void) {
+    player.play(0, GLANCE, 0);
+    TEST_ASSERT_TRUE(player.enqueue(0, CLOSE, 0));
+    TEST_ASSERT_EQUAL(512, sampleAt(100).pupilX);
+
+    // 第一个动画在200ms结束，第二个从200ms开始：250ms 时处于线性区间中点
+    EyeModel::Params eye = sampleAt(250);
+    TEST_ASSERT_EQUAL(&CLOSE, player.current(0));
+    TEST_ASSERT_EQUAL(0, eye.pupilX);
+    TEST_ASSERT_EQUAL(128, eye.openness);
+
+    // 队列有上限
+    for (uint8_t i = 0; i < TIMELINE_QUEUE_SIZE; i++) {
+        TEST_ASSERT_TRUE(player.enqueue(0, GLANCE, 250));
+    }
+    TEST_ASSERT_FALSE(player.enqueue(0, GLANCE, 250));
+}
+
+/**
+ * 多层叠加：动作层移动瞳孔、反应层覆盖大小和嘴巴、眨眼层按比例缩放睁开程度
+ */
+void test_layers_blend(void) {
+    player.play(0, GLANCE, 0);
+    player.play(1, WIDE, 0);
+    player.play(2, HALF, 0);
+
+    uint8_t mouth = 0;
+    EyeModel::Params eye = sampleAt(100, &mouth);
+    TEST_ASSERT_EQUAL(512, eye.pupilX);
+    TEST_ASSERT_EQUAL(288, eye.size);
+    TEST_ASSERT_EQUAL(128, eye.openness);
+    TEST_ASSERT_EQUAL(MOUTH_B, mouth);
+
+    // 反应层和眨眼层结束后，只剩动作层
+    eye = sampleAt(175, &mouth);
+    TEST_ASSERT_EQUAL(256, eye.size);
+    TEST_ASSERT_EQUAL(256, eye.openness);
+    TEST_ASSERT_EQUAL(MOUTH_BASE, mouth);
+    TEST_ASSERT_TRUE(eye.pupilX > 0 && eye.pupilX < 512);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_keyframe_sampling);
+    RUN_TEST(test_ease_in_out);
+    RUN_TEST(test_cursor_skips_keyframes);
+    RUN_TEST(test_next_deadline);
+    RUN_TEST(test_queue_chains_animations);
+    RUN_TEST(test_layers_blend);
+
+    return UNITY_END();
+}
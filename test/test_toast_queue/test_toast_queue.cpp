@@ -0,0 +1,169 @@
+/**
+ * 智能桌面伴侣 - 通知队列测试
+ *
+ * 验证优先级与投递顺序、抢占后剩余时间的保留、到期移除、队列满时丢弃，
+ * 以及多个任务同时投递、渲染路径同时消费时没有通知丢失或重复
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+#include "ToastQueue.h"
+
+static ToastQueue* queue;
+
+void setUp(void) {
+    queue = new ToastQueue();
+}
+
+void tearDown(void) {
+    delete queue;
+}
+
+/**
+ * 优先级高的先显示，同优先级按投递顺序
+ */
+void test_priority_order(void) {
+    queue->post("a", TOAST_INFO, 100);
+    queue->post("b", TOAST_ALERT, 100);
+    queue->post("c", TOAST_INFO, 100);
+    queue->post("d", TOAST_ALERT, 100);
+
+    const char* expected[] = {"b", "d", "a", "c"};
+    uint32_t now = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(queue->update(now));
+        TEST_ASSERT_NOT_NULL(queue->getCurrent());
+        TEST_ASSERT_EQUAL_STRING(expected[i], queue->getCurrent()->text);
+        now += 100;
+    }
+    TEST_ASSERT_TRUE(queue->update(now));
+    TEST_ASSERT_NULL(queue->getCurrent());
+    TEST_ASSERT_FALSE(queue->update(now + 1000));
+}
+
+/**
+ * 到期前不变化；剩余时间用于安排下一帧
+ */
+void test_expiry(void) {
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFFUL, queue->getRemaining(0));
+    queue->post("wifi", TOAST_INFO, 1500, 0x48);
+    TEST_ASSERT_TRUE(queue->hasPending());
+    TEST_ASSERT_TRUE(queue->update(1000));
+    TEST_ASSERT_FALSE(queue->hasPending());
+    TEST_ASSERT_EQUAL(0x48, queue->getCurrent()->icon);
+    TEST_ASSERT_FALSE(queue->update(2499));
+    TEST_ASSERT_EQUAL_UINT32(1, queue->getRemaining(2499));
+    TEST_ASSERT_TRUE(queue->update(2500));
+    TEST_ASSERT_NULL(queue->getCurrent());
+}
+
+/**
+ * 更高优先级的通知抢占当前通知，被抢占的通知之后显示剩余的时间
+ */
+void test_preempt_keeps_remaining(void) {
+    queue->post("sync", TOAST_INFO, 1000);
+    queue->update(0);
+    queue->post("reset", TOAST_ALERT, 500);
+    TEST_ASSERT_TRUE(queue->update(400));
+    TEST_ASSERT_EQUAL_STRING("reset", queue->getCurrent()->text);
+    TEST_ASSERT_TRUE(queue->update(900));
+    TEST_ASSERT_EQUAL_STRING("sync", queue->getCurrent()->text);
+    TEST_ASSERT_EQUAL_UINT32(600, queue->getRemaining(900));
+    TEST_ASSERT_FALSE(queue->update(1499));
+    TEST_ASSERT_TRUE(queue->update(1500));
+    TEST_ASSERT_NULL(queue->getCurrent());
+}
+
+/**
+ * 队列满时丢弃并计数；长文本截断
+ */
+void test_full_and_truncate(void) {
+    for (uint8_t i = 0; i < TOAST_SLOTS; i++) {
+        TEST_ASSERT_TRUE(queue->post("0123456789012345678901234567890123456789", TOAST_INFO, 10));
+    }
+    TEST_ASSERT_FALSE(queue->post("x", TOAST_ALERT, 10));
+    TEST_ASSERT_EQUAL_UINT32(1, queue->getDropped());
+
+    queue->update(0);
+    TEST_ASSERT_EQUAL(TOAST_TEXT_BYTES - 1, strlen(queue->getCurrent()->text));
+
+    // 显示到期后槽位可以再次使用
+    queue->update(10);
+    TEST_ASSERT_TRUE(queue->post("y", TOAST_ALERT, 10));
+}
+
+/**
+ * 多个投递线程与一个消费线程并发：每条成功投递的通知恰好显示一次，内容完整
+ */
+void test_concurrent_producers(void) {
+    static const uint8_t PRODUCERS = 4;
+    static const uint16_t PER_PRODUCER = 2000;
+    std::atomic<uint32_t> posted(0);
+    std::atomic<bool> done(false);
+    std::vector<uint16_t> seen(PRODUCERS * PER_PRODUCER, 0);
+
+    std::vector<std::thread> producers;
+    for (uint8_t p = 0; p < PRODUCERS; p++) {
+        producers.push_back(std::thread([p, &posted]() {
+            char text[TOAST_TEXT_BYTES];
+            for (uint16_t i = 0; i < PER_PRODUCER; ) {
+                snprintf(text, sizeof(text), "%u:%u", (unsigned)p, (unsigned)i);
+                if (queue->post(text, (ToastPriority)(i % 3), 0)) {
+                    posted.fetch_add(1);
+                    i++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+
+    // 消费者：时长为0，每次update显示下一条并在下一次update时移除
+    std::thread consumer([&]() {
+        uint32_t now = 0;
+        for (;;) {
+            bool finished = done.load();
+            queue->update(now++);
+            const ToastQueue::Toast* toast = queue->getCurrent();
+            if (toast != nullptr) {
+                unsigned p, i;
+                if (sscanf(toast->text, "%u:%u", &p, &i) == 2 && p < PRODUCERS && i < PER_PRODUCER) {
+                    seen[p * PER_PRODUCER + i]++;
+                }
+            } else if (finished) {
+                break;
+            }
+        }
+    });
+
+    for (size_t p = 0; p < producers.size(); p++) {
+        producers[p].join();
+    }
+    done.store(true);
+    consumer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(PRODUCERS * PER_PRODUCER, posted.load());
+    uint32_t once = 0;
+    for (size_t i = 0; i < seen.size(); i++) {
+        if (seen[i] == 1) once++;
+    }
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%lu toasts from %u producers, each shown once: %lu, retries dropped: %lu",
+             (unsigned long)posted.load(), PRODUCERS, (unsigned long)once, (unsigned long)queue->getDropped());
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL_UINT32(seen.size(), once);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_priority_order);
+    RUN_TEST(test_expiry);
+    RUN_TEST(test_preempt_keeps_remaining);
+    RUN_TEST(test_full_and_truncate);
+    RUN_TEST(test_concurrent_producers);
+
+    return UNITY_END();
+}
@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+"""
+智能桌面伴侣 - 表情包生成工具
+
+把JSON描述的表情（眼睛参数、嘴巴帧、关键帧动画）打包为 ExpressionPack 使用的
+二进制文件，再烧录到 partitions.csv 中的 expr 分区。新增表情不需要重新编译固件。
+
+用法:
+    python tools/make_expression_pack.py tools/expressions.json expr.bin
+    esptool.py --chip esp32c3 write_flash 0x2D0000 expr.bin
+
+描述文件格式:
+    {
+      "mouth_y": 42,                      # 嘴巴绘制位置的Y坐标（决定页格式的纵向偏移）
+      "expressions": [
+        {
+          "name": "laugh",                # 最多8个字符
+          "eye": [256, 0, 0, 64, 256],    # openness, pupilX, pupilY, squint, size（Q8）
+          "frame_ms": 250,                # 嘴巴帧间隔
+          "sprites": [["..##..", ...]],   # 嘴巴帧，每帧为若干行，'#' 表示点亮
+          "track": {                      # 可选：加载表情时播放一次的关键帧动画
+            "channels": ["openness", "size"],
+            "blend": "override",
+            "keyframes": [[0, [256, 0, 0, 0, 256], null, "step"], ...]
+          }
+        }
+      ]
+    }
+
+关键帧为 [时间ms, 眼睛参数, 嘴巴状态（null表示不改变）, 缓动（step/linear/in_out）]。
+文件格式见 include/ExpressionPack.h。
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+EXPRESSION_PACK_MAGIC = 0x4B505845
+EXPRESSION_PACK_VERSION = 1
+EXPRESSION_NAME_LENGTH = 8
+EXPRESSION_MAX_SPRITES = 4
+EXPRESSION_MAX_KEYFRAMES = 16
+EXPRESSION_CACHE_BYTES = 512
+EXPRESSION_NO_TRACK = 0xFF
+PARTITION_SIZE = 0x40000
+
+HEADER_SIZE = 12
+EXPRESSION_ENTRY_SIZE = 24
+SPRITE_ENTRY_SIZE = 12
+TRACK_ENTRY_SIZE = 12
+
+CHANNELS = {'openness': 0x01, 'pupil': 0x02, 'squint': 0x04, 'size': 0x08, 'mouth': 0x10}
+BLENDS = {'override': 0, 'multiply': 1}
+EASINGS = {'step': 0, 'linear': 1, 'in_out': 2}
+MOUTH_KEEP = 0xFF
+
+
+def rle_encode(data):
+    """PackBits风格的RLE编码（与 ExpressionPack::rleEncode 相同）"""
+    out = bytearray()
+    i = 0
+    n = len(data)
+    while i < n:
+        run = 1
+        while i + run < n and run < 130 and data[i + run] == data[i]:
+            run += 1
+        if run >= 3:
+            out += bytes((run + 125, data[i]))
+            i += run
+            continue
+        literal = 0
+        while i + literal < n and literal < 128:
+            j = i + literal
+            if j + 2 < n and data[j] == data[j + 1] == data[j + 2]:
+                break
+            literal += 1
+        out.append(literal - 1)
+        out += data[i:i + literal]
+        i += literal
+    return bytes(out)
+
+
+def to_pages(rows, shift):
+    """把 '#'/'.' 行转换为页格式（bit0在最上方），整体下移 shift 行"""
+    height = len(rows)
+    width = max(len(r) for r in rows)
+    pages = (height + shift + 7) // 8
+    data = bytearray(width * pages)
+    for y, row in enumerate(rows):
+        for x, ch in enumerate(row):
+            if ch == '#':
+                py = y + shift
+                data[(py // 8) * width + x] |= 1 << (py % 8)
+    return width, height, pages, bytes(data)
+
+
+def pack_keyframes(keyframes):
+    data = bytearray()
+    previous = -1
+    for time, eye, mouth, easing in keyframes:
+        if time < previous or (previous < 0 and time != 0):
+            sys.exit('关键帧必须从0开始且时间递增')
+        previous = time
+        data += struct.pack('<H5hBB', time, *eye, MOUTH_KEEP if mouth is None else mouth, EASINGS[easing])
+    return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='JSON -> ExpressionPack 表情包')
+    parser.add_argument('spec', help='表情描述文件（JSON）')
+    parser.add_argument('output', help='输出的表情包文件')
+    args = parser.parse_args()
+
+    with open(args.spec, encoding='utf-8') as f:
+        spec = json.load(f)
+    shift = spec.get('mouth_y', 42) & 7
+    expressions = spec['expressions']
+
+    sprites = []        # (width, height, pages, 压缩数据)
+    tracks = []         # (关键帧数, channels, blend, 压缩数据)
+    entries = []
+    raw_bytes = 0
+
+    for expr in expressions:
+        name = expr['name'].encode('ascii')
+        if len(name) > EXPRESSION_NAME_LENGTH:
+            sys.exit('表情名过长: %s' % expr['name'])
+        frames = expr.get('sprites', [])
+        if len(frames) > EXPRESSION_MAX_SPRITES:
+            sys.exit('%s: 最多 %d 帧' % (expr['name'], EXPRESSION_MAX_SPRITES))
+
+        first_sprite = len(sprites)
+        cache_bytes = 0
+        for rows in frames:
+            width, height, pages, data = to_pages(rows, shift)
+            cache_bytes += len(data)
+            raw_bytes += len(data)
+            sprites.append((width, height, pages, rle_encode(data)))
+        if cache_bytes > EXPRESSION_CACHE_BYTES:
+            sys.exit('%s: 嘴巴帧共 %d 字节，超过缓存 %d 字节' % (expr['name'], cache_bytes, EXPRESSION_CACHE_BYTES))
+
+        track = EXPRESSION_NO_TRACK
+        if 'track' in expr:
+            t = expr['track']
+            if not 2 <= len(t['keyframes']) <= EXPRESSION_MAX_KEYFRAMES:
+                sys.exit('%s: 动画需要 2-%d 个关键帧' % (expr['name'], EXPRESSION_MAX_KEYFRAMES))
+            channels = 0
+            for channel in t['channels']:
+                channels |= CHANNELS[channel]
+            data = pack_keyframes(t['keyframes'])
+            raw_bytes += len(data)
+            track = len(tracks)
+            tracks.append((len(t['keyframes']), channels, BLENDS[t.get('blend', 'override')], rle_encode(data)))
+
+        entries.append((name, expr['eye'], first_sprite, len(frames), expr.get('frame_ms', 200), track))
+
+    # 表头之后依次存放压缩数据
+    offset = (HEADER_SIZE + len(entries) * EXPRESSION_ENTRY_SIZE +
+              len(sprites) * SPRITE_ENTRY_SIZE + len(tracks) * TRACK_ENTRY_SIZE)
+    tables = struct.pack('<IHHHH', EXPRESSION_PACK_MAGIC, EXPRESSION_PACK_VERSION,
+                         len(entries), len(sprites), len(tracks))
+    for name, eye, first_sprite, count, frame_ms, track in entries:
+        tables += struct.pack('<8s5hBBHBB', name, *eye, first_sprite, count, frame_ms, track, 0)
+    payload = b''
+    for width, height, pages, data in sprites:
+        tables += struct.pack('<IHBBBBH', offset + len(payload), len(data), width, height, shift, pages, 0)
+        payload += data
+    for count, channels, blend, data in tracks:
+        tables += struct.pack('<IHBBB3x', offset + len(payload), len(data), count, channels, blend)
+        payload += data
+
+    blob = tables + payload
+    if len(blob) > PARTITION_SIZE:
+        sys.exit('表情包 %d 字节，超过分区大小 %d' % (len(blob), PARTITION_SIZE))
+
+    with open(args.output, 'wb') as f:
+        f.write(blob)
+    print('%d 个表情，%d 帧，%d 段动画；数据 %d -> %d 字节，表情包 %d 字节' %
+          (len(entries), len(sprites), len(tracks), raw_bytes, len(payload), len(blob)))
+
+
+if __name__ == '__main__':
+    main()
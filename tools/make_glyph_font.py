@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""
+智能桌面伴侣 - 中文字库生成工具
+
+把BDF点阵字体（如文泉驿12px）转换为 GlyphStore 使用的字库文件，
+再烧录到 partitions.csv 中的 font 分区。
+
+用法:
+    python tools/make_glyph_font.py wenquanyi_12pt.bdf font.bin --chars chars.txt
+    esptool.py --chip esp32c3 write_flash 0x290000 font.bin
+
+--chars 指定一个UTF-8文本文件，只收录其中出现的字符（如常用3500字 + 中文标点）；
+不指定时收录BDF中所有码点大于0xFF的字形。
+
+文件格式见 include/GlyphStore.h。
+"""
+
+import argparse
+import struct
+import sys
+
+GLYPH_FONT_MAGIC = 0x46594C47
+GLYPH_FONT_VERSION = 1
+GLYPH_MAX_BYTES = 32
+PARTITION_SIZE = 0x40000
+
+
+def parse_bdf(path):
+    """解析BDF字体，返回 (字体上升高度, {码点: (宽, 高, x偏移, y偏移, 行数据列表)})"""
+    glyphs = {}
+    ascent = None
+    encoding = None
+    bbx = None
+    rows = None
+
+    with open(path, encoding='latin-1') as f:
+        for line in f:
+            parts = line.split()
+            if not parts:
+                continue
+            key = parts[0]
+            if key == 'FONT_ASCENT':
+                ascent = int(parts[1])
+            elif key == 'STARTCHAR':
+                encoding = None
+                bbx = None
+            elif key == 'ENCODING':
+                encoding = int(parts[1])
+            elif key == 'BBX':
+                bbx = tuple(int(v) for v in parts[1:5])
+            elif key == 'BITMAP':
+                rows = []
+            elif key == 'ENDCHAR':
+                if encoding is not None and encoding >= 0 and bbx is not None:
+                    glyphs[encoding] = bbx + (rows,)
+                rows = None
+            elif rows is not None:
+                rows.append((int(key, 16), len(key) * 4))
+
+    if ascent is None:
+        sys.exit('BDF缺少 FONT_ASCENT')
+    return ascent, glyphs
+
+
+def render_glyph(glyph, ascent, width, height):
+    """把BDF字形放入 width x height 的单元格，返回 [行][列] 的像素"""
+    w, h, xoff, yoff, rows = glyph
+    cell = [[0] * width for _ in range(height)]
+    top = ascent - (h + yoff)
+    for r, (value, bits) in enumerate(rows):
+        for c in range(w):
+            if (value >> (bits - 1 - c)) & 1:
+                x = xoff + c
+                y = top + r
+                if 0 <= x < width and 0 <= y < height:
+                    cell[y][x] = 1
+    return cell
+
+
+def to_pages(cell, width, height):
+    """转换为页格式：每页 width 字节，每字节为一列中纵向8个像素（bit0在最上方）"""
+    pages = (height + 7) // 8
+    data = bytearray(width * pages)
+    for y in range(height):
+        for x in range(width):
+            if cell[y][x]:
+                data[(y // 8) * width + x] |= 1 << (y % 8)
+    return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='BDF -> GlyphStore 字库')
+    parser.add_argument('bdf', help='BDF字体文件')
+    parser.add_argument('output', help='输出的字库文件')
+    parser.add_argument('--chars', help='收录字符列表（UTF-8文本文件）')
+    parser.add_argument('--width', type=int, default=12, help='字形宽度')
+    parser.add_argument('--height', type=int, default=12, help='字形高度')
+    parser.add_argument('--advance', type=int, default=12, help='前进宽度')
+    args = parser.parse_args()
+
+    bytes_per_glyph = args.width * ((args.height + 7) // 8)
+    if bytes_per_glyph > GLYPH_MAX_BYTES:
+        sys.exit('字形过大：每个字形最多 %d 字节' % GLYPH_MAX_BYTES)
+
+    ascent, glyphs = parse_bdf(args.bdf)
+
+    if args.chars:
+        with open(args.chars, encoding='utf-8') as f:
+            wanted = {ord(ch) for ch in f.read() if ord(ch) > 0xFF}
+    else:
+        wanted = {cp for cp in glyphs if cp > 0xFF}
+
+    # 只支持基本多文种平面，索引为 uint16_t
+    codes = sorted(cp for cp in wanted if cp in glyphs and cp <= 0xFFFF)
+    missing = sorted(cp for cp in wanted if cp not in glyphs)
+    if missing:
+        print('BDF中缺少 %d 个字符: %s' % (len(missing), ''.join(chr(cp) for cp in missing[:40])))
+
+    header = struct.pack('<IHHBBBB', GLYPH_FONT_MAGIC, GLYPH_FONT_VERSION, len(codes),
+                         args.width, args.height, args.advance, bytes_per_glyph)
+    index = b''.join(struct.pack('<H', cp) for cp in codes)
+    padding = b'\0' * ((-(len(header) + len(index))) % 4)
+    bitmaps = b''.join(to_pages(render_glyph(glyphs[cp], ascent, args.width, args.height),
+                                args.width, args.height) for cp in codes)
+
+    blob = header + index + padding + bitmaps
+    if len(blob) > PARTITION_SIZE:
+        sys.exit('字库 %d 字节，超过分区大小 %d' % (len(blob), PARTITION_SIZE))
+
+    with open(args.output, 'wb') as f:
+        f.write(blob)
+    print('%d 个字形，%d 字节（分区使用 %.1f%%）' % (len(codes), len(blob), len(blob) * 100.0 / PARTITION_SIZE))
+
+
+if __name__ == '__main__':
+    main()
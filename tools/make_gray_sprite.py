@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""
+智能桌面伴侣 - 灰度精灵生成工具
+
+把PGM灰度图（P2/P5，可由GIMP或 `convert in.png -colorspace gray out.pgm` 导出）
+量化为4级灰度，生成 GraySprite 使用的页格式高位/低位平面头文件，
+由 DisplayManager::showGrayscale 按时间抖动显示。
+
+用法:
+    python tools/make_gray_sprite.py avatar.pgm include/sprites/avatar_gray.h --name AVATAR
+    python tools/make_gray_sprite.py photo.pgm photo_gray.h --name PHOTO --dither
+
+--dither 使用误差扩散（Floyd-Steinberg），适合照片类图片；
+默认直接取最接近的灰度，适合线条和图标。
+
+数据格式见 include/GrayPlanes.h。
+"""
+
+import argparse
+import sys
+
+LEVELS = 4
+MAX_WIDTH = 128
+MAX_HEIGHT = 64
+
+
+def read_tokens(data, count, pos):
+    """读取PGM头部的 count 个数字（跳过注释），返回 (数字列表, 数据起始位置)"""
+    values = []
+    while len(values) < count:
+        while pos < len(data) and data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b'#':
+            while pos < len(data) and data[pos:pos + 1] not in (b'\n', b'\r'):
+                pos += 1
+            continue
+        start = pos
+        while pos < len(data) and not data[pos:pos + 1].isspace():
+            pos += 1
+        values.append(int(data[start:pos]))
+    return values, pos + 1
+
+
+def read_pgm(path):
+    """解析PGM，返回 (宽, 高, [行][列] 的灰度，0-1浮点)"""
+    with open(path, 'rb') as f:
+        data = f.read()
+    magic = data[:2]
+    if magic not in (b'P2', b'P5'):
+        sys.exit('只支持PGM灰度图（P2/P5）')
+    (width, height, maxval), pos = read_tokens(data, 3, 2)
+    if magic == b'P5':
+        step = 2 if maxval > 255 else 1
+        raw = data[pos:pos + width * height * step]
+        values = [int.from_bytes(raw[i:i + step], 'big') for i in range(0, len(raw), step)]
+    else:
+        values, _ = read_tokens(data, width * height, pos - 1)
+    if len(values) < width * height:
+        sys.exit('PGM数据不完整')
+    return width, height, [[values[y * width + x] / float(maxval) for x in range(width)]
+                           for y in range(height)]
+
+
+def quantize(pixels, width, height, dither):
+    """量化为0-3级灰度，可选误差扩散"""
+    work = [row[:] for row in pixels]
+    levels = [[0] * width for _ in range(height)]
+    for y in range(height):
+        for x in range(width):
+            value = min(max(work[y][x], 0.0), 1.0)
+            level = int(round(value * (LEVELS - 1)))
+            levels[y][x] = level
+            if not dither:
+                continue
+            error = value - level / float(LEVELS - 1)
+            for dx, dy, weight in ((1, 0, 7), (-1, 1, 3), (0, 1, 5), (1, 1, 1)):
+                if 0 <= x + dx < width and y + dy < height:
+                    work[y + dy][x + dx] += error * weight / 16.0
+    return levels
+
+
+def to_planes(levels, width, height):
+    """拆成页格式的高位、低位平面：每页 width 字节，每字节为一列中纵向8个像素（bit0在最上方）"""
+    pages = (height + 7) // 8
+    hi = bytearray(width * pages)
+    lo = bytearray(width * pages)
+    for y in range(height):
+        for x in range(width):
+            bit = 1 << (y % 8)
+            if levels[y][x] & 2:
+                hi[(y // 8) * width + x] |= bit
+            if levels[y][x] & 1:
+                lo[(y // 8) * width + x] |= bit
+    return pages, bytes(hi), bytes(lo)
+
+
+def format_bytes(data, width):
+    lines = []
+    for start in range(0, len(data), width):
+        chunk = data[start:start + width]
+        for i in range(0, len(chunk), 16):
+            lines.append('    ' + ', '.join('0x%02X' % b for b in chunk[i:i + 16]) + ',')
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='PGM -> GraySprite 头文件')
+    parser.add_argument('pgm', help='PGM灰度图')
+    parser.add_argument('output', help='输出的头文件')
+    parser.add_argument('--name', required=True, help='精灵名称（大写，用作变量名前缀）')
+    parser.add_argument('--dither', action='store_true', help='误差扩散量化')
+    parser.add_argument('--invert', action='store_true', help='反转灰度（源图为白底黑字时使用）')
+    args = parser.parse_args()
+
+    width, height, pixels = read_pgm(args.pgm)
+    if width > MAX_WIDTH or height > MAX_HEIGHT:
+        sys.exit('图片 %dx%d 超过屏幕尺寸 %dx%d' % (width, height, MAX_WIDTH, MAX_HEIGHT))
+    if args.invert:
+        pixels = [[1.0 - v for v in row] for row in pixels]
+
+    levels = quantize(pixels, width, height, args.dither)
+    pages, hi, lo = to_planes(levels, width, height)
+    name = args.name.upper()
+    guard = name + '_GRAY_H'
+
+    with open(args.output, 'w', encoding='utf-8') as f:
+        f.write('/**\n * 由 tools/make_gray_sprite.py 从 %s 生成，请勿手工修改\n */\n\n' % args.pgm.replace('\\', '/'))
+        f.write('#ifndef %s\n#define %s\n\n#include "GrayPlanes.h"\n\n' % (guard, guard))
+        f.write('static const uint8_t %s_HI[%d] = {\n%s\n};\n\n' % (name, len(hi), format_bytes(hi, width)))
+        f.write('static const uint8_t %s_LO[%d] = {\n%s\n};\n\n' % (name, len(lo), format_bytes(lo, width)))
+        f.write('static const GraySprite %s = {%d, %d, %s_HI, %s_LO};\n\n' % (name, width, pages, name, name))
+        f.write('#endif // %s\n' % guard)
+
+    histogram = [sum(row.count(level) for row in levels) for level in range(LEVELS)]
+    gray_tiles = sum(1 for p in range(pages) for t in range((width + 7) // 8)
+                     if any(hi[p * width + x] ^ lo[p * width + x] for x in range(t * 8, min(width, t * 8 + 8))))
+    print('%dx%d，%d 字节；各级灰度像素数 %s；平面之间变化的tile %d 个（每平面 %d 字节）'
+          % (width, height, len(hi) + len(lo), histogram, gray_tiles, gray_tiles * 8))
+
+
+if __name__ == '__main__':
+    main()